@@ -0,0 +1,14 @@
+#ifndef PKG_X11_H
+#define PKG_X11_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XShm.h>
+
+#endif
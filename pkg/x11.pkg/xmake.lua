@@ -13,6 +13,9 @@ option("x11")
     -- add defines to config.h if checking ok
     add_defines_h("$(prefix)_PACKAGE_HAVE_X11")
 
+    -- add links for checking
+    add_links("Xext", "X11")
+
     -- add link directories
     add_linkdirs("lib/$(plat)/$(arch)")
 
@@ -0,0 +1,155 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+static tb_void_t gb_demo_core_device_draw(gb_canvas_ref_t canvas, tb_size_t width, tb_size_t height)
+{
+    // clear it
+    gb_canvas_draw_clear(canvas, GB_COLOR_WHITE);
+
+    // draw the random shapes
+    tb_size_t i = 0;
+    tb_random_reset(tb_true);
+    for (i = 0; i < 2000; i++)
+    {
+        // the position and size, some shapes cross the edges of the bitmap for checking the clipping of the tiles
+        tb_long_t r = tb_random_range(2, (tb_min(width, height) >> 3) + 2);
+        tb_long_t x = tb_random_range(-r, width + r);
+        tb_long_t y = tb_random_range(-r, height + r);
+
+        // init paint
+        gb_canvas_mode_set(canvas, (i & 0x3)? GB_PAINT_MODE_FILL : GB_PAINT_MODE_STROKE);
+        gb_canvas_color_set(canvas, gb_color_make(0xff, (tb_byte_t)tb_random_range(0, 255), (tb_byte_t)tb_random_range(0, 255), (tb_byte_t)tb_random_range(0, 255)));
+        gb_canvas_alpha_set(canvas, (i & 0x1)? 0xff : 0x80);
+        gb_canvas_stroke_width_set(canvas, gb_long_to_float((i & 0x7) + 1));
+
+        // draw shape
+        switch (i % 5)
+        {
+        case 0:
+            gb_canvas_draw_rect2i(canvas, x, y, r, r >> 1);
+            break;
+        case 1:
+            gb_canvas_draw_circle2i(canvas, x, y, r);
+            break;
+        case 2:
+            gb_canvas_draw_ellipse2i(canvas, x, y, r, r >> 1);
+            break;
+        case 3:
+            gb_canvas_draw_triangle2i(canvas, x, y, x + r, y + (r >> 1), x - (r >> 2), y + r);
+            break;
+        default:
+            gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+            gb_canvas_draw_line2i(canvas, x, y, x + r, y + (r >> 2));
+            break;
+        }
+    }
+}
+static tb_uint32_t gb_demo_core_device_sum(gb_bitmap_ref_t bitmap)
+{
+    // fnv-1a hash of the pixels
+    tb_uint32_t     hash = 2166136261u;
+    tb_byte_t const* p = (tb_byte_t const*)gb_bitmap_data(bitmap);
+    tb_size_t       n = gb_bitmap_size(bitmap);
+    while (n--) 
+    {
+        hash ^= *p++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+static tb_hong_t gb_demo_core_device_done(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, tb_size_t frames)
+{
+    // check
+    tb_assert_and_check_return_val(canvas && bitmap && frames, 0);
+
+    // done
+    tb_size_t i = 0;
+    tb_hong_t dt = tb_mclock();
+    for (i = 0; i < frames; i++)
+    {
+        gb_demo_core_device_draw(canvas, gb_bitmap_width(bitmap), gb_bitmap_height(bitmap));
+        gb_canvas_flush(canvas);
+    }
+    return tb_mclock() - dt;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_device_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+    // the width, height, frames, max workers and tile size
+    tb_size_t width     = (argc > 1)? tb_atoi(argv[1]) : 3840;
+    tb_size_t height    = (argc > 2)? tb_atoi(argv[2]) : 2160;
+    tb_size_t frames    = (argc > 3)? tb_atoi(argv[3]) : 10;
+    tb_size_t workers   = (argc > 4)? tb_atoi(argv[4]) : tb_max(tb_processor_count(), 4);
+    tb_size_t tile      = (argc > 5)? tb_atoi(argv[5]) : 0;
+    tb_assert_and_check_return_val(width && height && frames && workers, -1);
+
+    // init bitmap
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888, width, height, 0, tb_false);
+    tb_assert_and_check_return_val(bitmap, -1);
+
+    // done the bitmap device
+    tb_hong_t       base = 0;
+    tb_uint32_t     sum = 0;
+    gb_canvas_ref_t canvas = gb_canvas_init_from_bitmap(bitmap);
+    if (canvas)
+    {
+        // done
+        base = gb_demo_core_device_done(canvas, bitmap, frames);
+        sum = gb_demo_core_device_sum(bitmap);
+
+        // trace
+        tb_trace_i("bitmap: %lux%lu: %lld ms/frame, sum: %08x", width, height, base / frames, sum);
+
+        // exit canvas
+        gb_canvas_exit(canvas);
+    }
+
+    // done the tiled bitmap device
+    tb_size_t count = 1;
+    for (count = 1; count <= workers; count <<= 1)
+    {
+        // init device
+        gb_device_ref_t device = gb_device_init_bitmap_tiled(bitmap, tile, count);
+        tb_assert_and_check_break(device);
+
+        // init canvas
+        canvas = gb_canvas_init(device);
+        if (!canvas)
+        {
+            gb_device_exit(device);
+            break;
+        }
+
+        // clear the bitmap
+        tb_memset(gb_bitmap_data(bitmap), 0, gb_bitmap_size(bitmap));
+
+        // done
+        tb_hong_t   dt = gb_demo_core_device_done(canvas, bitmap, frames);
+        tb_uint32_t tiled_sum = gb_demo_core_device_sum(bitmap);
+
+        // trace
+        tb_trace_i("tiled: %lu workers: %lld ms/frame, %lld frames/s, x%lld.%02lld, sum: %08x %s", count, dt / frames, dt? ((tb_hong_t)frames * 1000) / dt : 0, dt? base / dt : 0, dt? ((base * 100) / dt) % 100 : 0, tiled_sum, tiled_sum == sum? "ok" : "different!");
+
+        // exit canvas and device
+        gb_canvas_exit(canvas);
+    }
+
+    // exit bitmap
+    gb_bitmap_exit(bitmap);
+#else
+    // trace
+    tb_trace_e("no bitmap device!");
+#endif
+    return 0;
+}
@@ -0,0 +1,235 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+static tb_void_t gb_demo_core_picture_draw(gb_canvas_ref_t canvas, tb_size_t width, tb_size_t height)
+{
+    // clear it
+    gb_canvas_draw_clear(canvas, GB_COLOR_WHITE);
+
+    // draw the random widgets
+    tb_size_t i = 0;
+    tb_random_reset(tb_true);
+    for (i = 0; i < 1000; i++)
+    {
+        // the position and size, the widgets are kept inside the bitmap because the bitmap device does not clip them now
+        tb_long_t w = tb_random_range(8, (width >> 3) + 8);
+        tb_long_t h = tb_random_range(8, (height >> 4) + 8);
+        tb_long_t x = tb_random_range(16, width - w - 16);
+        tb_long_t y = tb_random_range(16, height - h - 16);
+
+        // init paint
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+        gb_canvas_color_set(canvas, gb_color_make(0xff, (tb_byte_t)tb_random_range(0, 255), (tb_byte_t)tb_random_range(0, 255), (tb_byte_t)tb_random_range(0, 255)));
+
+        // the widget frame
+        gb_rect_t bounds;
+        gb_rect_imake(&bounds, x, y, w, h);
+        gb_canvas_draw_round_rect2i(canvas, &bounds, 4, 4);
+
+        // the widget border
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+        gb_canvas_color_set(canvas, GB_COLOR_BLACK);
+        gb_canvas_stroke_width_set(canvas, GB_ONE);
+        gb_canvas_draw_rect2i(canvas, x, y, w, h);
+
+        // the widget icon
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+        gb_canvas_draw_circle2i(canvas, x + (h >> 1), y + (h >> 1), h >> 2);
+
+        // the widget underline
+        gb_canvas_draw_line2i(canvas, x + h, y + h - 2, x + w - 2, y + h - 2);
+    }
+}
+static tb_void_t gb_demo_core_picture_draw_clipped(gb_canvas_ref_t canvas, tb_size_t width, tb_size_t height)
+{
+    // clip the circle and subtract the rect in the center
+    gb_canvas_save_clipper(canvas);
+    gb_canvas_clip_circle2i(canvas, GB_CLIPPER_MODE_INTERSECT, width >> 1, height >> 1, height / 3);
+    gb_canvas_clip_rect2i(canvas, GB_CLIPPER_MODE_SUBTRACT, (width >> 1) - 40, (height >> 1) - 30, 80, 60);
+
+    // draw the clipped widgets
+    gb_demo_core_picture_draw(canvas, width, height);
+
+    // draw the unclipped frame
+    gb_canvas_load_clipper(canvas);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    gb_canvas_draw_rect2i(canvas, 40, 40, width - 80, height - 80);
+
+    // draw the widgets inside the clipped band
+    gb_canvas_save_clipper(canvas);
+    gb_canvas_clip_rect2i(canvas, GB_CLIPPER_MODE_INTERSECT, 0, 60, width, 40);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_color_set(canvas, GB_COLOR_RED);
+    gb_canvas_draw_ellipse2i(canvas, width >> 1, 80, width >> 2, 30);
+    gb_canvas_load_clipper(canvas);
+}
+static tb_uint32_t gb_demo_core_picture_sum(gb_bitmap_ref_t bitmap)
+{
+    // fnv-1a hash of the pixels
+    tb_uint32_t     hash = 2166136261u;
+    tb_byte_t const* p = (tb_byte_t const*)gb_bitmap_data(bitmap);
+    tb_size_t       n = gb_bitmap_size(bitmap);
+    while (n--) 
+    {
+        hash ^= *p++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+static tb_bool_t gb_demo_core_picture_clip(tb_size_t quality, tb_long_t dx, tb_long_t dy)
+{
+    // the width and height
+    tb_size_t width     = 640;
+    tb_size_t height    = 480;
+
+    // init quality before making the canvas, the pixmap of the device depends on it
+    tb_size_t saved = gb_quality();
+    gb_quality_set(quality);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_bitmap_ref_t     bitmap = tb_null;
+    gb_canvas_ref_t     canvas = tb_null;
+    gb_canvas_ref_t     recorder = tb_null;
+    gb_picture_ref_t    picture = tb_null;
+    do
+    {
+        // init bitmap and canvas
+        bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888, width, height, 0, tb_false);
+        tb_assert_and_check_break(bitmap);
+        canvas = gb_canvas_init_from_bitmap(bitmap);
+        tb_assert_and_check_break(canvas);
+
+        // draw it directly
+        tb_memset(gb_bitmap_data(bitmap), 0, gb_bitmap_size(bitmap));
+        gb_canvas_save_matrix(canvas);
+        gb_canvas_translate(canvas, gb_long_to_float(dx), gb_long_to_float(dy));
+        gb_demo_core_picture_draw_clipped(canvas, width, height);
+        gb_canvas_load_matrix(canvas);
+        tb_uint32_t sum = gb_demo_core_picture_sum(bitmap);
+
+        // record it
+        recorder = gb_canvas_init(gb_device_init_recorder(width, height));
+        tb_assert_and_check_break(recorder);
+        gb_demo_core_picture_draw_clipped(recorder, width, height);
+        picture = gb_device_recorder_done(gb_canvas_device(recorder));
+        tb_assert_and_check_break(picture);
+
+        // replay it
+        tb_memset(gb_bitmap_data(bitmap), 0, gb_bitmap_size(bitmap));
+        gb_canvas_save_matrix(canvas);
+        gb_canvas_translate(canvas, gb_long_to_float(dx), gb_long_to_float(dy));
+        gb_canvas_draw_picture(canvas, picture);
+        gb_canvas_load_matrix(canvas);
+        tb_uint32_t replay_sum = gb_demo_core_picture_sum(bitmap);
+
+        // trace
+        ok = replay_sum == sum;
+        tb_trace_i("clip: quality: %lu, translate: %ld, %ld, %lu commands, sum: %08x, replay: %08x %s", quality, dx, dy, gb_picture_size(picture), sum, replay_sum, ok? "ok" : "different!");
+
+    } while (0);
+
+    // exit them
+    if (picture) gb_picture_exit(picture);
+    if (recorder) gb_canvas_exit(recorder);
+    if (canvas) gb_canvas_exit(canvas);
+    if (bitmap) gb_bitmap_exit(bitmap);
+
+    // restore quality
+    gb_quality_set(saved);
+
+    // ok?
+    return ok;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_picture_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+    // the width, height and frames
+    tb_size_t width     = (argc > 1)? tb_atoi(argv[1]) : 1920;
+    tb_size_t height    = (argc > 2)? tb_atoi(argv[2]) : 1080;
+    tb_size_t frames    = (argc > 3)? tb_atoi(argv[3]) : 10;
+    tb_assert_and_check_return_val(width && height && frames, -1);
+
+    // init bitmap
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888, width, height, 0, tb_false);
+    tb_assert_and_check_return_val(bitmap, -1);
+
+    // init canvas
+    gb_canvas_ref_t canvas = gb_canvas_init_from_bitmap(bitmap);
+    if (canvas)
+    {
+        // draw it directly
+        tb_size_t i = 0;
+        tb_hong_t base = tb_mclock();
+        for (i = 0; i < frames; i++) gb_demo_core_picture_draw(canvas, width, height);
+        base = tb_mclock() - base;
+        tb_uint32_t sum = gb_demo_core_picture_sum(bitmap);
+
+        // trace
+        tb_trace_i("draw: %lux%lu: %lld ms/frame, sum: %08x", width, height, base / frames, sum);
+
+        // record it
+        gb_picture_ref_t    picture = tb_null;
+        gb_canvas_ref_t     recorder = gb_canvas_init(gb_device_init_recorder(width, height));
+        if (recorder)
+        {
+            tb_hong_t dt = tb_mclock();
+            gb_demo_core_picture_draw(recorder, width, height);
+            picture = gb_device_recorder_done(gb_canvas_device(recorder));
+            dt = tb_mclock() - dt;
+
+            // trace
+            if (picture) tb_trace_i("record: %lld ms, %lu commands", dt, gb_picture_size(picture));
+
+            // exit recorder
+            gb_canvas_exit(recorder);
+        }
+
+        // replay it
+        if (picture)
+        {
+            // clear the bitmap
+            tb_memset(gb_bitmap_data(bitmap), 0, gb_bitmap_size(bitmap));
+
+            // done
+            tb_hong_t dt = tb_mclock();
+            for (i = 0; i < frames; i++) gb_canvas_draw_picture(canvas, picture);
+            dt = tb_mclock() - dt;
+            tb_uint32_t replay_sum = gb_demo_core_picture_sum(bitmap);
+
+            // trace
+            tb_trace_i("replay: %lld ms/frame, x%lld.%02lld, sum: %08x %s", dt / frames, dt? base / dt : 0, dt? ((base * 100) / dt) % 100 : 0, replay_sum, replay_sum == sum? "ok" : "different!");
+
+            // exit picture
+            gb_picture_exit(picture);
+        }
+
+        // exit canvas
+        gb_canvas_exit(canvas);
+    }
+
+    // exit bitmap
+    gb_bitmap_exit(bitmap);
+
+    // the recorded clippers must be replayed, the translated clip mask is only exact for the aliased pixels
+    gb_demo_core_picture_clip(gb_quality(), 0, 0);
+    gb_demo_core_picture_clip(GB_QUALITY_LOW, 0, 0);
+    gb_demo_core_picture_clip(GB_QUALITY_LOW, 17, 9);
+#else
+    // trace
+    tb_trace_e("no bitmap device!");
+#endif
+    return 0;
+}
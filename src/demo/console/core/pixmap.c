@@ -0,0 +1,140 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the simd names
+static tb_char_t const* g_simd_names[] = 
+{
+    "scalar"
+,   "sse2"
+,   "avx2"
+,   "neon"
+};
+
+// the pixfmts
+static tb_size_t g_pixfmts[] = 
+{
+    GB_PIXFMT_ARGB8888
+,   GB_PIXFMT_XRGB8888
+,   GB_PIXFMT_RGB565
+,   GB_PIXFMT_ARGB4444
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_hong_t gb_demo_core_pixmap_fill(tb_size_t pixfmt, tb_byte_t* data, tb_size_t count, tb_size_t loop)
+{
+    // the pixmap for blending
+    gb_pixmap_ref_t pixmap = gb_pixmap(pixfmt, 0x80);
+    tb_assert_and_check_return_val(pixmap && pixmap->pixels_fill, 0);
+
+    // the pixel
+    gb_pixel_t pixel = pixmap->pixel(GB_COLOR_RED);
+
+    // fill the translucent pixels
+    tb_hong_t dt = tb_uclock();
+    while (loop--) pixmap->pixels_fill(data + (loop & 0x3) * pixmap->btp, pixel, count, (tb_byte_t)(0x40 + (loop & 0x7f)));
+    return tb_uclock() - dt;
+}
+
+static tb_size_t gb_demo_core_pixmap_check(tb_size_t pixfmt, tb_size_t simd, tb_byte_t* data, tb_byte_t* base, tb_size_t count)
+{
+    // the scalar and simd pixmaps
+    gb_pixmap_simd_set(GB_PIXMAP_SIMD_NONE);
+    gb_pixmap_ref_t pixmap = gb_pixmap(pixfmt, 0x80);
+    gb_pixmap_simd_set(simd);
+    gb_pixmap_ref_t pixmap_simd = gb_pixmap(pixfmt, 0x80);
+    tb_assert_and_check_return_val(pixmap && pixmap->pixels_fill && pixmap_simd && pixmap_simd->pixels_fill, 0);
+
+    // the pixel
+    gb_pixel_t pixel = pixmap->pixel(GB_COLOR_RED);
+
+    // init the same pixels
+    tb_size_t i = 0;
+    tb_size_t size = (count + 4) * pixmap->btp;
+    for (i = 0; i < size; i++) base[i] = (tb_byte_t)(i * 131 + (i >> 8));
+    tb_memcpy(data, base, size);
+
+    // fill the translucent pixels by the scalar and simd kernels with the unaligned rows and all alphas
+    tb_size_t alpha = 0;
+    for (alpha = 0; alpha < 256; alpha += 5)
+    {
+        tb_size_t offset = (alpha & 0x3) * pixmap->btp;
+        tb_size_t length = count > 8? count - (alpha & 0x7) : count;
+        pixmap->pixels_fill(base + offset, pixel, length, (tb_byte_t)alpha);
+        pixmap_simd->pixels_fill(data + offset, pixel, length, (tb_byte_t)alpha);
+    }
+
+    // the different bytes
+    tb_size_t diff = 0;
+    for (i = 0; i < size; i++) if (data[i] != base[i]) diff++;
+    return diff;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_pixmap_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the pixels count and loop count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 1920 * 1080;
+    tb_size_t loop  = (argv[1] && argv[2])? tb_atoi(argv[2]) : 100;
+    tb_assert_and_check_return_val(count && loop, -1);
+
+    // make data, and offset it with the loop index for the unaligned rows
+    tb_byte_t* data = tb_malloc0_bytes((count + 4) * 4);
+    tb_assert_and_check_return_val(data, -1);
+
+    // make the scalar data for checking the simd results
+    tb_byte_t* base_data = tb_malloc0_bytes((count + 4) * 4);
+    tb_assert_and_check_return_val(base_data, -1);
+
+    // save the current simd
+    tb_size_t simd_saved = gb_pixmap_simd();
+
+    // done
+    tb_int_t  ok = 0;
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(g_pixfmts); i++)
+    {
+        // the scalar time
+        gb_pixmap_simd_set(GB_PIXMAP_SIMD_NONE);
+        tb_hong_t base = gb_demo_core_pixmap_fill(g_pixfmts[i], data, count, loop);
+
+        // trace
+        tb_trace_i("%s: %s: %lld us, %lld Mpixels/s", gb_pixmap(g_pixfmts[i], 0xff)->name, g_simd_names[GB_PIXMAP_SIMD_NONE], base, base? ((tb_hong_t)count * loop) / base : 0);
+
+        // the simd time
+        tb_size_t simd = 0;
+        for (simd = GB_PIXMAP_SIMD_NONE + 1; simd < GB_PIXMAP_SIMD_MAXN; simd++)
+        {
+            // not supported?
+            tb_check_continue(gb_pixmap_simd_set(simd));
+
+            // done
+            tb_hong_t dt = gb_demo_core_pixmap_fill(g_pixfmts[i], data, count, loop);
+
+            // check the results with the scalar kernel
+            tb_size_t diff = gb_demo_core_pixmap_check(g_pixfmts[i], simd, data, base_data, count);
+            if (diff) ok = -1;
+
+            // trace
+            tb_trace_i("%s: %s: %lld us, %lld Mpixels/s, x%lld.%02lld, %s", gb_pixmap(g_pixfmts[i], 0xff)->name, g_simd_names[simd], dt, dt? ((tb_hong_t)count * loop) / dt : 0, dt? base / dt : 0, dt? ((base * 100) / dt) % 100 : 0, diff? "mismatched" : "ok");
+            if (diff) tb_trace_e("%s: %s: %lu bytes are different from the scalar kernel", gb_pixmap(g_pixfmts[i], 0xff)->name, g_simd_names[simd], diff);
+        }
+    }
+
+    // restore the simd
+    gb_pixmap_simd_set(simd_saved);
+
+    // exit data
+    tb_free(base_data);
+    tb_free(data);
+    return ok;
+}
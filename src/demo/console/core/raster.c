@@ -0,0 +1,281 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the quality names
+static tb_char_t const* g_quality_names[] = {"low", "mid", "top"};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+static tb_uint32_t gb_demo_core_raster_back(gb_bitmap_ref_t bitmap)
+{
+    // the background pixel at the left-top corner
+    return *((tb_uint32_t const*)gb_bitmap_data(bitmap)) & 0xffffff;
+}
+static tb_size_t gb_demo_core_raster_count(gb_bitmap_ref_t bitmap, tb_uint32_t back, tb_long_t top, tb_long_t bottom)
+{
+    // the pixels
+    tb_size_t   count = 0;
+    tb_size_t   width = gb_bitmap_width(bitmap);
+    tb_size_t   row_bytes = gb_bitmap_row_bytes(bitmap);
+    tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(bitmap);
+
+    // count the painted pixels of the rows: [top, bottom)
+    tb_long_t   y = 0;
+    tb_size_t   x = 0;
+    for (y = tb_max(top, 0); y < tb_min(bottom, (tb_long_t)gb_bitmap_height(bitmap)); y++)
+    {
+        tb_uint32_t const* p = (tb_uint32_t const*)(data + y * row_bytes);
+        for (x = 0; x < width; x++) if ((p[x] & 0xffffff) != back) count++;
+    }
+    return count;
+}
+static tb_bool_t gb_demo_core_raster_tall(tb_size_t quality)
+{
+    /* the circles at the top and bottom of the tall bitmap, the coverage edges overflowed at y > 32767 before
+     *
+     * the height is limited to GB_HEIGHT_MAXN for the fixed-point coordinates
+     */
+    tb_long_t const height = tb_min(40000, GB_HEIGHT_MAXN);
+    tb_long_t const s_ys[] = {100, height - 10000, height - 7000, height - 1000};
+    tb_long_t const r = 20;
+
+    // init bitmap
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888, 64, height, 0, tb_false);
+    tb_assert_and_check_return_val(bitmap, tb_false);
+
+    // init canvas
+    gb_canvas_ref_t canvas = gb_canvas_init_from_bitmap(bitmap);
+    if (!canvas)
+    {
+        gb_bitmap_exit(bitmap);
+        return tb_false;
+    }
+
+    // draw the circles
+    tb_size_t i = 0;
+    gb_quality_set(quality);
+    gb_canvas_draw_clear(canvas, GB_COLOR_WHITE);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_color_set(canvas, GB_COLOR_RED);
+    for (i = 0; i < tb_arrayn(s_ys); i++)
+        gb_canvas_draw_circle2i(canvas, 32, s_ys[i], r);
+    gb_canvas_flush(canvas);
+
+    // every circle must paint the same pixels, the left-top corner is not painted
+    tb_uint32_t back = gb_demo_core_raster_back(bitmap);
+    tb_bool_t   ok = tb_true;
+    tb_size_t   total = 0;
+    tb_size_t   first = 0;
+    for (i = 0; i < tb_arrayn(s_ys); i++)
+    {
+        tb_size_t count = gb_demo_core_raster_count(bitmap, back, s_ys[i] - r - 2, s_ys[i] + r + 2);
+        if (!i) first = count;
+        if (!count || count != first) ok = tb_false;
+        total += count;
+
+        // trace
+        tb_trace_i("tall: %s: y: %ld, %lu pixels", g_quality_names[quality], s_ys[i], count);
+    }
+
+    // trace
+    tb_trace_i("tall: %s: 64x%ld: %lu pixels, %s", g_quality_names[quality], height, total, ok? "ok" : "different!");
+
+    // exit canvas and bitmap
+    gb_canvas_exit(canvas);
+    gb_bitmap_exit(bitmap);
+    return ok;
+}
+static tb_bool_t gb_demo_core_raster_clip(tb_size_t quality)
+{
+    // init bitmap
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888, 100, 100, 0, tb_false);
+    tb_assert_and_check_return_val(bitmap, tb_false);
+
+    // init canvas
+    gb_canvas_ref_t canvas = gb_canvas_init_from_bitmap(bitmap);
+    if (!canvas)
+    {
+        gb_bitmap_exit(bitmap);
+        return tb_false;
+    }
+
+    /* the full-width rects are filled at once by the solid biltter,
+     * they were filled from the row 0 before if the rect or the clipped piece starts at y > 0
+     */
+    tb_size_t i = 0;
+    tb_bool_t ok = tb_true;
+    gb_quality_set(quality);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    for (i = 0; i < 4; i++)
+    {
+        // clear the bitmap, the corner will be painted
+        tb_memset(gb_bitmap_data(bitmap), 0, gb_bitmap_size(bitmap));
+        tb_uint32_t back = gb_demo_core_raster_back(bitmap);
+
+        // save the clipper
+        gb_canvas_save_clipper(canvas);
+        gb_canvas_color_set(canvas, GB_COLOR_RED);
+
+        // draw it
+        tb_char_t const*    name = tb_null;
+        tb_size_t           above = 0;
+        tb_size_t           inner_min = 0;
+        tb_size_t           inner_max = 0;
+        switch (i)
+        {
+        case 0:
+            // the rect at y > 0, only the rows: [50, 80) are painted
+            name = "rect";
+            gb_canvas_draw_rect2i(canvas, 0, 50, 100, 30);
+            above = 50;
+            inner_min = inner_max = 3000;
+            break;
+        case 1:
+            // the band clip below the row 0
+            name = "band";
+            gb_canvas_clip_rect2i(canvas, GB_CLIPPER_MODE_REPLACE, 0, 30, 100, 40);
+            gb_canvas_draw_rect2i(canvas, 0, 0, 100, 100);
+            above = 30;
+            inner_min = inner_max = 4000;
+            break;
+        case 2:
+            // the hole in the middle, the full-width bands are above and below it
+            name = "subtract rect";
+            gb_canvas_clip_rect2i(canvas, GB_CLIPPER_MODE_SUBTRACT, 40, 40, 20, 20);
+            gb_canvas_draw_rect2i(canvas, 0, 0, 100, 100);
+            inner_min = inner_max = 9600;
+            break;
+        default:
+            // the circle hole, about 100 * 100 - pi * 20 * 20 pixels
+            name = "subtract circle";
+            gb_canvas_clip_circle2i(canvas, GB_CLIPPER_MODE_SUBTRACT, 50, 50, 20);
+            gb_canvas_draw_rect2i(canvas, 0, 0, 100, 100);
+            inner_min = 8650;
+            inner_max = 8850;
+            break;
+        }
+        gb_canvas_flush(canvas);
+        gb_canvas_load_clipper(canvas);
+
+        // the rows above the drawn rows must not be painted
+        tb_size_t count_above = gb_demo_core_raster_count(bitmap, back, 0, above);
+        tb_size_t count = gb_demo_core_raster_count(bitmap, back, above, 100);
+        tb_bool_t passed = !count_above && count >= inner_min && count <= inner_max;
+        if (!passed) ok = tb_false;
+
+        // trace
+        tb_trace_i("clip: %s: %s: %lu pixels, %lu above, %s", g_quality_names[quality], name, count, count_above, passed? "ok" : "failed!");
+    }
+
+    // exit canvas and bitmap
+    gb_canvas_exit(canvas);
+    gb_bitmap_exit(bitmap);
+    return ok;
+}
+static tb_bool_t gb_demo_core_raster_stress(tb_size_t edges, tb_size_t quality, tb_size_t rule)
+{
+    // init bitmap
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888, 1024, 1024, 0, tb_false);
+    tb_assert_and_check_return_val(bitmap, tb_false);
+
+    // init canvas and points
+    gb_point_ref_t  points = tb_nalloc_type(edges + 1, gb_point_t);
+    gb_canvas_ref_t canvas = gb_canvas_init_from_bitmap(bitmap);
+    if (!canvas || !points)
+    {
+        if (points) tb_free(points);
+        if (canvas) gb_canvas_exit(canvas);
+        gb_bitmap_exit(bitmap);
+        return tb_false;
+    }
+
+    /* make a star with the given edges
+     *
+     * the spikes are thinner than one pixel, so every scan-line crosses thousands of edges,
+     * the polygon is used instead of the path, because the path points are limited by the vector of tbox
+     */
+    tb_size_t i = 0;
+    for (i = 0; i < edges; i++)
+    {
+        tb_float_t a = (2 * TB_PI * i) / edges;
+        tb_float_t d = (i & 1)? 500 : 450;
+        points[i].x = tb_float_to_gb(512 + d * tb_cosf(a));
+        points[i].y = tb_float_to_gb(512 + d * tb_sinf(a));
+    }
+    points[edges] = points[0];
+
+    // make polygon
+    tb_uint32_t     counts[2] = {(tb_uint32_t)edges + 1, 0};
+    gb_polygon_t    polygon = {points, counts, tb_false};
+
+    // fill it
+    gb_quality_set(quality);
+    gb_canvas_draw_clear(canvas, GB_COLOR_WHITE);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_fill_rule_set(canvas, rule);
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    tb_hong_t dt = tb_mclock();
+    gb_canvas_draw_polygon(canvas, &polygon);
+    gb_canvas_flush(canvas);
+    dt = tb_mclock() - dt;
+
+    // the star must cover the inner circle at least
+    tb_size_t count = gb_demo_core_raster_count(bitmap, gb_demo_core_raster_back(bitmap), 0, 1024);
+    tb_bool_t ok = count > (tb_size_t)(TB_PI * 450 * 450);
+
+    // trace
+    tb_trace_i("stress: %s: %s: %lu edges: %lld ms, %lu pixels, %s", g_quality_names[quality], rule == GB_PAINT_FILL_RULE_ODD? "odd" : "nonzero", edges, dt, count, ok? "ok" : "failed!");
+
+    // exit it
+    tb_free(points);
+    gb_canvas_exit(canvas);
+    gb_bitmap_exit(bitmap);
+    return ok;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_raster_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+    // the edges of the stress test
+    tb_size_t edges = (argc > 1)? tb_atoi(argv[1]) : 2000000;
+    tb_assert_and_check_return_val(edges >= 4, -1);
+
+    // save the quality
+    tb_size_t quality = gb_quality();
+
+    // done the tall bitmap
+    tb_bool_t ok = tb_true;
+    if (!gb_demo_core_raster_tall(GB_QUALITY_LOW)) ok = tb_false;
+    if (!gb_demo_core_raster_tall(GB_QUALITY_TOP)) ok = tb_false;
+
+    // done the clipped and full-width rects
+    if (!gb_demo_core_raster_clip(GB_QUALITY_LOW)) ok = tb_false;
+    if (!gb_demo_core_raster_clip(GB_QUALITY_TOP)) ok = tb_false;
+
+    // done the stress test with millions of edges, the top quality uses the anti-aliasing coverage raster
+    if (!gb_demo_core_raster_stress(edges, GB_QUALITY_LOW, GB_PAINT_FILL_RULE_NONZERO)) ok = tb_false;
+    if (!gb_demo_core_raster_stress(edges, GB_QUALITY_LOW, GB_PAINT_FILL_RULE_ODD)) ok = tb_false;
+    if (!gb_demo_core_raster_stress(edges, GB_QUALITY_TOP, GB_PAINT_FILL_RULE_NONZERO)) ok = tb_false;
+    if (!gb_demo_core_raster_stress(edges, GB_QUALITY_TOP, GB_PAINT_FILL_RULE_ODD)) ok = tb_false;
+
+    // restore the quality
+    gb_quality_set(quality);
+    return ok? 0 : -1;
+#else
+    // trace
+    tb_trace_e("no bitmap device!");
+    return 0;
+#endif
+}
@@ -36,6 +36,10 @@ static gb_demo_t g_demo[] =
     GB_DEMO_MAIN_ITEM(core_path)
 ,   GB_DEMO_MAIN_ITEM(core_bitmap)
 ,   GB_DEMO_MAIN_ITEM(core_vector)
+,   GB_DEMO_MAIN_ITEM(core_pixmap)
+,   GB_DEMO_MAIN_ITEM(core_device)
+,   GB_DEMO_MAIN_ITEM(core_picture)
+,   GB_DEMO_MAIN_ITEM(core_raster)
 
     // utils
 ,   GB_DEMO_MAIN_ITEM(utils_mesh)
@@ -43,6 +47,7 @@ static gb_demo_t g_demo[] =
 
     // ohter
 ,   GB_DEMO_MAIN_ITEM(other_test)
+,   GB_DEMO_MAIN_ITEM(other_bench)
 };
 
 /* //////////////////////////////////////////////////////////////////////////////////////
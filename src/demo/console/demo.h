@@ -45,6 +45,10 @@
 GB_DEMO_MAIN_DECL(core_path);
 GB_DEMO_MAIN_DECL(core_bitmap);
 GB_DEMO_MAIN_DECL(core_vector);
+GB_DEMO_MAIN_DECL(core_pixmap);
+GB_DEMO_MAIN_DECL(core_device);
+GB_DEMO_MAIN_DECL(core_picture);
+GB_DEMO_MAIN_DECL(core_raster);
 
 // utils
 GB_DEMO_MAIN_DECL(utils_mesh);
@@ -52,6 +56,7 @@ GB_DEMO_MAIN_DECL(utils_geometry);
 
 // other
 GB_DEMO_MAIN_DECL(other_test);
+GB_DEMO_MAIN_DECL(other_bench);
 
 #endif
 
@@ -0,0 +1,561 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include "../../core/tiger.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default frames of each case
+#define GB_DEMO_BENCH_FRAMES            (50)
+
+// the scene units, the scenes are drawn in [-360, 360] and scaled to the bitmap
+#define GB_DEMO_BENCH_UNITS             (720)
+
+// the teeth of the tessellator scenes, every tooth keeps two edges active, so 10000 edges are active at once
+#define GB_DEMO_BENCH_TEETH             (5000)
+
+// the tooth height of the tessellator scenes
+#define GB_DEMO_BENCH_TOOTH_HEIGHT      (1000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bench scene type
+typedef struct __gb_demo_bench_scene_t
+{
+    // the name
+    tb_char_t const*    name;
+
+    // the draw func
+    tb_void_t           (*draw)(gb_canvas_ref_t canvas);
+
+}gb_demo_bench_scene_t;
+
+// the bench polygon scene type, only for the tessellator
+typedef struct __gb_demo_bench_polygon_t
+{
+    // the name
+    tb_char_t const*    name;
+
+    // the make func
+    tb_bool_t           (*make)(gb_polygon_ref_t polygon);
+
+}gb_demo_bench_polygon_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the paths of the path scene
+static gb_path_ref_t            g_paths[3] = {tb_null};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * scenes
+ */
+static tb_void_t gb_demo_bench_rect(gb_canvas_ref_t canvas)
+{
+    // rect
+    gb_rect_t rect;
+    gb_rect_imake(&rect, -100, -100, 200, 200);
+
+    // fill
+    gb_canvas_color_set(canvas, GB_COLOR_RED);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_draw_rect(canvas, &rect);
+
+    // stroke
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_draw_rect(canvas, &rect);
+}
+static tb_void_t gb_demo_bench_round_rect(gb_canvas_ref_t canvas)
+{
+    // the bounds
+    gb_rect_t bounds;
+    gb_rect_imake(&bounds, -100, -100, 200, 200);
+
+    // fill
+    gb_canvas_color_set(canvas, GB_COLOR_RED);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_draw_round_rect2i(canvas, &bounds, 50, 50);
+
+    // stroke
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_draw_round_rect2i(canvas, &bounds, 50, 50);
+}
+static tb_void_t gb_demo_bench_path(gb_canvas_ref_t canvas)
+{
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(g_paths); i++)
+    {
+        // fill
+        gb_canvas_color_set(canvas, GB_COLOR_RED);
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+        gb_canvas_draw_path(canvas, g_paths[i]);
+
+        // stroke
+        gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+        gb_canvas_draw_path(canvas, g_paths[i]);
+    }
+}
+static tb_void_t gb_demo_bench_lines(gb_canvas_ref_t canvas)
+{
+    // make points
+    gb_point_t points[] =
+    {
+        { -gb_long_to_float(100),   -gb_long_to_float(100)  }
+    ,   { gb_long_to_float(100),    gb_long_to_float(100)   }
+
+    ,   { -gb_long_to_float(100),   -gb_long_to_float(50)   }
+    ,   { gb_long_to_float(100),    gb_long_to_float(50)    }
+
+    ,   { -gb_long_to_float(50),    -gb_long_to_float(100)  }
+    ,   { gb_long_to_float(50),     gb_long_to_float(100)   }
+
+    ,   { -gb_long_to_float(100),   gb_long_to_float(100)   }
+    ,   { gb_long_to_float(100),    -gb_long_to_float(100)  }
+
+    ,   { -gb_long_to_float(100),   gb_long_to_float(50)    }
+    ,   { gb_long_to_float(100),    -gb_long_to_float(50)   }
+
+    ,   { -gb_long_to_float(50),   gb_long_to_float(100)    }
+    ,   { gb_long_to_float(50),    -gb_long_to_float(100)   }
+
+    ,   { gb_long_to_float(0),      gb_long_to_float(100)   }
+    ,   { gb_long_to_float(0),      -gb_long_to_float(100)  }
+
+    ,   { gb_long_to_float(100),    gb_long_to_float(0)     }
+    ,   { -gb_long_to_float(100),   gb_long_to_float(0)     }
+    };
+
+    // stroke
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_draw_lines(canvas, points, tb_arrayn(points));
+}
+static tb_void_t gb_demo_bench_circle(gb_canvas_ref_t canvas)
+{
+    // circle
+    gb_circle_t circle;
+    gb_circle_imake(&circle, 0, 0, 200);
+
+    // fill
+    gb_canvas_color_set(canvas, GB_COLOR_RED);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_draw_circle(canvas, &circle);
+
+    // stroke
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_draw_circle(canvas, &circle);
+}
+static tb_void_t gb_demo_bench_arc(gb_canvas_ref_t canvas)
+{
+    // stroke
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_draw_arc2i(canvas, 0, 0, 300, 150, -45, 180);
+    gb_canvas_draw_arc2i(canvas, 0, 0, 200, 100, 45, 200);
+    gb_canvas_draw_arc2i(canvas, 0, 0, 100, 50, 45, -22);
+    gb_canvas_draw_arc2i(canvas, 0, 0, 10, 10, 300, -181);
+    gb_canvas_draw_arc2i(canvas, 0, 0, 50, 20, -100, -222);
+    gb_canvas_draw_arc2i(canvas, -50, -50, 50, 50, 180, 90);
+    gb_canvas_draw_arc2i(canvas, 50, -50, 50, 50, 90, 90);
+}
+static tb_void_t gb_demo_bench_tiger(gb_canvas_ref_t canvas)
+{
+    // draw the tiger of the core demo
+    gb_demo_tiger_paths_draw(canvas);
+
+    // restore the stroke width
+    gb_canvas_stroke_width_set(canvas, GB_ONE);
+}
+static tb_bool_t gb_demo_bench_polygon_rects(gb_polygon_ref_t polygon)
+{
+    // make the points and counts of the thin rects side by side, the contours are closed
+    polygon->points = tb_nalloc_type(GB_DEMO_BENCH_TEETH * 5, gb_point_t);
+    polygon->counts = tb_nalloc_type(GB_DEMO_BENCH_TEETH + 1, tb_uint32_t);
+    polygon->convex = tb_false;
+    tb_assert_and_check_return_val(polygon->points && polygon->counts, tb_false);
+
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < GB_DEMO_BENCH_TEETH; i++)
+    {
+        // stagger the tops to avoid the same events
+        tb_long_t       x = i * 3;
+        tb_long_t       y = i % 7;
+        gb_point_ref_t  p = polygon->points + i * 5;
+        gb_point_imake(&p[0], x,        y);
+        gb_point_imake(&p[1], x + 2,    y);
+        gb_point_imake(&p[2], x + 2,    GB_DEMO_BENCH_TOOTH_HEIGHT);
+        gb_point_imake(&p[3], x,        GB_DEMO_BENCH_TOOTH_HEIGHT);
+        gb_point_imake(&p[4], x,        y);
+        polygon->counts[i] = 5;
+    }
+    polygon->counts[i] = 0;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_demo_bench_polygon_comb(gb_polygon_ref_t polygon)
+{
+    // make the points and counts of the comb with one closed contour
+    polygon->points = tb_nalloc_type((GB_DEMO_BENCH_TEETH << 2) + 3, gb_point_t);
+    polygon->counts = tb_nalloc_type(2, tb_uint32_t);
+    polygon->convex = tb_false;
+    tb_assert_and_check_return_val(polygon->points && polygon->counts, tb_false);
+
+    // the back of the comb
+    tb_size_t       n = 0;
+    gb_point_ref_t  points = polygon->points;
+    gb_point_imake(&points[n++], 0, 0);
+
+    // the teeth
+    tb_size_t i = 0;
+    for (i = 0; i < GB_DEMO_BENCH_TEETH; i++)
+    {
+        tb_long_t x = i * 3;
+        gb_point_imake(&points[n++], x + 1, 10);
+        gb_point_imake(&points[n++], x + 1, GB_DEMO_BENCH_TOOTH_HEIGHT);
+        gb_point_imake(&points[n++], x + 2, GB_DEMO_BENCH_TOOTH_HEIGHT);
+        gb_point_imake(&points[n++], x + 2, 10);
+    }
+    gb_point_imake(&points[n++], GB_DEMO_BENCH_TEETH * 3, 0);
+    gb_point_imake(&points[n++], 0, 0);
+    polygon->counts[0] = (tb_uint32_t)n;
+    polygon->counts[1] = 0;
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the scenes
+static gb_demo_bench_scene_t    g_scenes[] =
+{
+    { "rect",       gb_demo_bench_rect          }
+,   { "round_rect", gb_demo_bench_round_rect    }
+,   { "path",       gb_demo_bench_path          }
+,   { "lines",      gb_demo_bench_lines         }
+,   { "circle",     gb_demo_bench_circle        }
+,   { "arc",        gb_demo_bench_arc           }
+,   { "tiger",      gb_demo_bench_tiger         }
+};
+
+// the polygon scenes
+static gb_demo_bench_polygon_t  g_polygons[] =
+{
+    { "rects",      gb_demo_bench_polygon_rects }
+,   { "comb",       gb_demo_bench_polygon_comb  }
+};
+
+// the sizes
+static tb_size_t                g_sizes[][2] =
+{
+    { 320,  240     }
+,   { 800,  600     }
+,   { 1920, 1080    }
+};
+
+// the pixfmts
+static tb_size_t                g_pixfmts[] =
+{
+    GB_PIXFMT_RGB565
+,   GB_PIXFMT_XRGB8888
+,   GB_PIXFMT_ARGB8888
+};
+
+// the quality names
+static tb_char_t const*         g_qualities[] =
+{
+    "low"
+,   "normal"
+,   "top"
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_demo_bench_init()
+{
+    // make the star path
+    gb_path_ref_t path = gb_path_init();
+    tb_assert_and_check_return_val(path, tb_false);
+    gb_path_move2i_to(path, -100, -100);
+    gb_path_line2i_to(path, -50, -100);
+    gb_path_line2i_to(path, 0, -150);
+    gb_path_line2i_to(path, 50, -100);
+    gb_path_line2i_to(path, 100, -100);
+    gb_path_line2i_to(path, 100, -50);
+    gb_path_line2i_to(path, 20, 0);
+    gb_path_line2i_to(path, 100, 50);
+    gb_path_line2i_to(path, 100, 100);
+    gb_path_line2i_to(path, 50, 100);
+    gb_path_line2i_to(path, 0, 150);
+    gb_path_line2i_to(path, -50, 100);
+    gb_path_line2i_to(path, -100, 100);
+    gb_path_line2i_to(path, -100, 50);
+    gb_path_line2i_to(path, -200, 0);
+    gb_path_line2i_to(path, -100, -50);
+    gb_path_clos(path);
+    g_paths[0] = path;
+
+    // make the nested rects path
+    path = gb_path_init();
+    tb_assert_and_check_return_val(path, tb_false);
+    gb_path_add_rect2i(path, -200, -200, 400, 400, GB_ROTATE_DIRECTION_CW);
+    gb_path_add_rect2i(path, -100, -100, 200, 200, GB_ROTATE_DIRECTION_CW);
+    gb_path_add_rect2i(path, -50, -50, 100, 100, GB_ROTATE_DIRECTION_CW);
+    g_paths[1] = path;
+
+    // make the quad path
+    path = gb_path_init();
+    tb_assert_and_check_return_val(path, tb_false);
+    gb_path_move2i_to(path, -100, -100);
+    gb_path_quad2i_to(path, -50, -100, 0, -150);
+    gb_path_quad2i_to(path, 50, -100, 100, -100);
+    gb_path_quad2i_to(path, 100, -50, 20, 0);
+    gb_path_quad2i_to(path, 100, 50, 100, 100);
+    gb_path_quad2i_to(path, 50, 100, 0, 150);
+    gb_path_quad2i_to(path, -50, 100, -100, 100);
+    gb_path_quad2i_to(path, -100, 50, -200, 0);
+    gb_path_quad2i_to(path, -100, -50, -100, -100);
+    gb_path_clos(path);
+    g_paths[2] = path;
+
+    // make the tiger paths centered at the origin
+    return gb_demo_tiger_paths_init(tb_null);
+}
+static tb_void_t gb_demo_bench_exit()
+{
+    // exit paths
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(g_paths); i++)
+    {
+        if (g_paths[i]) gb_path_exit(g_paths[i]);
+        g_paths[i] = tb_null;
+    }
+
+    // exit tiger
+    gb_demo_tiger_paths_exit();
+}
+static tb_void_t gb_demo_bench_sort(tb_hong_t* times, tb_size_t count)
+{
+    // insertion sort, the frames are not too many
+    tb_size_t i = 1;
+    for (i = 1; i < count; i++)
+    {
+        tb_hong_t   time = times[i];
+        tb_size_t   j = i;
+        for (; j && times[j - 1] > time; j--) times[j] = times[j - 1];
+        times[j] = time;
+    }
+}
+static tb_void_t gb_demo_bench_done(gb_demo_bench_scene_t const* scene, tb_size_t width, tb_size_t height, tb_size_t pixfmt, tb_size_t quality, tb_size_t warmup, tb_size_t frames, tb_hong_t* times)
+{
+    // check
+    tb_assert_and_check_return(scene && width && height && frames && times);
+
+    // init bitmap
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, pixfmt, width, height, 0, tb_false);
+    tb_assert_and_check_return(bitmap);
+
+    // init canvas
+    gb_canvas_ref_t canvas = gb_canvas_init_from_bitmap(bitmap);
+    if (canvas)
+    {
+        // init quality
+        gb_quality_set(quality);
+
+        // the matrix: center the scene and scale it to the bitmap
+        gb_matrix_t matrix;
+        gb_float_t  scale = gb_idiv(gb_long_to_float(tb_min(width, height)), GB_DEMO_BENCH_UNITS);
+        gb_matrix_init_translate(&matrix, gb_long_to_float(width >> 1), gb_long_to_float(height >> 1));
+        gb_matrix_scale(&matrix, scale, scale);
+
+        // done
+        tb_size_t i = 0;
+        tb_hong_t total = 0;
+        for (i = 0; i < warmup + frames; i++)
+        {
+            // draw it
+            tb_hong_t time = tb_uclock();
+            gb_canvas_draw_clear(canvas, GB_COLOR_DEFAULT);
+            gb_matrix_copy(gb_canvas_save_matrix(canvas), &matrix);
+            scene->draw(canvas);
+            gb_canvas_load_matrix(canvas);
+            gb_canvas_flush(canvas);
+            time = tb_uclock() - time;
+
+            // save the time of this frame
+            if (i >= warmup)
+            {
+                times[i - warmup] = time;
+                total += time;
+            }
+        }
+
+        // the percentiles
+        gb_demo_bench_sort(times, frames);
+        tb_hong_t p50 = times[(frames * 50) / 100];
+        tb_hong_t p99 = times[tb_min((frames * 99) / 100, frames - 1)];
+
+        // the pixels/s
+        tb_hong_t pixels = total? ((tb_hong_t)width * height * frames * 1000000) / total : 0;
+
+        // trace: scene,width,height,pixfmt,quality,frames,us_per_frame,p50_us,p99_us,pixels_per_s
+        tb_printf("%s,%lu,%lu,%s,%s,%lu,%lld,%lld,%lld,%lld\n", scene->name, width, height, gb_pixmap(pixfmt, 0xff)->name, g_qualities[quality], frames, total / frames, p50, p99, pixels);
+
+        // exit canvas
+        gb_canvas_exit(canvas);
+    }
+
+    // exit bitmap
+    gb_bitmap_exit(bitmap);
+}
+static tb_void_t gb_demo_bench_polygon_func(gb_point_ref_t points, tb_size_t count, tb_cpointer_t priv)
+{
+    // count the output points
+    *((tb_size_t*)priv) += count;
+}
+static tb_void_t gb_demo_bench_polygon_done(gb_demo_bench_polygon_t const* scene, tb_size_t warmup, tb_size_t frames, tb_hong_t* times)
+{
+    // check
+    tb_assert_and_check_return(scene && scene->make && frames && times);
+
+    // make polygon
+    gb_polygon_t polygon = {tb_null, tb_null, tb_false};
+    if (scene->make(&polygon))
+    {
+        // the edges of the closed contours
+        tb_size_t       edges = 0;
+        tb_uint32_t*    counts = polygon.counts;
+        while (*counts) edges += *counts++ - 1;
+
+        // the bounds of all scenes
+        gb_rect_t bounds;
+        gb_rect_imake(&bounds, 0, 0, GB_DEMO_BENCH_TEETH * 3, GB_DEMO_BENCH_TOOTH_HEIGHT);
+
+        // init tessellator
+        gb_tessellator_ref_t tessellator = gb_tessellator_init();
+        if (tessellator)
+        {
+            // init mode and rule like the gl device
+            tb_size_t output = 0;
+            gb_tessellator_mode_set(tessellator, GB_TESSELLATOR_MODE_CONVEX);
+            gb_tessellator_rule_set(tessellator, GB_TESSELLATOR_RULE_NONZERO);
+            gb_tessellator_func_set(tessellator, gb_demo_bench_polygon_func, &output);
+
+            // done
+            tb_size_t i = 0;
+            tb_hong_t total = 0;
+            for (i = 0; i < warmup + frames; i++)
+            {
+                // tessellate it
+                output = 0;
+                tb_hong_t time = tb_uclock();
+                gb_tessellator_done(tessellator, &polygon, &bounds);
+                time = tb_uclock() - time;
+
+                // save the time of this frame
+                if (i >= warmup)
+                {
+                    times[i - warmup] = time;
+                    total += time;
+                }
+            }
+
+            // the percentiles
+            gb_demo_bench_sort(times, frames);
+            tb_hong_t p50 = times[(frames * 50) / 100];
+            tb_hong_t p99 = times[tb_min((frames * 99) / 100, frames - 1)];
+
+            // trace: scene,edges,frames,us_per_frame,p50_us,p99_us,points
+            tb_printf("%s,%lu,%lu,%lld,%lld,%lld,%lu\n", scene->name, edges, frames, total / frames, p50, p99, output);
+
+            // exit tessellator
+            gb_tessellator_exit(tessellator);
+        }
+    }
+
+    // exit polygon
+    if (polygon.points) tb_free(polygon.points);
+    if (polygon.counts) tb_free(polygon.counts);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_other_bench_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the frames, the scene name and the warm frames
+    tb_size_t           frames  = (argc > 1)? tb_atoi(argv[1]) : GB_DEMO_BENCH_FRAMES;
+    tb_char_t const*    name    = (argc > 2 && tb_stricmp(argv[2], "all"))? argv[2] : tb_null;
+    tb_size_t           warmup  = (argc > 3)? tb_atoi(argv[3]) : tb_max(frames / 10, 3);
+    tb_assert_and_check_return_val(frames, -1);
+
+    // init the frame times
+    tb_hong_t* times = tb_nalloc_type(frames, tb_hong_t);
+    tb_assert_and_check_return_val(times, -1);
+
+    // done
+    tb_size_t s = 0;
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+    // init scenes
+    tb_size_t quality = gb_quality();
+    if (gb_demo_bench_init())
+    {
+        // the header
+        tb_printf("scene,width,height,pixfmt,quality,frames,us_per_frame,p50_us,p99_us,pixels_per_s\n");
+
+        // done
+        tb_size_t z, f, q;
+        for (s = 0; s < tb_arrayn(g_scenes); s++)
+        {
+            // filter the scene
+            if (name && tb_stricmp(name, g_scenes[s].name)) continue;
+
+            // done all cases
+            for (z = 0; z < tb_arrayn(g_sizes); z++)
+                for (f = 0; f < tb_arrayn(g_pixfmts); f++)
+                    for (q = 0; q < tb_arrayn(g_qualities); q++)
+                        gb_demo_bench_done(&g_scenes[s], g_sizes[z][0], g_sizes[z][1], g_pixfmts[f], q, warmup, frames, times);
+        }
+    }
+
+    // exit scenes
+    gb_demo_bench_exit();
+    gb_quality_set(quality);
+#else
+    // trace
+    tb_trace_e("no bitmap device!");
+#endif
+
+    // the header of the tessellator scenes, they need not any device
+    tb_printf("scene,edges,frames,us_per_frame,p50_us,p99_us,points\n");
+
+    // done the tessellator scenes
+    for (s = 0; s < tb_arrayn(g_polygons); s++)
+    {
+        // filter the scene
+        if (name && tb_stricmp(name, g_polygons[s].name)) continue;
+
+        // done it
+        gb_demo_bench_polygon_done(&g_polygons[s], warmup, frames, times);
+    }
+
+    // exit the frame times
+    tb_free(times);
+    return 0;
+}
@@ -27,3 +27,6 @@ target("console")
     -- add the source files
     add_files("**.c") 
 
+    -- add the tiger scene of the core demo for the bench
+    add_files("../core/tiger.c") 
+
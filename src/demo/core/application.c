@@ -23,6 +23,12 @@ tb_bool_t gb_application_init(gb_application_ref_t application, gb_window_info_r
     info->resize        = gb_demo_resize;
     info->event         = gb_demo_event;
 
+    // time the fill modes without any input? e.g. demo bench [frames]
+    tb_size_t   argc = gb_application_argc(application);
+    tb_char_t** argv = gb_application_argv(application);
+    if (argc > 1 && argv[1] && !tb_strcmp(argv[1], "bench"))
+        gb_demo_bench((argc > 2 && argv[2])? tb_atoi(argv[2]) : 120);
+
     // ok
     return tb_true;
 }
@@ -22,6 +22,7 @@
 #include "ellipse.h"
 #include "triangle.h"
 #include "round_rect.h"
+#include <stdlib.h>
  
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -91,6 +92,32 @@ static tb_byte_t        g_alpha = 255;
 // transform it?
 static tb_bool_t        g_transform = tb_false;
 
+// the gl fill mode
+static tb_size_t        g_fill_mode = GB_DEVICE_GL_FILL_MODE_TESSELLATE;
+
+// the cpu time of the drawn frames, in us
+static tb_hong_t        g_draw_time = 0;
+
+// the drawn frames
+static tb_size_t        g_draw_count = 0;
+
+// the bench frames for each fill mode, the bench is disabled if zero
+static tb_size_t        g_bench_maxn = 0;
+
+// the bench frame of the current fill mode
+static tb_size_t        g_bench_frame = 0;
+
+// the cpu time of the current entry for each fill mode, in us
+static tb_hong_t        g_bench_time[2];
+
+// the cpu time of all entries for each fill mode, in us
+static tb_hong_t        g_bench_total[2];
+
+#ifdef GB_CONFIG_PACKAGE_HAVE_OPENGL
+// the gl statistics of the current entry for each fill mode
+static gb_device_gl_stats_t g_bench_stats[2];
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -103,13 +130,76 @@ static tb_void_t gb_demo_info(tb_bool_t killed, tb_cpointer_t priv)
     // the framerate 
     gb_float_t framerate = gb_window_framerate(window);
 
+    // the cpu time per frame
+    tb_hong_t time = g_draw_count? (g_draw_time / g_draw_count) : 0;
+    g_draw_time = 0;
+    g_draw_count = 0;
+
     // trace
-    tb_trace_i("framerate: %{float}", &framerate);
+    tb_trace_i("framerate: %{float}, draw: %lld us/frame", &framerate, time);
+}
+
+static tb_void_t gb_demo_bench_done(gb_canvas_ref_t canvas, tb_hong_t time)
+{
+    // save the cpu time of this frame
+    g_bench_time[g_fill_mode] += time;
+    g_bench_total[g_fill_mode] += time;
+
+#ifdef GB_CONFIG_PACKAGE_HAVE_OPENGL
+    // save the statistics of the last frame with the same fill mode
+    gb_device_ref_t device = gb_canvas_device(canvas);
+    if (g_bench_frame && device && gb_device_type(device) == GB_DEVICE_TYPE_GL) 
+        gb_device_gl_stats(device, &g_bench_stats[g_fill_mode]);
+#endif
+
+    // the next frame
+    if (++g_bench_frame < g_bench_maxn) return ;
+    g_bench_frame = 0;
+
+    // time the stencil mode next
+    if (g_fill_mode == GB_DEVICE_GL_FILL_MODE_TESSELLATE)
+    {
+        g_fill_mode = GB_DEVICE_GL_FILL_MODE_STENCIL;
+        return ;
+    }
+
+    // trace
+    tb_trace_i("entry[%lu]: tessellate: %lld us/frame, stencil: %lld us/frame", g_index, g_bench_time[GB_DEVICE_GL_FILL_MODE_TESSELLATE] / g_bench_maxn, g_bench_time[GB_DEVICE_GL_FILL_MODE_STENCIL] / g_bench_maxn);
+#ifdef GB_CONFIG_PACKAGE_HAVE_OPENGL
+    tb_trace_i("entry[%lu]: tessellate: %lu draws %lu vertices, stencil: %lu draws %lu vertices", g_index
+        , g_bench_stats[GB_DEVICE_GL_FILL_MODE_TESSELLATE].draws, g_bench_stats[GB_DEVICE_GL_FILL_MODE_TESSELLATE].vertices
+        , g_bench_stats[GB_DEVICE_GL_FILL_MODE_STENCIL].draws, g_bench_stats[GB_DEVICE_GL_FILL_MODE_STENCIL].vertices);
+#endif
+
+    // the next entry
+    g_fill_mode = GB_DEVICE_GL_FILL_MODE_TESSELLATE;
+    g_bench_time[GB_DEVICE_GL_FILL_MODE_TESSELLATE] = 0;
+    g_bench_time[GB_DEVICE_GL_FILL_MODE_STENCIL] = 0;
+    if (++g_index < tb_arrayn(g_entries)) return ;
+
+    // trace
+    tb_size_t frames = g_bench_maxn * tb_arrayn(g_entries);
+    tb_trace_i("total: tessellate: %lld us/frame, stencil: %lld us/frame", g_bench_total[GB_DEVICE_GL_FILL_MODE_TESSELLATE] / frames, g_bench_total[GB_DEVICE_GL_FILL_MODE_STENCIL] / frames);
+
+    // finished, the window loop cannot be stopped from the demo
+    gb_canvas_flush(canvas);
+    exit(0);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+tb_void_t gb_demo_bench(tb_size_t frames)
+{
+    // check
+    tb_assert_and_check_return(frames);
+
+    // start from the first entry with the tessellate mode
+    g_bench_maxn    = frames;
+    g_bench_frame   = 0;
+    g_index         = 0;
+    g_fill_mode     = GB_DEVICE_GL_FILL_MODE_TESSELLATE;
+}
 tb_bool_t gb_demo_init(gb_window_ref_t window, gb_canvas_ref_t canvas, tb_cpointer_t priv)
 {
     // check
@@ -163,6 +253,12 @@ tb_void_t gb_demo_draw(gb_window_ref_t window, gb_canvas_ref_t canvas, tb_cpoint
     tb_assert(window && canvas);
     tb_assert(g_index < tb_arrayn(g_entries));
 
+#ifdef GB_CONFIG_PACKAGE_HAVE_OPENGL
+    // apply the gl fill mode
+    gb_device_ref_t device = gb_canvas_device(canvas);
+    if (device && gb_device_type(device) == GB_DEVICE_TYPE_GL) gb_device_gl_fill_mode_set(device, g_fill_mode);
+#endif
+
     // clear it
     gb_canvas_draw_clear(canvas, GB_COLOR_DEFAULT);
 
@@ -186,10 +282,17 @@ tb_void_t gb_demo_draw(gb_window_ref_t window, gb_canvas_ref_t canvas, tb_cpoint
     gb_canvas_alpha_set(canvas, g_alpha);
 
     // done draw
+    tb_hong_t time = tb_uclock();
     entry->draw(window, canvas);
+    time = tb_uclock() - time;
+    g_draw_time += time;
+    g_draw_count++;
 
     // leave matrix
     gb_canvas_load_matrix(canvas);
+
+    // done bench
+    if (g_bench_maxn) gb_demo_bench_done(canvas, time);
 }
 tb_void_t gb_demo_resize(gb_window_ref_t window, gb_canvas_ref_t canvas, tb_cpointer_t priv)
 {
@@ -251,6 +354,10 @@ tb_void_t gb_demo_event(gb_window_ref_t window, gb_event_ref_t event, tb_cpointe
         case 't':
             g_transform = !g_transform;
             break;
+        case 's':
+            g_fill_mode = (g_fill_mode == GB_DEVICE_GL_FILL_MODE_TESSELLATE)? GB_DEVICE_GL_FILL_MODE_STENCIL : GB_DEVICE_GL_FILL_MODE_TESSELLATE;
+            tb_trace_i("fill mode: %s", g_fill_mode == GB_DEVICE_GL_FILL_MODE_STENCIL? "stencil" : "tessellate");
+            break;
         case 'i':
             tb_timer_task_post(gb_window_timer(window), 1000, tb_true, gb_demo_info, (tb_cpointer_t)window);
             break;
@@ -15,6 +15,12 @@ __tb_extern_c_enter__
  * interface
  */
 
+/* time the tessellate and stencil fill modes of all entries and exit
+ *
+ * @param frames    the frames of each entry for each fill mode
+ */
+tb_void_t           gb_demo_bench(tb_size_t frames);
+
 /* init window
  *
  * @param window    the window
@@ -547,23 +547,24 @@ static tb_void_t gb_demo_tiger_entry_init(gb_demo_tiger_entry_ref_t entry, tb_ch
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_void_t gb_demo_tiger_init(gb_window_ref_t window)
+tb_bool_t gb_demo_tiger_paths_init(gb_matrix_ref_t matrix)
 {
     // check
     tb_assert_static(!(tb_arrayn(g_demo_tiger) & 0x1));
 
-    // the width and height
-    gb_float_t w = gb_long_to_float(gb_window_width(window));
-    gb_float_t h = gb_long_to_float(gb_window_height(window));
-
     // init entries
-    g_tiger_entries = tb_nalloc0_type(tb_arrayn(g_demo_tiger) >> 1, gb_demo_tiger_entry_t);
-    tb_assert(g_tiger_entries);
+    if (!g_tiger_entries) g_tiger_entries = tb_nalloc0_type(tb_arrayn(g_demo_tiger) >> 1, gb_demo_tiger_entry_t);
+    tb_assert_and_check_return_val(g_tiger_entries, tb_false);
+
+    // the matrix: center the tiger at the origin and apply the given matrix
+    gb_matrix_t applied;
+    gb_matrix_init_translate(&applied, -gb_long_to_float(320), -gb_long_to_float(320));
+    if (matrix) gb_matrix_multiply_lhs(&applied, matrix);
 
     // done
     tb_size_t index = 0;
     tb_size_t count = tb_arrayn(g_demo_tiger);
-    for (index = 0; index < count; index += 2)
+    for (index = 0; index < count && g_tiger_entries_count < (count >> 1); index += 2)
     {
         // the style and path
         tb_char_t const* style  = g_demo_tiger[index];
@@ -576,16 +577,13 @@ tb_void_t gb_demo_tiger_init(gb_window_ref_t window)
         gb_demo_tiger_entry_init(entry, style, path);
 
         // apply matrix to the path
-        if (entry->path) 
-        {
-            gb_matrix_t matrix;
-            gb_matrix_init_translate(&matrix, -gb_long_to_float(320), -gb_long_to_float(320));
-            gb_matrix_scale_lhs(&matrix, gb_idiv(w, 640), gb_idiv(h, 640));
-            gb_path_apply(entry->path, &matrix);
-        }
+        if (entry->path) gb_path_apply(entry->path, &applied);
     }
+
+    // ok
+    return tb_true;
 }
-tb_void_t gb_demo_tiger_exit(gb_window_ref_t window)
+tb_void_t gb_demo_tiger_paths_exit()
 {
     // exit entries
     if (g_tiger_entries)
@@ -602,8 +600,10 @@ tb_void_t gb_demo_tiger_exit(gb_window_ref_t window)
         // exit it
         tb_free(g_tiger_entries);
     }
+    g_tiger_entries         = tb_null;
+    g_tiger_entries_count   = 0;
 }
-tb_void_t gb_demo_tiger_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
+tb_void_t gb_demo_tiger_paths_draw(gb_canvas_ref_t canvas)
 {
     // done
     tb_size_t i = 0;
@@ -634,7 +634,27 @@ tb_void_t gb_demo_tiger_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
         }
     }
 }
+tb_void_t gb_demo_tiger_init(gb_window_ref_t window)
+{
+    // the width and height
+    gb_float_t w = gb_long_to_float(gb_window_width(window));
+    gb_float_t h = gb_long_to_float(gb_window_height(window));
+
+    // init paths and scale them to the window
+    gb_matrix_t matrix;
+    gb_matrix_init_scale(&matrix, gb_idiv(w, 640), gb_idiv(h, 640));
+    gb_demo_tiger_paths_init(&matrix);
+}
+tb_void_t gb_demo_tiger_exit(gb_window_ref_t window)
+{
+    // exit paths
+    gb_demo_tiger_paths_exit();
+}
+tb_void_t gb_demo_tiger_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
+{
+    // draw paths
+    gb_demo_tiger_paths_draw(canvas);
+}
 tb_void_t gb_demo_tiger_event(gb_window_ref_t window, gb_event_ref_t event)
 {
 }
-
@@ -15,6 +15,26 @@ __tb_extern_c_enter__
  * interface
  */
 
+/* init the tiger paths
+ *
+ * the paths are centered at the origin and the matrix is applied to them
+ *
+ * @param matrix    the matrix, not applied if be null
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_demo_tiger_paths_init(gb_matrix_ref_t matrix);
+
+/* exit the tiger paths
+ */
+tb_void_t           gb_demo_tiger_paths_exit(tb_noarg_t);
+
+/* draw the tiger paths
+ *
+ * @param canvas    the canvas
+ */
+tb_void_t           gb_demo_tiger_paths_draw(gb_canvas_ref_t canvas);
+
 /* init window
  *
  * @param window    the window
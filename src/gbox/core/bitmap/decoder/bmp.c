@@ -428,8 +428,8 @@ gb_bitmap_decoder_ref_t gb_bitmap_decoder_bmp_init(tb_size_t pixfmt, tb_stream_r
         impl->type          = GB_BITMAP_TYPE_BMP;
         impl->stream        = stream;
         impl->pixfmt        = (tb_uint16_t)pixfmt;
-        impl->width         = (tb_uint16_t)width;
-        impl->height        = (tb_uint16_t)height;
+        impl->width         = (tb_uint32_t)width;
+        impl->height        = (tb_uint32_t)height;
         impl->done          = gb_bitmap_decoder_bmp_done;
 
         // ok
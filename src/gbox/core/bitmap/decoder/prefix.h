@@ -51,10 +51,10 @@ typedef struct __gb_bitmap_decoder_impl_t
     tb_uint16_t     pixfmt;
 
     // the width
-    tb_uint16_t     width;
+    tb_uint32_t     width;
 
     // the height
-    tb_uint16_t     height;
+    tb_uint32_t     height;
 
     // the stream
     tb_stream_ref_t stream;
@@ -38,7 +38,10 @@
 #include "path.h"
 #include "paint.h"
 #include "clipper.h"
+#include "picture.h"
 #include "impl/bounds.h"
+#include "impl/picture.h"
+#include "impl/path_cache.h"
 #include "impl/cache_stack.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -66,8 +69,43 @@ typedef struct __gb_canvas_impl_t
     // the clipper stack
     gb_cache_stack_ref_t    clipper_stack;
 
+    // the path cache for the shapes
+    gb_path_cache_ref_t     path_cache;
+
 }gb_canvas_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_canvas_draw_shape(gb_canvas_impl_t* impl, gb_shape_ref_t shape)
+{
+    // check
+    tb_assert(impl && impl->device && impl->path_cache && shape);
+
+    // get the cached path or make it
+    gb_path_ref_t path = gb_path_cache_get(impl->path_cache, shape);
+    if (!path) path = gb_path_cache_add(impl->path_cache, shape);
+    tb_check_return_val(path, tb_false);
+
+    // draw path
+    gb_device_draw_path(impl->device, path);
+
+    // ok
+    return tb_true;
+}
+static gb_clipper_ref_t gb_canvas_clipper_bind_matrix(gb_canvas_ref_t canvas)
+{
+    // the clipper
+    gb_clipper_ref_t clipper = gb_canvas_clipper(canvas);
+    tb_check_return_val(clipper, tb_null);
+
+    // the clipped shapes will be transformed by the current matrix
+    gb_clipper_matrix_set(clipper, gb_canvas_matrix(canvas));
+
+    // ok
+    return clipper;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -104,6 +142,10 @@ gb_canvas_ref_t gb_canvas_init(gb_device_ref_t device)
         impl->clipper_stack = gb_cache_stack_init(8, GB_CACHE_STACK_TYPE_CLIPPER);
         tb_assert_and_check_break(impl->clipper_stack);
 
+        // init path cache
+        impl->path_cache = gb_path_cache_init(0, 0);
+        tb_assert_and_check_break(impl->path_cache);
+
         // bind matrix
         gb_device_bind_matrix(impl->device, &impl->matrix);
 
@@ -223,6 +265,10 @@ tb_void_t gb_canvas_exit(gb_canvas_ref_t canvas)
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl);
 
+    // exit path cache
+    if (impl->path_cache) gb_path_cache_exit(impl->path_cache);
+    impl->path_cache = tb_null;
+
     // exit clipper stack
     if (impl->clipper_stack) gb_cache_stack_exit(impl->clipper_stack);
     impl->clipper_stack = tb_null;
@@ -705,12 +751,12 @@ tb_void_t gb_canvas_arc2i_to(gb_canvas_ref_t canvas, tb_long_t x0, tb_long_t y0,
 tb_void_t gb_canvas_clip_path(gb_canvas_ref_t canvas, tb_size_t mode, gb_path_ref_t path)
 {
     // clip path
-    gb_clipper_add_path(gb_canvas_clipper(canvas), mode, path);
+    gb_clipper_add_path(gb_canvas_clipper_bind_matrix(canvas), mode, path);
 }
 tb_void_t gb_canvas_clip_triangle(gb_canvas_ref_t canvas, tb_size_t mode, gb_triangle_ref_t triangle)
 {
     // clip triangle
-    gb_clipper_add_triangle(gb_canvas_clipper(canvas), mode, triangle);
+    gb_clipper_add_triangle(gb_canvas_clipper_bind_matrix(canvas), mode, triangle);
 }
 tb_void_t gb_canvas_clip_triangle2(gb_canvas_ref_t canvas, tb_size_t mode, gb_float_t x0, gb_float_t y0, gb_float_t x1, gb_float_t y1, gb_float_t x2, gb_float_t y2)
 {
@@ -733,7 +779,7 @@ tb_void_t gb_canvas_clip_triangle2i(gb_canvas_ref_t canvas, tb_size_t mode, tb_l
 tb_void_t gb_canvas_clip_rect(gb_canvas_ref_t canvas, tb_size_t mode, gb_rect_ref_t rect)
 {
     // clip rect
-    gb_clipper_add_rect(gb_canvas_clipper(canvas), mode, rect);
+    gb_clipper_add_rect(gb_canvas_clipper_bind_matrix(canvas), mode, rect);
 }
 tb_void_t gb_canvas_clip_rect2(gb_canvas_ref_t canvas, tb_size_t mode, gb_float_t x, gb_float_t y, gb_float_t w, gb_float_t h)
 {
@@ -756,7 +802,7 @@ tb_void_t gb_canvas_clip_rect2i(gb_canvas_ref_t canvas, tb_size_t mode, tb_long_
 tb_void_t gb_canvas_clip_round_rect(gb_canvas_ref_t canvas, tb_size_t mode, gb_round_rect_ref_t rect)
 {
     // clip round rect
-    gb_clipper_add_round_rect(gb_canvas_clipper(canvas), mode, rect);
+    gb_clipper_add_round_rect(gb_canvas_clipper_bind_matrix(canvas), mode, rect);
 }
 tb_void_t gb_canvas_clip_round_rect2(gb_canvas_ref_t canvas, tb_size_t mode, gb_rect_ref_t bounds, gb_float_t rx, gb_float_t ry)
 {
@@ -779,7 +825,7 @@ tb_void_t gb_canvas_clip_round_rect2i(gb_canvas_ref_t canvas, tb_size_t mode, gb
 tb_void_t gb_canvas_clip_circle(gb_canvas_ref_t canvas, tb_size_t mode, gb_circle_ref_t circle)
 {
     // clip circle
-    gb_clipper_add_circle(gb_canvas_clipper(canvas), mode, circle);
+    gb_clipper_add_circle(gb_canvas_clipper_bind_matrix(canvas), mode, circle);
 }
 tb_void_t gb_canvas_clip_circle2(gb_canvas_ref_t canvas, tb_size_t mode, gb_float_t x0, gb_float_t y0, gb_float_t r)
 {
@@ -802,7 +848,7 @@ tb_void_t gb_canvas_clip_circle2i(gb_canvas_ref_t canvas, tb_size_t mode, tb_lon
 tb_void_t gb_canvas_clip_ellipse(gb_canvas_ref_t canvas, tb_size_t mode, gb_ellipse_ref_t ellipse)
 {
     // clip ellipse
-    gb_clipper_add_ellipse(gb_canvas_clipper(canvas), mode, ellipse);
+    gb_clipper_add_ellipse(gb_canvas_clipper_bind_matrix(canvas), mode, ellipse);
 }
 tb_void_t gb_canvas_clip_ellipse2(gb_canvas_ref_t canvas, tb_size_t mode, gb_float_t x0, gb_float_t y0, gb_float_t rx, gb_float_t ry)
 {
@@ -822,6 +868,15 @@ tb_void_t gb_canvas_clip_ellipse2i(gb_canvas_ref_t canvas, tb_size_t mode, tb_lo
     // clip ellipse
     gb_canvas_clip_ellipse(canvas, mode, &ellipse);
 }
+tb_void_t gb_canvas_flush(gb_canvas_ref_t canvas)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device);
+
+    // flush it
+    gb_device_flush(impl->device);
+}
 tb_void_t gb_canvas_draw_clear(gb_canvas_ref_t canvas, gb_color_t color)
 {
     // check
@@ -912,6 +967,12 @@ tb_void_t gb_canvas_draw_arc(gb_canvas_ref_t canvas, gb_arc_ref_t arc)
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && arc);
 
+    // draw the cached path
+    gb_shape_t shape;
+    shape.type  = GB_SHAPE_TYPE_ARC;
+    shape.u.arc = *arc;
+    if (gb_canvas_draw_shape(impl, &shape)) return ;
+
     // save path
     gb_path_ref_t path = gb_canvas_save_path(canvas);
     tb_assert_and_check_return(path);
@@ -952,7 +1013,7 @@ tb_void_t gb_canvas_draw_triangle(gb_canvas_ref_t canvas, gb_triangle_ref_t tria
 
     // init polygon
     gb_point_t      points[] = {triangle->p0, triangle->p1, triangle->p2, triangle->p0};
-    tb_uint16_t     counts[] = {4, 0};
+    tb_uint32_t     counts[] = {4, 0};
     gb_polygon_t    polygon = {points, counts, tb_true};
 
     // init hint
@@ -993,7 +1054,7 @@ tb_void_t gb_canvas_draw_rect(gb_canvas_ref_t canvas, gb_rect_ref_t rect)
 
     // init polygon
     gb_point_t      points[5];
-    tb_uint16_t     counts[] = {5, 0};
+    tb_uint32_t     counts[] = {5, 0};
     gb_polygon_t    polygon = {points, counts, tb_true};
 
     // init points
@@ -1058,6 +1119,12 @@ tb_void_t gb_canvas_draw_round_rect(gb_canvas_ref_t canvas, gb_round_rect_ref_t
         return ;
     }
 
+    // draw the cached path
+    gb_shape_t shape;
+    shape.type          = GB_SHAPE_TYPE_ROUND_RECT;
+    shape.u.round_rect  = *rect;
+    if (gb_canvas_draw_shape(impl, &shape)) return ;
+
     // save path
     gb_path_ref_t path = gb_canvas_save_path(canvas);
     tb_assert_and_check_return(path);
@@ -1096,6 +1163,12 @@ tb_void_t gb_canvas_draw_circle(gb_canvas_ref_t canvas, gb_circle_ref_t circle)
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && circle);
 
+    // draw the cached path
+    gb_shape_t shape;
+    shape.type      = GB_SHAPE_TYPE_CIRCLE;
+    shape.u.circle  = *circle;
+    if (gb_canvas_draw_shape(impl, &shape)) return ;
+
     // save path
     gb_path_ref_t path = gb_canvas_save_path(canvas);
     tb_assert_and_check_return(path);
@@ -1134,6 +1207,12 @@ tb_void_t gb_canvas_draw_ellipse(gb_canvas_ref_t canvas, gb_ellipse_ref_t ellips
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && ellipse);
 
+    // draw the cached path
+    gb_shape_t shape;
+    shape.type      = GB_SHAPE_TYPE_ELLIPSE;
+    shape.u.ellipse = *ellipse;
+    if (gb_canvas_draw_shape(impl, &shape)) return ;
+
     // save path
     gb_path_ref_t path = gb_canvas_save_path(canvas);
     tb_assert_and_check_return(path);
@@ -1193,3 +1272,40 @@ tb_void_t gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, t
     // draw points
     gb_device_draw_points(impl->device, points, count, tb_null);
 }
+tb_void_t gb_canvas_draw_picture(gb_canvas_ref_t canvas, gb_picture_ref_t picture)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && picture);
+
+    // nothing to draw?
+    gb_rect_ref_t bounds = gb_picture_bounds(picture);
+    tb_check_return(bounds);
+
+    // the device width and height
+    tb_size_t width     = gb_device_width(impl->device);
+    tb_size_t height    = gb_device_height(impl->device);
+    if (width && height)
+    {
+        // apply matrix to bounds
+        gb_rect_t  device_bounds;
+        gb_point_t pt[4];
+        gb_point_make(&pt[0], bounds->x, bounds->y);
+        gb_point_make(&pt[1], bounds->x, bounds->y + bounds->h);
+        gb_point_make(&pt[2], bounds->x + bounds->w, bounds->y + bounds->h);
+        gb_point_make(&pt[3], bounds->x + bounds->w, bounds->y);
+        gb_matrix_apply_points(&impl->matrix, pt, tb_arrayn(pt));
+        gb_bounds_make(&device_bounds, pt, tb_arrayn(pt));
+
+        // outside the device? cull it
+        tb_check_return(    device_bounds.x + device_bounds.w >= 0 && device_bounds.x < gb_long_to_float(width)
+                        &&  device_bounds.y + device_bounds.h >= 0 && device_bounds.y < gb_long_to_float(height));
+    }
+
+    // replay it with the clipper of the canvas
+    gb_picture_replay(picture, impl->device, &impl->matrix, gb_canvas_clipper(canvas));
+
+    // restore the matrix and paint of the canvas
+    gb_device_bind_matrix(impl->device, &impl->matrix);
+    gb_device_bind_paint(impl->device, gb_canvas_paint(canvas));
+}
@@ -855,6 +855,12 @@ tb_void_t           gb_canvas_clip_ellipse2(gb_canvas_ref_t canvas, tb_size_t mo
  */
 tb_void_t           gb_canvas_clip_ellipse2i(gb_canvas_ref_t canvas, tb_size_t mode, tb_long_t x0, tb_long_t y0, tb_size_t rx, tb_size_t ry);
 
+/*! flush the recorded draws of the deferred device
+ *
+ * @param canvas    the canvas
+ */
+tb_void_t           gb_canvas_flush(gb_canvas_ref_t canvas);
+
 /*! clear draw and fill the given color
  *
  * @param canvas    the canvas
@@ -1114,6 +1120,15 @@ tb_void_t           gb_canvas_draw_lines(gb_canvas_ref_t canvas, gb_point_ref_t
  */
 tb_void_t           gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_size_t count);
 
+/*! draw the recorded picture
+ *
+ * all recorded draws will be transformed by the current matrix of the canvas
+ *
+ * @param canvas    the canvas
+ * @param picture   the picture
+ */
+tb_void_t           gb_canvas_draw_picture(gb_canvas_ref_t canvas, gb_picture_ref_t picture);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -33,6 +33,16 @@
  * includes
  */
 #include "clipper.h"
+#include "path.h"
+#include "impl/clipper.h"
+#include "impl/polygon_raster.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bounds maxn of the infinite region before clipping
+#define GB_CLIPPER_BOUNDS_MAXN          (1 << 28)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -41,65 +51,689 @@
 // the clipper impl type
 typedef struct __gb_clipper_impl_t
 {
+    // the matrix
+    gb_matrix_t             matrix;
+
+    // the shapes count, nothing is clipped if be zero
+    tb_size_t               size;
+
+    // the clipped region of the device pixels
+    gb_region_t             region;
+
+    /* the coverage mask of the non-rect shapes, only the region is clipped if be null
+     *
+     * the clipped coverage is region * mask and the mask is shared with the copied clippers
+     */
+    gb_clip_mask_ref_t      mask;
+
+    // the path of the shape in the device pixels
+    gb_path_ref_t           path;
+
+    // the raster for making the coverage of the shape
+    gb_polygon_raster_ref_t raster;
 
+    // the generation of the clipped region and mask, zero if nothing is clipped
+    tb_size_t               generation;
 
 }gb_clipper_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * globals
+ */
+
+// the clipper generation
+static tb_atomic_t          g_generation = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
  */
+static tb_void_t gb_clipper_changed(gb_clipper_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // the generation is unique for all clippers
+    impl->generation = (tb_size_t)tb_atomic_fetch_and_inc(&g_generation) + 1;
+}
+static tb_void_t gb_clipper_raster(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(priv);
+
+    // append the full covered runs
+    for (; yb < ye; yb++) gb_clip_mask_append((gb_clip_mask_ref_t)priv, lx, rx, yb, 0xff);
+}
+static tb_void_t gb_clipper_raster_coverage(tb_long_t lx, tb_long_t rx, tb_long_t y, tb_byte_t alpha, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(priv);
+
+    // append the run
+    gb_clip_mask_append((gb_clip_mask_ref_t)priv, lx, rx, y, alpha);
+}
+static tb_bool_t gb_clipper_make_infinite(gb_clipper_impl_t* impl, tb_size_t mode)
+{
+    // check
+    tb_assert(impl);
+
+    // nothing is clipped now and it will be combined? make the infinite region
+    if (!impl->size && mode != GB_CLIPPER_MODE_REPLACE)
+        return gb_region_set_rect(&impl->region, -GB_CLIPPER_BOUNDS_MAXN, -GB_CLIPPER_BOUNDS_MAXN, GB_CLIPPER_BOUNDS_MAXN, GB_CLIPPER_BOUNDS_MAXN);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_clipper_add_region_mask(gb_clipper_impl_t* impl, tb_size_t mode, gb_clip_mask_ref_t shape)
+{
+    // check
+    tb_assert(impl && shape);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_clip_mask_ref_t  mask = tb_null;
+    do
+    {
+        // check mode
+        tb_assert_and_check_break(mode >= GB_CLIPPER_MODE_SUBTRACT && mode <= GB_CLIPPER_MODE_REPLACE);
+
+        // make the infinite region first
+        if (!gb_clipper_make_infinite(impl, mode)) break;
+
+        // the bounds of the shape and the mask
+        gb_region_ref_t region  = &impl->region;
+        tb_long_t       left    = shape->left;
+        tb_long_t       top     = shape->top;
+        tb_long_t       right   = shape->right;
+        tb_long_t       bottom  = shape->bottom;
+        if (impl->mask && mode != GB_CLIPPER_MODE_INTERSECT)
+        {
+            left    = tb_min(left, impl->mask->left);
+            top     = tb_min(top, impl->mask->top);
+            right   = tb_max(right, impl->mask->right);
+            bottom  = tb_max(bottom, impl->mask->bottom);
+        }
+
+        // done it
+        switch (mode)
+        {
+        case GB_CLIPPER_MODE_INTERSECT:
+            {
+                // only the intersected pixels need the mask
+                left    = tb_max(left, region->left);
+                top     = tb_max(top, region->top);
+                right   = tb_min(right, region->right);
+                bottom  = tb_min(bottom, region->bottom);
+
+                // the shape is the new mask if nothing is masked now
+                if (!impl->mask) mask = gb_clip_mask_retain(shape);
+                else if (left < right && top < bottom) mask = gb_clip_mask_init_op(impl->mask, tb_null, shape, mode, left, top, right, bottom);
+
+                // clip the region
+                if (!gb_region_op_rect(region, shape->left, shape->top, shape->right, shape->bottom, GB_REGION_OP_INTERSECT)) break;
+                ok = tb_true;
+            }
+            break;
+        case GB_CLIPPER_MODE_SUBTRACT:
+            {
+                // only mask it, the region is not changed
+                mask = gb_clip_mask_init_op(impl->mask, tb_null, shape, mode, left, top, right, bottom);
+                ok = mask? tb_true : tb_false;
+            }
+            break;
+        case GB_CLIPPER_MODE_UNION:
+            {
+                // the region of the original pixels will be multiplied to the mask
+                mask = gb_clip_mask_init_op(impl->mask, region, shape, mode, left, top, right, bottom);
+                tb_assert_and_check_break(mask);
 
+                // union the region
+                if (!gb_region_op_rect(region, shape->left, shape->top, shape->right, shape->bottom, GB_REGION_OP_UNION)) break;
+                ok = tb_true;
+            }
+            break;
+        case GB_CLIPPER_MODE_REPLACE:
+            {
+                // the shape is the new mask
+                mask = gb_clip_mask_retain(shape);
+
+                // replace the region
+                if (!gb_region_set_rect(region, shape->left, shape->top, shape->right, shape->bottom)) break;
+                ok = tb_true;
+            }
+            break;
+        default:
+            break;
+        }
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // trace
+        tb_trace_e("clip mask failed!");
+
+        // exit the new mask
+        if (mask) gb_clip_mask_exit(mask);
+        return ;
+    }
+
+    /* the outside of the shape is not masked now, it has been clipped by the region
+     *
+     * @note the shape has not been shared with the others, so it can be modified directly
+     */
+    shape->outside = 0xff;
+
+    // update the mask
+    if (impl->mask) gb_clip_mask_exit(impl->mask);
+    impl->mask = mask;
+
+    // update the shapes count
+    impl->size = mode == GB_CLIPPER_MODE_REPLACE? 1 : impl->size + 1;
+    gb_clipper_changed(impl);
+}
+static tb_void_t gb_clipper_add_region_rect(gb_clipper_impl_t* impl, tb_size_t mode, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom)
+{
+    // check
+    tb_assert(impl);
+
+    // check mode
+    tb_assert_static((tb_size_t)GB_REGION_OP_SUBTRACT == (tb_size_t)GB_CLIPPER_MODE_SUBTRACT);
+    tb_assert_static((tb_size_t)GB_REGION_OP_INTERSECT == (tb_size_t)GB_CLIPPER_MODE_INTERSECT);
+    tb_assert_static((tb_size_t)GB_REGION_OP_UNION == (tb_size_t)GB_CLIPPER_MODE_UNION);
+    tb_assert_static((tb_size_t)GB_REGION_OP_REPLACE == (tb_size_t)GB_CLIPPER_MODE_REPLACE);
+    tb_assert_and_check_return(mode >= GB_CLIPPER_MODE_SUBTRACT && mode <= GB_CLIPPER_MODE_REPLACE);
+
+    // union the masked pixels? the pixels inside the rect need be full covered
+    if (impl->mask && mode == GB_CLIPPER_MODE_UNION)
+    {
+        // make the full covered shape of the rect
+        gb_clip_mask_ref_t shape = gb_clip_mask_init(left, top, right, bottom, 0);
+        tb_assert_and_check_return(shape);
+
+        // make rows
+        tb_long_t y = top;
+        for (; y < bottom; y++) gb_clip_mask_append(shape, left, right, y, 0xff);
+        gb_clip_mask_done(shape);
+
+        // add it
+        gb_clipper_add_region_mask(impl, mode, shape);
+        gb_clip_mask_exit(shape);
+        return ;
+    }
+
+    // make the infinite region first
+    if (!gb_clipper_make_infinite(impl, mode)) return ;
+
+    // clip it
+    if (!gb_region_op_rect(&impl->region, left, top, right, bottom, mode))
+    {
+        // trace
+        tb_trace_e("clip rect failed!");
+        return ;
+    }
+
+    // replace it? the mask is discarded
+    if (mode == GB_CLIPPER_MODE_REPLACE && impl->mask)
+    {
+        gb_clip_mask_exit(impl->mask);
+        impl->mask = tb_null;
+    }
+
+    // update the shapes count
+    impl->size = mode == GB_CLIPPER_MODE_REPLACE? 1 : impl->size + 1;
+    gb_clipper_changed(impl);
+}
+static gb_path_ref_t gb_clipper_path(gb_clipper_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // init path
+    if (!impl->path) impl->path = gb_path_init();
+    tb_assert_and_check_return_val(impl->path, tb_null);
+
+    // clear it
+    gb_path_clear(impl->path);
+
+    // ok
+    return impl->path;
+}
+static tb_void_t gb_clipper_add_region_path(gb_clipper_impl_t* impl, tb_size_t mode)
+{
+    // check
+    tb_assert(impl && impl->path);
+
+    // apply matrix to the path, the curves will be flattened for the device pixels
+    gb_path_apply(impl->path, &impl->matrix);
+
+    // the polygon and bounds
+    gb_polygon_ref_t    polygon = gb_path_polygon(impl->path);
+    gb_rect_ref_t       bounds = gb_path_bounds(impl->path);
+    tb_check_return(polygon && polygon->points && bounds);
+
+    // the pixel bounds of the shape
+    tb_long_t left      = gb_floor(bounds->x);
+    tb_long_t top       = gb_floor(bounds->y);
+    tb_long_t right     = gb_ceil(bounds->x + bounds->w);
+    tb_long_t bottom    = gb_ceil(bounds->y + bounds->h);
+
+    // init raster
+    if (!impl->raster) impl->raster = gb_polygon_raster_init();
+    tb_assert_and_check_return(impl->raster);
+
+    // only make the coverage of the clipped scan-lines for intersecting
+    if (mode == GB_CLIPPER_MODE_INTERSECT && impl->size) 
+        gb_polygon_raster_clip(impl->raster, impl->region.top, tb_max(impl->region.bottom, impl->region.top + 1));
+    else gb_polygon_raster_clip(impl->raster, 0, 0);
+
+    // make the coverage of the shape
+    gb_clip_mask_ref_t shape = gb_clip_mask_init(left, top, right, bottom, 0);
+    tb_assert_and_check_return(shape);
+    if (left < right && top < bottom)
+    {
+        // done raster with the anti-aliasing coverage if not the low quality
+        if (gb_quality() > GB_QUALITY_LOW)
+            gb_polygon_raster_done_coverage(impl->raster, polygon, bounds, GB_POLYGON_RASTER_RULE_NONZERO, gb_clipper_raster_coverage, shape);
+        else gb_polygon_raster_done(impl->raster, polygon, bounds, GB_POLYGON_RASTER_RULE_NONZERO, gb_clipper_raster, shape);
+    }
+    gb_clip_mask_done(shape);
+
+    // add it
+    gb_clipper_add_region_mask(impl, mode, shape);
+    gb_clip_mask_exit(shape);
+}
+
+static tb_void_t gb_clipper_coverage_add_row(gb_clip_mask_ref_t mask, gb_path_ref_t path, tb_long_t left, tb_long_t right, tb_long_t y)
+{
+    // check
+    tb_assert(mask && path);
+
+    // the pixels before and after the mask are full covered
+    if (left < mask->left) gb_path_add_rect2i(path, left, y, tb_min(right, mask->left) - left, 1, GB_ROTATE_DIRECTION_CW);
+    if (right > mask->right) 
+    {
+        tb_long_t x = tb_max(left, mask->right);
+        gb_path_add_rect2i(path, x, y, right - x, 1, GB_ROTATE_DIRECTION_CW);
+    }
+
+    // the covered runs inside the mask
+    left    = tb_max(left, mask->left);
+    right   = tb_min(right, mask->right);
+    tb_check_return(left < right);
+
+    // add the runs whose pixels are covered by half or more
+    gb_clip_mask_run_ref_t end = tb_null;
+    gb_clip_mask_run_ref_t run = gb_clip_mask_run(mask, left, y, &end);
+    for (; run < end && run->left < right; run++)
+    {
+        tb_long_t lx = tb_max(left, run->left);
+        tb_long_t rx = tb_min(right, run->right);
+        if (run->alpha >= 0x80 && lx < rx) gb_path_add_rect2i(path, lx, y, rx - lx, 1, GB_ROTATE_DIRECTION_CW);
+    }
+}
+static tb_void_t gb_clipper_coverage_path(gb_clipper_impl_t* impl, gb_path_ref_t path)
+{
+    // check
+    tb_assert(impl && impl->size && path);
+
+    /* add the rects of the covered pixels for each band
+     *
+     * the infinite region is limited to the max device bounds, the path coordinates cannot be too large
+     */
+    tb_size_t               i = 0;
+    gb_clip_mask_ref_t      mask = impl->mask;
+    gb_region_band_ref_t    band = impl->region.bands;
+    for (i = 0; i < impl->region.bands_count; i++, band++)
+    {
+        // the band
+        tb_long_t top       = tb_max(band->top, 0);
+        tb_long_t bottom    = tb_min(band->bottom, GB_HEIGHT_MAXN);
+        if (top >= bottom) continue ;
+
+        // is this band masked?
+        tb_bool_t masked = mask && top < mask->bottom && bottom > mask->top;
+
+        // add the intervals
+        tb_size_t                   j = 0;
+        gb_region_interval_ref_t    interval = impl->region.intervals + band->index;
+        for (j = 0; j < band->count; j++, interval++)
+        {
+            // the interval
+            tb_long_t left  = tb_max(interval->left, 0);
+            tb_long_t right = tb_min(interval->right, GB_WIDTH_MAXN);
+            if (left >= right) continue ;
+
+            // not masked? add the rect of the whole interval
+            if (!masked || right <= mask->left || left >= mask->right)
+            {
+                gb_path_add_rect2i(path, left, top, right - left, bottom - top, GB_ROTATE_DIRECTION_CW);
+                continue ;
+            }
+
+            // add the masked rows
+            tb_long_t y = top;
+            for (; y < bottom; y++)
+            {
+                if (y < mask->top || y >= mask->bottom) gb_path_add_rect2i(path, left, y, right - left, 1, GB_ROTATE_DIRECTION_CW);
+                else gb_clipper_coverage_add_row(mask, path, left, right, y);
+            }
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
 gb_clipper_ref_t gb_clipper_init()
 {
-    return (gb_clipper_ref_t)1;
+    // make clipper
+    gb_clipper_impl_t* impl = tb_malloc0_type(gb_clipper_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init matrix
+    gb_matrix_clear(&impl->matrix);
+
+    // init region
+    gb_region_init(&impl->region);
+
+    // ok
+    return (gb_clipper_ref_t)impl;
 }
 tb_void_t gb_clipper_exit(gb_clipper_ref_t clipper)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl);
+
+    // exit region
+    gb_region_exit(&impl->region);
+
+    // exit mask
+    if (impl->mask) gb_clip_mask_exit(impl->mask);
+    impl->mask = tb_null;
+
+    // exit path
+    if (impl->path) gb_path_exit(impl->path);
+    impl->path = tb_null;
+
+    // exit raster
+    if (impl->raster) gb_polygon_raster_exit(impl->raster);
+    impl->raster = tb_null;
+
+    // exit it
+    tb_free(impl);
 }
 tb_size_t gb_clipper_size(gb_clipper_ref_t clipper)
 {
-    tb_trace_noimpl();
-    return 0;
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the shapes count
+    return impl->size;
 }
 tb_void_t gb_clipper_clear(gb_clipper_ref_t clipper)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl);
+
+    // clear region
+    gb_region_clear(&impl->region);
+
+    // clear mask
+    if (impl->mask) gb_clip_mask_exit(impl->mask);
+    impl->mask = tb_null;
+
+    // clear the shapes count
+    impl->size          = 0;
+    impl->generation    = 0;
 }
 tb_void_t gb_clipper_copy(gb_clipper_ref_t clipper, gb_clipper_ref_t copied)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl         = (gb_clipper_impl_t*)clipper;
+    gb_clipper_impl_t* impl_copied  = (gb_clipper_impl_t*)copied;
+    tb_assert_and_check_return(impl && impl_copied);
+
+    // same?
+    tb_check_return(impl != impl_copied);
+
+    // copy region
+    if (!gb_region_copy(&impl->region, &impl_copied->region)) return ;
+
+    // share the mask, it will be never modified
+    if (impl_copied->mask) gb_clip_mask_retain(impl_copied->mask);
+    if (impl->mask) gb_clip_mask_exit(impl->mask);
+    impl->mask = impl_copied->mask;
+
+    // copy matrix and shapes count, the copied clipper has the same generation
+    impl->matrix        = impl_copied->matrix;
+    impl->size          = impl_copied->size;
+    impl->generation    = impl_copied->generation;
 }
 gb_matrix_ref_t gb_clipper_matrix(gb_clipper_ref_t clipper)
 {
-    tb_trace_noimpl();
-    return tb_null;
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the matrix
+    return &impl->matrix;
 }
 tb_void_t gb_clipper_matrix_set(gb_clipper_ref_t clipper, gb_matrix_ref_t matrix)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl);
+
+    // set matrix
+    if (matrix) impl->matrix = *matrix;
+    else gb_matrix_clear(&impl->matrix);
 }
 tb_void_t gb_clipper_add_path(gb_clipper_ref_t clipper, tb_size_t mode, gb_path_ref_t path)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl && path);
+
+    // the hint shape is a rect? 
+    gb_shape_ref_t hint = gb_path_hint(path);
+    if (hint && hint->type == GB_SHAPE_TYPE_RECT)
+    {
+        gb_clipper_add_rect(clipper, mode, &hint->u.rect);
+        return ;
+    }
+
+    // copy path
+    gb_path_ref_t shape = gb_clipper_path(impl);
+    tb_assert_and_check_return(shape);
+    gb_path_copy(shape, path);
+
+    // clip it
+    gb_clipper_add_region_path(impl, mode);
 }
 tb_void_t gb_clipper_add_triangle(gb_clipper_ref_t clipper, tb_size_t mode, gb_triangle_ref_t triangle)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl && triangle);
+
+    // make path
+    gb_path_ref_t shape = gb_clipper_path(impl);
+    tb_assert_and_check_return(shape);
+    gb_path_add_triangle(shape, triangle);
+
+    // clip it
+    gb_clipper_add_region_path(impl, mode);
 }
 tb_void_t gb_clipper_add_rect(gb_clipper_ref_t clipper, tb_size_t mode, gb_rect_ref_t rect)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl && rect);
+
+    // rotated or skewed? clip it by the coverage mask
+    if (impl->matrix.kx != 0 || impl->matrix.ky != 0)
+    {
+        // make path
+        gb_path_ref_t shape = gb_clipper_path(impl);
+        tb_assert_and_check_return(shape);
+        gb_path_add_rect(shape, rect, GB_ROTATE_DIRECTION_CW);
+
+        // clip it
+        gb_clipper_add_region_path(impl, mode);
+        return ;
+    }
+
+    // apply matrix to rect
+    gb_rect_t bounds;
+    gb_rect_apply2(rect, &bounds, &impl->matrix);
+
+    // clip it for the pixel centers inside the rect
+    gb_clipper_add_region_rect(impl, mode, gb_round(bounds.x), gb_round(bounds.y), gb_round(bounds.x + bounds.w), gb_round(bounds.y + bounds.h));
 }
 tb_void_t gb_clipper_add_round_rect(gb_clipper_ref_t clipper, tb_size_t mode, gb_round_rect_ref_t rect)
 {
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl && rect);
+
+    // rect?
+    if (gb_round_rect_is_rect(rect))
+    {
+        gb_clipper_add_rect(clipper, mode, &rect->bounds);
+        return ;
+    }
+
+    // make path
+    gb_path_ref_t shape = gb_clipper_path(impl);
+    tb_assert_and_check_return(shape);
+    gb_path_add_round_rect(shape, rect, GB_ROTATE_DIRECTION_CW);
+
+    // clip it
+    gb_clipper_add_region_path(impl, mode);
 }
 tb_void_t gb_clipper_add_circle(gb_clipper_ref_t clipper, tb_size_t mode, gb_circle_ref_t circle)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl && circle);
+
+    // make path
+    gb_path_ref_t shape = gb_clipper_path(impl);
+    tb_assert_and_check_return(shape);
+    gb_path_add_circle(shape, circle, GB_ROTATE_DIRECTION_CW);
+
+    // clip it
+    gb_clipper_add_region_path(impl, mode);
 }
 tb_void_t gb_clipper_add_ellipse(gb_clipper_ref_t clipper, tb_size_t mode, gb_ellipse_ref_t ellipse)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl && ellipse);
+
+    // make path
+    gb_path_ref_t shape = gb_clipper_path(impl);
+    tb_assert_and_check_return(shape);
+    gb_path_add_ellipse(shape, ellipse, GB_ROTATE_DIRECTION_CW);
+
+    // clip it
+    gb_clipper_add_region_path(impl, mode);
 }
+gb_region_ref_t gb_clipper_region(gb_clipper_ref_t clipper)
+{
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_check_return_val(impl && impl->size, tb_null);
 
+    // the region
+    return &impl->region;
+}
+gb_clip_mask_ref_t gb_clipper_mask(gb_clipper_ref_t clipper)
+{
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_check_return_val(impl && impl->size, tb_null);
+
+    // the mask
+    return impl->mask;
+}
+tb_size_t gb_clipper_generation(gb_clipper_ref_t clipper)
+{
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_check_return_val(impl && impl->size, 0);
+
+    // the generation
+    return impl->generation;
+}
+tb_void_t gb_clipper_intersect(gb_clipper_ref_t clipper, gb_clipper_ref_t other)
+{
+    // check
+    gb_clipper_impl_t* impl         = (gb_clipper_impl_t*)clipper;
+    gb_clipper_impl_t* impl_other   = (gb_clipper_impl_t*)other;
+    tb_assert_and_check_return(impl && impl_other && impl != impl_other);
+
+    // nothing is clipped by the other?
+    tb_check_return(impl_other->size);
+
+    // the matrix is not identity? clip the covered pixels of the other as the path
+    if (!gb_matrix_identity(&impl->matrix))
+    {
+        // make path
+        gb_path_ref_t shape = gb_clipper_path(impl);
+        tb_assert_and_check_return(shape);
+        gb_clipper_coverage_path(impl_other, shape);
+
+        // clip it, all pixels are clipped out if nothing is covered
+        if (gb_path_null(shape)) gb_clipper_add_region_rect(impl, GB_CLIPPER_MODE_INTERSECT, 0, 0, 0, 0);
+        else gb_clipper_add_region_path(impl, GB_CLIPPER_MODE_INTERSECT);
+        return ;
+    }
+
+    // nothing is clipped now? copy it and keep the matrix
+    if (!impl->size)
+    {
+        gb_matrix_t matrix = impl->matrix;
+        gb_clipper_copy(clipper, other);
+        impl->matrix = matrix;
+        return ;
+    }
+
+    // intersect the region
+    if (!gb_region_op(&impl->region, &impl_other->region, GB_REGION_OP_INTERSECT))
+    {
+        // trace
+        tb_trace_e("intersect clipper failed!");
+        return ;
+    }
+
+    // intersect the mask
+    if (impl_other->mask)
+    {
+        // the other mask is the new mask if nothing is masked now
+        gb_clip_mask_ref_t mask = tb_null;
+        if (!impl->mask) mask = gb_clip_mask_retain(impl_other->mask);
+        else
+        {
+            // only the masked pixels inside the region need be combined, the others are full covered
+            tb_long_t left      = tb_max(tb_min(impl->mask->left, impl_other->mask->left), impl->region.left);
+            tb_long_t top       = tb_max(tb_min(impl->mask->top, impl_other->mask->top), impl->region.top);
+            tb_long_t right     = tb_min(tb_max(impl->mask->right, impl_other->mask->right), impl->region.right);
+            tb_long_t bottom    = tb_min(tb_max(impl->mask->bottom, impl_other->mask->bottom), impl->region.bottom);
+            mask = gb_clip_mask_init_op(impl->mask, tb_null, impl_other->mask, GB_REGION_OP_INTERSECT, left, top, right, bottom);
+            tb_assert_and_check_return(mask);
+        }
+
+        // update the mask
+        if (impl->mask) gb_clip_mask_exit(impl->mask);
+        impl->mask = mask;
+    }
+
+    // update the shapes count
+    impl->size += impl_other->size;
+    gb_clipper_changed(impl);
+}
@@ -36,6 +36,9 @@ tb_bool_t gb_core_init()
     // init prefix
     if (!gb_prefix_init()) return tb_false;
 
+    // init pixmap
+    if (!gb_pixmap_init()) return tb_false;
+
     // ok
     return tb_true;
 }
@@ -37,6 +37,8 @@
 #include "canvas.h"
 #include "device.h"
 #include "clipper.h"
+#include "picture.h"
+#include "stats.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
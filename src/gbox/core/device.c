@@ -94,8 +94,8 @@ gb_device_ref_t gb_device_init(gb_window_ref_t window)
         impl->pixfmt    = (tb_uint16_t)gb_window_pixfmt(window); 
 
         // init width and height
-        impl->width     = (tb_uint16_t)gb_window_width(window); 
-        impl->height    = (tb_uint16_t)gb_window_height(window); 
+        impl->width     = (tb_uint32_t)gb_window_width(window); 
+        impl->height    = (tb_uint32_t)gb_window_height(window); 
 
         // ok
         ok = tb_true;
@@ -194,6 +194,37 @@ tb_void_t gb_device_bind_clipper(gb_device_ref_t device, gb_clipper_ref_t clippe
     // bind it
     impl->clipper = clipper;
 }
+tb_void_t gb_device_flush(gb_device_ref_t device)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl);
+
+    // flush it
+    if (impl->flush) impl->flush(impl);
+}
+gb_rect_ref_t gb_device_damage(gb_device_ref_t device, tb_size_t* count)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return_val(impl && count, tb_null);
+
+    // not tracked?
+    *count = 0;
+    tb_check_return_val(impl->damage, tb_null);
+
+    // the damaged rects
+    return gb_damage_rects(impl->damage, count);
+}
+tb_void_t gb_device_damage_clear(gb_device_ref_t device)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl);
+
+    // clear it
+    if (impl->damage) gb_damage_clear(impl->damage);
+}
 tb_void_t gb_device_draw_clear(gb_device_ref_t device, gb_color_t color)
 {
     // check
@@ -220,7 +251,7 @@ tb_void_t gb_device_draw_path(gb_device_ref_t device, gb_path_ref_t path)
          *
          * @note the quality of drawing curve may be not higher and faster for stroking with the width > 1
          */
-        gb_device_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        gb_device_draw_polygon(device, gb_path_polygon2(path, impl->matrix), gb_path_hint(path), gb_path_bounds(path));
     }
 }
 tb_void_t gb_device_draw_lines(gb_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
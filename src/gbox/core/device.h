@@ -48,9 +48,52 @@ typedef enum __gb_device_type_e
 ,   GB_DEVICE_TYPE_GL       = 1
 ,   GB_DEVICE_TYPE_BITMAP   = 2
 ,   GB_DEVICE_TYPE_SKIA     = 3
+,   GB_DEVICE_TYPE_RECORDER = 4
 
 }gb_device_type_e;
 
+/// the gl device fill mode enum
+typedef enum __gb_device_gl_fill_mode_e
+{
+    GB_DEVICE_GL_FILL_MODE_TESSELLATE   = 0 //!< tessellate the polygon to the convex pieces on the cpu, the default mode
+,   GB_DEVICE_GL_FILL_MODE_STENCIL      = 1 //!< draw the polygon to the stencil buffer and cover its bounds, need gl >= 2.0 and a stencil buffer
+
+}gb_device_gl_fill_mode_e;
+
+/// the gl device tessellation cache statistics type
+typedef struct __gb_device_gl_tess_cache_stats_t
+{
+    /// the hit count
+    tb_size_t           hits;
+
+    /// the miss count
+    tb_size_t           misses;
+
+    /// the evicted items count
+    tb_size_t           evictions;
+
+    /// the cached items count
+    tb_size_t           items;
+
+    /// the cached vertex count
+    tb_size_t           vertices;
+
+    /// the cached vertex count resident in the vertex buffer objects
+    tb_size_t           resident;
+
+}gb_device_gl_tess_cache_stats_t, *gb_device_gl_tess_cache_stats_ref_t;
+
+/// the gl device frame statistics type
+typedef struct __gb_device_gl_stats_t
+{
+    /// the draw call count
+    tb_size_t           draws;
+
+    /// the vertex count
+    tb_size_t           vertices;
+
+}gb_device_gl_stats_t, *gb_device_gl_stats_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -81,6 +124,85 @@ gb_device_ref_t     gb_device_init_skia(gb_bitmap_ref_t bitmap);
  * @return          the device
  */
 gb_device_ref_t     gb_device_init_bitmap(gb_bitmap_ref_t bitmap);
+
+/*! init tiled bitmap device
+ *
+ * the draws will be recorded into the screen tiles 
+ * and all tiles will be rasterized concurrently on the worker threads at gb_device_flush()
+ *
+ * the output is the same as the bitmap device
+ *
+ * @param bitmap    the bitmap
+ * @param tile      the tile size, using the default size if be zero
+ * @param workers   the worker count, using the processor count if be zero
+ * @return          the device
+ */
+gb_device_ref_t     gb_device_init_bitmap_tiled(gb_bitmap_ref_t bitmap, tb_size_t tile, tb_size_t workers);
+#endif
+
+/*! init recorder device
+ *
+ * the draws will be recorded into a picture instead of being rendered, 
+ * and the picture can be replayed to any device by gb_canvas_draw_picture()
+ *
+ * @param width     the width
+ * @param height    the height
+ *
+ * @return          the device
+ */
+gb_device_ref_t     gb_device_init_recorder(tb_size_t width, tb_size_t height);
+
+/*! finish the current recording of the recorder device
+ *
+ * the next draws will be recorded into a new picture
+ *
+ * @param device    the recorder device
+ *
+ * @return          the recorded picture, need be exited by gb_picture_exit()
+ */
+gb_picture_ref_t    gb_device_recorder_done(gb_device_ref_t device);
+
+#ifdef GB_CONFIG_PACKAGE_HAVE_OPENGL
+/*! set the fill mode of the gl device
+ *
+ * the stencil mode bypasses the tessellator completely 
+ * and is faster for the complex or frequently changing paths
+ *
+ * @param device    the gl device
+ * @param mode      the fill mode, @see gb_device_gl_fill_mode_e
+ */
+tb_void_t           gb_device_gl_fill_mode_set(gb_device_ref_t device, tb_size_t mode);
+
+/*! set the vertex budget of the tessellation cache of the gl device
+ *
+ * the triangles of the filled paths are cached by the path generation, the fill rule and the flattening level,
+ * so the unchanged paths are drawn without tessellating them again,
+ * and the least recently used triangles will be removed if the cached vertices exceed the budget
+ *
+ * @param device    the gl device
+ * @param budget    the max vertex count of the cached triangles, disable the cache if be zero
+ */
+tb_void_t           gb_device_gl_tess_cache_set(gb_device_ref_t device, tb_size_t budget);
+
+/*! get the statistics of the tessellation cache of the gl device
+ *
+ * @param device    the gl device
+ * @param stats     the statistics
+ *
+ * @return          tb_true or tb_false if the cache is disabled
+ */
+tb_bool_t           gb_device_gl_tess_cache_stats(gb_device_ref_t device, gb_device_gl_tess_cache_stats_ref_t stats);
+
+/*! get the statistics of the last flushed frame of the gl device
+ *
+ * the draw calls and the vertices are counted for the batched triangles
+ *
+ * @param device    the gl device
+ * @param stats     the statistics
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_device_gl_stats(gb_device_ref_t device, gb_device_gl_stats_ref_t stats);
 #endif
 
 /*! exit device 
@@ -150,6 +272,32 @@ tb_void_t           gb_device_bind_matrix(gb_device_ref_t device, gb_matrix_ref_
  */
 tb_void_t           gb_device_bind_clipper(gb_device_ref_t device, gb_clipper_ref_t clipper);
 
+/*! flush the recorded draws to the target
+ *
+ * only for the deferred device, e.g. the tiled bitmap device
+ *
+ * @param device    the device
+ */
+tb_void_t           gb_device_flush(gb_device_ref_t device);
+
+/*! the damaged rects of the current frame in the device coordinate
+ *
+ * the device-space bounds of all draws since the last gb_device_damage_clear(),
+ * the overlapped bounds are merged into a short list of rects
+ *
+ * @param device    the device
+ * @param count     the rects count, zero if nothing has been drawn
+ *
+ * @return          the rects, tb_null if the damage is not tracked by this device and all pixels may be changed
+ */
+gb_rect_ref_t       gb_device_damage(gb_device_ref_t device, tb_size_t* count);
+
+/*! clear the damaged rects for the next frame
+ *
+ * @param device    the device
+ */
+tb_void_t           gb_device_damage_clear(gb_device_ref_t device);
+
 /*! clear draw and fill the given color
  *
  * @param device    the device
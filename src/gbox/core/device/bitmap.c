@@ -35,17 +35,7 @@
  */
 #include "prefix.h"
 #include "bitmap/bitmap.h"
-
-/* //////////////////////////////////////////////////////////////////////////////////////
- * macros
- */
-
-// the points grow count
-#ifdef __gb_small__
-#   define GB_DEVICE_BITMAP_POINTS_GROW      (64)
-#else
-#   define GB_DEVICE_BITMAP_POINTS_GROW      (128)
-#endif
+#include "../clipper.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -65,6 +55,16 @@ static tb_void_t gb_device_bitmap_draw_clear(gb_device_impl_t* device, gb_color_
     gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
     tb_assert_and_check_return(impl && impl->bitmap);
 
+    // clipped? only clear the clipped pixels
+    if (impl->clip || (impl->base.clipper && gb_clipper_size(impl->base.clipper)))
+    {
+        gb_bitmap_render_clear(impl, color);
+        return ;
+    }
+
+    // all pixels are damaged
+    gb_damage_add(&impl->damage, 0, 0, gb_bitmap_width(impl->bitmap), gb_bitmap_height(impl->bitmap));
+
     // the pixels data
     tb_pointer_t pixels = gb_bitmap_data(impl->bitmap);
     tb_assert(pixels);
@@ -150,8 +150,8 @@ static gb_shader_ref_t gb_device_bitmap_shader_linear(gb_device_impl_t* device,
     gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
     tb_assert_and_check_return_val(impl, tb_null);
 
-    tb_trace_noimpl();
-    return tb_null;
+    // init shader
+    return gb_bitmap_shader_init_linear(impl, mode, gradient, line);
 }
 static gb_shader_ref_t gb_device_bitmap_shader_radial(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle)
 {
@@ -159,8 +159,8 @@ static gb_shader_ref_t gb_device_bitmap_shader_radial(gb_device_impl_t* device,
     gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
     tb_assert_and_check_return_val(impl, tb_null);
 
-    tb_trace_noimpl();
-    return tb_null;
+    // init shader
+    return gb_bitmap_shader_init_radial(impl, mode, gradient, circle);
 }
 static gb_shader_ref_t gb_device_bitmap_shader_bitmap(gb_device_impl_t* device, tb_size_t mode, gb_bitmap_ref_t bitmap)
 {
@@ -168,8 +168,8 @@ static gb_shader_ref_t gb_device_bitmap_shader_bitmap(gb_device_impl_t* device,
     gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
     tb_assert_and_check_return_val(impl, tb_null);
 
-    tb_trace_noimpl();
-    return tb_null;
+    // init shader
+    return gb_bitmap_shader_init_bitmap(impl, mode, bitmap);
 }
 static tb_void_t gb_device_bitmap_exit(gb_device_impl_t* device)
 {
@@ -178,13 +178,18 @@ static tb_void_t gb_device_bitmap_exit(gb_device_impl_t* device)
     tb_assert_and_check_return(impl);
 
     // exit points
-    if (impl->points) tb_vector_exit(impl->points);
+    if (impl->points) tb_free(impl->points);
     impl->points = tb_null;
+    impl->points_maxn = 0;
 
     // exit counts
     if (impl->counts) tb_vector_exit(impl->counts);
     impl->counts = tb_null;
 
+    // exit stroke cache
+    if (impl->stroke_cache) gb_stroke_cache_exit(impl->stroke_cache);
+    impl->stroke_cache = tb_null;
+
     // exit stroker
     if (impl->stroker) gb_stroker_exit(impl->stroker);
     impl->stroker = tb_null;
@@ -235,6 +240,9 @@ gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
         // init bitmap
         impl->bitmap = bitmap;
 
+        // init damage
+        impl->base.damage = &impl->damage;
+
         // init pixmap
         impl->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
         tb_assert_and_check_break(impl->pixmap);
@@ -247,12 +255,12 @@ gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
         impl->stroker = gb_stroker_init();
         tb_assert_and_check_break(impl->stroker);
 
-        // init points
-        impl->points = tb_vector_init(GB_DEVICE_BITMAP_POINTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
-        tb_assert_and_check_break(impl->points);
+        // init stroke cache
+        impl->stroke_cache = gb_stroke_cache_init(0, 0);
+        tb_assert_and_check_break(impl->stroke_cache);
 
         // init counts
-        impl->counts = tb_vector_init(8, tb_element_uint16());
+        impl->counts = tb_vector_init(8, tb_element_uint32());
         tb_assert_and_check_break(impl->counts);
 
         // ok
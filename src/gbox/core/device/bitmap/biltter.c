@@ -36,23 +36,481 @@
 #include "biltter.h"
 #include "biltter/solid.h"
 #include "biltter/shader.h"
+#include "../../impl/stats.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef GB_CONFIG_CORE_HAVE_STATS
+static tb_size_t gb_bitmap_biltter_spans_pixels(gb_bitmap_biltter_span_ref_t spans, tb_size_t count)
+{
+    // count the pixels of all spans
+    tb_size_t pixels = 0;
+    while (count--) pixels += (spans++)->w;
+    return pixels;
+}
+#endif
+static __tb_inline__ tb_bool_t gb_bitmap_biltter_clip_h(gb_bitmap_biltter_clip_ref_t clip, tb_long_t* x, tb_long_t y, tb_long_t* w)
+{
+    // outside?
+    if (y < clip->top || y >= clip->bottom || *x >= clip->right || *x + *w <= clip->left) return tb_false;
+
+    // clip the left
+    if (*x < clip->left)
+    {
+        *w -= clip->left - *x;
+        *x = clip->left;
+    }
+
+    // clip the right
+    if (*x + *w > clip->right) *w = clip->right - *x;
+
+    // ok
+    return *w > 0;
+}
+static __tb_inline__ tb_bool_t gb_bitmap_biltter_clip_v(gb_bitmap_biltter_clip_ref_t clip, tb_long_t x, tb_long_t* y, tb_long_t* h)
+{
+    // outside?
+    if (x < clip->left || x >= clip->right || *y >= clip->bottom || *y + *h <= clip->top) return tb_false;
+
+    // clip the top
+    if (*y < clip->top)
+    {
+        *h -= clip->top - *y;
+        *y = clip->top;
+    }
+
+    // clip the bottom
+    if (*y + *h > clip->bottom) *h = clip->bottom - *y;
+
+    // ok
+    return *h > 0;
+}
+static __tb_inline__ tb_bool_t gb_bitmap_biltter_region_contains(gb_region_ref_t region, tb_long_t x, tb_long_t y)
+{
+    // the band
+    gb_region_band_ref_t band = gb_region_band(region, y);
+    tb_check_return_val(band && band->top <= y, tb_false);
+
+    // find the interval
+    gb_region_interval_ref_t interval       = region->intervals + band->index;
+    gb_region_interval_ref_t interval_end   = interval + band->count;
+    for (; interval < interval_end && interval->left <= x; interval++)
+    {
+        if (x < interval->right) return tb_true;
+    }
+
+    // outside
+    return tb_false;
+}
+static tb_void_t gb_bitmap_biltter_done_r_clipped(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // horizontal?
+    if (h == 1) 
+    {
+        // check
+        tb_assert(biltter->done_h);
+
+        // done it
+        biltter->done_h(biltter, x, y, w);
+    }
+    // vertical?
+    else if (w == 1)
+    {
+        // check
+        tb_assert(biltter->done_v);
+
+        // done it
+        biltter->done_v(biltter, x, y, h);
+    }
+    // rect?
+    else if (biltter->done_r) biltter->done_r(biltter, x, y, w, h);
+    else
+    {
+        // check
+        tb_assert(biltter->done_h);
+
+        // scan it
+        while (h--) biltter->done_h(biltter, x, y++, w);
+    }
+}
+static tb_void_t gb_bitmap_biltter_done_c_clipped(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha)
+{
+    // full covered? done it as the solid span
+    if (alpha == 0xff) 
+    {
+        // check
+        tb_assert(biltter->done_h);
+
+        // done it
+        biltter->done_h(biltter, x, y, w);
+    }
+    // done it with the coverage
+    else if (biltter->done_c) biltter->done_c(biltter, x, y, w, alpha);
+    // no coverage operation? only done the more than half covered span
+    else if (alpha & 0x80)
+    {
+        // check
+        tb_assert(biltter->done_h);
+
+        // done it
+        biltter->done_h(biltter, x, y, w);
+    }
+}
+static tb_void_t gb_bitmap_biltter_done_s_clipped(gb_bitmap_biltter_ref_t biltter, gb_bitmap_biltter_span_ref_t spans, tb_size_t count)
+{
+    // no spans?
+    tb_check_return(count);
+
+    // done it
+    if (biltter->done_s) biltter->done_s(biltter, spans, count);
+    else
+    {
+        // check
+        tb_assert(biltter->done_h);
+
+        // done spans one by one
+        while (count--)
+        {
+            // done it
+            if (spans->alpha == 0xff) biltter->done_h(biltter, spans->x, spans->y, spans->w);
+            else gb_bitmap_biltter_done_c_clipped(biltter, spans->x, spans->y, spans->w, spans->alpha);
+
+            // next span
+            spans++;
+        }
+    }
+}
+static tb_void_t gb_bitmap_biltter_mask_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // the mask
+    gb_clip_mask_ref_t mask = biltter->mask;
+    tb_assert(mask && mask->outside == 0xff);
+
+    // the rows above the mask are not masked
+    tb_long_t right     = x + w;
+    tb_long_t bottom    = y + h;
+    if (y < mask->top)
+    {
+        tb_long_t b = tb_min(bottom, mask->top);
+        gb_bitmap_biltter_done_r_clipped(biltter, x, y, w, b - y);
+        y = b;
+    }
+
+    // the rows inside the mask
+    tb_long_t rows_bottom = tb_min(bottom, mask->bottom);
+    if (y < rows_bottom)
+    {
+        // the left and right pixels outside the mask are not masked
+        tb_long_t l = tb_max(x, mask->left);
+        tb_long_t r = tb_min(right, mask->right);
+        if (x < l) gb_bitmap_biltter_done_r_clipped(biltter, x, y, tb_min(l, right) - x, rows_bottom - y);
+        if (r < right) gb_bitmap_biltter_done_r_clipped(biltter, tb_max(r, x), y, right - tb_max(r, x), rows_bottom - y);
+
+        // walk the runs of the rows
+        if (l < r)
+        {
+            tb_long_t row = y;
+            for (; row < rows_bottom; row++)
+            {
+                gb_clip_mask_run_ref_t end = tb_null;
+                gb_clip_mask_run_ref_t run = gb_clip_mask_run(mask, l, row, &end);
+                for (; run < end && run->left < r; run++)
+                {
+                    tb_long_t rl = tb_max(l, run->left);
+                    tb_long_t rr = tb_min(r, run->right);
+                    gb_bitmap_biltter_done_c_clipped(biltter, rl, row, rr - rl, run->alpha);
+                }
+            }
+        }
+        y = rows_bottom;
+    }
+
+    // the rows below the mask are not masked
+    y = tb_max(y, mask->bottom);
+    if (y < bottom) gb_bitmap_biltter_done_r_clipped(biltter, x, y, w, bottom - y);
+}
+static tb_void_t gb_bitmap_biltter_mask_done_c(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha)
+{
+    // the mask
+    gb_clip_mask_ref_t mask = biltter->mask;
+    tb_assert(mask && mask->outside == 0xff);
+
+    // the row outside the mask is not masked
+    tb_long_t right = x + w;
+    if (y < mask->top || y >= mask->bottom || x >= mask->right || right <= mask->left)
+    {
+        gb_bitmap_biltter_done_c_clipped(biltter, x, y, w, alpha);
+        return ;
+    }
+
+    // the left pixels outside the mask are not masked
+    if (x < mask->left)
+    {
+        gb_bitmap_biltter_done_c_clipped(biltter, x, y, mask->left - x, alpha);
+        x = mask->left;
+    }
+
+    // the right pixels outside the mask are not masked
+    if (right > mask->right)
+    {
+        gb_bitmap_biltter_done_c_clipped(biltter, mask->right, y, right - mask->right, alpha);
+        right = mask->right;
+    }
+
+    // modulate the pieces by the runs
+    gb_clip_mask_run_ref_t end = tb_null;
+    gb_clip_mask_run_ref_t run = gb_clip_mask_run(mask, x, y, &end);
+    for (; run < end && run->left < right; run++)
+    {
+        tb_long_t l = tb_max(x, run->left);
+        tb_long_t r = tb_min(right, run->right);
+        tb_byte_t a = alpha == 0xff? run->alpha : gb_clip_mask_alpha_mul(alpha, run->alpha);
+        if (a) gb_bitmap_biltter_done_c_clipped(biltter, l, y, r - l, a);
+    }
+}
+static tb_void_t gb_bitmap_biltter_mask_done_s(gb_bitmap_biltter_ref_t biltter, gb_bitmap_biltter_span_ref_t spans, tb_size_t count)
+{
+    // the mask
+    gb_clip_mask_ref_t mask = biltter->mask;
+    tb_assert(mask && mask->outside == 0xff);
+
+    // split the spans by the runs, a span may be split to more pieces
+    tb_size_t                   n = 0;
+    gb_bitmap_biltter_span_t    pieces[GB_BITMAP_BILTTER_SPANS_MAXN];
+    for (; count; count--, spans++)
+    {
+        // the span outside the mask is not masked
+        tb_long_t x     = spans->x;
+        tb_long_t y     = spans->y;
+        tb_long_t right = x + spans->w;
+        if (y < mask->top || y >= mask->bottom || x >= mask->right || right <= mask->left)
+        {
+            // flush the full pieces
+            if (n == tb_arrayn(pieces))
+            {
+                gb_bitmap_biltter_done_s_clipped(biltter, pieces, n);
+                n = 0;
+            }
+
+            // append it
+            pieces[n++] = *spans;
+            continue ;
+        }
+
+        // the pieces: the left outside, the runs and the right outside
+        tb_long_t               l = tb_max(x, mask->left);
+        tb_long_t               r = tb_min(right, mask->right);
+        gb_clip_mask_run_ref_t  end = tb_null;
+        gb_clip_mask_run_ref_t  run = gb_clip_mask_run(mask, l, y, &end);
+        while (x < right)
+        {
+            // the next piece
+            tb_long_t pl;
+            tb_long_t pr;
+            tb_byte_t alpha;
+            if (x < l) 
+            {
+                pl      = x;
+                pr      = l;
+                alpha   = spans->alpha;
+            }
+            else if (x >= r)
+            {
+                pl      = x;
+                pr      = right;
+                alpha   = spans->alpha;
+            }
+            else if (run < end && run->left < r)
+            {
+                pl      = tb_max(x, run->left);
+                pr      = tb_min(r, run->right);
+                alpha   = spans->alpha == 0xff? run->alpha : gb_clip_mask_alpha_mul(spans->alpha, run->alpha);
+                run++;
+            }
+            else 
+            {
+                // skip the transparent pixels after all runs
+                x = r;
+                continue ;
+            }
+            x = pr;
+
+            // transparent? skip it
+            if (!alpha || pl >= pr) continue ;
+
+            // flush the full pieces
+            if (n == tb_arrayn(pieces))
+            {
+                gb_bitmap_biltter_done_s_clipped(biltter, pieces, n);
+                n = 0;
+            }
+
+            // append the piece
+            pieces[n].x     = (tb_int32_t)pl;
+            pieces[n].y     = (tb_int32_t)y;
+            pieces[n].w     = (tb_int32_t)(pr - pl);
+            pieces[n].alpha = alpha;
+            n++;
+        }
+    }
+
+    // flush the left pieces
+    gb_bitmap_biltter_done_s_clipped(biltter, pieces, n);
+}
+static __tb_inline__ tb_void_t gb_bitmap_biltter_done_r_masked(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    if (biltter->mask) gb_bitmap_biltter_mask_done_r(biltter, x, y, w, h);
+    else gb_bitmap_biltter_done_r_clipped(biltter, x, y, w, h);
+}
+static __tb_inline__ tb_void_t gb_bitmap_biltter_done_c_masked(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha)
+{
+    if (biltter->mask) gb_bitmap_biltter_mask_done_c(biltter, x, y, w, alpha);
+    else gb_bitmap_biltter_done_c_clipped(biltter, x, y, w, alpha);
+}
+static __tb_inline__ tb_void_t gb_bitmap_biltter_done_s_masked(gb_bitmap_biltter_ref_t biltter, gb_bitmap_biltter_span_ref_t spans, tb_size_t count)
+{
+    if (biltter->mask) gb_bitmap_biltter_mask_done_s(biltter, spans, count);
+    else gb_bitmap_biltter_done_s_clipped(biltter, spans, count);
+}
+static tb_void_t gb_bitmap_biltter_region_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // the region
+    gb_region_ref_t region = biltter->region;
+    tb_assert(region);
+
+    // done the pieces of the rect in the bands
+    tb_long_t               right       = x + w;
+    tb_long_t               bottom      = y + h;
+    gb_region_band_ref_t    band        = gb_region_band(region, y);
+    gb_region_band_ref_t    band_end    = region->bands + region->bands_count;
+    for (; band && band < band_end && band->top < bottom; band++)
+    {
+        // the rows of this band
+        tb_long_t top       = tb_max(y, band->top);
+        tb_long_t rows      = tb_min(bottom, band->bottom) - top;
+
+        // done the intervals
+        gb_region_interval_ref_t interval       = region->intervals + band->index;
+        gb_region_interval_ref_t interval_end   = interval + band->count;
+        for (; interval < interval_end && interval->left < right; interval++)
+        {
+            tb_long_t l = tb_max(x, interval->left);
+            tb_long_t r = tb_min(right, interval->right);
+            if (l < r) gb_bitmap_biltter_done_r_masked(biltter, l, top, r - l, rows);
+        }
+    }
+}
+static tb_void_t gb_bitmap_biltter_region_done_c(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha)
+{
+    // the region
+    gb_region_ref_t region = biltter->region;
+    tb_assert(region);
+
+    // the band
+    gb_region_band_ref_t band = gb_region_band(region, y);
+    tb_check_return(band && band->top <= y);
+
+    // done the pieces of the span in the intervals
+    tb_long_t                   right           = x + w;
+    gb_region_interval_ref_t    interval        = region->intervals + band->index;
+    gb_region_interval_ref_t    interval_end    = interval + band->count;
+    for (; interval < interval_end && interval->left < right; interval++)
+    {
+        tb_long_t l = tb_max(x, interval->left);
+        tb_long_t r = tb_min(right, interval->right);
+        if (l < r) gb_bitmap_biltter_done_c_masked(biltter, l, y, r - l, alpha);
+    }
+}
+static tb_void_t gb_bitmap_biltter_region_done_s(gb_bitmap_biltter_ref_t biltter, gb_bitmap_biltter_span_ref_t spans, tb_size_t count)
+{
+    // the region
+    gb_region_ref_t region = biltter->region;
+    tb_assert(region);
+
+    // split the spans by the intervals, a span may be split to more pieces
+    tb_size_t                   n = 0;
+    gb_bitmap_biltter_span_t    pieces[GB_BITMAP_BILTTER_SPANS_MAXN];
+    for (; count; count--, spans++)
+    {
+        // the band
+        gb_region_band_ref_t band = gb_region_band(region, spans->y);
+        if (!band || band->top > spans->y) continue;
+
+        // split it
+        tb_long_t                   right           = spans->x + spans->w;
+        gb_region_interval_ref_t    interval        = region->intervals + band->index;
+        gb_region_interval_ref_t    interval_end    = interval + band->count;
+        for (; interval < interval_end && interval->left < right; interval++)
+        {
+            tb_long_t l = tb_max(spans->x, interval->left);
+            tb_long_t r = tb_min(right, interval->right);
+            if (l < r)
+            {
+                // flush the full pieces
+                if (n == tb_arrayn(pieces))
+                {
+                    gb_bitmap_biltter_done_s_masked(biltter, pieces, n);
+                    n = 0;
+                }
+
+                // append the piece
+                pieces[n].x     = (tb_int32_t)l;
+                pieces[n].y     = spans->y;
+                pieces[n].w     = (tb_int32_t)(r - l);
+                pieces[n].alpha = spans->alpha;
+                n++;
+            }
+        }
+    }
+
+    // flush the left pieces
+    gb_bitmap_biltter_done_s_masked(biltter, pieces, n);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_bool_t gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint)
+tb_bool_t gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint, gb_matrix_ref_t matrix)
+{
+    // check
+    tb_assert(biltter && bitmap && paint && matrix);
+
+    // clear the clip, the region, the mask, the spans buffer and the optional operations
+    biltter->clip           = tb_null;
+    biltter->region         = tb_null;
+    biltter->mask           = tb_null;
+    biltter->spans_count    = 0;
+    biltter->done_c         = tb_null;
+    biltter->done_s         = tb_null;
+
+    // init it
+    return gb_paint_shader(paint)? gb_bitmap_biltter_shader_init(biltter, bitmap, paint, matrix) : gb_bitmap_biltter_solid_init(biltter, bitmap, paint);
+}
+tb_bool_t gb_bitmap_biltter_init_clear(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_color_t color)
 {
     // check
-    tb_assert(biltter && bitmap && paint);
+    tb_assert(biltter && bitmap);
+
+    // clear the clip, the region, the mask, the spans buffer and the optional operations
+    biltter->clip           = tb_null;
+    biltter->region         = tb_null;
+    biltter->mask           = tb_null;
+    biltter->spans_count    = 0;
+    biltter->done_c         = tb_null;
+    biltter->done_s         = tb_null;
 
     // init it
-    return gb_paint_shader(paint)? gb_bitmap_biltter_shader_init(biltter, bitmap, paint) : gb_bitmap_biltter_solid_init(biltter, bitmap, paint);
+    return gb_bitmap_biltter_solid_init_color(biltter, bitmap, color);
 }
 tb_void_t gb_bitmap_biltter_exit(gb_bitmap_biltter_ref_t biltter)
 {
     // check
     tb_assert(biltter);
 
+    // flush the left spans
+    gb_bitmap_biltter_flush(biltter);
+
     // exit it
     if (biltter->exit) biltter->exit(biltter);
 }
@@ -61,58 +519,166 @@ tb_void_t gb_bitmap_biltter_done_p(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // check
     tb_assert(biltter && biltter->done_p);
 
-    // done it
-    biltter->done_p(biltter, x, y);
+    // clipped?
+    tb_check_return(!biltter->clip || (x >= biltter->clip->left && x < biltter->clip->right && y >= biltter->clip->top && y < biltter->clip->bottom));
+    tb_check_return(!biltter->region || gb_bitmap_biltter_region_contains(biltter->region, x, y));
+
+    // enter the stats
+    gb_stats_enter();
+
+    // masked? done it with the coverage of the mask
+    tb_byte_t alpha = biltter->mask? gb_clip_mask_alpha(biltter->mask, x, y) : 0xff;
+    if (alpha == 0xff) biltter->done_p(biltter, x, y);
+    else if (alpha) gb_bitmap_biltter_done_c_clipped(biltter, x, y, 1, alpha);
+
+    // leave the stats
+    gb_stats_leave(GB_STATS_STAGE_BLEND, 1);
+    gb_stats_pixels(1);
 }
 tb_void_t gb_bitmap_biltter_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
 {   
     // check
     tb_assert(biltter && biltter->done_h);
 
+    // clip it
+    if (biltter->clip && !gb_bitmap_biltter_clip_h(biltter->clip, &x, y, &w)) return ;
+
+    // enter the stats
+    gb_stats_enter();
+
+    // clip it by the region
+    if (biltter->region) gb_bitmap_biltter_region_done_r(biltter, x, y, w, 1);
     // done it
-    biltter->done_h(biltter, x, y, w);
+    else if (biltter->mask) gb_bitmap_biltter_mask_done_c(biltter, x, y, w, 0xff);
+    else biltter->done_h(biltter, x, y, w);
+
+    // leave the stats
+    gb_stats_leave(GB_STATS_STAGE_BLEND, 1);
+    gb_stats_pixels(w);
 }
 tb_void_t gb_bitmap_biltter_done_v(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t h)
 {   
     // check
     tb_assert(biltter && biltter->done_v);
 
+    // clip it
+    if (biltter->clip && !gb_bitmap_biltter_clip_v(biltter->clip, x, &y, &h)) return ;
+
+    // enter the stats
+    gb_stats_enter();
+
+    // clip it by the region
+    if (biltter->region) gb_bitmap_biltter_region_done_r(biltter, x, y, 1, h);
     // done it
-    biltter->done_v(biltter, x, y, h);
+    else if (biltter->mask) gb_bitmap_biltter_mask_done_r(biltter, x, y, 1, h);
+    else biltter->done_v(biltter, x, y, h);
+
+    // leave the stats
+    gb_stats_leave(GB_STATS_STAGE_BLEND, h);
+    gb_stats_pixels(h);
 }
 tb_void_t gb_bitmap_biltter_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
 {   
     // check
     tb_assert(biltter);
 
-    // horizontal?
-    if (h == 1) 
+    // clip it
+    if (biltter->clip)
     {
-        // check
-        tb_assert(biltter->done_h);
+        // the clipped bounds
+        tb_long_t left      = tb_max(x, biltter->clip->left);
+        tb_long_t top       = tb_max(y, biltter->clip->top);
+        tb_long_t right     = tb_min(x + w, biltter->clip->right);
+        tb_long_t bottom    = tb_min(y + h, biltter->clip->bottom);
+        tb_check_return(left < right && top < bottom);
 
-        // done it
-        biltter->done_h(biltter, x, y, w);
-        return ;
+        // update rect
+        x = left;
+        y = top;
+        w = right - left;
+        h = bottom - top;
     }
-    // vertical?
-    else if (w == 1)
-    {
-        // check
-        tb_assert(biltter->done_v);
 
-        // done it
-        biltter->done_v(biltter, x, y, h);
-        return ;
-    }
-    // rect?
-    else if (biltter->done_r) biltter->done_r(biltter, x, y, w, h);
-    else
-    {
-        // check
-        tb_assert(biltter->done_h);
+    // enter the stats
+    gb_stats_enter();
 
-        // scan it
-        while (h--) biltter->done_h(biltter, x, y++, w);
+    // clip it by the region
+    if (biltter->region) gb_bitmap_biltter_region_done_r(biltter, x, y, w, h);
+    // done it
+    else gb_bitmap_biltter_done_r_masked(biltter, x, y, w, h);
+
+    // leave the stats
+    gb_stats_leave(GB_STATS_STAGE_BLEND, h);
+    gb_stats_pixels(w * h);
+}
+tb_void_t gb_bitmap_biltter_done_c(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha)
+{   
+    // check
+    tb_assert(biltter);
+
+    // clip it
+    if (biltter->clip && !gb_bitmap_biltter_clip_h(biltter->clip, &x, y, &w)) return ;
+
+    // enter the stats
+    gb_stats_enter();
+
+    // clip it by the region
+    if (biltter->region) gb_bitmap_biltter_region_done_c(biltter, x, y, w, alpha);
+    // done it
+    else gb_bitmap_biltter_done_c_masked(biltter, x, y, w, alpha);
+
+    // leave the stats
+    gb_stats_leave(GB_STATS_STAGE_BLEND, 1);
+    gb_stats_pixels(w);
+}
+tb_void_t gb_bitmap_biltter_done_s(gb_bitmap_biltter_ref_t biltter, gb_bitmap_biltter_span_ref_t spans, tb_size_t count)
+{   
+    // check
+    tb_assert(biltter && spans);
+
+    // clip spans in place
+    if (biltter->clip)
+    {
+        tb_size_t i = 0;
+        tb_size_t n = 0;
+        for (i = 0; i < count; i++)
+        {
+            tb_long_t x = spans[i].x;
+            tb_long_t w = spans[i].w;
+            if (gb_bitmap_biltter_clip_h(biltter->clip, &x, spans[i].y, &w))
+            {
+                spans[n]    = spans[i];
+                spans[n].x  = (tb_int32_t)x;
+                spans[n].w  = (tb_int32_t)w;
+                n++;
+            }
+        }
+        count = n;
     }
+
+    // enter the stats
+    gb_stats_enter();
+
+    // clip it by the region
+    if (biltter->region) gb_bitmap_biltter_region_done_s(biltter, spans, count);
+    // done it
+    else gb_bitmap_biltter_done_s_masked(biltter, spans, count);
+
+    // leave the stats
+    gb_stats_leave(GB_STATS_STAGE_BLEND, count);
+    gb_stats_pixels(gb_bitmap_biltter_spans_pixels(spans, count));
+}
+tb_void_t gb_bitmap_biltter_flush(gb_bitmap_biltter_ref_t biltter)
+{
+    // check
+    tb_assert(biltter);
+
+    // no spans?
+    tb_check_return(biltter->spans_count);
+
+    // done spans
+    gb_bitmap_biltter_done_s(biltter, biltter->spans, biltter->spans_count);
+
+    // clear spans
+    biltter->spans_count = 0;
 }
@@ -29,16 +29,67 @@
  * includes
  */
 #include "prefix.h"
+#include "../../impl/region.h"
+#include "../../impl/clip_mask.h"
+#include "../../impl/pixmap_simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the spans maxn of the biltter buffer
+#ifdef __gb_small__
+#   define GB_BITMAP_BILTTER_SPANS_MAXN     (64)
+#else
+#   define GB_BITMAP_BILTTER_SPANS_MAXN     (256)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the bitmap biltter type
+struct __gb_bitmap_biltter_t;
+
+// the bitmap biltter span type
+typedef struct __gb_bitmap_biltter_span_t
+{
+    // the start x-coordinate
+    tb_int32_t                      x;
+
+    // the y-coordinate
+    tb_int32_t                      y;
+
+    // the width
+    tb_int32_t                      w;
+
+    // the coverage alpha, 0xff: full covered
+    tb_byte_t                       alpha;
+
+}gb_bitmap_biltter_span_t, *gb_bitmap_biltter_span_ref_t;
+
+// the bitmap biltter clip type
+typedef struct __gb_bitmap_biltter_clip_t
+{
+    // the left
+    tb_long_t                       left;
+
+    // the top
+    tb_long_t                       top;
+
+    // the right, exclusive
+    tb_long_t                       right;
+
+    // the bottom, exclusive
+    tb_long_t                       bottom;
+
+}gb_bitmap_biltter_clip_t, *gb_bitmap_biltter_clip_ref_t;
+
 // the bitmap biltter solid type
 typedef struct __gb_bitmap_biltter_solid_t
 {
@@ -50,6 +101,107 @@ typedef struct __gb_bitmap_biltter_solid_t
 
 }gb_bitmap_biltter_solid_t;
 
+// the bitmap biltter shader type
+typedef struct __gb_bitmap_biltter_shader_t
+{
+    // the alphas of the color ramp
+    tb_byte_t const*                alphas;
+
+    // the opaque pixels of the color ramp
+    gb_pixel_t const*               pixels;
+
+    // the premultiplied pixels of the color ramp, only for the 32-bits pixfmt
+    tb_uint32_t const*              premuls;
+
+    // the blend32 kernel for the premultiplied pixels, only for the 32-bits pixfmt
+    gb_pixmap_simd_func_blend32_t   blend32;
+
+    // the filter32 kernel for the bilinear filtering of the bitmap pattern
+    gb_pixmap_simd_func_filter32_t  filter32;
+
+    // the source pixmap of the bitmap pattern
+    gb_pixmap_ref_t                 source;
+
+    // the source data of the bitmap pattern
+    tb_byte_t const*                data;
+
+    // the source width of the bitmap pattern
+    tb_long_t                       width;
+
+    // the source height of the bitmap pattern
+    tb_long_t                       height;
+
+    // the source row bytes of the bitmap pattern
+    tb_size_t                       row_bytes;
+
+    // the integer offset of the source coordinates for the translate-only matrix
+    tb_long_t                       ox;
+    tb_long_t                       oy;
+
+    // the alpha mask of the premultiplied pixels
+    tb_uint32_t                     amask;
+
+    // the alpha shift of the premultiplied pixels
+    tb_uint8_t                      ashift;
+
+    // the bitmap data is big-endian?
+    tb_uint8_t                      be;
+
+    // the source pixels have the same pixfmt as the 32-bits bitmap? they can be used directly
+    tb_uint8_t                      direct;
+
+    // the source pixels have alpha? they will be premultiplied
+    tb_uint8_t                      has_alpha;
+
+    // filter the source pixels with the bilinear sampling?
+    tb_uint8_t                      filter;
+
+    // the source coordinates are only translated by the integer offset?
+    tb_uint8_t                      translate;
+
+    /* done the span with the alpha scale
+     *
+     * @param biltter               the biltter
+     * @param x                     the start x-coordinate
+     * @param y                     the y-coordinate
+     * @param w                     the width
+     * @param scale                 the alpha scale, [0, 256]
+     */
+    tb_void_t                       (*done_span)(struct __gb_bitmap_biltter_t* biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_size_t scale);
+
+    // the opaque pixmap
+    gb_pixmap_ref_t                 pixmap_opaque;
+
+    // the alpha pixmap
+    gb_pixmap_ref_t                 pixmap_alpha;
+
+    /* the factors for the pixel center: (x + 0.5, y + 0.5)
+     *
+     * linear: t = sx * x + kx * y + tx, fixed30
+     * radial: t = |(sx * x + kx * y + tx, ky * x + sy * y + ty)|, fixed30
+     * bitmap: (u, v) = (sx * x + kx * y + tx, ky * x + sy * y + ty), fixed
+     */
+    tb_hong_t                       sx;
+    tb_hong_t                       kx;
+    tb_hong_t                       tx;
+    tb_hong_t                       ky;
+    tb_hong_t                       sy;
+    tb_hong_t                       ty;
+
+    // the shader type
+    tb_uint8_t                      type;
+
+    // the shader mode
+    tb_uint8_t                      mode;
+
+    // all pixels are opaque? the outside pixels of the border mode are transparent
+    tb_uint8_t                      opaque;
+
+    // the alpha of the paint
+    tb_byte_t                       alpha;
+
+}gb_bitmap_biltter_shader_t;
+
 // the bitmap biltter type
 typedef struct __gb_bitmap_biltter_t
 {
@@ -58,6 +210,9 @@ typedef struct __gb_bitmap_biltter_t
         // the solid biltter
         gb_bitmap_biltter_solid_t    solid;
 
+        // the shader biltter
+        gb_bitmap_biltter_shader_t   shader;
+
     }u;
 
     // the bitmap
@@ -72,6 +227,21 @@ typedef struct __gb_bitmap_biltter_t
     // the row bytes of the bitmap
     tb_size_t                       row_bytes;
 
+    // the clip, all pixels outside it will be discarded if exists
+    gb_bitmap_biltter_clip_ref_t    clip;
+
+    // the clip region, all pixels outside its bands will be discarded if exists, only for the complex region
+    gb_region_ref_t                 region;
+
+    // the clip mask, the pixels will be modulated by its coverage if exists
+    gb_clip_mask_ref_t              mask;
+
+    // the spans count of the buffer
+    tb_size_t                       spans_count;
+
+    // the spans buffer, will be flushed to done_s if be full
+    gb_bitmap_biltter_span_t        spans[GB_BITMAP_BILTTER_SPANS_MAXN];
+
     /* exit the biltter
      *
      * @param biltter               the biltter 
@@ -114,6 +284,24 @@ typedef struct __gb_bitmap_biltter_t
      */
     tb_void_t                       (*done_r)(struct __gb_bitmap_biltter_t* biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h);
 
+    /* done biltter by horizontal with the coverage alpha
+     *
+     * @param biltter               the biltter
+     * @param x                     the start x-coordinate
+     * @param y                     the start y-coordinate
+     * @param w                     the width
+     * @param alpha                 the coverage alpha
+     */
+    tb_void_t                       (*done_c)(struct __gb_bitmap_biltter_t* biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha);
+
+    /* done biltter by spans
+     *
+     * @param biltter               the biltter
+     * @param spans                 the spans
+     * @param count                 the spans count
+     */
+    tb_void_t                       (*done_s)(struct __gb_bitmap_biltter_t* biltter, gb_bitmap_biltter_span_ref_t spans, tb_size_t count);
+
 }gb_bitmap_biltter_t, *gb_bitmap_biltter_ref_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -125,10 +313,21 @@ typedef struct __gb_bitmap_biltter_t
  * @param biltter       the biltter
  * @param bitmap        the bitmap
  * @param paint         the paint
+ * @param matrix        the matrix for the shader
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint, gb_matrix_ref_t matrix);
+
+/* init biltter for clearing the pixels with the given color
+ *
+ * @param biltter       the biltter
+ * @param bitmap        the bitmap
+ * @param color         the color
  *
  * @return              tb_true or tb_false
  */
-tb_bool_t               gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint);
+tb_bool_t               gb_bitmap_biltter_init_clear(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_color_t color);
 
 /* exit biltter
  *
@@ -172,6 +371,75 @@ tb_void_t               gb_bitmap_biltter_done_v(gb_bitmap_biltter_ref_t biltter
  */
 tb_void_t               gb_bitmap_biltter_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h);
 
+/* done biltter by horizontal with the coverage alpha
+ *
+ * @param biltter       the biltter
+ * @param x             the start x-coordinate
+ * @param y             the start y-coordinate
+ * @param w             the width
+ * @param alpha         the coverage alpha
+ */
+tb_void_t               gb_bitmap_biltter_done_c(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha);
+
+/* done biltter by spans
+ *
+ * @param biltter       the biltter
+ * @param spans         the spans
+ * @param count         the spans count
+ */
+tb_void_t               gb_bitmap_biltter_done_s(gb_bitmap_biltter_ref_t biltter, gb_bitmap_biltter_span_ref_t spans, tb_size_t count);
+
+/* flush the buffered spans 
+ *
+ * @param biltter       the biltter
+ */
+tb_void_t               gb_bitmap_biltter_flush(gb_bitmap_biltter_ref_t biltter);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* append a span to the buffer of the biltter
+ *
+ * the span will be merged to the previous span if they are conjoint at the same line,
+ * and all spans will be done together if the buffer is full or be flushed
+ *
+ * @param biltter       the biltter
+ * @param x             the start x-coordinate
+ * @param y             the y-coordinate
+ * @param w             the width
+ * @param alpha         the coverage alpha, 0xff: full covered
+ */
+static __tb_inline__ tb_void_t gb_bitmap_biltter_span(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha)
+{
+    // check
+    tb_assert(biltter && biltter->spans_count <= GB_BITMAP_BILTTER_SPANS_MAXN);
+
+    // no width? ignore it
+    tb_check_return(w > 0);
+
+    // merge it to the previous span?
+    if (biltter->spans_count)
+    {
+        gb_bitmap_biltter_span_ref_t last = biltter->spans + biltter->spans_count - 1;
+        if (last->y == y && last->x + last->w == x && last->alpha == alpha)
+        {
+            last->w += (tb_int32_t)w;
+            return ;
+        }
+    }
+
+    // full? flush it
+    if (biltter->spans_count == GB_BITMAP_BILTTER_SPANS_MAXN) gb_bitmap_biltter_flush(biltter);
+
+    // append it
+    gb_bitmap_biltter_span_ref_t span = biltter->spans + biltter->spans_count++;
+    span->x     = (tb_int32_t)x;
+    span->y     = (tb_int32_t)y;
+    span->w     = (tb_int32_t)w;
+    span->alpha = alpha;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -34,36 +34,712 @@
  * includes
  */
 #include "shader.h"
+#include "../shader.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the pixels maxn of the span chunk
+#ifdef __gb_small__
+#   define GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN      (64)
+#else
+#   define GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN      (256)
+#endif
+
+// the maximum coordinate of the normalized point for the radial gradient, fixed, |q|^2 will not overflow
+#define GB_BITMAP_BILTTER_SHADER_RADIAL_MAXQ        ((tb_hong_t)1 << 30)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_size_t gb_bitmap_biltter_shader_scale(tb_size_t alpha)
+{
+    // [0, 255] => [0, 256]
+    return alpha + (alpha >> 7);
+}
+static __tb_inline__ tb_hong_t gb_bitmap_biltter_shader_radial_clamp(tb_hong_t q)
+{
+    return q > GB_BITMAP_BILTTER_SHADER_RADIAL_MAXQ? GB_BITMAP_BILTTER_SHADER_RADIAL_MAXQ : (q < -GB_BITMAP_BILTTER_SHADER_RADIAL_MAXQ? -GB_BITMAP_BILTTER_SHADER_RADIAL_MAXQ : q);
+}
+static tb_void_t gb_bitmap_biltter_shader_indices(gb_bitmap_biltter_shader_t const* shader, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t* values, tb_uint16_t* indices)
+{
+    // check
+    tb_assert(shader && values && indices && w > 0);
+
+    /* compute the gradient parameters of the pixels: t * 256
+     *
+     * the parameter is stepped incrementally from the start pixel, 
+     * so the matrix is only applied once for this span
+     */
+    tb_long_t i = 0;
+    switch (shader->type)
+    {
+    case GB_SHADER_TYPE_LINEAR:
+        {
+            // the parameter of the start pixel center
+            tb_hong_t t = shader->sx * x + shader->kx * y + shader->tx + ((shader->sx + shader->kx) >> 1);
+            tb_hong_t d = shader->sx;
+
+            // step it, fixed30 => t * 256
+            for (i = 0; i < w; i++, t += d) values[i] = (tb_long_t)(t >> 22);
+        }
+        break;
+    case GB_SHADER_TYPE_RADIAL:
+        {
+            // the normalized point of the start pixel center
+            tb_hong_t qx = shader->sx * x + shader->kx * y + shader->tx + ((shader->sx + shader->kx) >> 1);
+            tb_hong_t qy = shader->ky * x + shader->sy * y + shader->ty + ((shader->ky + shader->sy) >> 1);
+            tb_hong_t dx = shader->sx;
+            tb_hong_t dy = shader->ky;
+
+            // step it, t * 256 = sqrt(|q|^2 * 65536)
+            for (i = 0; i < w; i++, qx += dx, qy += dy) 
+            {
+                tb_hong_t  px = gb_bitmap_biltter_shader_radial_clamp(qx >> 14);
+                tb_hong_t  py = gb_bitmap_biltter_shader_radial_clamp(qy >> 14);
+                tb_hize_t  f = (tb_hize_t)(px * px + py * py) >> 16;
+                values[i] = (tb_long_t)tb_isqrti(f > 0xffffffff? 0xffffffff : (tb_uint32_t)f);
+            }
+        }
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+
+    // map the parameters to the ramp entries by the mode
+    tb_long_t n = GB_BITMAP_SHADER_RAMP_SIZE;
+    switch (shader->mode)
+    {
+    case GB_SHADER_MODE_REPEAT:
+        for (i = 0; i < w; i++) indices[i] = (tb_uint16_t)(values[i] & (n - 1));
+        break;
+    case GB_SHADER_MODE_MIRROR:
+        for (i = 0; i < w; i++) indices[i] = (tb_uint16_t)((values[i] & n)? (~values[i] & (n - 1)) : (values[i] & (n - 1)));
+        break;
+    case GB_SHADER_MODE_BORDER:
+        // the outside pixels use the transparent entry
+        for (i = 0; i < w; i++) indices[i] = (tb_uint16_t)((values[i] < 0 || values[i] > n)? n : tb_min(values[i], n - 1));
+        break;
+    default:
+        // pad it
+        for (i = 0; i < w; i++) indices[i] = (tb_uint16_t)((values[i] < 0)? 0 : tb_min(values[i], n - 1));
+        break;
+    }
+}
+static tb_void_t gb_bitmap_biltter_shader_gradient_done_span(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_size_t scale)
+{
+    // check
+    tb_assert(biltter && biltter->bitmap && x >= 0 && y >= 0);
+
+    // transparent? ignore it
+    tb_check_return(w > 0 && scale);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // the factors
+    gb_bitmap_biltter_shader_t const*   shader = &biltter->u.shader;
+    tb_size_t                           btp = biltter->btp;
+    tb_byte_t const*                    alphas = shader->alphas;
+    tb_byte_t                           alpha_minn = GB_ALPHA_MINN;
+    tb_byte_t                           alpha_maxn = GB_ALPHA_MAXN;
+
+    // the chunk buffers
+    tb_long_t                           values[GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN];
+    tb_uint16_t                         indices[GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN];
+    tb_uint32_t                         colors[GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN];
+    tb_byte_t                           covers[GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN];
+
+    // done
+    pixels += y * biltter->row_bytes + x * btp;
+    while (w > 0)
+    {
+        // the indices of this chunk
+        tb_long_t n = tb_min(w, GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN);
+        gb_bitmap_biltter_shader_indices(shader, x, y, n, values, indices);
+
+        // the 32-bits pixfmt? blend the premultiplied pixels
+        tb_long_t i = 0;
+        if (shader->blend32)
+        {
+            // the data
+            tb_uint32_t*        data = (tb_uint32_t*)pixels;
+            tb_uint32_t const*  premuls = shader->premuls;
+
+            // opaque? copy them
+            if (shader->opaque && scale == 256)
+            {
+                for (i = 0; i < n; i++) data[i] = premuls[indices[i]];
+            }
+            else
+            {
+                for (i = 0; i < n; i++) 
+                {
+                    colors[i] = premuls[indices[i]];
+                    covers[i] = alphas[indices[i]];
+                }
+                shader->blend32(data, colors, covers, n, scale);
+            }
+        }
+        else
+        {
+            // the ramp pixels
+            gb_pixel_t const*           ramp = shader->pixels;
+            gb_pixmap_func_pixel_set_t  pixel_set_opaque = shader->pixmap_opaque->pixel_set;
+            gb_pixmap_func_pixel_set_t  pixel_set_alpha = shader->pixmap_alpha->pixel_set;
+
+            // set the pixels with the alpha of the entry and the paint
+            tb_byte_t* p = pixels;
+            for (i = 0; i < n; i++, p += btp)
+            {
+                tb_byte_t a = (tb_byte_t)((alphas[indices[i]] * scale) >> 8);
+                if (a > alpha_maxn) pixel_set_opaque(p, ramp[indices[i]], 0xff);
+                else if (a >= alpha_minn) pixel_set_alpha(p, ramp[indices[i]], a);
+            }
+        }
+
+        // next chunk
+        pixels += n * btp;
+        x += n;
+        w -= n;
+    }
+}
+static __tb_inline__ tb_long_t gb_bitmap_biltter_shader_wrap(tb_size_t mode, tb_hong_t i, tb_long_t n)
+{
+    // inside?
+    if (i >= 0 && i < n) return (tb_long_t)i;
+
+    // wrap the source coordinate by the mode
+    switch (mode)
+    {
+    case GB_SHADER_MODE_REPEAT:
+        i %= n;
+        return (tb_long_t)(i < 0? i + n : i);
+    case GB_SHADER_MODE_MIRROR:
+        i %= n << 1;
+        if (i < 0) i += n << 1;
+        return (tb_long_t)(i < n? i : (n << 1) - 1 - i);
+    case GB_SHADER_MODE_BORDER:
+        // the outside pixel
+        return -1;
+    default:
+        // pad it
+        return i < 0? 0 : n - 1;
+    }
+}
+static __tb_inline__ tb_uint32_t gb_bitmap_biltter_shader_premul(gb_bitmap_biltter_shader_t const* shader, tb_uint32_t pixel, tb_size_t a)
+{
+    // opaque?
+    tb_check_return_val(a != 0xff, pixel);
+
+    // scale all bytes by the alpha: [0, 255] => [0, 256], and keep the alpha byte exact
+    tb_size_t   s = a + (a >> 7);
+    tb_uint32_t l = (((pixel & 0x00ff00ff) * s) >> 8) & 0x00ff00ff;
+    tb_uint32_t h = (((pixel >> 8) & 0x00ff00ff) * s) & 0xff00ff00;
+    return ((h | l) & ~shader->amask) | ((tb_uint32_t)a << shader->ashift);
+}
+static __tb_inline__ tb_uint32_t gb_bitmap_biltter_shader_fetch(gb_bitmap_biltter_shader_t const* shader, tb_byte_t const* row, tb_long_t ix)
+{
+    // the outside pixel of the border mode? transparent
+    tb_check_return_val(row && ix >= 0, 0);
+
+    // the same pixfmt? use the pixel directly
+    if (shader->direct)
+    {
+        tb_uint32_t pixel = tb_bits_get_u32_ne(row + (ix << 2));
+        return shader->has_alpha? gb_bitmap_biltter_shader_premul(shader, pixel, (pixel >> shader->ashift) & 0xff) : (pixel | shader->amask);
+    }
+
+    // convert the source color to the work pixel
+    gb_color_t  color = shader->source->color_get(row + ix * shader->source->btp);
+    tb_size_t   a = shader->has_alpha? color.a : 0xff;
+    gb_pixel_t  pixel;
+    color.a = 0xff;
+    if (shader->blend32)
+    {
+        // the opaque pixel of the bitmap with the byte order of the bitmap data
+        pixel = shader->pixmap_opaque->pixel(color);
+        pixel = shader->be? tb_bits_ne_to_be_u32(pixel) : tb_bits_ne_to_le_u32(pixel);
+    }
+    else pixel = gb_color_pixel(color);
+    return gb_bitmap_biltter_shader_premul(shader, pixel, a);
+}
+static __tb_inline__ tb_byte_t const* gb_bitmap_biltter_shader_row(gb_bitmap_biltter_shader_t const* shader, tb_hong_t iy)
+{
+    // the source row, null for the outside row of the border mode
+    tb_long_t y = gb_bitmap_biltter_shader_wrap(shader->mode, iy, shader->height);
+    return y >= 0? shader->data + y * shader->row_bytes : tb_null;
+}
+static tb_void_t gb_bitmap_biltter_shader_sample(gb_bitmap_biltter_shader_t const* shader, tb_long_t x, tb_long_t y, tb_long_t w, tb_uint32_t* works)
+{
+    // check
+    tb_assert(shader && works && w > 0 && w <= GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN);
+
+    /* the source coordinates of the start pixel center, fixed
+     *
+     * the coordinates are stepped incrementally from the start pixel, 
+     * so the matrix is only applied once for this span
+     */
+    tb_size_t   mode = shader->mode;
+    tb_long_t   width = shader->width;
+    tb_hong_t   u = shader->sx * x + shader->kx * y + shader->tx + ((shader->sx + shader->kx) >> 1);
+    tb_hong_t   v = shader->ky * x + shader->sy * y + shader->ty + ((shader->ky + shader->sy) >> 1);
+    tb_hong_t   du = shader->sx;
+    tb_hong_t   dv = shader->ky;
+    tb_long_t   i = 0;
+
+    // nearest?
+    if (!shader->filter)
+    {
+        // the scale-only matrix? the source row is same for this span
+        if (!dv)
+        {
+            tb_byte_t const* row = gb_bitmap_biltter_shader_row(shader, v >> 16);
+            for (i = 0; i < w; i++, u += du) 
+                works[i] = gb_bitmap_biltter_shader_fetch(shader, row, gb_bitmap_biltter_shader_wrap(mode, u >> 16, width));
+        }
+        else
+        {
+            for (i = 0; i < w; i++, u += du, v += dv) 
+                works[i] = gb_bitmap_biltter_shader_fetch(shader, gb_bitmap_biltter_shader_row(shader, v >> 16), gb_bitmap_biltter_shader_wrap(mode, u >> 16, width));
+        }
+        return ;
+    }
+
+    // the taps and weights of the bilinear filtering
+    tb_uint32_t taps[GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN << 2];
+    tb_byte_t   weights[GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN << 1];
+
+    // the top-left tap of the pixel center
+    u -= TB_FIXED_HALF;
+    v -= TB_FIXED_HALF;
+
+    // gather the taps and weights
+    tb_uint32_t*    tap = taps;
+    tb_byte_t*      weight = weights;
+    tb_byte_t const* row0 = tb_null;
+    tb_byte_t const* row1 = tb_null;
+    if (!dv)
+    {
+        // the scale-only matrix? the source rows are same for this span
+        row0 = gb_bitmap_biltter_shader_row(shader, v >> 16);
+        row1 = gb_bitmap_biltter_shader_row(shader, (v >> 16) + 1);
+    }
+    for (i = 0; i < w; i++, u += du, v += dv, tap += 4, weight += 2)
+    {
+        // the source rows
+        if (dv)
+        {
+            row0 = gb_bitmap_biltter_shader_row(shader, v >> 16);
+            row1 = gb_bitmap_biltter_shader_row(shader, (v >> 16) + 1);
+        }
+
+        // the source columns
+        tb_long_t ix0 = gb_bitmap_biltter_shader_wrap(mode, u >> 16, width);
+        tb_long_t ix1 = gb_bitmap_biltter_shader_wrap(mode, (u >> 16) + 1, width);
+
+        // the taps: [tl, tr, bl, br]
+        tap[0] = gb_bitmap_biltter_shader_fetch(shader, row0, ix0);
+        tap[1] = gb_bitmap_biltter_shader_fetch(shader, row0, ix1);
+        tap[2] = gb_bitmap_biltter_shader_fetch(shader, row1, ix0);
+        tap[3] = gb_bitmap_biltter_shader_fetch(shader, row1, ix1);
+
+        // the weights: [fx, fy]
+        weight[0] = (tb_byte_t)((u >> 8) & 0xff);
+        weight[1] = (tb_byte_t)((v >> 8) & 0xff);
+    }
+
+    // filter them
+    shader->filter32(works, taps, weights, w);
+}
+static tb_void_t gb_bitmap_biltter_shader_blend(gb_bitmap_biltter_shader_t const* shader, tb_byte_t* pixels, tb_uint32_t const* works, tb_long_t w, tb_size_t scale)
+{
+    // check
+    tb_assert(shader && pixels && works && w > 0 && w <= GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN);
+
+    // the 32-bits pixfmt? blend the premultiplied pixels
+    tb_long_t i = 0;
+    if (shader->blend32)
+    {
+        // opaque? copy them
+        if (shader->opaque && scale == 256) tb_memcpy(pixels, works, w << 2);
+        else
+        {
+            // the alphas of the pixels
+            tb_byte_t covers[GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN];
+            if (shader->opaque) tb_memset(covers, 0xff, w);
+            else for (i = 0; i < w; i++) covers[i] = (tb_byte_t)(works[i] >> shader->ashift);
+
+            // blend them
+            shader->blend32((tb_uint32_t*)pixels, works, covers, w, scale);
+        }
+    }
+    else
+    {
+        // the factors
+        tb_size_t                   btp = shader->pixmap_opaque->btp;
+        gb_pixmap_func_pixel_t      pixel = shader->pixmap_opaque->pixel;
+        gb_pixmap_func_pixel_set_t  pixel_set_opaque = shader->pixmap_opaque->pixel_set;
+        gb_pixmap_func_pixel_set_t  pixel_set_alpha = shader->pixmap_alpha->pixel_set;
+
+        // set the unpremultiplied pixels with the alpha of the pixel and the paint
+        for (i = 0; i < w; i++, pixels += btp)
+        {
+            // the premultiplied color
+            gb_color_t  color = gb_pixel_color(works[i]);
+            tb_size_t   a = color.a;
+            tb_check_continue(a);
+
+            // unpremultiply it
+            if (a != 0xff)
+            {
+                color.r = (tb_byte_t)tb_min((color.r * 255 + (a >> 1)) / a, 0xff);
+                color.g = (tb_byte_t)tb_min((color.g * 255 + (a >> 1)) / a, 0xff);
+                color.b = (tb_byte_t)tb_min((color.b * 255 + (a >> 1)) / a, 0xff);
+                color.a = 0xff;
+            }
+
+            // set it
+            a = (a * scale) >> 8;
+            if (a > GB_ALPHA_MAXN) pixel_set_opaque(pixels, pixel(color), 0xff);
+            else if (a >= GB_ALPHA_MINN) pixel_set_alpha(pixels, pixel(color), (tb_byte_t)a);
+        }
+    }
+}
+static tb_void_t gb_bitmap_biltter_shader_bitmap_done_chunks(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_size_t scale)
+{
+    // the factors
+    gb_bitmap_biltter_shader_t const*   shader = &biltter->u.shader;
+    tb_size_t                           btp = biltter->btp;
+    tb_byte_t*                          pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * biltter->row_bytes + x * btp;
+
+    // done
+    tb_uint32_t works[GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN];
+    while (w > 0)
+    {
+        // sample and blend this chunk
+        tb_long_t n = tb_min(w, GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN);
+        gb_bitmap_biltter_shader_sample(shader, x, y, n, works);
+        gb_bitmap_biltter_shader_blend(shader, pixels, works, n, scale);
+
+        // next chunk
+        pixels += n * btp;
+        x += n;
+        w -= n;
+    }
+}
+static tb_void_t gb_bitmap_biltter_shader_bitmap_done_span(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_size_t scale)
+{
+    // check
+    tb_assert(biltter && biltter->bitmap && x >= 0 && y >= 0);
+
+    // transparent? ignore it
+    tb_check_return(w > 0 && scale);
+
+    // the shader
+    gb_bitmap_biltter_shader_t const* shader = &biltter->u.shader;
+
+    // the general matrix or the converted pixels? sample them 
+    if (!shader->translate || !shader->direct)
+    {
+        gb_bitmap_biltter_shader_bitmap_done_chunks(biltter, x, y, w, scale);
+        return ;
+    }
+
+    // the source row of the translate-only matrix
+    tb_byte_t const* row = gb_bitmap_biltter_shader_row(shader, y + shader->oy);
+    tb_check_return(row);
+
+    // the inside part of this span: [x0, x1)
+    tb_long_t x0 = tb_max(x, -shader->ox);
+    tb_long_t x1 = tb_min(x + w, shader->width - shader->ox);
+    if (x0 >= x1)
+    {
+        // all pixels are outside
+        if (shader->mode != GB_SHADER_MODE_BORDER) gb_bitmap_biltter_shader_bitmap_done_chunks(biltter, x, y, w, scale);
+        return ;
+    }
+
+    // done the left and right outside parts, they are transparent for the border mode
+    if (shader->mode != GB_SHADER_MODE_BORDER)
+    {
+        if (x < x0) gb_bitmap_biltter_shader_bitmap_done_chunks(biltter, x, y, x0 - x, scale);
+        if (x1 < x + w) gb_bitmap_biltter_shader_bitmap_done_chunks(biltter, x1, y, x + w - x1, scale);
+    }
+
+    // done the inside part, the source pixels can be copied or blended directly
+    tb_long_t           i = 0;
+    tb_uint32_t         amask = shader->amask;
+    tb_byte_t*          pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap) + y * biltter->row_bytes + (x0 << 2);
+    tb_uint32_t const*  source = (tb_uint32_t const*)(row + ((x0 + shader->ox) << 2));
+    tb_uint32_t*        data = (tb_uint32_t*)pixels;
+    w = x1 - x0;
+    if (!shader->has_alpha && scale == 256)
+    {
+        // copy them, the alpha byte may be not filled for the opaque pixels
+        for (i = 0; i < w; i++) data[i] = source[i] | amask;
+    }
+    else
+    {
+        tb_uint32_t works[GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN];
+        while (w > 0)
+        {
+            // premultiply and blend this chunk
+            tb_long_t n = tb_min(w, GB_BITMAP_BILTTER_SHADER_CHUNK_MAXN);
+            if (shader->has_alpha) 
+            {
+                for (i = 0; i < n; i++) works[i] = gb_bitmap_biltter_shader_premul(shader, source[i], (source[i] >> shader->ashift) & 0xff);
+            }
+            else for (i = 0; i < n; i++) works[i] = source[i] | amask;
+            gb_bitmap_biltter_shader_blend(shader, pixels, works, n, scale);
+
+            // next chunk
+            pixels += n << 2;
+            source += n;
+            w -= n;
+        }
+    }
+}
+static tb_void_t gb_bitmap_biltter_shader_done_p(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y)
+{
+    // check
+    tb_assert(biltter);
+
+    // done
+    biltter->u.shader.done_span(biltter, x, y, 1, gb_bitmap_biltter_shader_scale(biltter->u.shader.alpha));
+}
+static tb_void_t gb_bitmap_biltter_shader_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w)
+{
+    // check
+    tb_assert(biltter);
+
+    // done
+    biltter->u.shader.done_span(biltter, x, y, w, gb_bitmap_biltter_shader_scale(biltter->u.shader.alpha));
+}
+static tb_void_t gb_bitmap_biltter_shader_done_v(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t h)
+{
+    // check
+    tb_assert(biltter && h >= 0);
+
+    // done
+    tb_size_t scale = gb_bitmap_biltter_shader_scale(biltter->u.shader.alpha);
+    while (h--) biltter->u.shader.done_span(biltter, x, y++, 1, scale);
+}
+static tb_void_t gb_bitmap_biltter_shader_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // check
+    tb_assert(biltter && w >= 0 && h >= 0);
+
+    // done
+    tb_size_t scale = gb_bitmap_biltter_shader_scale(biltter->u.shader.alpha);
+    while (h--) biltter->u.shader.done_span(biltter, x, y++, w, scale);
+}
+static __tb_inline__ tb_size_t gb_bitmap_biltter_shader_cover(gb_bitmap_biltter_ref_t biltter, tb_byte_t coverage)
+{
+    // compute the alpha scale of the paint with the coverage: (alpha * coverage) / 255
+    tb_size_t a = biltter->u.shader.alpha * coverage + 0x80;
+    return gb_bitmap_biltter_shader_scale((a + (a >> 8)) >> 8);
+}
+static tb_void_t gb_bitmap_biltter_shader_done_c(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha)
+{
+    // check
+    tb_assert(biltter);
+
+    // done
+    biltter->u.shader.done_span(biltter, x, y, w, gb_bitmap_biltter_shader_cover(biltter, alpha));
+}
+static tb_void_t gb_bitmap_biltter_shader_done_s(gb_bitmap_biltter_ref_t biltter, gb_bitmap_biltter_span_ref_t spans, tb_size_t count)
+{
+    // check
+    tb_assert(biltter && spans);
+
+    // done
+    while (count--)
+    {
+        biltter->u.shader.done_span(biltter, spans->x, spans->y, spans->w, gb_bitmap_biltter_shader_cover(biltter, spans->alpha));
+        spans++;
+    }
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_bool_t gb_bitmap_biltter_shader_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint)
+tb_bool_t gb_bitmap_biltter_shader_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint, gb_matrix_ref_t matrix)
 {
     // check
-    tb_assert(biltter && bitmap && paint);
+    tb_assert(biltter && bitmap && paint && matrix);
  
+    // the shader
+    gb_bitmap_shader_ref_t shader = (gb_bitmap_shader_ref_t)gb_paint_shader(paint);
+    tb_assert_and_check_return_val(shader, tb_false);
+
+    // only for the gradient and bitmap shader now
+    if (shader->base.type != GB_SHADER_TYPE_LINEAR && shader->base.type != GB_SHADER_TYPE_RADIAL && shader->base.type != GB_SHADER_TYPE_BITMAP)
+    {
+        // trace
+        tb_trace_noimpl();
+        return tb_false;
+    }
+
+    // the ramp pixels must be made for this pixfmt
+    tb_size_t pixfmt = gb_bitmap_pixfmt(bitmap);
+    tb_assert_and_check_return_val(shader->pixfmt == pixfmt, tb_false);
+
     // init bitmap
     biltter->bitmap = bitmap;
 
     // init pixmap
-    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
+    biltter->pixmap = gb_pixmap(pixfmt, gb_paint_alpha(paint));
     tb_check_return_val(biltter->pixmap, tb_false);
 
     // init btp and row_bytes
     biltter->btp        = biltter->pixmap->btp;
     biltter->row_bytes  = gb_bitmap_row_bytes(biltter->bitmap);
 
+    // the inverse matrix from the device to the shader
+    gb_matrix_t mx = *matrix;
+    gb_matrix_multiply(&mx, &shader->base.matrix);
+    tb_check_return_val(gb_matrix_invert(&mx), tb_false);
+
+    // the inverse matrix, fixed
+    tb_hong_t sx = gb_float_to_fixed(mx.sx);
+    tb_hong_t kx = gb_float_to_fixed(mx.kx);
+    tb_hong_t ky = gb_float_to_fixed(mx.ky);
+    tb_hong_t sy = gb_float_to_fixed(mx.sy);
+    tb_hong_t tx = gb_float_to_fixed(mx.tx);
+    tb_hong_t ty = gb_float_to_fixed(mx.ty);
+
     // init shader
-    // TODO
+    gb_bitmap_biltter_shader_t* impl = &biltter->u.shader;
+    impl->blend32       = biltter->btp == 4? gb_pixmap_simd_pixels_blend32(gb_pixmap_simd()) : tb_null;
+    impl->pixmap_opaque = gb_pixmap(pixfmt, 0xff);
+    impl->pixmap_alpha  = gb_pixmap(pixfmt, 0x80);
+    impl->type          = shader->base.type;
+    impl->mode          = shader->base.mode;
+    impl->alpha         = gb_paint_alpha(paint);
+    tb_assert_and_check_return_val(impl->pixmap_opaque && impl->pixmap_alpha, tb_false);
 
-    // init operations
-    // TODO
+    // init the factors
+    switch (impl->type)
+    {
+    case GB_SHADER_TYPE_LINEAR:
+        {
+            // t = (p - pb) . g
+            gb_bitmap_shader_linear_t const* linear = &shader->u.linear;
+            impl->sx = (sx * linear->gx + ky * linear->gy) >> 16;
+            impl->kx = (kx * linear->gx + sy * linear->gy) >> 16;
+            impl->tx = ((tx - linear->x0) * linear->gx + (ty - linear->y0) * linear->gy) >> 16;
+            impl->ky = 0;
+            impl->sy = 0;
+            impl->ty = 0;
+        }
+        break;
+    case GB_SHADER_TYPE_RADIAL:
+        {
+            // q = (p - c) / r
+            gb_bitmap_shader_radial_t const* radial = &shader->u.radial;
+            impl->sx = (sx << 30) / radial->r;
+            impl->kx = (kx << 30) / radial->r;
+            impl->tx = ((tx - radial->x0) << 30) / radial->r;
+            impl->ky = (ky << 30) / radial->r;
+            impl->sy = (sy << 30) / radial->r;
+            impl->ty = ((ty - radial->y0) << 30) / radial->r;
+        }
+        break;
+    default:
+        {
+            // (u, v) = p * inverse(matrix)
+            impl->sx = sx;
+            impl->kx = kx;
+            impl->tx = tx;
+            impl->ky = ky;
+            impl->sy = sy;
+            impl->ty = ty;
+        }
+        break;
+    }
+
+    // init the gradient
+    if (impl->type != GB_SHADER_TYPE_BITMAP)
+    {
+        impl->alphas    = shader->alphas;
+        impl->pixels    = shader->pixels;
+        impl->premuls   = shader->premuls;
+        impl->opaque    = (shader->opaque && impl->mode != GB_SHADER_MODE_BORDER)? 1 : 0;
+        impl->done_span = gb_bitmap_biltter_shader_gradient_done_span;
+    }
+    // init the bitmap pattern
+    else
+    {
+        // the source bitmap
+        gb_bitmap_ref_t source = shader->u.bitmap.bitmap;
+        tb_assert_and_check_return_val(source, tb_false);
 
-    // trace
-    tb_trace_noimpl();
+        // the source pixmap
+        tb_size_t source_pixfmt = gb_bitmap_pixfmt(source);
+        impl->source = gb_pixmap(source_pixfmt, 0xff);
+        tb_assert_and_check_return_val(impl->source, tb_false);
+
+        // init the source
+        impl->data          = (tb_byte_t const*)gb_bitmap_data(source);
+        impl->width         = gb_bitmap_width(source);
+        impl->height        = gb_bitmap_height(source);
+        impl->row_bytes     = gb_bitmap_row_bytes(source);
+        impl->filter32      = gb_pixmap_simd_pixels_filter32(gb_pixmap_simd());
+        impl->be            = GB_PIXFMT_BE(pixfmt)? 1 : 0;
+        impl->direct        = (source_pixfmt == pixfmt && impl->blend32)? 1 : 0;
+        impl->has_alpha     = gb_bitmap_has_alpha(source)? 1 : 0;
+        impl->opaque        = (!impl->has_alpha && impl->mode != GB_SHADER_MODE_BORDER)? 1 : 0;
+        impl->filter        = (gb_paint_flag(paint) & GB_PAINT_FLAG_FILTER_BITMAP)? 1 : 0;
+        tb_assert_and_check_return_val(impl->data && impl->width > 0 && impl->height > 0, tb_false);
+
+        /* the alpha byte of the work pixels
+         *
+         * the 32-bits pixfmt: the opaque pixel with the byte order of the bitmap data
+         * the others: the color pixel
+         */
+        if (impl->blend32)
+        {
+            gb_color_t  color = {0};
+            gb_pixel_t  pixel;
+            color.a = 0xff;
+            pixel = impl->pixmap_opaque->pixel(color);
+            impl->amask = impl->be? tb_bits_ne_to_be_u32(pixel) : tb_bits_ne_to_le_u32(pixel);
+        }
+        else impl->amask = 0xff000000;
+        for (impl->ashift = 0; impl->ashift < 32 && ((impl->amask >> impl->ashift) & 0xff) != 0xff; impl->ashift += 8) ;
+        tb_assert_and_check_return_val(impl->ashift < 32 && impl->amask == (tb_uint32_t)0xff << impl->ashift, tb_false);
+
+        /* the translate-only matrix? the source rows can be used directly
+         *
+         * the nearest pixel of the center: floor(x + tx + 0.5)
+         * the fractional offset will be filtered, so only the integer offset can be used for the bilinear filtering
+         */
+        if (sx == TB_FIXED_ONE && sy == TB_FIXED_ONE && !kx && !ky && (!impl->filter || (!(tx & 0xffff) && !(ty & 0xffff))))
+        {
+            impl->translate = 1;
+            impl->filter    = 0;
+            impl->ox        = (tb_long_t)((tx + TB_FIXED_HALF) >> 16);
+            impl->oy        = (tb_long_t)((ty + TB_FIXED_HALF) >> 16);
+        }
+        else impl->translate = 0;
+
+        // init the span
+        impl->done_span = gb_bitmap_biltter_shader_bitmap_done_span;
+    }
+
+    // init operations
+    biltter->done_p     = gb_bitmap_biltter_shader_done_p;
+    biltter->done_h     = gb_bitmap_biltter_shader_done_h;
+    biltter->done_v     = gb_bitmap_biltter_shader_done_v;
+    biltter->done_r     = gb_bitmap_biltter_shader_done_r;
+    biltter->done_c     = gb_bitmap_biltter_shader_done_c;
+    biltter->done_s     = gb_bitmap_biltter_shader_done_s;
+    biltter->exit       = tb_null;
 
     // ok
-    return tb_false;
+    return tb_true;
 }
-
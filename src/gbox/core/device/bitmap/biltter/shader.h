@@ -45,10 +45,11 @@ __tb_extern_c_enter__
  * @param biltter       the biltter
  * @param bitmap        the bitmap
  * @param paint         the paint
+ * @param matrix        the matrix
  *
  * @return              tb_true or tb_false
  */
-tb_bool_t               gb_bitmap_biltter_shader_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint);
+tb_bool_t               gb_bitmap_biltter_shader_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint, gb_matrix_ref_t matrix);
 
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -110,11 +110,11 @@ static tb_void_t gb_bitmap_biltter_solid_done_r(gb_bitmap_biltter_ref_t biltter,
     tb_byte_t                       alpha = biltter->u.solid.alpha;
     gb_pixmap_func_pixels_fill_t    pixels_fill = biltter->pixmap->pixels_fill;
 
-    // done
+    // done, the full rows are filled at once
+    pixels += y * row_bytes + x * btp;
     if (!x && (w * btp == row_bytes)) pixels_fill(pixels, pixel, h * w, alpha);
     else
     {
-        pixels += y * row_bytes + x * btp;
         while (h--) 
         {
             pixels_fill(pixels, pixel, w, alpha);
@@ -122,20 +122,93 @@ static tb_void_t gb_bitmap_biltter_solid_done_r(gb_bitmap_biltter_ref_t biltter,
         }
     }
 }
+static __tb_inline__ tb_byte_t gb_bitmap_biltter_solid_alpha(gb_bitmap_biltter_ref_t biltter, tb_byte_t coverage)
+{
+    // compute the alpha of the paint with the coverage: (alpha * coverage) / 255
+    tb_size_t a = biltter->u.solid.alpha * coverage + 0x80;
+    return (tb_byte_t)((a + (a >> 8)) >> 8);
+}
+static tb_void_t gb_bitmap_biltter_solid_done_c(gb_bitmap_biltter_ref_t biltter, tb_long_t x, tb_long_t y, tb_long_t w, tb_byte_t alpha)
+{
+    // check
+    tb_assert(biltter && biltter->bitmap);
+    tb_assert(x >= 0 && y >= 0 && w >= 0);
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
- */
-tb_bool_t gb_bitmap_biltter_solid_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint)
+    // no width? ignore it
+    tb_check_return(w);
+
+    // the alpha of the paint with the coverage
+    alpha = gb_bitmap_biltter_solid_alpha(biltter, alpha);
+
+    // get the pixmap for this alpha, transparent? ignore it
+    gb_pixmap_ref_t pixmap = gb_pixmap(gb_bitmap_pixfmt(biltter->bitmap), alpha);
+    tb_check_return(pixmap && pixmap->pixels_fill);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // done
+    pixmap->pixels_fill(pixels + y * biltter->row_bytes + x * biltter->btp, biltter->u.solid.pixel, w, alpha);
+}
+static tb_void_t gb_bitmap_biltter_solid_done_s(gb_bitmap_biltter_ref_t biltter, gb_bitmap_biltter_span_ref_t spans, tb_size_t count)
 {
     // check
-    tb_assert(biltter && bitmap && paint);
+    tb_assert(biltter && biltter->pixmap && biltter->pixmap->pixels_fill && spans);
+
+    // the pixels
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(biltter->bitmap);
+    tb_assert(pixels);
+
+    // the factors
+    tb_size_t                       btp = biltter->btp;
+    tb_size_t                       row_bytes = biltter->row_bytes;
+    gb_pixel_t                      pixel = biltter->u.solid.pixel;
+    tb_byte_t                       alpha = biltter->u.solid.alpha;
+    gb_pixmap_func_pixels_fill_t    pixels_fill = biltter->pixmap->pixels_fill;
+    tb_size_t                       pixfmt = gb_bitmap_pixfmt(biltter->bitmap);
+
+    // the pixmap cache for the coverage alpha, the edge pixels of the same polygon often have the same coverage
+    tb_size_t                       cover = 0xff;
+    tb_byte_t                       cover_alpha = 0;
+    gb_pixmap_ref_t                 cover_pixmap = tb_null;
+
+    // done
+    while (count--)
+    {
+        // check
+        tb_assert(spans->x >= 0 && spans->y >= 0 && spans->w >= 0);
+
+        // full covered?
+        if (spans->alpha == 0xff) pixels_fill(pixels + spans->y * row_bytes + spans->x * btp, pixel, spans->w, alpha);
+        else
+        {
+            // update the pixmap for this coverage
+            if (spans->alpha != cover)
+            {
+                cover           = spans->alpha;
+                cover_alpha     = gb_bitmap_biltter_solid_alpha(biltter, spans->alpha);
+                cover_pixmap    = gb_pixmap(pixfmt, cover_alpha);
+            }
+
+            // done it if not transparent
+            if (cover_pixmap) cover_pixmap->pixels_fill(pixels + spans->y * row_bytes + spans->x * btp, pixel, spans->w, cover_alpha);
+        }
+
+        // next span
+        spans++;
+    }
+}
+static tb_bool_t gb_bitmap_biltter_solid_init_pixel(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_color_t color, tb_byte_t alpha)
+{
+    // check
+    tb_assert(biltter && bitmap);
  
     // init bitmap
     biltter->bitmap = bitmap;
 
     // init pixmap
-    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
+    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), alpha);
     tb_check_return_val(biltter->pixmap, tb_false);
 
     // init btp and row_bytes
@@ -143,17 +216,38 @@ tb_bool_t gb_bitmap_biltter_solid_init(gb_bitmap_biltter_ref_t biltter, gb_bitma
     biltter->row_bytes  = gb_bitmap_row_bytes(biltter->bitmap);
 
     // init solid
-    biltter->u.solid.pixel = biltter->pixmap->pixel(gb_paint_color(paint));
-    biltter->u.solid.alpha = gb_paint_alpha(paint);
+    biltter->u.solid.pixel = biltter->pixmap->pixel(color);
+    biltter->u.solid.alpha = alpha;
 
     // init operations
     biltter->done_p     = gb_bitmap_biltter_solid_done_p;
     biltter->done_h     = gb_bitmap_biltter_solid_done_h;
     biltter->done_v     = gb_bitmap_biltter_solid_done_v;
     biltter->done_r     = gb_bitmap_biltter_solid_done_r;
+    biltter->done_c     = gb_bitmap_biltter_solid_done_c;
+    biltter->done_s     = gb_bitmap_biltter_solid_done_s;
     biltter->exit       = tb_null;
 
     // ok
     return tb_true;
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_bitmap_biltter_solid_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint)
+{
+    // check
+    tb_assert(biltter && bitmap && paint);
+
+    // init it with the color and alpha of the paint
+    return gb_bitmap_biltter_solid_init_pixel(biltter, bitmap, gb_paint_color(paint), gb_paint_alpha(paint));
+}
+tb_bool_t gb_bitmap_biltter_solid_init_color(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_color_t color)
+{
+    // check
+    tb_assert(biltter && bitmap);
+
+    // init it with the opaque pixmap, the pixels will be replaced by the color
+    return gb_bitmap_biltter_solid_init_pixel(biltter, bitmap, color, 0xff);
+}
@@ -50,6 +50,16 @@ __tb_extern_c_enter__
  */
 tb_bool_t               gb_bitmap_biltter_solid_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint);
 
+/* init the solid biltter for clearing the pixels with the given color
+ *
+ * @param biltter       the biltter
+ * @param bitmap        the bitmap
+ * @param color         the color, the pixels will be replaced by it if full covered
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_bitmap_biltter_solid_init_color(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_color_t color);
+
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
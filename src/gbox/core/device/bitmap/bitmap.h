@@ -31,6 +31,7 @@
 #include "prefix.h"
 #include "device.h"
 #include "render.h"
+#include "shader.h"
 
 #endif
 
@@ -31,6 +31,7 @@
 #include "prefix.h"
 #include "biltter.h"
 #include "../../impl/stroker.h"
+#include "../../impl/stroke_cache.h"
 #include "../../impl/polygon_raster.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -49,8 +50,11 @@ typedef struct __gb_bitmap_device_t
     // the pixmap
     gb_pixmap_ref_t                 pixmap;
 
-    // the points 
-    tb_vector_ref_t                 points;
+    // the points applied the matrix
+    gb_point_ref_t                  points;
+
+    // the points maxn
+    tb_size_t                       points_maxn;
 
     // the counts
     tb_vector_ref_t                 counts;
@@ -67,9 +71,27 @@ typedef struct __gb_bitmap_device_t
     // the biltter
     gb_bitmap_biltter_t             biltter;
 
+    // the biltter clip, only for rendering the tile of the tiled device
+    gb_bitmap_biltter_clip_ref_t    clip;
+
+    // the clipped bounds of the current draw: bitmap & tile & clipper
+    gb_bitmap_biltter_clip_t        clipped;
+
+    // the damaged rects of the current frame
+    gb_damage_t                     damage;
+
     // the stroker
     gb_stroker_ref_t                stroker;
 
+    // the stroke cache
+    gb_stroke_cache_ref_t           stroke_cache;
+
+    /* the stroked outline of the drawing path, only for the worker devices of the tiled device
+     *
+     * the path has been stroked once when recording it, so the workers only fill the outline
+     */
+    gb_path_ref_t                   stroked;
+
 }gb_bitmap_device_t, *gb_bitmap_device_ref_t;
 
 #endif
@@ -38,10 +38,124 @@
 #include "render/render.h"
 #include "../../impl/bounds.h"
 #include "../../impl/stroker.h"
+#include "../../impl/clipper.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static tb_bool_t gb_bitmap_render_clip_init(gb_bitmap_device_ref_t device, gb_region_ref_t* region, gb_clip_mask_ref_t* mask)
+{
+    // check
+    tb_assert(device && device->bitmap && device->raster && region && mask);
+
+    // init the clipped bounds to the bitmap
+    gb_bitmap_biltter_clip_ref_t clipped = &device->clipped;
+    clipped->left   = 0;
+    clipped->top    = 0;
+    clipped->right  = gb_bitmap_width(device->bitmap);
+    clipped->bottom = gb_bitmap_height(device->bitmap);
+
+    // clip it by the tile
+    if (device->clip)
+    {
+        clipped->left   = tb_max(clipped->left, device->clip->left);
+        clipped->top    = tb_max(clipped->top, device->clip->top);
+        clipped->right  = tb_min(clipped->right, device->clip->right);
+        clipped->bottom = tb_min(clipped->bottom, device->clip->bottom);
+    }
+
+    // clip it by the clipper
+    *region = tb_null;
+    *mask   = device->base.clipper? gb_clipper_mask(device->base.clipper) : tb_null;
+    gb_region_ref_t clipper_region = device->base.clipper? gb_clipper_region(device->base.clipper) : tb_null;
+    if (clipper_region)
+    {
+        // clip it by the region bounds
+        clipped->left   = tb_max(clipped->left, clipper_region->left);
+        clipped->top    = tb_max(clipped->top, clipper_region->top);
+        clipped->right  = tb_min(clipped->right, clipper_region->right);
+        clipped->bottom = tb_min(clipped->bottom, clipper_region->bottom);
+
+        // not a rect? the spans need be clipped by the bands
+        if (!gb_region_is_rect(clipper_region)) *region = clipper_region;
+    }
+
+    // all pixels are clipped?
+    tb_check_return_val(clipped->left < clipped->right && clipped->top < clipped->bottom, tb_false);
+
+    // only raster the clipped scan-lines
+    gb_polygon_raster_clip(device->raster, clipped->top, clipped->bottom);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_bitmap_render_clipped_out(gb_bitmap_device_ref_t device, gb_rect_ref_t bounds, tb_long_t margin)
+{
+    // check
+    tb_assert(device && bounds);
+
+    // the pixels bounds 
+    tb_long_t left      = gb_floor(bounds->x) - margin;
+    tb_long_t top       = gb_floor(bounds->y) - margin;
+    tb_long_t right     = gb_ceil(bounds->x + bounds->w) + margin;
+    tb_long_t bottom    = gb_ceil(bounds->y + bounds->h) + margin;
+
+    // outside the clipped bounds?
+    gb_bitmap_biltter_clip_ref_t clipped = &device->clipped;
+    tb_check_return_val(left < clipped->right && right > clipped->left && top < clipped->bottom && bottom > clipped->top, tb_true);
+
+    // outside the clipped region?
+    if (device->biltter.region && !gb_region_intersects(device->biltter.region, left, top, right, bottom)) return tb_true;
+
+    // the pixels inside the clipped bounds will be damaged
+    gb_damage_add(&device->damage, tb_max(left, clipped->left), tb_max(top, clipped->top), tb_min(right, clipped->right), tb_min(bottom, clipped->bottom));
+
+    // ok
+    return tb_false;
+}
+static tb_bool_t gb_bitmap_render_clipped_out_for_bounds(gb_bitmap_device_ref_t device, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(device && device->base.matrix && device->base.paint);
+
+    // no bounds? all clipped pixels will be damaged
+    if (!bounds)
+    {
+        gb_bitmap_biltter_clip_ref_t clipped = &device->clipped;
+        gb_damage_add(&device->damage, clipped->left, clipped->top, clipped->right, clipped->bottom);
+        return tb_false;
+    }
+
+    // apply matrix to bounds
+    gb_rect_t  device_bounds;
+    gb_point_t pt[4];
+    gb_point_make(&pt[0], bounds->x, bounds->y);
+    gb_point_make(&pt[1], bounds->x, bounds->y + bounds->h);
+    gb_point_make(&pt[2], bounds->x + bounds->w, bounds->y + bounds->h);
+    gb_point_make(&pt[3], bounds->x + bounds->w, bounds->y);
+    gb_matrix_apply_points(device->base.matrix, pt, tb_arrayn(pt));
+    gb_bounds_make(&device_bounds, pt, tb_arrayn(pt));
+
+    // the margin for the antialiasing and stroking
+    tb_long_t       margin = 1;
+    gb_paint_ref_t  paint = device->base.paint;
+    if (gb_paint_mode(paint) & GB_PAINT_MODE_STROKE)
+    {
+        // the max scale of the matrix 
+        gb_matrix_ref_t matrix = device->base.matrix;
+        gb_float_t      scale = gb_abs(matrix->sx) + gb_abs(matrix->kx) + gb_abs(matrix->ky) + gb_abs(matrix->sy);
+
+        // the max extension of the join and cap
+        gb_float_t miter = gb_paint_stroke_miter(paint);
+        if (gb_paint_stroke_join(paint) != GB_PAINT_STROKE_JOIN_MITER || miter < GB_TWO) miter = GB_TWO;
+
+        // the stroke margin
+        margin += gb_ceil(gb_mul(gb_mul(gb_paint_stroke_width(paint), scale), miter));
+    }
+
+    // clipped out?
+    return gb_bitmap_render_clipped_out(device, &device_bounds, margin);
+}
 static tb_bool_t gb_bitmap_render_apply_matrix_for_hint(gb_bitmap_device_ref_t device, gb_shape_ref_t hint, gb_shape_ref_t output)
 {
     // check
@@ -68,70 +182,39 @@ static tb_bool_t gb_bitmap_render_apply_matrix_for_hint(gb_bitmap_device_ref_t d
 static tb_size_t gb_bitmap_render_apply_matrix_for_points(gb_bitmap_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_point_ref_t* output)
 {
     // check
-    tb_assert(device && device->points && device->base.matrix && points);
+    tb_assert(device && device->base.matrix && points && output);
 
-    // clear points
-    tb_vector_clear(device->points);
-
-    // done
-    tb_size_t index = 0;
-    for (index = 0; index < count; index++)
+    /* make the output points
+     *
+     * the points are not stored in the vector, because it is limited to 64K items for the small tbox
+     */
+    if (count > device->points_maxn)
     {
-        // apply to point
-        gb_point_t point;
-        gb_point_apply2(points + index, &point, device->base.matrix);
-
-        // append point
-        tb_vector_insert_tail(device->points, &point);
+        device->points_maxn = 0;
+        device->points = (gb_point_ref_t)tb_ralloc(device->points, count * sizeof(gb_point_t));
+        tb_assert_and_check_return_val(device->points, 0);
+        device->points_maxn = count;
     }
+    *output = device->points;
 
-    // save points
-    if (output) *output = (gb_point_ref_t)tb_vector_data(device->points);
-    tb_assert(*output);
+    // apply matrix to the points
+    gb_matrix_apply_points2(device->base.matrix, points, *output, count);
 
     // the points count
-    return tb_vector_size(device->points);
+    return count;
 }
 static tb_size_t gb_bitmap_render_apply_matrix_for_polygon(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon, gb_point_ref_t* output)
 {
     // check
-    tb_assert(device && device->points && device->base.matrix && polygon && polygon->points);
+    tb_assert(device && device->base.matrix && polygon && polygon->points && polygon->counts && output);
 
-    // clear points
-    tb_vector_clear(device->points);
+    // the points count of all contours
+    tb_size_t       count = 0;
+    tb_uint32_t*    counts = polygon->counts;
+    while (*counts) count += *counts++;
 
-    // done
-    gb_point_ref_t  points = polygon->points;
-    tb_uint16_t*    counts = polygon->counts;
-    tb_uint16_t     count = *counts++;
-    tb_uint16_t     index = 0;
-    while (index < count)
-    {
-        // apply to point
-        gb_point_t point;
-        gb_point_apply2(points++, &point, device->base.matrix);
-
-        // append point
-        tb_vector_insert_tail(device->points, &point);
-        
-        // next point
-        index++;
-
-        // next polygon
-        if (index == count) 
-        {
-            // next
-            count = *counts++;
-            index = 0;
-        }
-    }
-
-    // save points
-    if (output) *output = (gb_point_ref_t)tb_vector_data(device->points);
-    tb_assert(*output);
-
-    // the points count
-    return tb_vector_size(device->points);
+    // apply matrix to the points
+    return gb_bitmap_render_apply_matrix_for_points(device, polygon->points, count, output);
 }
 static gb_rect_ref_t gb_bitmap_render_make_bounds_for_points(gb_bitmap_device_ref_t device, gb_rect_ref_t bounds, gb_point_ref_t points, tb_size_t count)
 {
@@ -155,6 +238,28 @@ static gb_rect_ref_t gb_bitmap_render_make_bounds_for_points(gb_bitmap_device_re
     // ok?
     return &device->bounds;
 }
+static gb_path_ref_t gb_bitmap_render_stroke_path(gb_bitmap_device_ref_t device, gb_path_ref_t path)
+{
+    // check
+    tb_assert(device && device->stroker && device->stroke_cache && device->base.paint && path);
+
+    // stroked when recording it?
+    tb_check_return_val(!device->stroked, device->stroked);
+
+    // get the cached stroked path first
+    gb_path_ref_t stroked = gb_stroke_cache_get(device->stroke_cache, device->base.paint, device->base.matrix, path);
+    tb_check_return_val(!stroked, stroked);
+
+    // stroke it
+    stroked = gb_stroker_done_path(device->stroker, device->base.paint, path);
+    tb_check_return_val(stroked, tb_null);
+
+    // cache the stroked path, using the stroker result directly if it is too large to be cached
+    gb_path_ref_t cached = gb_stroke_cache_add(device->stroke_cache, device->base.paint, device->base.matrix, path, stroked);
+
+    // ok
+    return cached? cached : stroked;
+}
 static tb_void_t gb_bitmap_render_stroke_fill(gb_bitmap_device_ref_t device, gb_path_ref_t path)
 {
     // check
@@ -204,6 +309,11 @@ tb_bool_t gb_bitmap_render_init(gb_bitmap_device_ref_t device)
     // check
     tb_assert_and_check_return_val(device && device->base.matrix && device->base.paint, tb_false);
 
+    // init clip, discard this draw if all pixels are clipped
+    gb_region_ref_t     region = tb_null;
+    gb_clip_mask_ref_t  mask = tb_null;
+    tb_check_return_val(gb_bitmap_render_clip_init(device, &region, &mask), tb_false);
+
     // done
     tb_bool_t ok = tb_false;
     do
@@ -212,7 +322,12 @@ tb_bool_t gb_bitmap_render_init(gb_bitmap_device_ref_t device)
         device->shader = gb_paint_shader(device->base.paint);
 
         // init biltter
-        if (!gb_bitmap_biltter_init(&device->biltter, device->bitmap, device->base.paint)) break;
+        if (!gb_bitmap_biltter_init(&device->biltter, device->bitmap, device->base.paint, device->base.matrix)) break;
+
+        // init biltter clip, region and mask
+        device->biltter.clip    = &device->clipped;
+        device->biltter.region  = region;
+        device->biltter.mask    = mask;
 
         // ok
         ok = tb_true;
@@ -233,18 +348,48 @@ tb_void_t gb_bitmap_render_exit(gb_bitmap_device_ref_t device)
     // exit biltter
     gb_bitmap_biltter_exit(&device->biltter);
 }
+tb_void_t gb_bitmap_render_clear(gb_bitmap_device_ref_t device, gb_color_t color)
+{
+    // check
+    tb_assert_and_check_return(device && device->bitmap);
+
+    // init clip, all pixels are clipped?
+    gb_region_ref_t     region = tb_null;
+    gb_clip_mask_ref_t  mask = tb_null;
+    tb_check_return(gb_bitmap_render_clip_init(device, &region, &mask));
+
+    // init biltter for clearing
+    gb_bitmap_biltter_ref_t biltter = &device->biltter;
+    if (!gb_bitmap_biltter_init_clear(biltter, device->bitmap, color)) return ;
+
+    // init biltter clip, region and mask
+    biltter->clip   = &device->clipped;
+    biltter->region = region;
+    biltter->mask   = mask;
+
+    // clear the clipped pixels
+    gb_bitmap_biltter_clip_ref_t clipped = &device->clipped;
+    gb_damage_add(&device->damage, clipped->left, clipped->top, clipped->right, clipped->bottom);
+    gb_bitmap_biltter_done_r(biltter, clipped->left, clipped->top, clipped->right - clipped->left, clipped->bottom - clipped->top);
+
+    // exit biltter
+    gb_bitmap_biltter_exit(biltter);
+}
 tb_void_t gb_bitmap_render_draw_path(gb_bitmap_device_ref_t device, gb_path_ref_t path)
 {
     // check
     tb_assert(device && device->base.paint && path);
 
+    // clipped out?
+    tb_check_return(!gb_bitmap_render_clipped_out_for_bounds(device, gb_path_bounds(path)));
+
     // the mode
     tb_size_t mode = gb_paint_mode(device->base.paint);
 
     // fill it
     if (mode & GB_PAINT_MODE_FILL)
     {
-        gb_bitmap_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        gb_bitmap_render_draw_polygon(device, gb_path_polygon2(path, device->base.matrix), gb_path_hint(path), gb_path_bounds(path));
     }
 
     // stroke it
@@ -253,10 +398,10 @@ tb_void_t gb_bitmap_render_draw_path(gb_bitmap_device_ref_t device, gb_path_ref_
         // only stroke?
         if (gb_bitmap_render_stroke_only(device))
         {
-            gb_bitmap_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+            gb_bitmap_render_draw_polygon(device, gb_path_polygon2(path, device->base.matrix), gb_path_hint(path), gb_path_bounds(path));
         }
         // fill the stroked path
-        else gb_bitmap_render_stroke_fill(device, gb_stroker_done_path(device->stroker, device->base.paint, path));
+        else gb_bitmap_render_stroke_fill(device, gb_bitmap_render_stroke_path(device, path));
     }
 }
 tb_void_t gb_bitmap_render_draw_lines(gb_bitmap_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
@@ -270,16 +415,16 @@ tb_void_t gb_bitmap_render_draw_lines(gb_bitmap_device_ref_t device, gb_point_re
     // check width
     tb_check_return((gb_paint_stroke_width(device->base.paint) > 0));
 
+    // clipped out?
+    tb_check_return(!gb_bitmap_render_clipped_out_for_bounds(device, bounds));
+
     // only stroke?
     if (gb_bitmap_render_stroke_only(device))
     {
         // apply matrix to points
         gb_point_ref_t  stroked_points  = tb_null;
         tb_size_t       stroked_count   = gb_bitmap_render_apply_matrix_for_points(device, points, count, &stroked_points);
-        tb_assert(stroked_points && stroked_count);
-
-        // TODO: clip it
-        // ...
+        tb_assert_and_check_return(stroked_points && stroked_count);
 
         // stroke lines
         gb_bitmap_render_stroke_lines(device, stroked_points, stroked_count);
@@ -298,16 +443,16 @@ tb_void_t gb_bitmap_render_draw_points(gb_bitmap_device_ref_t device, gb_point_r
     // check width
     tb_check_return((gb_paint_stroke_width(device->base.paint) > 0));
 
+    // clipped out?
+    tb_check_return(!gb_bitmap_render_clipped_out_for_bounds(device, bounds));
+
     // only stroke?
     if (gb_bitmap_render_stroke_only(device))
     {
         // apply matrix to points
         gb_point_ref_t  stroked_points  = tb_null;
         tb_size_t       stroked_count   = gb_bitmap_render_apply_matrix_for_points(device, points, count, &stroked_points);
-        tb_assert(stroked_points && stroked_count);
-
-        // TODO: clip it
-        // ...
+        tb_assert_and_check_return(stroked_points && stroked_count);
 
         // stroke points
         gb_bitmap_render_stroke_points(device, stroked_points, stroked_count);
@@ -336,6 +481,9 @@ tb_void_t gb_bitmap_render_draw_polygon(gb_bitmap_device_ref_t device, gb_polygo
         return ;
     }
 
+    // clipped out?
+    tb_check_return(!gb_bitmap_render_clipped_out_for_bounds(device, bounds));
+
     // the mode
     tb_size_t mode = gb_paint_mode(device->base.paint);
 
@@ -345,27 +493,28 @@ tb_void_t gb_bitmap_render_draw_polygon(gb_bitmap_device_ref_t device, gb_polygo
         // apply matrix to points
         gb_polygon_t    filled_polygon = {tb_null, polygon->counts, polygon->convex};
         tb_size_t       filled_count   = gb_bitmap_render_apply_matrix_for_polygon(device, polygon, &filled_polygon.points);
-        tb_assert(filled_polygon.points && filled_count);
+        tb_assert_and_check_return(filled_polygon.points && filled_count);
 
         // make the filled bounds
         gb_rect_ref_t   filled_bounds = gb_bitmap_render_make_bounds_for_points(device, bounds, filled_polygon.points, filled_count);
         tb_assert(filled_bounds);
 
-        // TODO: clip it
-        tb_bool_t       clipped = tb_false;
-
-        // apply matrix to hint
-        gb_shape_t      filled_hint;
-        if (!clipped && gb_bitmap_render_apply_matrix_for_hint(device, hint, &filled_hint))
+        // not clipped out?
+        if (!gb_bitmap_render_clipped_out(device, filled_bounds, 1))
         {
-            // check
-            tb_assert(filled_hint.type == GB_SHAPE_TYPE_RECT);
-
-            // fill rect
-            gb_bitmap_render_fill_rect(device, &filled_hint.u.rect);
+            // apply matrix to hint
+            gb_shape_t filled_hint;
+            if (gb_bitmap_render_apply_matrix_for_hint(device, hint, &filled_hint))
+            {
+                // check
+                tb_assert(filled_hint.type == GB_SHAPE_TYPE_RECT);
+
+                // fill rect
+                gb_bitmap_render_fill_rect(device, &filled_hint.u.rect);
+            }
+            // fill polygon
+            else gb_bitmap_render_fill_polygon(device, &filled_polygon, filled_bounds);
         }
-        // fill polygon
-        else gb_bitmap_render_fill_polygon(device, &filled_polygon, filled_bounds);
     }
 
     // stroke it
@@ -377,10 +526,7 @@ tb_void_t gb_bitmap_render_draw_polygon(gb_bitmap_device_ref_t device, gb_polygo
             // apply matrix to points
             gb_polygon_t    stroked_polygon = {tb_null, polygon->counts, polygon->convex};
             tb_size_t       stroked_count   = gb_bitmap_render_apply_matrix_for_polygon(device, polygon, &stroked_polygon.points);
-            tb_assert(stroked_polygon.points && stroked_count);
-
-            // TODO: clip it
-            // ...
+            tb_assert_and_check_return(stroked_polygon.points && stroked_count);
 
             // stroke polygon
             if (stroked_count) gb_bitmap_render_stroke_polygon(device, &stroked_polygon);
@@ -54,6 +54,13 @@ tb_bool_t           gb_bitmap_render_init(gb_bitmap_device_ref_t device);
  */
 tb_void_t           gb_bitmap_render_exit(gb_bitmap_device_ref_t device);
 
+/* clear the clipped pixels
+ *
+ * @param device    the device
+ * @param color     the color
+ */
+tb_void_t           gb_bitmap_render_clear(gb_bitmap_device_ref_t device, gb_color_t color);
+
 /* draw path
  *
  * @param device    the device
@@ -92,8 +92,8 @@ static tb_size_t gb_bitmap_render_stroke_line_generic(gb_bitmap_biltter_ref_t bi
         // done
         do
         {
-            // done biltter
-            gb_bitmap_biltter_done_p(biltter, ixb, tb_fixed_round(start_y));
+            // append the pixel to the spans buffer, the conjoint pixels at the same line will be merged
+            gb_bitmap_biltter_span(biltter, ixb, tb_fixed_round(start_y), 1, 0xff);
 
             // update the y-coordinate
             start_y += slope;
@@ -139,8 +139,8 @@ static tb_size_t gb_bitmap_render_stroke_line_generic(gb_bitmap_biltter_ref_t bi
         // done
         do
         {
-            // done biltter
-            gb_bitmap_biltter_done_p(biltter, tb_fixed_round(start_x), iyb);
+            // append the pixel to the spans buffer
+            gb_bitmap_biltter_span(biltter, tb_fixed_round(start_x), iyb, 1, 0xff);
 
             // update the x-coordinate
             start_x += slope;
@@ -160,6 +160,9 @@ static tb_void_t gb_bitmap_render_stroke_line_vertical(gb_bitmap_biltter_ref_t b
         tb_swap(tb_long_t, yb, ye);
     }
 
+    // flush the previous spans first
+    gb_bitmap_biltter_flush(biltter);
+
     // done
     gb_bitmap_biltter_done_v(biltter, tb_fixed6_round(xb), tb_fixed6_round(yb), tb_fixed6_round(ye - yb + TB_FIXED6_ONE));
 }
@@ -172,8 +175,8 @@ static tb_void_t gb_bitmap_render_stroke_line_horizontal(gb_bitmap_biltter_ref_t
         tb_swap(tb_long_t, xb, xe);
     }
 
-    // done
-    gb_bitmap_biltter_done_h(biltter, tb_fixed6_round(xb), tb_fixed6_round(yb), tb_fixed6_round(xe - xb + TB_FIXED6_ONE));
+    // append it to the spans buffer
+    gb_bitmap_biltter_span(biltter, tb_fixed6_round(xb), tb_fixed6_round(yb), tb_fixed6_round(xe - xb + TB_FIXED6_ONE), 0xff);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -217,4 +220,8 @@ tb_void_t gb_bitmap_render_stroke_lines(gb_bitmap_device_ref_t device, gb_point_
             else gb_bitmap_render_stroke_line_vertical(&device->biltter, xb, yb, xe, ye);
         }
     }
+
+    /* the left spans will be flushed when the buffer is full or the biltter is exited,
+     * so the short lines of the stroked polygon can be done together
+     */
 }
@@ -43,8 +43,8 @@ tb_void_t gb_bitmap_render_stroke_points(gb_bitmap_device_ref_t device, gb_point
     // check
     tb_assert(device && points && count);
 
-    // done
+    // append the points to the spans buffer
     tb_size_t i;
     for (i = 0; i < count; i++) 
-        gb_bitmap_biltter_done_p(&device->biltter, gb_float_to_long(points[i].x), gb_float_to_long(points[i].y));
+        gb_bitmap_biltter_span(&device->biltter, gb_float_to_long(points[i].x), gb_float_to_long(points[i].y), 1, 0xff);
 }
@@ -44,8 +44,27 @@ static tb_void_t gb_bitmap_render_fill_raster(tb_long_t lx, tb_long_t rx, tb_lon
     // check
     tb_assert(priv && rx >= lx && ye > yb);
 
-    // done biltter
-    gb_bitmap_biltter_done_r((gb_bitmap_biltter_ref_t)priv, lx, yb, rx - lx, ye - yb);
+    // the biltter
+    gb_bitmap_biltter_ref_t biltter = (gb_bitmap_biltter_ref_t)priv;
+
+    // only one line? append it to the spans buffer
+    if (ye - yb == 1) gb_bitmap_biltter_span(biltter, lx, yb, rx - lx, 0xff);
+    else
+    {
+        // flush the previous spans first
+        gb_bitmap_biltter_flush(biltter);
+
+        // done biltter
+        gb_bitmap_biltter_done_r(biltter, lx, yb, rx - lx, ye - yb);
+    }
+}
+static tb_void_t gb_bitmap_render_fill_raster_coverage(tb_long_t lx, tb_long_t rx, tb_long_t y, tb_byte_t alpha, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(priv && rx >= lx);
+
+    // append it to the spans buffer
+    gb_bitmap_biltter_span((gb_bitmap_biltter_ref_t)priv, lx, y, rx - lx, alpha);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -56,8 +75,17 @@ tb_void_t gb_bitmap_render_fill_polygon(gb_bitmap_device_ref_t device, gb_polygo
     // check
     tb_assert(device && device->base.paint);
 
+    // the fill rule
+    tb_size_t rule = gb_paint_fill_rule(device->base.paint);
+
+    // done raster with the anti-aliasing coverage?
+    if (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING)
+        gb_polygon_raster_done_coverage(device->raster, polygon, bounds, rule, gb_bitmap_render_fill_raster_coverage, &device->biltter);
     // done raster
-    gb_polygon_raster_done(device->raster, polygon, bounds, gb_paint_fill_rule(device->base.paint), gb_bitmap_render_fill_raster, &device->biltter);
+    else gb_polygon_raster_done(device->raster, polygon, bounds, rule, gb_bitmap_render_fill_raster, &device->biltter);
+
+    // flush the left spans
+    gb_bitmap_biltter_flush(&device->biltter);
 }
 tb_void_t gb_bitmap_render_stroke_polygon(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon)
 {
@@ -65,11 +93,11 @@ tb_void_t gb_bitmap_render_stroke_polygon(gb_bitmap_device_ref_t device, gb_poly
     tb_assert(device && polygon && polygon->points && polygon->counts);
 
     // done
-    tb_uint16_t     index = 0;
+    tb_uint32_t     index = 0;
     gb_point_t      points_line[2];
     gb_point_ref_t  points = polygon->points;
-    tb_uint16_t*    counts = polygon->counts;
-    tb_uint16_t     count = *counts++;
+    tb_uint32_t*    counts = polygon->counts;
+    tb_uint32_t     count = *counts++;
     while (index < count)
     {
         // the point
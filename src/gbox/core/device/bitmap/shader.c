@@ -0,0 +1,230 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        shader.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bitmap_shader"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "shader.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_bitmap_shader_exit(gb_shader_impl_t* shader)
+{
+    // exit it
+    if (shader) tb_free(shader);
+}
+static __tb_inline__ tb_long_t gb_bitmap_shader_ramp_stop(gb_gradient_ref_t gradient, tb_size_t index)
+{
+    // the position of the stop in the ramp, [0, 255]
+    if (gradient->radios) return (tb_long_t)((tb_min(tb_max(gb_float_to_fixed(gradient->radios[index]), 0), TB_FIXED_ONE) * 255) >> 16);
+    else return gradient->count > 1? (tb_long_t)((index * 255) / (gradient->count - 1)) : 0;
+}
+static tb_void_t gb_bitmap_shader_ramp_set(gb_bitmap_shader_ref_t shader, gb_pixmap_ref_t pixmap, tb_size_t index, gb_color_t c0, gb_color_t c1, tb_size_t w)
+{
+    /* interpolate the premultiplied color with the weight of the second color, [0, 256]
+     *
+     * the transparent stops will not darken the neighbour colors
+     */
+    tb_size_t a = (c0.a * (256 - w) + c1.a * w) >> 8;
+    tb_size_t r = (c0.r * c0.a * (256 - w) + c1.r * c1.a * w) >> 8;
+    tb_size_t g = (c0.g * c0.a * (256 - w) + c1.g * c1.a * w) >> 8;
+    tb_size_t b = (c0.b * c0.a * (256 - w) + c1.b * c1.a * w) >> 8;
+
+    // the opaque pixel of the unpremultiplied color
+    gb_color_t color;
+    color.a = 0xff;
+    color.r = a? (tb_byte_t)tb_min((r + (a >> 1)) / a, 0xff) : 0;
+    color.g = a? (tb_byte_t)tb_min((g + (a >> 1)) / a, 0xff) : 0;
+    color.b = a? (tb_byte_t)tb_min((b + (a >> 1)) / a, 0xff) : 0;
+    gb_pixel_t pixel = pixmap->pixel(color);
+
+    // save the entry
+    shader->alphas[index] = (tb_byte_t)a;
+    shader->pixels[index] = pixel;
+
+    // save the premultiplied pixel with the byte order of the bitmap data, all bytes are scaled by the alpha: [0, 255] => [0, 256]
+    if (pixmap->btp == 4)
+    {
+        tb_size_t   s = a + (a >> 7);
+        tb_uint32_t l = (((pixel & 0x00ff00ff) * s) >> 8) & 0x00ff00ff;
+        tb_uint32_t h = (((pixel >> 8) & 0x00ff00ff) * s) & 0xff00ff00;
+        shader->premuls[index] = GB_PIXFMT_BE(shader->pixfmt)? tb_bits_ne_to_be_u32(h | l) : tb_bits_ne_to_le_u32(h | l);
+    }
+}
+static tb_void_t gb_bitmap_shader_ramp_make(gb_bitmap_shader_ref_t shader, gb_pixmap_ref_t pixmap, gb_gradient_ref_t gradient)
+{
+    // check
+    tb_assert(shader && pixmap && gradient && gradient->colors && gradient->count);
+
+    // the stops
+    tb_size_t           count = gradient->count;
+    gb_color_t const*   colors = gradient->colors;
+
+    // make the entries before the first stop
+    tb_long_t           i = 0;
+    tb_long_t           p0 = gb_bitmap_shader_ramp_stop(gradient, 0);
+    for (i = 0; i < p0; i++) gb_bitmap_shader_ramp_set(shader, pixmap, i, colors[0], colors[0], 0);
+
+    // make the entries between the stops, the position of the stop is not less than the previous stop
+    tb_size_t           k = 0;
+    for (k = 1; k < count; k++)
+    {
+        tb_long_t p1 = tb_max(gb_bitmap_shader_ramp_stop(gradient, k), p0);
+        for (; i <= p1 && i < GB_BITMAP_SHADER_RAMP_SIZE; i++)
+            gb_bitmap_shader_ramp_set(shader, pixmap, i, colors[k - 1], colors[k], p1 > p0? (tb_size_t)(((i - p0) << 8) / (p1 - p0)) : 256);
+        p0 = p1;
+    }
+
+    // make the entries after the last stop
+    for (; i < GB_BITMAP_SHADER_RAMP_SIZE; i++) gb_bitmap_shader_ramp_set(shader, pixmap, i, colors[count - 1], colors[count - 1], 0);
+
+    // the transparent entry for the outside pixels of the border mode
+    shader->alphas[GB_BITMAP_SHADER_RAMP_SIZE]  = 0;
+    shader->pixels[GB_BITMAP_SHADER_RAMP_SIZE]  = 0;
+    shader->premuls[GB_BITMAP_SHADER_RAMP_SIZE] = 0;
+
+    // all colors are opaque?
+    shader->opaque = 1;
+    for (i = 0; i < GB_BITMAP_SHADER_RAMP_SIZE && shader->opaque; i++)
+        if (shader->alphas[i] != 0xff) shader->opaque = 0;
+}
+static gb_bitmap_shader_ref_t gb_bitmap_shader_init(gb_bitmap_device_ref_t device, tb_size_t type, tb_size_t mode, gb_gradient_ref_t gradient)
+{
+    // check
+    tb_assert_and_check_return_val(device && device->bitmap, tb_null);
+    tb_assert_and_check_return_val(!gradient || (gradient->colors && gradient->count), tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_bitmap_shader_ref_t  shader = tb_null;
+    do
+    {
+        // the opaque pixmap of the bitmap
+        tb_size_t       pixfmt = gb_bitmap_pixfmt(device->bitmap);
+        gb_pixmap_ref_t pixmap = gb_pixmap(pixfmt, 0xff);
+        tb_assert_and_check_break(pixmap);
+
+        // make shader
+        shader = tb_malloc0_type(gb_bitmap_shader_t);
+        tb_assert_and_check_break(shader);
+
+        // init base
+        shader->base.type   = (tb_uint8_t)type;
+        shader->base.mode   = (tb_uint8_t)mode;
+        shader->base.refn   = 1;
+        shader->base.exit   = gb_bitmap_shader_exit;
+        gb_matrix_clear(&shader->base.matrix);
+
+        // bake the color ramp once for all draws of this gradient
+        shader->pixfmt = (tb_uint16_t)pixfmt;
+        if (gradient) gb_bitmap_shader_ramp_make(shader, pixmap, gradient);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (shader) tb_free(shader);
+        shader = tb_null;
+    }
+
+    // ok?
+    return shader;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_shader_ref_t gb_bitmap_shader_init_linear(gb_bitmap_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
+{
+    // check
+    tb_assert_and_check_return_val(line, tb_null);
+
+    // the line, fixed
+    tb_fixed_t x0 = gb_float_to_fixed(line->p0.x);
+    tb_fixed_t y0 = gb_float_to_fixed(line->p0.y);
+    tb_hong_t  dx = (tb_hong_t)gb_float_to_fixed(line->p1.x) - x0;
+    tb_hong_t  dy = (tb_hong_t)gb_float_to_fixed(line->p1.y) - y0;
+
+    // the squared length of the line, fixed, the empty line has no gradient
+    tb_hong_t  d2 = (dx * dx + dy * dy) >> 16;
+    tb_assert_and_check_return_val(d2 > 0, tb_null);
+
+    // init shader
+    gb_bitmap_shader_ref_t shader = gb_bitmap_shader_init(device, GB_SHADER_TYPE_LINEAR, mode, gradient);
+    tb_check_return_val(shader, tb_null);
+
+    // init the gradient vector: t = (p - pb) . (pe - pb) / |pe - pb|^2
+    shader->u.linear.x0 = x0;
+    shader->u.linear.y0 = y0;
+    shader->u.linear.gx = (dx << 30) / d2;
+    shader->u.linear.gy = (dy << 30) / d2;
+
+    // ok
+    return (gb_shader_ref_t)shader;
+}
+gb_shader_ref_t gb_bitmap_shader_init_radial(gb_bitmap_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle)
+{
+    // check
+    tb_assert_and_check_return_val(circle && circle->r > 0, tb_null);
+
+    // init shader
+    gb_bitmap_shader_ref_t shader = gb_bitmap_shader_init(device, GB_SHADER_TYPE_RADIAL, mode, gradient);
+    tb_check_return_val(shader, tb_null);
+
+    // init the circle: t = |p - c| / r
+    shader->u.radial.x0 = gb_float_to_fixed(circle->c.x);
+    shader->u.radial.y0 = gb_float_to_fixed(circle->c.y);
+    shader->u.radial.r  = gb_float_to_fixed(circle->r);
+
+    // ok
+    return (gb_shader_ref_t)shader;
+}
+gb_shader_ref_t gb_bitmap_shader_init_bitmap(gb_bitmap_device_ref_t device, tb_size_t mode, gb_bitmap_ref_t bitmap)
+{
+    // check
+    tb_assert_and_check_return_val(bitmap && gb_bitmap_data(bitmap) && gb_bitmap_width(bitmap) && gb_bitmap_height(bitmap), tb_null);
+
+    // init shader
+    gb_bitmap_shader_ref_t shader = gb_bitmap_shader_init(device, GB_SHADER_TYPE_BITMAP, mode, tb_null);
+    tb_check_return_val(shader, tb_null);
+
+    // init the bitmap, the matrix maps the bitmap pixels to the canvas
+    shader->u.bitmap.bitmap = bitmap;
+
+    // ok
+    return (gb_shader_ref_t)shader;
+}
@@ -0,0 +1,163 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        shader.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_DEVICE_BITMAP_SHADER_H
+#define GB_CORE_DEVICE_BITMAP_SHADER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "device.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the entries count of the gradient color ramp
+ *
+ * the gradient parameter t is mapped to the entry: t * 256, 
+ * and the last extra entry is transparent for the outside pixels of the border mode
+ */
+#define GB_BITMAP_SHADER_RAMP_SIZE          (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bitmap linear gradient type
+typedef struct __gb_bitmap_shader_linear_t
+{
+    // the begin point, fixed
+    tb_fixed_t                      x0;
+    tb_fixed_t                      y0;
+
+    // the gradient vector: (xe - xb, ye - yb) / |pe - pb|^2, fixed30
+    tb_hong_t                       gx;
+    tb_hong_t                       gy;
+
+}gb_bitmap_shader_linear_t;
+
+// the bitmap radial gradient type
+typedef struct __gb_bitmap_shader_radial_t
+{
+    // the center, fixed
+    tb_fixed_t                      x0;
+    tb_fixed_t                      y0;
+
+    // the radius, fixed
+    tb_fixed_t                      r;
+
+}gb_bitmap_shader_radial_t;
+
+// the bitmap pattern type
+typedef struct __gb_bitmap_shader_bitmap_t
+{
+    // the bitmap, it must be alive until the shader is exited
+    gb_bitmap_ref_t                 bitmap;
+
+}gb_bitmap_shader_bitmap_t;
+
+// the bitmap shader type
+typedef struct __gb_bitmap_shader_t
+{
+    // the base
+    gb_shader_impl_t                base;
+
+    // the geometry
+    union
+    {
+        // the linear gradient
+        gb_bitmap_shader_linear_t   linear;
+
+        // the radial gradient
+        gb_bitmap_shader_radial_t   radial;
+
+        // the bitmap pattern
+        gb_bitmap_shader_bitmap_t   bitmap;
+
+    }u;
+
+    // the pixfmt of the ramp pixels
+    tb_uint16_t                     pixfmt;
+
+    // all colors of the ramp are opaque? only for the gradient
+    tb_uint8_t                      opaque;
+
+    // the alphas of the ramp
+    tb_byte_t                       alphas[GB_BITMAP_SHADER_RAMP_SIZE + 1];
+
+    // the opaque pixels of the ramp for the pixmap
+    gb_pixel_t                      pixels[GB_BITMAP_SHADER_RAMP_SIZE + 1];
+
+    // the premultiplied pixels of the ramp with the byte order of the bitmap data, only for the 32-bits pixfmt
+    tb_uint32_t                     premuls[GB_BITMAP_SHADER_RAMP_SIZE + 1];
+
+}gb_bitmap_shader_t, *gb_bitmap_shader_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface
+ */
+
+/* init bitmap linear gradient shader
+ *
+ * @param device    the device
+ * @param mode      the mode 
+ * @param gradient  the gradient
+ * @param line      the line
+ *
+ * @return          the shader
+ */
+gb_shader_ref_t     gb_bitmap_shader_init_linear(gb_bitmap_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line);
+
+/* init bitmap radial gradient shader
+ *
+ * @param device    the device
+ * @param mode      the mode 
+ * @param gradient  the gradient
+ * @param circle    the circle
+ *
+ * @return          the shader
+ */
+gb_shader_ref_t     gb_bitmap_shader_init_radial(gb_bitmap_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle);
+
+/* init bitmap pattern shader
+ *
+ * @param device    the device
+ * @param mode      the mode 
+ * @param bitmap    the bitmap
+ *
+ * @return          the shader
+ */
+gb_shader_ref_t     gb_bitmap_shader_init_bitmap(gb_bitmap_device_ref_t device, tb_size_t mode, gb_bitmap_ref_t bitmap);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -0,0 +1,1176 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        bitmap_tiled.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "device_bitmap_tiled"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "bitmap/bitmap.h"
+#include "../impl/bounds.h"
+#include "../impl/clipper.h"
+#include "../impl/stroker.h"
+#include "../impl/lru_cache.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default tile size
+#ifdef __gb_small__
+#   define GB_DEVICE_BITMAP_TILED_TILE_SIZE         (128)
+#else
+#   define GB_DEVICE_BITMAP_TILED_TILE_SIZE         (256)
+#endif
+
+// the commands grow count
+#ifdef __gb_small__
+#   define GB_DEVICE_BITMAP_TILED_COMMANDS_GROW     (64)
+#else
+#   define GB_DEVICE_BITMAP_TILED_COMMANDS_GROW     (256)
+#endif
+
+// the command indices grow count of the tile
+#define GB_DEVICE_BITMAP_TILED_INDICES_GROW         (16)
+
+// the workers maxn
+#define GB_DEVICE_BITMAP_TILED_WORKERS_MAXN         (256)
+
+// the max items count of the recorded paths kept for the next frames
+#ifdef __gb_small__
+#   define GB_DEVICE_BITMAP_TILED_PATHS_MAXN        (256)
+#else
+#   define GB_DEVICE_BITMAP_TILED_PATHS_MAXN        (1024)
+#endif
+
+// the max bytes of the recorded paths kept for the next frames
+#ifdef __gb_small__
+#   define GB_DEVICE_BITMAP_TILED_PATHS_SIZE        (512 * 1024)
+#else
+#   define GB_DEVICE_BITMAP_TILED_PATHS_SIZE        (4 * 1024 * 1024)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the tiled command type enum
+typedef enum __gb_bitmap_tiled_command_type_e
+{
+    GB_BITMAP_TILED_COMMAND_TYPE_NONE       = 0
+,   GB_BITMAP_TILED_COMMAND_TYPE_CLEAR      = 1
+,   GB_BITMAP_TILED_COMMAND_TYPE_PATH       = 2
+,   GB_BITMAP_TILED_COMMAND_TYPE_LINES      = 3
+,   GB_BITMAP_TILED_COMMAND_TYPE_POINTS     = 4
+,   GB_BITMAP_TILED_COMMAND_TYPE_POLYGON    = 5
+
+}gb_bitmap_tiled_command_type_e;
+
+// the recorded path key type
+typedef struct __gb_bitmap_tiled_path_key_t
+{
+    // the path generation
+    tb_size_t                       generation;
+
+    // the flattening level for the matrix
+    tb_long_t                       level;
+
+    // the stroke width, zero for the copied path
+    gb_float_t                      width;
+
+    // the stroke miter limit
+    gb_float_t                      miter;
+
+    // the stroke cap
+    tb_uint16_t                     cap;
+
+    // the stroke join
+    tb_uint16_t                     join;
+
+}gb_bitmap_tiled_path_key_t, *gb_bitmap_tiled_path_key_ref_t;
+
+/* the recorded path type
+ *
+ * the copied path or the stroked outline of the drawn path,
+ * it is immutable and is referenced by the commands of the same path in this frame and the next frames
+ */
+typedef struct __gb_bitmap_tiled_path_t
+{
+    // the lru cache item, must be the first member
+    gb_lru_cache_item_t             base;
+
+    // the key
+    gb_bitmap_tiled_path_key_t      key;
+
+    // the path
+    gb_path_ref_t                   path;
+
+}gb_bitmap_tiled_path_t, *gb_bitmap_tiled_path_ref_t;
+
+/* the tiled command type
+ *
+ * the paint, clipper and points will be reused by the next frame after flushing,
+ * the paths are referenced from the recorded paths of the device
+ */
+typedef struct __gb_bitmap_tiled_command_t
+{
+    // the type
+    tb_size_t                       type;
+
+    // the clear color
+    gb_color_t                      color;
+
+    // the paint
+    gb_paint_ref_t                  paint;
+
+    // the matrix
+    gb_matrix_t                     matrix;
+
+    // the clipper, only valid if has_clipper is true
+    gb_clipper_ref_t                clipper;
+
+    // have clipper?
+    tb_bool_t                       has_clipper;
+
+    // the recorded path, or the stroked outline if it is only stroked
+    gb_path_ref_t                   path;
+
+    // the recorded stroked outline, it will be filled directly by the workers
+    gb_path_ref_t                   stroked;
+
+    // the points
+    gb_point_ref_t                  points;
+
+    // the points count
+    tb_size_t                       points_count;
+
+    // the points maxn
+    tb_size_t                       points_maxn;
+
+    // the polygon counts
+    tb_uint32_t*                    counts;
+
+    // the polygon counts maxn
+    tb_size_t                       counts_maxn;
+
+    // the polygon is convex?
+    tb_bool_t                       convex;
+
+    // have hint?
+    tb_bool_t                       has_hint;
+
+    // have bounds?
+    tb_bool_t                       has_bounds;
+
+    // the hint
+    gb_shape_t                      hint;
+
+    // the bounds
+    gb_rect_t                       bounds;
+
+}gb_bitmap_tiled_command_t, *gb_bitmap_tiled_command_ref_t;
+
+// the tile type
+typedef struct __gb_bitmap_tiled_tile_t
+{
+    // the clip
+    gb_bitmap_biltter_clip_t        clip;
+
+    // the command indices
+    tb_uint32_t*                    indices;
+
+    // the command indices count
+    tb_size_t                       indices_count;
+
+    // the command indices maxn
+    tb_size_t                       indices_maxn;
+
+}gb_bitmap_tiled_tile_t, *gb_bitmap_tiled_tile_ref_t;
+
+// the tiled worker type
+typedef struct __gb_bitmap_tiled_worker_t
+{
+    // the device
+    struct __gb_bitmap_tiled_device_t*  device;
+
+    // the bitmap device for rendering tiles, have the own raster, stroker and biltter
+    gb_device_ref_t                 bitmap;
+
+    // the paint, the recorded paint will be copied to it because rendering may modify it
+    gb_paint_ref_t                  paint;
+
+}gb_bitmap_tiled_worker_t, *gb_bitmap_tiled_worker_ref_t;
+
+// the tiled bitmap device type
+typedef struct __gb_bitmap_tiled_device_t
+{
+    // the base
+    gb_device_impl_t                base;
+
+    // the bitmap
+    gb_bitmap_ref_t                 bitmap;
+
+    // the pixmap
+    gb_pixmap_ref_t                 pixmap;
+
+    // the tile size
+    tb_size_t                       tile;
+
+    // the tiles
+    gb_bitmap_tiled_tile_ref_t      tiles;
+
+    // the tiles count for x-coordinate
+    tb_size_t                       tiles_x;
+
+    // the tiles count for y-coordinate
+    tb_size_t                       tiles_y;
+
+    // the commands
+    gb_bitmap_tiled_command_ref_t   commands;
+
+    // the commands count
+    tb_size_t                       commands_count;
+
+    // the commands maxn
+    tb_size_t                       commands_maxn;
+
+    // the workers
+    gb_bitmap_tiled_worker_ref_t    workers;
+
+    // the workers count
+    tb_size_t                       workers_count;
+
+    // the thread pool
+    tb_thread_pool_ref_t            pool;
+
+    // the semaphore for waiting the workers
+    tb_semaphore_ref_t              semaphore;
+
+    // the next tile index for the workers
+    tb_atomic_t                     next;
+
+    // the stroker for recording the stroked outlines
+    gb_stroker_ref_t                stroker;
+
+    /* the recorded paths, keyed by the path generation, level and stroke
+     *
+     * they are not removed before flushing because the commands reference them
+     */
+    gb_lru_cache_t                  paths;
+
+    // the damaged rects of the current frame, aligned to the tiles
+    gb_damage_t                     damage;
+
+}gb_bitmap_tiled_device_t, *gb_bitmap_tiled_device_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_device_bitmap_tiled_tiles_exit(gb_bitmap_tiled_device_ref_t impl)
+{
+    // check
+    tb_assert(impl);
+
+    // exit tiles
+    if (impl->tiles)
+    {
+        tb_size_t i = 0;
+        tb_size_t n = impl->tiles_x * impl->tiles_y;
+        for (i = 0; i < n; i++)
+        {
+            if (impl->tiles[i].indices) tb_free(impl->tiles[i].indices);
+        }
+        tb_free(impl->tiles);
+    }
+    impl->tiles     = tb_null;
+    impl->tiles_x   = 0;
+    impl->tiles_y   = 0;
+}
+static tb_bool_t gb_device_bitmap_tiled_tiles_init(gb_bitmap_tiled_device_ref_t impl)
+{
+    // check
+    tb_assert(impl && impl->bitmap && impl->tile);
+
+    // exit the previous tiles
+    gb_device_bitmap_tiled_tiles_exit(impl);
+
+    // the width and height
+    tb_size_t width     = gb_bitmap_width(impl->bitmap);
+    tb_size_t height    = gb_bitmap_height(impl->bitmap);
+    tb_assert_and_check_return_val(width && height, tb_false);
+
+    // make tiles
+    tb_size_t tiles_x   = (width + impl->tile - 1) / impl->tile;
+    tb_size_t tiles_y   = (height + impl->tile - 1) / impl->tile;
+    impl->tiles = tb_nalloc0_type(tiles_x * tiles_y, gb_bitmap_tiled_tile_t);
+    tb_assert_and_check_return_val(impl->tiles, tb_false);
+
+    // init tiles
+    tb_size_t x = 0;
+    tb_size_t y = 0;
+    gb_bitmap_tiled_tile_ref_t tile = impl->tiles;
+    for (y = 0; y < tiles_y; y++)
+    {
+        for (x = 0; x < tiles_x; x++, tile++)
+        {
+            tile->clip.left     = x * impl->tile;
+            tile->clip.top      = y * impl->tile;
+            tile->clip.right    = tb_min((x + 1) * impl->tile, width);
+            tile->clip.bottom   = tb_min((y + 1) * impl->tile, height);
+        }
+    }
+    impl->tiles_x = tiles_x;
+    impl->tiles_y = tiles_y;
+
+    // ok
+    return tb_true;
+}
+static gb_bitmap_tiled_command_ref_t gb_device_bitmap_tiled_command_make(gb_bitmap_tiled_device_ref_t impl, tb_size_t type)
+{
+    // check
+    tb_assert(impl && impl->base.paint && impl->base.matrix);
+
+    // grow commands
+    if (impl->commands_count == impl->commands_maxn)
+    {
+        // the new maxn
+        tb_size_t maxn = impl->commands_maxn + GB_DEVICE_BITMAP_TILED_COMMANDS_GROW;
+        tb_assert_and_check_return_val(maxn <= TB_MAXU32, tb_null);
+
+        // grow it
+        impl->commands = (gb_bitmap_tiled_command_ref_t)tb_ralloc(impl->commands, maxn * sizeof(gb_bitmap_tiled_command_t));
+        tb_assert_and_check_return_val(impl->commands, tb_null);
+
+        // clear the new commands
+        tb_memset(impl->commands + impl->commands_maxn, 0, GB_DEVICE_BITMAP_TILED_COMMANDS_GROW * sizeof(gb_bitmap_tiled_command_t));
+        impl->commands_maxn = maxn;
+    }
+
+    // the command
+    gb_bitmap_tiled_command_ref_t command = impl->commands + impl->commands_count;
+
+    // init paint
+    if (!command->paint) command->paint = gb_paint_init();
+    tb_assert_and_check_return_val(command->paint, tb_null);
+
+    // save paint and matrix
+    gb_paint_copy(command->paint, impl->base.paint);
+    command->matrix         = *impl->base.matrix;
+
+    // save clipper
+    command->has_clipper    = tb_false;
+    if (impl->base.clipper && gb_clipper_size(impl->base.clipper))
+    {
+        // init clipper
+        if (!command->clipper) command->clipper = gb_clipper_init();
+        tb_assert_and_check_return_val(command->clipper, tb_null);
+
+        // copy it
+        gb_clipper_copy(command->clipper, impl->base.clipper);
+        command->has_clipper = tb_true;
+    }
+
+    // init it
+    command->type           = type;
+    command->points_count   = 0;
+    command->has_hint       = tb_false;
+    command->has_bounds     = tb_false;
+
+    // ok
+    return command;
+}
+static tb_bool_t gb_device_bitmap_tiled_command_save_points(gb_bitmap_tiled_command_ref_t command, gb_point_ref_t points, tb_size_t count)
+{
+    // check
+    tb_assert(command && points && count);
+
+    // grow points
+    if (count > command->points_maxn)
+    {
+        command->points = (gb_point_ref_t)tb_ralloc(command->points, count * sizeof(gb_point_t));
+        tb_assert_and_check_return_val(command->points, tb_false);
+        command->points_maxn = count;
+    }
+
+    // save points
+    tb_memcpy(command->points, points, count * sizeof(gb_point_t));
+    command->points_count = count;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_device_bitmap_tiled_command_save_bounds(gb_bitmap_tiled_command_ref_t command, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(command);
+
+    // save bounds
+    if (bounds)
+    {
+        command->bounds     = *bounds;
+        command->has_bounds = tb_true;
+    }
+}
+static tb_void_t gb_device_bitmap_tiled_command_exit(gb_bitmap_tiled_command_ref_t command)
+{
+    // check
+    tb_assert(command);
+
+    // exit paint
+    if (command->paint) gb_paint_exit(command->paint);
+    command->paint = tb_null;
+
+    // exit clipper
+    if (command->clipper) gb_clipper_exit(command->clipper);
+    command->clipper = tb_null;
+
+    // exit points
+    if (command->points) tb_free(command->points);
+    command->points = tb_null;
+
+    // exit counts
+    if (command->counts) tb_free(command->counts);
+    command->counts = tb_null;
+}
+static tb_size_t gb_device_bitmap_tiled_path_hash(tb_cpointer_t data)
+{
+    // the generation is unique for each path, the copied path and the strokes are only compared in the bucket
+    gb_bitmap_tiled_path_key_ref_t key = (gb_bitmap_tiled_path_key_ref_t)data;
+    return (key->generation * 31 + (tb_size_t)key->level) * 31 + ((tb_size_t)key->cap << 8 | key->join);
+}
+static tb_void_t gb_device_bitmap_tiled_path_exit(gb_lru_cache_ref_t lru, gb_lru_cache_item_ref_t base)
+{
+    // check
+    gb_bitmap_tiled_path_ref_t item = (gb_bitmap_tiled_path_ref_t)base;
+    tb_assert(lru && item);
+
+    // exit path
+    if (item->path) gb_path_exit(item->path);
+    item->path = tb_null;
+
+    // exit it
+    tb_free(item);
+}
+static gb_path_ref_t gb_device_bitmap_tiled_path_record(gb_bitmap_tiled_device_ref_t impl, gb_bitmap_tiled_command_ref_t command, gb_path_ref_t path, tb_bool_t stroked)
+{
+    // check
+    tb_assert(impl && impl->stroker && command && command->paint && path);
+
+    // make key, the padding bytes will be compared
+    gb_bitmap_tiled_path_key_t key;
+    tb_memset(&key, 0, sizeof(gb_bitmap_tiled_path_key_t));
+    key.generation = gb_path_generation(path);
+    if (stroked)
+    {
+        // the outline may have curves even if the path has no curve, e.g. the round joins
+        key.level   = gb_path_polygon_level(&command->matrix);
+        key.width   = gb_paint_stroke_width(command->paint);
+        key.miter   = gb_paint_stroke_miter(command->paint);
+        key.cap     = (tb_uint16_t)gb_paint_stroke_cap(command->paint);
+        key.join    = (tb_uint16_t)gb_paint_stroke_join(command->paint);
+    }
+    else key.level = gb_path_polygon2_level(path, &command->matrix);
+
+    // recorded? reference it
+    gb_bitmap_tiled_path_ref_t item = (gb_bitmap_tiled_path_ref_t)gb_lru_cache_get(&impl->paths, &key, tb_true);
+    tb_check_return_val(!item, item->path);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // make item
+        item = tb_malloc0_type(gb_bitmap_tiled_path_t);
+        tb_assert_and_check_break(item);
+
+        // init item
+        item->key   = key;
+        item->path  = gb_path_init();
+        tb_assert_and_check_break(item->path);
+
+        // copy the path or stroke it
+        if (stroked)
+        {
+            gb_path_ref_t outline = gb_stroker_done_path(impl->stroker, command->paint, path);
+            tb_assert_and_check_break(outline);
+
+            gb_path_copy(item->path, outline);
+        }
+        else gb_path_copy(item->path, path);
+
+        /* make the cached hint, bounds, convex, polygon (for this level) and generation of the path now
+         *
+         * because the path will be read concurrently by the workers
+         */
+        gb_path_hint(item->path);
+        gb_path_bounds(item->path);
+        gb_path_convex(item->path);
+        gb_path_polygon2(item->path, &command->matrix);
+        gb_path_generation(item->path);
+
+        // insert it with the size of the items, code + points, and the polygons
+        item->base.size = tb_iterator_size(item->path) * (sizeof(tb_uint8_t) + 3 * sizeof(gb_point_t)) + gb_path_polygon_cache_size(item->path) + 256;
+        if (!gb_lru_cache_insert(&impl->paths, &item->base)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (item) gb_device_bitmap_tiled_path_exit(&impl->paths, &item->base);
+        item = tb_null;
+    }
+
+    // ok?
+    return item? item->path : tb_null;
+}
+static tb_void_t gb_device_bitmap_tiled_command_bin(gb_bitmap_tiled_device_ref_t impl, gb_bitmap_tiled_command_ref_t command, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(impl && impl->tiles && command && impl->commands_count < impl->commands_maxn);
+
+    // the tile range
+    tb_long_t tx0 = 0;
+    tb_long_t ty0 = 0;
+    tb_long_t tx1 = (tb_long_t)impl->tiles_x - 1;
+    tb_long_t ty1 = (tb_long_t)impl->tiles_y - 1;
+    if (bounds)
+    {
+        // apply matrix to bounds
+        gb_rect_t  device_bounds;
+        gb_point_t pt[4];
+        gb_point_make(&pt[0], bounds->x, bounds->y);
+        gb_point_make(&pt[1], bounds->x, bounds->y + bounds->h);
+        gb_point_make(&pt[2], bounds->x + bounds->w, bounds->y + bounds->h);
+        gb_point_make(&pt[3], bounds->x + bounds->w, bounds->y);
+        gb_matrix_apply_points(&command->matrix, pt, tb_arrayn(pt));
+        gb_bounds_make(&device_bounds, pt, tb_arrayn(pt));
+
+        /* the margin of the device bounds
+         *
+         * it will be larger than the real margin because the command will be clipped by the tile, 
+         * the pixels will be only lost if it is smaller
+         */
+        tb_long_t margin = 2;
+        if (gb_paint_mode(command->paint) & GB_PAINT_MODE_STROKE)
+        {
+            // the max scale of the matrix 
+            gb_float_t scale = gb_abs(command->matrix.sx) + gb_abs(command->matrix.kx) + gb_abs(command->matrix.ky) + gb_abs(command->matrix.sy);
+
+            // the max extension of the join and cap
+            gb_float_t miter = gb_paint_stroke_miter(command->paint);
+            if (gb_paint_stroke_join(command->paint) != GB_PAINT_STROKE_JOIN_MITER || miter < GB_TWO) miter = GB_TWO;
+
+            // the stroke margin
+            margin += gb_ceil(gb_mul(gb_mul(gb_paint_stroke_width(command->paint), scale), miter));
+        }
+
+        // the tile range
+        tx0 = (gb_floor(device_bounds.x) - margin) / (tb_long_t)impl->tile;
+        ty0 = (gb_floor(device_bounds.y) - margin) / (tb_long_t)impl->tile;
+        tx1 = (gb_ceil(device_bounds.x + device_bounds.w) + margin) / (tb_long_t)impl->tile;
+        ty1 = (gb_ceil(device_bounds.y + device_bounds.h) + margin) / (tb_long_t)impl->tile;
+
+        // outside? ignore it
+        tb_check_return(tx1 >= 0 && ty1 >= 0 && tx0 < (tb_long_t)impl->tiles_x && ty0 < (tb_long_t)impl->tiles_y);
+
+        // clip the tile range
+        tx0 = tb_max(tx0, 0);
+        ty0 = tb_max(ty0, 0);
+        tx1 = tb_min(tx1, (tb_long_t)impl->tiles_x - 1);
+        ty1 = tb_min(ty1, (tb_long_t)impl->tiles_y - 1);
+    }
+
+    // clip the tile range by the clipped region
+    gb_region_ref_t region = command->has_clipper? gb_clipper_region(command->clipper) : tb_null;
+    if (region)
+    {
+        // empty? ignore it
+        tb_check_return(!gb_region_is_empty(region));
+
+        // the tile range of the region
+        tx0 = tb_max(tx0, region->left / (tb_long_t)impl->tile);
+        ty0 = tb_max(ty0, region->top / (tb_long_t)impl->tile);
+        tx1 = tb_min(tx1, (region->right - 1) / (tb_long_t)impl->tile);
+        ty1 = tb_min(ty1, (region->bottom - 1) / (tb_long_t)impl->tile);
+
+        // outside? ignore it
+        tb_check_return(tx0 <= tx1 && ty0 <= ty1);
+    }
+
+    // the pixels of the binned tiles will be damaged
+    tb_long_t size = (tb_long_t)impl->tile;
+    gb_damage_add(&impl->damage, tx0 * size, ty0 * size, tb_min((tx1 + 1) * size, (tb_long_t)gb_bitmap_width(impl->bitmap)), tb_min((ty1 + 1) * size, (tb_long_t)gb_bitmap_height(impl->bitmap)));
+
+    // append the command index to the tiles
+    tb_long_t   x = 0;
+    tb_long_t   y = 0;
+    tb_uint32_t index = (tb_uint32_t)impl->commands_count;
+    for (y = ty0; y <= ty1; y++)
+    {
+        gb_bitmap_tiled_tile_ref_t tile = impl->tiles + y * impl->tiles_x + tx0;
+        for (x = tx0; x <= tx1; x++, tile++)
+        {
+            // grow indices
+            if (tile->indices_count == tile->indices_maxn)
+            {
+                tile->indices_maxn += GB_DEVICE_BITMAP_TILED_INDICES_GROW + (tile->indices_maxn >> 1);
+                tile->indices = (tb_uint32_t*)tb_ralloc(tile->indices, tile->indices_maxn * sizeof(tb_uint32_t));
+                tb_assert_and_check_return(tile->indices);
+            }
+
+            // append it
+            tile->indices[tile->indices_count++] = index;
+        }
+    }
+
+    // save the command
+    impl->commands_count++;
+}
+static tb_void_t gb_device_bitmap_tiled_render_clear(gb_bitmap_tiled_device_ref_t impl, gb_bitmap_tiled_tile_ref_t tile, gb_color_t color)
+{
+    // check
+    tb_assert(impl && impl->pixmap && impl->pixmap->pixel && impl->pixmap->pixels_fill && tile);
+
+    // the pixels data
+    tb_byte_t* pixels = (tb_byte_t*)gb_bitmap_data(impl->bitmap);
+    tb_assert(pixels);
+
+    // the row bytes
+    tb_size_t row_bytes = gb_bitmap_row_bytes(impl->bitmap);
+
+    // the pixel
+    gb_pixel_t pixel = impl->pixmap->pixel(color);
+
+    // clear the rows of the tile
+    tb_long_t   y = 0;
+    tb_size_t   n = tile->clip.right - tile->clip.left;
+    tb_byte_t*  p = pixels + tile->clip.top * row_bytes + tile->clip.left * impl->pixmap->btp;
+    for (y = tile->clip.top; y < tile->clip.bottom; y++, p += row_bytes)
+        impl->pixmap->pixels_fill(p, pixel, n, 0xff);
+}
+static tb_void_t gb_device_bitmap_tiled_render_tile(gb_bitmap_tiled_worker_ref_t worker, gb_bitmap_tiled_tile_ref_t tile)
+{
+    // check
+    tb_assert(worker && worker->device && worker->bitmap && worker->paint && tile);
+
+    // the device
+    gb_bitmap_tiled_device_ref_t impl = worker->device;
+
+    // clip the bitmap device to the tile, only the scan-lines of the tile will be rastered
+    gb_bitmap_device_ref_t bitmap = (gb_bitmap_device_ref_t)worker->bitmap;
+    bitmap->clip = &tile->clip;
+
+    // bind paint
+    gb_device_bind_paint(worker->bitmap, worker->paint);
+
+    // done commands
+    tb_size_t i = 0;
+    for (i = 0; i < tile->indices_count; i++)
+    {
+        // the command
+        gb_bitmap_tiled_command_ref_t command = impl->commands + tile->indices[i];
+
+        // clear it?
+        if (command->type == GB_BITMAP_TILED_COMMAND_TYPE_CLEAR)
+        {
+            // clipped? clear the clipped pixels of the tile by the bitmap device
+            if (command->has_clipper)
+            {
+                gb_device_bind_clipper(worker->bitmap, command->clipper);
+                gb_device_draw_clear(worker->bitmap, command->color);
+            }
+            else gb_device_bitmap_tiled_render_clear(impl, tile, command->color);
+            continue ;
+        }
+
+        // copy paint and bind matrix and clipper
+        gb_paint_copy(worker->paint, command->paint);
+        gb_device_bind_matrix(worker->bitmap, &command->matrix);
+        gb_device_bind_clipper(worker->bitmap, command->has_clipper? command->clipper : tb_null);
+
+        // done it
+        switch (command->type)
+        {
+        case GB_BITMAP_TILED_COMMAND_TYPE_PATH:
+            bitmap->stroked = command->stroked;
+            gb_device_draw_path(worker->bitmap, command->path);
+            bitmap->stroked = tb_null;
+            break;
+        case GB_BITMAP_TILED_COMMAND_TYPE_LINES:
+            gb_device_draw_lines(worker->bitmap, command->points, command->points_count, command->has_bounds? &command->bounds : tb_null);
+            break;
+        case GB_BITMAP_TILED_COMMAND_TYPE_POINTS:
+            gb_device_draw_points(worker->bitmap, command->points, command->points_count, command->has_bounds? &command->bounds : tb_null);
+            break;
+        case GB_BITMAP_TILED_COMMAND_TYPE_POLYGON:
+            {
+                gb_polygon_t polygon = {command->points, command->counts, command->convex};
+                gb_device_draw_polygon(worker->bitmap, &polygon, command->has_hint? &command->hint : tb_null, command->has_bounds? &command->bounds : tb_null);
+            }
+            break;
+        default:
+            tb_assert(0);
+            break;
+        }
+    }
+
+    // clear the tile commands
+    tile->indices_count = 0;
+}
+static tb_void_t gb_device_bitmap_tiled_worker_done(gb_bitmap_tiled_worker_ref_t worker)
+{
+    // check
+    tb_assert(worker && worker->device);
+
+    // the device
+    gb_bitmap_tiled_device_ref_t impl = worker->device;
+
+    // the tiles count
+    tb_size_t count = impl->tiles_x * impl->tiles_y;
+
+    // take the next tile until all tiles have been rendered, so the faster workers will do more tiles
+    tb_size_t index = 0;
+    while ((index = (tb_size_t)tb_atomic_fetch_and_inc(&impl->next)) < count)
+    {
+        // the tile
+        gb_bitmap_tiled_tile_ref_t tile = impl->tiles + index;
+
+        // render it
+        if (tile->indices_count) gb_device_bitmap_tiled_render_tile(worker, tile);
+    }
+}
+static tb_void_t gb_device_bitmap_tiled_worker_task(tb_thread_pool_worker_ref_t pool_worker, tb_cpointer_t priv)
+{
+    // check
+    gb_bitmap_tiled_worker_ref_t worker = (gb_bitmap_tiled_worker_ref_t)priv;
+    tb_assert(worker && worker->device && worker->device->semaphore);
+
+    // done worker
+    gb_device_bitmap_tiled_worker_done(worker);
+
+    // notify the flushing thread
+    tb_semaphore_post(worker->device->semaphore, 1);
+}
+static tb_void_t gb_device_bitmap_tiled_flush(gb_device_impl_t* device)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->workers && impl->workers_count);
+
+    // no commands?
+    tb_check_return(impl->commands_count);
+
+    // reset the next tile
+    tb_atomic_set(&impl->next, 0);
+
+    // post the other workers to the thread pool
+    tb_size_t i = 0;
+    tb_size_t posted = 0;
+    for (i = 1; i < impl->workers_count; i++)
+    {
+        if (tb_thread_pool_task_post(impl->pool, "bitmap_tiled", gb_device_bitmap_tiled_worker_task, tb_null, impl->workers + i, tb_false)) 
+            posted++;
+    }
+
+    // done the first worker in the current thread
+    gb_device_bitmap_tiled_worker_done(impl->workers);
+
+    // wait the other workers
+    while (posted)
+    {
+        tb_long_t wait = tb_semaphore_wait(impl->semaphore, -1);
+        tb_assert_and_check_break(wait >= 0);
+        if (wait > 0) posted--;
+    }
+
+    // clear commands
+    impl->commands_count = 0;
+
+    // remove the least recently used paths over the limit, they are no longer referenced
+    gb_lru_cache_trim(&impl->paths, GB_DEVICE_BITMAP_TILED_PATHS_MAXN, GB_DEVICE_BITMAP_TILED_PATHS_SIZE);
+}
+static tb_void_t gb_device_bitmap_tiled_resize(gb_device_impl_t* device, tb_size_t width, tb_size_t height)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->bitmap);
+
+    // flush the previous commands
+    gb_device_bitmap_tiled_flush(device);
+
+    // resize
+    gb_bitmap_resize(impl->bitmap, width, height);
+
+    // remake tiles
+    if (!gb_device_bitmap_tiled_tiles_init(impl))
+    {
+        // trace
+        tb_trace_e("resize tiles failed!");
+    }
+}
+static tb_void_t gb_device_bitmap_tiled_draw_clear(gb_device_impl_t* device, gb_color_t color)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->tiles);
+
+    // discard the previous commands if nothing is clipped, they will be covered
+    if (!impl->base.clipper || !gb_clipper_size(impl->base.clipper))
+    {
+        tb_size_t i = 0;
+        tb_size_t n = impl->tiles_x * impl->tiles_y;
+        for (i = 0; i < n; i++) impl->tiles[i].indices_count = 0;
+        impl->commands_count = 0;
+    }
+
+    // make command
+    gb_bitmap_tiled_command_ref_t command = gb_device_bitmap_tiled_command_make(impl, GB_BITMAP_TILED_COMMAND_TYPE_CLEAR);
+    tb_assert_and_check_return(command);
+
+    // save color
+    command->color = color;
+
+    // bin it to all tiles in the clipped region
+    gb_device_bitmap_tiled_command_bin(impl, command, tb_null);
+}
+static tb_void_t gb_device_bitmap_tiled_draw_lines(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return(impl && points && count);
+
+    // make command
+    gb_bitmap_tiled_command_ref_t command = gb_device_bitmap_tiled_command_make(impl, GB_BITMAP_TILED_COMMAND_TYPE_LINES);
+    tb_assert_and_check_return(command);
+
+    // save points and bounds
+    if (!gb_device_bitmap_tiled_command_save_points(command, points, count)) return ;
+    gb_device_bitmap_tiled_command_save_bounds(command, bounds);
+
+    // bin it
+    gb_rect_t points_bounds;
+    if (!bounds) gb_bounds_make(&points_bounds, points, count);
+    gb_device_bitmap_tiled_command_bin(impl, command, bounds? bounds : &points_bounds);
+}
+static tb_void_t gb_device_bitmap_tiled_draw_points(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return(impl && points && count);
+
+    // make command
+    gb_bitmap_tiled_command_ref_t command = gb_device_bitmap_tiled_command_make(impl, GB_BITMAP_TILED_COMMAND_TYPE_POINTS);
+    tb_assert_and_check_return(command);
+
+    // save points and bounds
+    if (!gb_device_bitmap_tiled_command_save_points(command, points, count)) return ;
+    gb_device_bitmap_tiled_command_save_bounds(command, bounds);
+
+    // bin it
+    gb_rect_t points_bounds;
+    if (!bounds) gb_bounds_make(&points_bounds, points, count);
+    gb_device_bitmap_tiled_command_bin(impl, command, bounds? bounds : &points_bounds);
+}
+static tb_void_t gb_device_bitmap_tiled_draw_polygon(gb_device_impl_t* device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return(impl && polygon && polygon->points && polygon->counts);
+
+    // the points and contours count
+    tb_size_t       count = 0;
+    tb_size_t       contours = 0;
+    tb_uint32_t*    counts = polygon->counts;
+    while (*counts) 
+    {
+        count += *counts++;
+        contours++;
+    }
+    tb_check_return(count);
+
+    // make command
+    gb_bitmap_tiled_command_ref_t command = gb_device_bitmap_tiled_command_make(impl, GB_BITMAP_TILED_COMMAND_TYPE_POLYGON);
+    tb_assert_and_check_return(command);
+
+    // save points
+    if (!gb_device_bitmap_tiled_command_save_points(command, polygon->points, count)) return ;
+
+    // save counts
+    if (contours + 1 > command->counts_maxn)
+    {
+        command->counts = (tb_uint32_t*)tb_ralloc(command->counts, (contours + 1) * sizeof(tb_uint32_t));
+        tb_assert_and_check_return(command->counts);
+        command->counts_maxn = contours + 1;
+    }
+    tb_memcpy(command->counts, polygon->counts, (contours + 1) * sizeof(tb_uint32_t));
+    command->convex = polygon->convex;
+
+    // save hint
+    if (hint)
+    {
+        command->hint       = *hint;
+        command->has_hint   = tb_true;
+    }
+
+    // save bounds
+    gb_device_bitmap_tiled_command_save_bounds(command, bounds);
+
+    // bin it
+    gb_rect_t points_bounds;
+    if (!bounds) gb_bounds_make(&points_bounds, command->points, count);
+    gb_device_bitmap_tiled_command_bin(impl, command, bounds? bounds : &points_bounds);
+}
+static tb_void_t gb_device_bitmap_tiled_draw_path(gb_device_impl_t* device, gb_path_ref_t path)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return(impl && path);
+
+    // make command
+    gb_bitmap_tiled_command_ref_t command = gb_device_bitmap_tiled_command_make(impl, GB_BITMAP_TILED_COMMAND_TYPE_PATH);
+    tb_assert_and_check_return(command);
+
+    // stroke it?
+    tb_size_t   mode    = gb_paint_mode(command->paint);
+    gb_float_t  width   = gb_paint_stroke_width(command->paint);
+    tb_bool_t   stroke  = (mode & GB_PAINT_MODE_STROKE) && width > 0;
+
+    // only stroke it without the outline? same as the bitmap render
+    tb_bool_t   stroke_only = (     stroke
+                                &&  GB_ONE == width
+                                &&  GB_ONE == gb_abs(command->matrix.sx)
+                                &&  GB_ONE == gb_abs(command->matrix.sy)
+                                &&  !gb_paint_shader(command->paint))? tb_true : tb_false;
+
+    // record the stroked outline once, the workers will only fill it for each tile
+    command->stroked = tb_null;
+    if (stroke && !stroke_only)
+    {
+        command->stroked = gb_device_bitmap_tiled_path_record(impl, command, path, tb_true);
+        tb_check_return(command->stroked);
+    }
+
+    // record the path if it will be filled, otherwise the outline is enough for the workers
+    command->path = ((mode & GB_PAINT_MODE_FILL) || stroke_only)? gb_device_bitmap_tiled_path_record(impl, command, path, tb_false) : command->stroked;
+    tb_check_return(command->path);
+
+    // bin it
+    gb_device_bitmap_tiled_command_bin(impl, command, gb_path_bounds(path));
+}
+static gb_shader_ref_t gb_device_bitmap_tiled_shader_linear(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && impl->workers && impl->workers->bitmap, tb_null);
+
+    // init shader from the bitmap device
+    return ((gb_device_impl_t*)impl->workers->bitmap)->shader_linear((gb_device_impl_t*)impl->workers->bitmap, mode, gradient, line);
+}
+static gb_shader_ref_t gb_device_bitmap_tiled_shader_radial(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && impl->workers && impl->workers->bitmap, tb_null);
+
+    // init shader from the bitmap device
+    return ((gb_device_impl_t*)impl->workers->bitmap)->shader_radial((gb_device_impl_t*)impl->workers->bitmap, mode, gradient, circle);
+}
+static gb_shader_ref_t gb_device_bitmap_tiled_shader_bitmap(gb_device_impl_t* device, tb_size_t mode, gb_bitmap_ref_t bitmap)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && impl->workers && impl->workers->bitmap, tb_null);
+
+    // init shader from the bitmap device
+    return ((gb_device_impl_t*)impl->workers->bitmap)->shader_bitmap((gb_device_impl_t*)impl->workers->bitmap, mode, bitmap);
+}
+static tb_void_t gb_device_bitmap_tiled_exit(gb_device_impl_t* device)
+{
+    // check
+    gb_bitmap_tiled_device_ref_t impl = (gb_bitmap_tiled_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // exit thread pool
+    if (impl->pool) tb_thread_pool_exit(impl->pool);
+    impl->pool = tb_null;
+
+    // exit semaphore
+    if (impl->semaphore) tb_semaphore_exit(impl->semaphore);
+    impl->semaphore = tb_null;
+
+    // exit workers
+    if (impl->workers)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < impl->workers_count; i++)
+        {
+            gb_bitmap_tiled_worker_ref_t worker = impl->workers + i;
+            if (worker->bitmap) gb_device_exit(worker->bitmap);
+            if (worker->paint) gb_paint_exit(worker->paint);
+        }
+        tb_free(impl->workers);
+    }
+    impl->workers = tb_null;
+
+    // exit commands
+    if (impl->commands)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < impl->commands_maxn; i++) 
+            gb_device_bitmap_tiled_command_exit(impl->commands + i);
+        tb_free(impl->commands);
+    }
+    impl->commands = tb_null;
+
+    // exit the recorded paths
+    if (impl->paths.buckets) gb_lru_cache_exit(&impl->paths);
+
+    // exit stroker
+    if (impl->stroker) gb_stroker_exit(impl->stroker);
+    impl->stroker = tb_null;
+
+    // exit tiles
+    gb_device_bitmap_tiled_tiles_exit(impl);
+
+    // exit it
+    tb_free(impl);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_device_ref_t gb_device_init_bitmap_tiled(gb_bitmap_ref_t bitmap, tb_size_t tile, tb_size_t workers)
+{
+    // check
+    tb_assert_and_check_return_val(bitmap, tb_null);
+
+    // done
+    tb_bool_t                       ok = tb_false;
+    gb_bitmap_tiled_device_ref_t    impl = tb_null;
+    do
+    {
+        // the width and height
+        tb_size_t width     = gb_bitmap_width(bitmap);
+        tb_size_t height    = gb_bitmap_height(bitmap);
+        tb_assert_and_check_break(width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
+
+        // the tile size and workers count
+        if (!tile) tile = GB_DEVICE_BITMAP_TILED_TILE_SIZE;
+        if (!workers) workers = tb_processor_count();
+        if (!workers) workers = 1;
+        tb_assert_and_check_break(workers <= GB_DEVICE_BITMAP_TILED_WORKERS_MAXN);
+
+        // make device
+        impl = tb_malloc0_type(gb_bitmap_tiled_device_t);
+        tb_assert_and_check_break(impl);
+
+        // init base 
+        impl->base.type             = GB_DEVICE_TYPE_BITMAP;
+        impl->base.resize           = gb_device_bitmap_tiled_resize;
+        impl->base.flush            = gb_device_bitmap_tiled_flush;
+        impl->base.draw_clear       = gb_device_bitmap_tiled_draw_clear;
+        impl->base.draw_path        = gb_device_bitmap_tiled_draw_path;
+        impl->base.draw_lines       = gb_device_bitmap_tiled_draw_lines;
+        impl->base.draw_points      = gb_device_bitmap_tiled_draw_points;
+        impl->base.draw_polygon     = gb_device_bitmap_tiled_draw_polygon;
+        impl->base.shader_linear    = gb_device_bitmap_tiled_shader_linear;
+        impl->base.shader_radial    = gb_device_bitmap_tiled_shader_radial;
+        impl->base.shader_bitmap    = gb_device_bitmap_tiled_shader_bitmap;
+        impl->base.exit             = gb_device_bitmap_tiled_exit;
+
+        // init bitmap
+        impl->bitmap = bitmap;
+        impl->tile   = tile;
+
+        // init damage
+        impl->base.damage = &impl->damage;
+
+        // init pixmap
+        impl->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
+        tb_assert_and_check_break(impl->pixmap);
+
+        // init tiles
+        if (!gb_device_bitmap_tiled_tiles_init(impl)) break;
+
+        // init stroker
+        impl->stroker = gb_stroker_init();
+        tb_assert_and_check_break(impl->stroker);
+
+        // init the recorded paths, no limit before flushing
+        if (!gb_lru_cache_init(&impl->paths, GB_DEVICE_BITMAP_TILED_PATHS_MAXN, 0, TB_MAXU32, tb_offsetof(gb_bitmap_tiled_path_t, key), sizeof(gb_bitmap_tiled_path_key_t), gb_device_bitmap_tiled_path_hash, gb_device_bitmap_tiled_path_exit)) break;
+
+        // init workers
+        impl->workers = tb_nalloc0_type(workers, gb_bitmap_tiled_worker_t);
+        tb_assert_and_check_break(impl->workers);
+
+        // init the bitmap device and paint of the workers
+        tb_size_t i = 0;
+        for (i = 0; i < workers; i++)
+        {
+            gb_bitmap_tiled_worker_ref_t worker = impl->workers + i;
+            worker->device  = impl;
+            worker->bitmap  = gb_device_init_bitmap(bitmap);
+            worker->paint   = gb_paint_init();
+            impl->workers_count++;
+            tb_assert_and_check_break(worker->bitmap && worker->paint);
+        }
+        tb_assert_and_check_break(i == workers);
+
+        // init thread pool and semaphore for the other workers
+        if (workers > 1)
+        {
+            impl->pool = tb_thread_pool_init(workers - 1, 0);
+            tb_assert_and_check_break(impl->pool);
+
+            impl->semaphore = tb_semaphore_init(0);
+            tb_assert_and_check_break(impl->semaphore);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_device_exit((gb_device_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_device_ref_t)impl;
+}
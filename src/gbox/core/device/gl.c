@@ -43,6 +43,9 @@
 // testing gl v1 interfaces
 //#define GB_DEVICE_GL_TEST_v1
 
+// trace the draw calls and vertices of each frame
+//#define GB_DEVICE_GL_TRACE_STATS
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
  */
@@ -86,6 +89,9 @@ static tb_void_t gb_device_gl_resize(gb_device_impl_t* device, tb_size_t width,
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl);
 
+    // flush the batched vertices with the old projection matrix
+    gb_gl_render_flush(impl);
+
 	// update viewport
 	gb_glViewport(0, 0, width, height);
 
@@ -109,9 +115,24 @@ static tb_void_t gb_device_gl_resize(gb_device_impl_t* device, tb_size_t width,
 }
 static tb_void_t gb_device_gl_draw_clear(gb_device_impl_t* device, gb_color_t color)
 {
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // flush the batched vertices first
+    gb_gl_render_flush(impl);
+
     // clear it
 	gb_glClearColor((gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
 	gb_glClear(GB_GL_COLOR_BUFFER_BIT);
+
+    // clear the stencil buffer for the stencil fill mode
+    if (impl->fill_mode == GB_DEVICE_GL_FILL_MODE_STENCIL)
+    {
+        gb_glStencilMask(0xff);
+        gb_glClearStencil(0);
+        gb_glClear(GB_GL_STENCIL_BUFFER_BIT);
+    }
 }
 static tb_void_t gb_device_gl_draw_path(gb_device_impl_t* device, gb_path_ref_t path)
 {
@@ -177,6 +198,24 @@ static tb_void_t gb_device_gl_draw_polygon(gb_device_impl_t* device, gb_polygon_
         gb_gl_render_exit(impl);
     }
 }
+static tb_void_t gb_device_gl_flush(gb_device_impl_t* device)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // flush the batched vertices at the end of this frame
+    gb_gl_render_flush(impl);
+
+    // save the statistics of this frame
+    impl->stats_frame = impl->stats;
+    tb_memset(&impl->stats, 0, sizeof(gb_device_gl_stats_t));
+
+#ifdef GB_DEVICE_GL_TRACE_STATS
+    // trace
+    tb_trace_d("frame: draws: %lu, vertices: %lu", impl->stats_frame.draws, impl->stats_frame.vertices);
+#endif
+}
 static gb_shader_ref_t gb_device_gl_shader_linear(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
 {
     // check
@@ -210,14 +249,34 @@ static tb_void_t gb_device_gl_exit(gb_device_impl_t* device)
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl);
      
+    // exit tessellation cache
+    if (impl->tess_cache) gb_gl_tess_cache_exit(impl->tess_cache);
+    impl->tess_cache = tb_null;
+
+    // exit the tessellated triangles
+    if (impl->tess_points) tb_free(impl->tess_points);
+    impl->tess_points = tb_null;
+
     // exit tessellator
     if (impl->tessellator) gb_tessellator_exit(impl->tessellator);
     impl->tessellator = tb_null;
  
+    // exit stroke cache
+    if (impl->stroke_cache) gb_stroke_cache_exit(impl->stroke_cache);
+    impl->stroke_cache = tb_null;
+ 
     // exit stroker
     if (impl->stroker) gb_stroker_exit(impl->stroker);
     impl->stroker = tb_null;
  
+    // exit the vertex buffer object of the batched vertices
+    if (impl->batch.buffer) gb_glDeleteBuffers(1, &impl->batch.buffer);
+    impl->batch.buffer = 0;
+
+    // exit the batched vertices
+    if (impl->batch.vertices) tb_free(impl->batch.vertices);
+    impl->batch.vertices = tb_null;
+
     // exit programs 
     tb_size_t i = 0;
     for (i = 0; i < GB_GL_PROGRAM_TYPE_MAXN; i++)
@@ -260,6 +319,7 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
         impl->base.draw_lines       = gb_device_gl_draw_lines;
         impl->base.draw_points      = gb_device_gl_draw_points;
         impl->base.draw_polygon     = gb_device_gl_draw_polygon;
+        impl->base.flush            = gb_device_gl_flush;
         impl->base.shader_linear    = gb_device_gl_shader_linear;
         impl->base.shader_radial    = gb_device_gl_shader_radial;
         impl->base.shader_bitmap    = gb_device_gl_shader_bitmap;
@@ -272,6 +332,10 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
         impl->stroker = gb_stroker_init();
         tb_assert_and_check_break(impl->stroker);
 
+        // init stroke cache
+        impl->stroke_cache = gb_stroke_cache_init(0, 0);
+        tb_assert_and_check_break(impl->stroke_cache);
+
         // init tessellator
         impl->tessellator = gb_tessellator_init();
         tb_assert_and_check_break(impl->tessellator);
@@ -279,6 +343,10 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
         // init tessellator mode
         gb_tessellator_mode_set(impl->tessellator, GB_TESSELLATOR_MODE_CONVEX);
 
+        // init the batched vertices
+        impl->batch.vertices = tb_nalloc_type(GB_GL_BATCH_MAXN, gb_gl_vertex_t);
+        tb_assert_and_check_break(impl->batch.vertices);
+
         // init version 
         if (!impl->version)
         {
@@ -316,6 +384,10 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
 
             // init the projection matrix
             gb_gl_matrix_orthof(impl->matrix_project, 0.0f, (gb_GLfloat_t)width, (gb_GLfloat_t)height, 0.0f, -1.0f, 1.0f);
+
+            // init the vertex buffer object for streaming the batched vertices
+            gb_glGenBuffers(1, &impl->batch.buffer);
+            tb_assert_and_check_break(impl->batch.buffer);
         }
         // init gl 1.x
         else
@@ -330,6 +402,10 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
             gb_glLoadIdentity();
         }
 
+        // init tessellation cache, keep the large triangles resident in the vertex buffer objects for gl >= 2.0
+        impl->tess_cache = gb_gl_tess_cache_init(0, impl->version >= 0x20);
+        tb_assert_and_check_break(impl->tess_cache);
+
         // ok
         ok = tb_true;
 
@@ -346,3 +422,79 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
     // ok?
     return (gb_device_ref_t)impl;
 }
+tb_void_t gb_device_gl_fill_mode_set(gb_device_ref_t device, tb_size_t mode)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->base.type == GB_DEVICE_TYPE_GL);
+
+    // flush the batched vertices of the old mode
+    gb_gl_render_flush(impl);
+
+    // the stencil mode needs gl >= 2.0
+    if (mode == GB_DEVICE_GL_FILL_MODE_STENCIL && impl->version < 0x20) 
+    {
+        // trace
+        tb_trace_w("the stencil fill mode is not supported for gl %x, using the tessellate mode", impl->version);
+        mode = GB_DEVICE_GL_FILL_MODE_TESSELLATE;
+    }
+
+    // clear the stencil buffer, it will be kept cleared after each stencil fill
+    if (mode == GB_DEVICE_GL_FILL_MODE_STENCIL && impl->fill_mode != mode)
+    {
+        gb_glStencilMask(0xff);
+        gb_glClearStencil(0);
+        gb_glClear(GB_GL_STENCIL_BUFFER_BIT);
+    }
+
+    // save mode
+    impl->fill_mode = mode;
+}
+tb_void_t gb_device_gl_tess_cache_set(gb_device_ref_t device, tb_size_t budget)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->base.type == GB_DEVICE_TYPE_GL);
+
+    // exit the old cache, the batched vertices have been copied from the cached triangles
+    if (impl->tess_cache) gb_gl_tess_cache_exit(impl->tess_cache);
+    impl->tess_cache = tb_null;
+
+    // init the new cache
+    if (budget) 
+    {
+        impl->tess_cache = gb_gl_tess_cache_init(budget, impl->version >= 0x20);
+        tb_assert(impl->tess_cache);
+    }
+}
+tb_bool_t gb_device_gl_tess_cache_stats(gb_device_ref_t device, gb_device_gl_tess_cache_stats_ref_t stats)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && impl->base.type == GB_DEVICE_TYPE_GL && stats, tb_false);
+
+    // disabled?
+    if (!impl->tess_cache)
+    {
+        tb_memset(stats, 0, sizeof(gb_device_gl_tess_cache_stats_t));
+        return tb_false;
+    }
+
+    // the statistics
+    gb_gl_tess_cache_stats(impl->tess_cache, stats);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_device_gl_stats(gb_device_ref_t device, gb_device_gl_stats_ref_t stats)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && impl->base.type == GB_DEVICE_TYPE_GL && stats, tb_false);
+
+    // the statistics of the last frame
+    *stats = impl->stats_frame;
+
+    // ok
+    return tb_true;
+}
@@ -31,13 +31,70 @@
 #include "interface.h"
 #include "program.h"
 #include "matrix.h"
+#include "tess_cache.h"
 #include "../../impl/stroker.h"
+#include "../../impl/stroke_cache.h"
 #include "../../../utils/tessellator.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum vertex count of the batch, must be a multiple of 3
+#define GB_GL_BATCH_MAXN                (3 * 4096)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the gl vertex type
+typedef struct __gb_gl_vertex_t
+{
+    // the point
+    gb_point_t                  point;
+
+    // the color: r, g, b, a
+    gb_GLubyte_t                color[4];
+
+}gb_gl_vertex_t, *gb_gl_vertex_ref_t;
+
+// the gl state type of the batched vertices
+typedef struct __gb_gl_state_t
+{
+    // the shader
+    gb_shader_ref_t             shader;
+
+    // the vertex matrix
+    gb_gl_matrix_t              matrix;
+
+    // enable blend?
+    tb_uint8_t                  blend;
+
+    // enable antialiasing?
+    tb_uint8_t                  antialiasing;
+
+}gb_gl_state_t, *gb_gl_state_ref_t;
+
+// the gl batch type
+typedef struct __gb_gl_batch_t
+{
+    // the vertices of the triangles
+    gb_gl_vertex_ref_t          vertices;
+
+    // the vertex count
+    tb_size_t                   count;
+
+    // the streamed vertex buffer object for gl >= 2.0
+    gb_GLuint_t                 buffer;
+
+    // the state of the batched vertices
+    gb_gl_state_t               state;
+
+    // the current color of the batched vertices
+    gb_GLubyte_t                color[4];
+
+}gb_gl_batch_t;
+
 // the gl device type
 typedef struct __gb_gl_device_t
 {
@@ -65,12 +122,39 @@ typedef struct __gb_gl_device_t
     // the stroker
     gb_stroker_ref_t            stroker;
 
+    // the stroke cache
+    gb_stroke_cache_ref_t       stroke_cache;
+
     // the program
     gb_gl_program_ref_t         program;
 
     // the tessellator
     gb_tessellator_ref_t        tessellator;
 
+    // the fill mode
+    tb_size_t                   fill_mode;
+
+    // the tessellation cache
+    gb_gl_tess_cache_ref_t      tess_cache;
+
+    // the triangles of the tessellated path for the tessellation cache
+    gb_point_ref_t              tess_points;
+
+    // the vertex count of the tessellated triangles
+    tb_size_t                   tess_count;
+
+    // the max vertex count of the tessellated triangles
+    tb_size_t                   tess_maxn;
+
+    // the batch
+    gb_gl_batch_t               batch;
+
+    // the statistics of the current frame
+    gb_device_gl_stats_t        stats;
+
+    // the statistics of the last frame
+    gb_device_gl_stats_t        stats_frame;
+
 }gb_gl_device_t, *gb_gl_device_ref_t;
 
 #endif
@@ -49,8 +49,10 @@
 GB_GL_INTERFACE_DEFINE(glActiveTexture);
 GB_GL_INTERFACE_DEFINE(glAlphaFunc);
 GB_GL_INTERFACE_DEFINE(glAttachShader);
+GB_GL_INTERFACE_DEFINE(glBindBuffer);
 GB_GL_INTERFACE_DEFINE(glBindTexture);
 GB_GL_INTERFACE_DEFINE(glBlendFunc);
+GB_GL_INTERFACE_DEFINE(glBufferData);
 GB_GL_INTERFACE_DEFINE(glClear);
 GB_GL_INTERFACE_DEFINE(glClearColor);
 GB_GL_INTERFACE_DEFINE(glClearStencil);
@@ -60,6 +62,7 @@ GB_GL_INTERFACE_DEFINE(glColorPointer);
 GB_GL_INTERFACE_DEFINE(glCompileShader);
 GB_GL_INTERFACE_DEFINE(glCreateProgram);
 GB_GL_INTERFACE_DEFINE(glCreateShader);
+GB_GL_INTERFACE_DEFINE(glDeleteBuffers);
 GB_GL_INTERFACE_DEFINE(glDeleteProgram);
 GB_GL_INTERFACE_DEFINE(glDeleteShader);
 GB_GL_INTERFACE_DEFINE(glDeleteTextures);
@@ -70,6 +73,7 @@ GB_GL_INTERFACE_DEFINE(glDrawArrays);
 GB_GL_INTERFACE_DEFINE(glEnable);
 GB_GL_INTERFACE_DEFINE(glEnableClientState);
 GB_GL_INTERFACE_DEFINE(glEnableVertexAttribArray);
+GB_GL_INTERFACE_DEFINE(glGenBuffers);
 GB_GL_INTERFACE_DEFINE(glGenTextures);
 GB_GL_INTERFACE_DEFINE(glGetAttribLocation);
 GB_GL_INTERFACE_DEFINE(glGetProgramiv);
@@ -98,6 +102,7 @@ GB_GL_INTERFACE_DEFINE(glShaderSource);
 GB_GL_INTERFACE_DEFINE(glStencilFunc);
 GB_GL_INTERFACE_DEFINE(glStencilMask);
 GB_GL_INTERFACE_DEFINE(glStencilOp);
+GB_GL_INTERFACE_DEFINE(glStencilOpSeparate);
 GB_GL_INTERFACE_DEFINE(glTexCoordPointer);
 GB_GL_INTERFACE_DEFINE(glTexEnvi);
 GB_GL_INTERFACE_DEFINE(glTexImage2D);
@@ -163,13 +168,17 @@ tb_bool_t gb_gl_interface_load()
 
             // load interfaces for gl >= 2.0
             GB_GL_INTERFACE_LOAD_D(library, glAttachShader);
+            GB_GL_INTERFACE_LOAD_D(library, glBindBuffer);
+            GB_GL_INTERFACE_LOAD_D(library, glBufferData);
             GB_GL_INTERFACE_LOAD_D(library, glCompileShader);
             GB_GL_INTERFACE_LOAD_D(library, glCreateProgram);
             GB_GL_INTERFACE_LOAD_D(library, glCreateShader);
+            GB_GL_INTERFACE_LOAD_D(library, glDeleteBuffers);
             GB_GL_INTERFACE_LOAD_D(library, glDeleteProgram);
             GB_GL_INTERFACE_LOAD_D(library, glDeleteShader);
             GB_GL_INTERFACE_LOAD_D(library, glDisableVertexAttribArray);
             GB_GL_INTERFACE_LOAD_D(library, glEnableVertexAttribArray);
+            GB_GL_INTERFACE_LOAD_D(library, glGenBuffers);
             GB_GL_INTERFACE_LOAD_D(library, glGetAttribLocation);
             GB_GL_INTERFACE_LOAD_D(library, glGetProgramiv);
             GB_GL_INTERFACE_LOAD_D(library, glGetProgramInfoLog);
@@ -178,6 +187,7 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glGetUniformLocation);
             GB_GL_INTERFACE_LOAD_D(library, glLinkProgram);
             GB_GL_INTERFACE_LOAD_D(library, glShaderSource);
+            GB_GL_INTERFACE_LOAD_D(library, glStencilOpSeparate);
             GB_GL_INTERFACE_LOAD_D(library, glUniform1i);
             GB_GL_INTERFACE_LOAD_D(library, glUniformMatrix4fv);
             GB_GL_INTERFACE_LOAD_D(library, glUseProgram);
@@ -291,13 +301,17 @@ tb_bool_t gb_gl_interface_load()
 #   ifndef TB_CONFIG_OS_WINDOWS
         // load interfaces for gl >= 2.0
         GB_GL_INTERFACE_LOAD_S(glAttachShader);
+        GB_GL_INTERFACE_LOAD_S(glBindBuffer);
+        GB_GL_INTERFACE_LOAD_S(glBufferData);
         GB_GL_INTERFACE_LOAD_S(glCompileShader);
         GB_GL_INTERFACE_LOAD_S(glCreateProgram);
         GB_GL_INTERFACE_LOAD_S(glCreateShader);
+        GB_GL_INTERFACE_LOAD_S(glDeleteBuffers);
         GB_GL_INTERFACE_LOAD_S(glDeleteProgram);
         GB_GL_INTERFACE_LOAD_S(glDeleteShader);
         GB_GL_INTERFACE_LOAD_S(glDisableVertexAttribArray);
         GB_GL_INTERFACE_LOAD_S(glEnableVertexAttribArray);
+        GB_GL_INTERFACE_LOAD_S(glGenBuffers);
         GB_GL_INTERFACE_LOAD_S(glGetAttribLocation);
         GB_GL_INTERFACE_LOAD_S(glGetProgramiv);
         GB_GL_INTERFACE_LOAD_S(glGetProgramInfoLog);
@@ -306,6 +320,7 @@ tb_bool_t gb_gl_interface_load()
         GB_GL_INTERFACE_LOAD_S(glGetUniformLocation);
         GB_GL_INTERFACE_LOAD_S(glLinkProgram);
         GB_GL_INTERFACE_LOAD_S(glShaderSource);
+        GB_GL_INTERFACE_LOAD_S(glStencilOpSeparate);
         GB_GL_INTERFACE_LOAD_S(glUniform1i);
         GB_GL_INTERFACE_LOAD_S(glUniformMatrix4fv);
         GB_GL_INTERFACE_LOAD_S(glUseProgram);
@@ -152,6 +152,11 @@
 #define GB_GL_INCR_WRAP                 (0x8507)
 #define GB_GL_DECR_WRAP                 (0x8508)
 
+// cull face mode
+#define GB_GL_FRONT                     (0x0404)
+#define GB_GL_BACK                      (0x0405)
+#define GB_GL_FRONT_AND_BACK            (0x0408)
+
 // stencil function
 #define GB_GL_NEVER                     (0x0200)
 #define GB_GL_LESS                      (0x0201)
@@ -200,6 +205,13 @@
 #define GB_GL_UNPACK_ALIGNMENT          (0x0CF5)
 #define GB_GL_PACK_ALIGNMENT            (0x0D05)
 
+// buffer objects
+#define GB_GL_ARRAY_BUFFER              (0x8892)
+#define GB_GL_ELEMENT_ARRAY_BUFFER      (0x8893)
+#define GB_GL_STREAM_DRAW               (0x88E0)
+#define GB_GL_STATIC_DRAW               (0x88E4)
+#define GB_GL_DYNAMIC_DRAW              (0x88E8)
+
 // begin mode 
 #define GB_GL_POINTS                    (0x0000)
 #define GB_GL_LINES                     (0x0001)
@@ -284,6 +296,7 @@ typedef tb_float_t      gb_GLfloat_t;
 typedef tb_float_t      gb_GLclampf_t;
 typedef tb_double_t     gb_GLdouble_t;
 typedef tb_double_t     gb_GLclampd_t;
+typedef tb_long_t       gb_GLsizeiptr_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interface types
@@ -291,8 +304,10 @@ typedef tb_double_t     gb_GLclampd_t;
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glActiveTexture))             (gb_GLenum_t texture);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glAlphaFunc))                 (gb_GLenum_t func, gb_GLclampf_t ref);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glAttachShader))              (gb_GLuint_t program, gb_GLuint_t shader);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBindBuffer))                (gb_GLenum_t target, gb_GLuint_t buffer);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBindTexture))               (gb_GLenum_t target, gb_GLuint_t texture);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBlendFunc))                 (gb_GLenum_t sfactor, gb_GLenum_t dfactor);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBufferData))                (gb_GLenum_t target, gb_GLsizeiptr_t size, gb_GLvoid_t const* data, gb_GLenum_t usage);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glClear))                     (gb_GLbitfield_t mask);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glClearColor))                (gb_GLclampf_t red, gb_GLclampf_t green, gb_GLclampf_t blue, gb_GLclampf_t alpha);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glClearStencil))              (gb_GLint_t s);
@@ -302,6 +317,7 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glColorPointer))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glCompileShader))             (gb_GLuint_t shader);
 typedef gb_GLuint_t             (GB_GL_INTERFACE_TYPE(glCreateProgram))             (gb_GLvoid_t);
 typedef gb_GLuint_t             (GB_GL_INTERFACE_TYPE(glCreateShader))              (gb_GLenum_t type);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteBuffers))             (gb_GLsizei_t n, gb_GLuint_t const* buffers);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteProgram))             (gb_GLuint_t program);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteShader))              (gb_GLuint_t shader);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteTextures))            (gb_GLsizei_t n, gb_GLuint_t const* textures);
@@ -312,6 +328,7 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDrawArrays))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glEnable))                    (gb_GLenum_t cap);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glEnableClientState))         (gb_GLenum_t cap);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glEnableVertexAttribArray))   (gb_GLuint_t index);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGenBuffers))                (gb_GLsizei_t n, gb_GLuint_t* buffers);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGenTextures))               (gb_GLsizei_t n, gb_GLuint_t* textures);
 typedef gb_GLint_t              (GB_GL_INTERFACE_TYPE(glGetAttribLocation))         (gb_GLuint_t program, gb_GLchar_t const* name);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGetProgramiv))              (gb_GLuint_t program, gb_GLenum_t pname, gb_GLint_t* params);
@@ -340,6 +357,7 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glShaderSource))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilFunc))               (gb_GLenum_t func, gb_GLint_t ref, gb_GLuint_t mask);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilMask))               (gb_GLuint_t mask);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilOp))                 (gb_GLenum_t fail, gb_GLenum_t zfail, gb_GLenum_t zpass);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilOpSeparate))         (gb_GLenum_t face, gb_GLenum_t fail, gb_GLenum_t zfail, gb_GLenum_t zpass);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexCoordPointer))           (gb_GLint_t size, gb_GLenum_t type, gb_GLsizei_t stride, gb_GLvoid_t const* ptr);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexEnvi))                   (gb_GLenum_t target, gb_GLenum_t pname, gb_GLint_t param);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexImage2D))                (gb_GLenum_t target, gb_GLint_t level, gb_GLint_t internalFormat, gb_GLsizei_t width, gb_GLsizei_t height, gb_GLint_t border, gb_GLenum_t format, gb_GLenum_t type, gb_GLvoid_t const* pixels);
@@ -360,8 +378,10 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glViewport))
 GB_GL_INTERFACE_EXTERN(glActiveTexture);
 GB_GL_INTERFACE_EXTERN(glAlphaFunc);
 GB_GL_INTERFACE_EXTERN(glAttachShader);
+GB_GL_INTERFACE_EXTERN(glBindBuffer);
 GB_GL_INTERFACE_EXTERN(glBindTexture);
 GB_GL_INTERFACE_EXTERN(glBlendFunc);
+GB_GL_INTERFACE_EXTERN(glBufferData);
 GB_GL_INTERFACE_EXTERN(glClear);
 GB_GL_INTERFACE_EXTERN(glClearColor);
 GB_GL_INTERFACE_EXTERN(glClearStencil);
@@ -371,6 +391,7 @@ GB_GL_INTERFACE_EXTERN(glColorPointer);
 GB_GL_INTERFACE_EXTERN(glCompileShader);
 GB_GL_INTERFACE_EXTERN(glCreateProgram);
 GB_GL_INTERFACE_EXTERN(glCreateShader);
+GB_GL_INTERFACE_EXTERN(glDeleteBuffers);
 GB_GL_INTERFACE_EXTERN(glDeleteProgram);
 GB_GL_INTERFACE_EXTERN(glDeleteShader);
 GB_GL_INTERFACE_EXTERN(glDeleteTextures);
@@ -381,6 +402,7 @@ GB_GL_INTERFACE_EXTERN(glDrawArrays);
 GB_GL_INTERFACE_EXTERN(glEnable);
 GB_GL_INTERFACE_EXTERN(glEnableClientState);
 GB_GL_INTERFACE_EXTERN(glEnableVertexAttribArray);
+GB_GL_INTERFACE_EXTERN(glGenBuffers);
 GB_GL_INTERFACE_EXTERN(glGenTextures);
 GB_GL_INTERFACE_EXTERN(glGetAttribLocation);
 GB_GL_INTERFACE_EXTERN(glGetProgramiv);
@@ -409,6 +431,7 @@ GB_GL_INTERFACE_EXTERN(glShaderSource);
 GB_GL_INTERFACE_EXTERN(glStencilFunc);
 GB_GL_INTERFACE_EXTERN(glStencilMask);
 GB_GL_INTERFACE_EXTERN(glStencilOp);
+GB_GL_INTERFACE_EXTERN(glStencilOpSeparate);
 GB_GL_INTERFACE_EXTERN(glTexCoordPointer);
 GB_GL_INTERFACE_EXTERN(glTexEnvi);
 GB_GL_INTERFACE_EXTERN(glTexImage2D);
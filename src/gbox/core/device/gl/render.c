@@ -34,6 +34,7 @@
  * includes
  */
 #include "render.h"
+#include "../../impl/bounds.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -74,153 +75,483 @@ static tb_void_t gb_gl_render_apply_vertices(gb_gl_device_ref_t device, gb_point
         gb_glVertexPointer(2, GB_GL_VERTEX_TYPE, 0, points);
     }
 }
-static tb_void_t gb_gl_render_enter_solid(gb_gl_device_ref_t device)
+static tb_void_t gb_gl_render_make_state(gb_gl_device_ref_t device, gb_gl_state_ref_t state, tb_bool_t batched)
 {
     // check
-    tb_assert(device);
- 
-    // the paint
-    gb_paint_ref_t paint = device->base.paint;
-    tb_assert(paint);
+    tb_assert(device && device->base.paint && state);
 
-    // the color 
-    gb_color_t color = gb_paint_color(paint);
+    // clear it first, the state will be compared as the raw bytes
+    tb_memset(state, 0, sizeof(gb_gl_state_t));
 
-    // the alpha
-    tb_byte_t alpha = gb_paint_alpha(paint);
+    // make shader
+    state->shader = device->shader;
 
-    // disable texture
-    gb_glDisable(GB_GL_TEXTURE_2D);
+    // make vertex matrix
+    tb_memcpy(state->matrix, device->matrix_vertex, sizeof(gb_gl_matrix_t));
 
-    // exists alpha?
-    if (alpha != 0xff)
-    {
-        // enable blend
-        gb_glEnable(GB_GL_BLEND);
-        gb_glBlendFunc(GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
+    /* make blend
+     *
+     * the batched solid vertices carry their own alpha and are always blended,
+     * so the opaque and translucent paints can be drawn in the same batch,
+     * (alpha: 0xff) * src + (1 - alpha: 0xff) * dst == src
+     */
+    state->blend = (!state->shader && (batched || gb_paint_alpha(device->base.paint) != 0xff))? 1 : 0;
 
-        // apply the alpha 
-        color.a = alpha;
-    }
-    else
+    // make antialiasing
+    state->antialiasing = (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING)? 1 : 0;
+}
+static tb_bool_t gb_gl_render_enter_state(gb_gl_device_ref_t device, gb_gl_state_ref_t state)
+{
+    // check
+    tb_assert(device && state);
+
+    // init antialiasing
+    if (state->antialiasing) 
     {
-        // disable blend
-        gb_glDisable(GB_GL_BLEND);
+        gb_glEnable(GB_GL_MULTISAMPLE);
+#if 0
+        gb_glEnable(GB_GL_LINE_SMOOTH);
+        gb_glHint(GB_GL_LINE_SMOOTH_HINT, GB_GL_NICEST);
+#endif
     }
+    else gb_glDisable(GB_GL_MULTISAMPLE);
 
-    // apply color
+    // init vertex and matrix
     if (device->version >= 0x20)
-    {
-        // check
-        tb_assert(device->program);
+    {   
+        // the program type
+        tb_size_t program_type = state->shader? GB_GL_PROGRAM_TYPE_BITMAP : GB_GL_PROGRAM_TYPE_COLOR;
 
-        // apply it
-        gb_glVertexAttrib4f(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_COLORS), (gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
+        // program
+        device->program = device->programs[program_type];
+        tb_assert_and_check_return_val(device->program, tb_false);
+
+        // bind this program to the current gl context
+        gb_gl_program_bind(device->program);
+
+        // enable vertex
+        gb_glEnableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES));
+
+        // apply projection matrix
+        gb_glUniformMatrix4fv(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT), 1, GB_GL_FALSE, device->matrix_project);
+
+        // apply vertex matrix
+        gb_glUniformMatrix4fv(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL), 1, GB_GL_FALSE, state->matrix);
     }
     else
     {
-        // apply it
-        gb_glColor4f((gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
+        // enable vertex
+        gb_glEnableClientState(GB_GL_VERTEX_ARRAY);
+
+        // apply vertex matrix
+        gb_glMatrixMode(GB_GL_MODELVIEW);
+        gb_glPushMatrix();
+        gb_glLoadIdentity();
+        gb_glMultMatrixf(state->matrix);
     }
+
+    // init blend
+    if (state->blend)
+    {
+        gb_glEnable(GB_GL_BLEND);
+        gb_glBlendFunc(GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else gb_glDisable(GB_GL_BLEND);
+
+    // init texture
+    if (state->shader) gb_glEnable(GB_GL_TEXTURE_2D);
+    else gb_glDisable(GB_GL_TEXTURE_2D);
+
+    // ok
+    return tb_true;
 }
-static tb_void_t gb_gl_render_leave_solid(gb_gl_device_ref_t device)
-{    
+static tb_void_t gb_gl_render_leave_state(gb_gl_device_ref_t device)
+{
     // check
     tb_assert(device);
+
+    // exit vertex and matrix
+    if (device->version >= 0x20)
+    {   
+        // check
+        tb_assert_and_check_return(device->program);
+
+        // disable vertex
+        gb_glDisableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES));
  
-    // disable blend
-    gb_glDisable(GB_GL_BLEND);
-}
-static tb_void_t gb_gl_render_enter_shader(gb_gl_device_ref_t device)
-{   
-    // check
-    tb_assert(device && device->base.paint);
+        // disable texcoord
+        gb_glDisableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_TEXCOORDS));
+    }
+    else
+    {
+        // restore vertex matrix
+        gb_glMatrixMode(GB_GL_MODELVIEW);
+        gb_glPopMatrix();
+
+        // disable vertex
+        gb_glDisableClientState(GB_GL_VERTEX_ARRAY);
  
+        // disable texcoord
+        gb_glDisableClientState(GB_GL_TEXTURE_COORD_ARRAY);
+    }
+
     // disable blend
     gb_glDisable(GB_GL_BLEND);
 
-    // enable texture
-    gb_glEnable(GB_GL_TEXTURE_2D);
-}
-static tb_void_t gb_gl_render_leave_shader(gb_gl_device_ref_t device)
-{   
-    // check
-    tb_assert(device);
- 
     // disable texture
     gb_glDisable(GB_GL_TEXTURE_2D);
+ 
+    // disable antialiasing
+    gb_glDisable(GB_GL_MULTISAMPLE);
 }
-static tb_void_t gb_gl_render_enter_paint(gb_gl_device_ref_t device)
+static tb_bool_t gb_gl_render_enter_paint(gb_gl_device_ref_t device)
 {
     // check
-    tb_assert(device);
+    tb_assert(device && device->base.paint);
+
+    // flush the batched vertices first, they must be drawn before these vertices
+    gb_gl_render_flush(device);
+
+    // enter state
+    gb_gl_state_t state;
+    gb_gl_render_make_state(device, &state, tb_false);
+    if (!gb_gl_render_enter_state(device, &state)) return tb_false;
+
+    // apply color for the solid paint
+    if (!state.shader)
+    {
+        // the color 
+        gb_color_t color = gb_paint_color(device->base.paint);
+
+        // apply the alpha 
+        color.a = gb_paint_alpha(device->base.paint);
 
-    // enter shader
-    if (device->shader) gb_gl_render_enter_shader(device);
-    // enter solid
-    else gb_gl_render_enter_solid(device);
+        // apply it
+        if (device->version >= 0x20)
+        {
+            // check
+            tb_assert(device->program);
+
+            // apply it
+            gb_glVertexAttrib4f(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_COLORS), (gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
+        }
+        else
+        {
+            // apply it
+            gb_glColor4f((gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
+        }
+    }
+
+    // ok
+    return tb_true;
 }
 static tb_void_t gb_gl_render_leave_paint(gb_gl_device_ref_t device)
+{
+    // leave state
+    gb_gl_render_leave_state(device);
+}
+static tb_void_t gb_gl_render_draw_arrays(gb_gl_device_ref_t device, gb_GLenum_t mode, tb_size_t index, tb_size_t count)
 {
     // check
-    tb_assert(device);
+    tb_assert(device && count);
 
-    // leave shader
-    if (device->shader) gb_gl_render_leave_shader(device);
-    // leave solid
-    else gb_gl_render_leave_solid(device);
+    // draw it
+    gb_glDrawArrays(mode, (gb_GLint_t)index, (gb_GLsizei_t)count);
+
+    // update the statistics
+    device->stats.draws++;
+    device->stats.vertices += count;
 }
-static tb_void_t gb_gl_render_fill_convex(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+static tb_void_t gb_gl_render_enter_batch(gb_gl_device_ref_t device)
 {
     // check
-    tb_assert(priv && points && count);
+    tb_assert(device && device->base.paint && device->batch.vertices);
 
-    // apply it
-    gb_gl_render_apply_vertices((gb_gl_device_ref_t)priv, points);
+    // the batch
+    gb_gl_batch_t* batch = &device->batch;
 
-#ifndef GB_GL_TESSELLATOR_TEST_ENABLE
-    // draw it
-    gb_glDrawArrays(GB_GL_TRIANGLE_FAN, 0, (gb_GLint_t)count);
-#else
-    // the device 
+    // make the state of the new vertices
+    gb_gl_state_t state;
+    gb_gl_render_make_state(device, &state, tb_true);
+
+    // the state has been changed? flush the batched vertices first
+    if (batch->count && tb_memcmp(&state, &batch->state, sizeof(gb_gl_state_t))) gb_gl_render_flush(device);
+
+    // save the state
+    batch->state = state;
+
+    // save the color of the solid paint
+    if (!state.shader)
+    {
+        gb_color_t color = gb_paint_color(device->base.paint);
+        batch->color[0] = color.r;
+        batch->color[1] = color.g;
+        batch->color[2] = color.b;
+        batch->color[3] = gb_paint_alpha(device->base.paint);
+    }
+}
+static tb_void_t gb_gl_render_fill_convex(gb_point_ref_t points, tb_size_t count, tb_cpointer_t priv)
+{
+    // check
     gb_gl_device_ref_t device = (gb_gl_device_ref_t)priv;
+    tb_assert(device && device->batch.vertices && points && count);
+
+    // the batch
+    gb_gl_batch_t* batch = &device->batch;
 
+    // the color
+    tb_uint32_t color;
+    tb_memcpy(&color, batch->color, sizeof(color));
+
+#ifdef GB_GL_TESSELLATOR_TEST_ENABLE
     // make crc32
     tb_uint32_t crc32 = 0xffffffff ^ tb_crc_encode(TB_CRC_MODE_32_IEEE_LE, 0xffffffff, (tb_byte_t const*)points, count * sizeof(gb_point_t));
 
-    // make color
-    gb_color_t color;
-    color.r = (tb_byte_t)crc32;
-    color.g = (tb_byte_t)(crc32 >> 8);
-    color.b = (tb_byte_t)(crc32 >> 16);
-    color.a = 128;
+    // make color for drawing the edges of the filled contour
+    gb_GLubyte_t* test = (gb_GLubyte_t*)&color;
+    test[0] = (gb_GLubyte_t)crc32;
+    test[1] = (gb_GLubyte_t)(crc32 >> 8);
+    test[2] = (gb_GLubyte_t)(crc32 >> 16);
+    test[3] = 128;
+#endif
 
-    // enable blend
-    gb_glEnable(GB_GL_BLEND);
-    gb_glBlendFunc(GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
+    // append the triangles of this triangle fan to the batch 
+    tb_size_t i = 1;
+    for (i = 1; i + 1 < count; i++)
+    {
+        // the batch is full? flush it
+        if (batch->count + 3 > GB_GL_BATCH_MAXN) gb_gl_render_flush(device);
+
+        // append triangle: (0, i, i + 1)
+        gb_gl_vertex_ref_t vertex = batch->vertices + batch->count;
+        vertex[0].point = points[0];
+        vertex[1].point = points[i];
+        vertex[2].point = points[i + 1];
+        tb_memcpy(vertex[0].color, &color, sizeof(color));
+        tb_memcpy(vertex[1].color, &color, sizeof(color));
+        tb_memcpy(vertex[2].color, &color, sizeof(color));
+        batch->count += 3;
+    }
+}
+static tb_void_t gb_gl_render_fill_triangles(gb_gl_device_ref_t device, gb_point_ref_t points, tb_size_t count)
+{
+    // check
+    tb_assert(device && device->batch.vertices && (points || !count) && !(count % 3));
 
-    // apply color
-    if (device->version >= 0x20) gb_glVertexAttrib4f(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_COLORS), (gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
-    else gb_glColor4f((gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
+    // the batch
+    gb_gl_batch_t* batch = &device->batch;
 
-    // draw the edges of the filled contour
-    gb_glDrawArrays(GB_GL_TRIANGLE_FAN, 0, (gb_GLint_t)count);
+    // the color
+    tb_uint32_t color;
+    tb_memcpy(&color, batch->color, sizeof(color));
 
-    // disable blend
-    gb_glEnable(GB_GL_BLEND);
-#endif
+    // append the triangles to the batch
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // the batch is full? flush it, the triangles will not be split for the batch size is a multiple of 3
+        if (batch->count == GB_GL_BATCH_MAXN) gb_gl_render_flush(device);
+
+        // append vertex
+        gb_gl_vertex_ref_t vertex = batch->vertices + batch->count++;
+        vertex->point = points[i];
+        tb_memcpy(vertex->color, &color, sizeof(color));
+    }
+}
+static tb_void_t gb_gl_render_fill_buffer(gb_gl_device_ref_t device, gb_GLuint_t buffer, tb_size_t count)
+{
+    // check
+    tb_assert(device && device->version >= 0x20 && buffer && count);
+
+    // enter paint
+    if (!gb_gl_render_enter_paint(device)) return ;
+
+    // check
+    tb_assert(device->program);
+
+    // apply the vertices resident in the vertex buffer object
+    gb_glBindBuffer(GB_GL_ARRAY_BUFFER, buffer);
+    gb_glVertexAttribPointer(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES), 2, GB_GL_VERTEX_TYPE, GB_GL_FALSE, 0, tb_null);
+
+    // draw triangles
+    gb_gl_render_draw_arrays(device, GB_GL_TRIANGLES, 0, count);
+
+    // unbind the vertex buffer object for the client-side vertices
+    gb_glBindBuffer(GB_GL_ARRAY_BUFFER, 0);
+
+    // leave paint
+    gb_gl_render_leave_paint(device);
+}
+static tb_void_t gb_gl_render_tess_record(gb_point_ref_t points, tb_size_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_gl_device_ref_t device = (gb_gl_device_ref_t)priv;
+    tb_assert(device && points && count);
+
+    // no triangle?
+    tb_check_return(count > 2);
+
+    // grow the recorded triangles
+    tb_size_t need = device->tess_count + (count - 2) * 3;
+    if (need > device->tess_maxn)
+    {
+        tb_size_t maxn = tb_max(device->tess_maxn << 1, 256);
+        while (maxn < need) maxn <<= 1;
+        gb_point_ref_t data = tb_ralloc_type(device->tess_points, maxn, gb_point_t);
+        tb_assert_and_check_return(data);
+        device->tess_points = data;
+        device->tess_maxn   = maxn;
+    }
+
+    // record the triangles of this triangle fan: (0, i, i + 1)
+    tb_size_t       i = 1;
+    gb_point_ref_t  triangle = device->tess_points + device->tess_count;
+    for (i = 1; i + 1 < count; i++, triangle += 3)
+    {
+        triangle[0] = points[0];
+        triangle[1] = points[i];
+        triangle[2] = points[i + 1];
+    }
+    device->tess_count = need;
+}
+static tb_bool_t gb_gl_render_fill_cached(gb_gl_device_ref_t device, gb_path_ref_t path)
+{
+    // check
+    tb_assert(device && device->tessellator && device->base.paint && device->base.matrix && path);
+
+    // no cache or using the stencil buffer? 
+    tb_check_return_val(device->tess_cache && device->fill_mode == GB_DEVICE_GL_FILL_MODE_TESSELLATE, tb_false);
+
+    // the line or point? it will be stroked
+    gb_shape_ref_t hint = gb_path_hint(path);
+    tb_check_return_val(!hint || (hint->type != GB_SHAPE_TYPE_LINE && hint->type != GB_SHAPE_TYPE_POINT), tb_false);
+
+    // the rule
+    tb_size_t rule = gb_paint_fill_rule(device->base.paint);
+
+    // the flattening level, the cached triangles are same for the matrices with the same level
+    tb_long_t level = gb_path_polygon2_level(path, device->base.matrix);
+
+    // get the cached triangles
+    gb_gl_tess_cache_entry_ref_t entry = gb_gl_tess_cache_get(device->tess_cache, path, rule, level);
+    if (!entry)
+    {
+        // the polygon
+        gb_polygon_ref_t polygon = gb_path_polygon2(path, device->base.matrix);
+        tb_check_return_val(polygon, tb_true);
+
+        // record the triangles of this path
+        device->tess_count = 0;
+        gb_tessellator_rule_set(device->tessellator, rule);
+        gb_tessellator_func_set(device->tessellator, gb_gl_render_tess_record, device);
+        gb_tessellator_done(device->tessellator, polygon, gb_path_bounds(path));
+
+        // cache them
+        entry = gb_gl_tess_cache_add(device->tess_cache, path, rule, level, device->tess_points, device->tess_count);
+    }
+
+    // fill the resident triangles
+    if (entry && entry->buffer) gb_gl_render_fill_buffer(device, entry->buffer, entry->count);
+    else
+    {
+        // enter batch
+        gb_gl_render_enter_batch(device);
+
+        // append the cached triangles or the recorded triangles if they are too large to be cached
+        if (entry) gb_gl_render_fill_triangles(device, entry->points, entry->count);
+        else gb_gl_render_fill_triangles(device, device->tess_points, device->tess_count);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_gl_render_fill_stencil(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule)
+{
+    // check
+    tb_assert(device && device->version >= 0x20 && polygon && polygon->points && polygon->counts);
+
+    // no bounds? make it
+    gb_rect_t bounds_polygon;
+    if (!bounds)
+    {
+        tb_size_t           count = 0;
+        tb_uint32_t const*  counts = polygon->counts;
+        while (*counts) count += *counts++;
+        tb_check_return(count);
+        gb_bounds_make(&bounds_polygon, polygon->points, count);
+        bounds = &bounds_polygon;
+    }
+
+    // enter paint
+    if (!gb_gl_render_enter_paint(device)) return ;
+
+    // enable stencil and disable color 
+    gb_glEnable(GB_GL_STENCIL_TEST);
+    gb_glStencilMask(0xff);
+    gb_glStencilFunc(GB_GL_ALWAYS, 0, 0xff);
+    gb_glColorMask(GB_GL_FALSE, GB_GL_FALSE, GB_GL_FALSE, GB_GL_FALSE);
+
+    /* draw the triangle fan of each contour to the stencil buffer
+     *
+     * odd:     invert the stencil value, the covered pixels are non-zero if they are covered odd times
+     * nonzero: increase the stencil value for the front faces and decrease it for the back faces, 
+     *          the covered pixels are non-zero if the sum of the winding numbers is non-zero
+     */
+    if (rule == GB_PAINT_FILL_RULE_ODD) gb_glStencilOp(GB_GL_KEEP, GB_GL_KEEP, GB_GL_INVERT);
+    else
+    {
+        gb_glStencilOpSeparate(GB_GL_FRONT, GB_GL_KEEP, GB_GL_KEEP, GB_GL_INCR_WRAP);
+        gb_glStencilOpSeparate(GB_GL_BACK, GB_GL_KEEP, GB_GL_KEEP, GB_GL_DECR_WRAP);
+    }
+    gb_gl_render_apply_vertices(device, polygon->points);
+    tb_uint32_t         count;
+    tb_size_t           index = 0;
+    tb_uint32_t const*  counts = polygon->counts;
+    while ((count = *counts++))
+    {
+        if (count > 2) gb_gl_render_draw_arrays(device, GB_GL_TRIANGLE_FAN, index, count);
+        index += count;
+    }
+
+    // cover the bounds for the non-zero stencil values and clear them for the next filling
+    gb_glColorMask(GB_GL_TRUE, GB_GL_TRUE, GB_GL_TRUE, GB_GL_TRUE);
+    gb_glStencilFunc(GB_GL_NOTEQUAL, 0, 0xff);
+    gb_glStencilOp(GB_GL_ZERO, GB_GL_ZERO, GB_GL_ZERO);
+    gb_point_t cover[4];
+    gb_point_make(&cover[0], bounds->x, bounds->y);
+    gb_point_make(&cover[1], bounds->x + bounds->w, bounds->y);
+    gb_point_make(&cover[2], bounds->x + bounds->w, bounds->y + bounds->h);
+    gb_point_make(&cover[3], bounds->x, bounds->y + bounds->h);
+    gb_gl_render_apply_vertices(device, cover);
+    gb_gl_render_draw_arrays(device, GB_GL_TRIANGLE_FAN, 0, 4);
+
+    // disable stencil
+    gb_glDisable(GB_GL_STENCIL_TEST);
+
+    // leave paint
+    gb_gl_render_leave_paint(device);
 }
 static tb_void_t gb_gl_render_fill_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule)
 {
     // check
     tb_assert(device && device->tessellator);
 
+    // fill it using the stencil buffer? 
+    if (device->fill_mode == GB_DEVICE_GL_FILL_MODE_STENCIL)
+    {
+        gb_gl_render_fill_stencil(device, polygon, bounds, rule);
+        return ;
+    }
+
 #ifdef GB_GL_TESSELLATOR_TEST_ENABLE
     // set mode
     gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_TRIANGULATION);
 //    gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_MONOTONE);
 #endif
 
+    // enter batch
+    gb_gl_render_enter_batch(device);
+
     // set rule
     gb_tessellator_rule_set(device->tessellator, rule);
 
@@ -239,7 +570,7 @@ static tb_void_t gb_gl_render_stroke_lines(gb_gl_device_ref_t device, gb_point_r
     gb_gl_render_apply_vertices(device, points);
 
     // done
-    gb_glDrawArrays(GB_GL_LINES, 0, (gb_GLint_t)count);
+    gb_gl_render_draw_arrays(device, GB_GL_LINES, 0, count);
 }
 static tb_void_t gb_gl_render_stroke_points(gb_gl_device_ref_t device, gb_point_ref_t points, tb_size_t count)
 {
@@ -250,9 +581,9 @@ static tb_void_t gb_gl_render_stroke_points(gb_gl_device_ref_t device, gb_point_
     gb_gl_render_apply_vertices(device, points);
 
     // done
-    gb_glDrawArrays(GB_GL_POINTS, 0, (gb_GLint_t)count);
+    gb_gl_render_draw_arrays(device, GB_GL_POINTS, 0, count);
 }
-static tb_void_t gb_gl_render_stroke_polygon(gb_gl_device_ref_t device, gb_point_ref_t points, tb_uint16_t const* counts)
+static tb_void_t gb_gl_render_stroke_polygon(gb_gl_device_ref_t device, gb_point_ref_t points, tb_uint32_t const* counts)
 {
     // check
     tb_assert(device && points && counts);
@@ -261,14 +592,33 @@ static tb_void_t gb_gl_render_stroke_polygon(gb_gl_device_ref_t device, gb_point
     gb_gl_render_apply_vertices(device, points);
 
     // done
-    tb_uint16_t count;
+    tb_uint32_t count;
     tb_size_t   index = 0;
     while ((count = *counts++))
     {
-        gb_glDrawArrays(GB_GL_LINE_STRIP, (gb_GLint_t)index, (gb_GLint_t)count);
+        gb_gl_render_draw_arrays(device, GB_GL_LINE_STRIP, index, count);
         index += count;
     }
 }
+static gb_path_ref_t gb_gl_render_stroke_path(gb_gl_device_ref_t device, gb_path_ref_t path)
+{
+    // check
+    tb_assert(device && device->stroker && device->stroke_cache && device->base.paint && path);
+
+    // get the cached stroked path first
+    gb_path_ref_t stroked = gb_stroke_cache_get(device->stroke_cache, device->base.paint, device->base.matrix, path);
+    tb_check_return_val(!stroked, stroked);
+
+    // stroke it
+    stroked = gb_stroker_done_path(device->stroker, device->base.paint, path);
+    tb_check_return_val(stroked, tb_null);
+
+    // cache the stroked path, using the stroker result directly if it is too large to be cached
+    gb_path_ref_t cached = gb_stroke_cache_add(device->stroke_cache, device->base.paint, device->base.matrix, path, stroked);
+
+    // ok
+    return cached? cached : stroked;
+}
 static tb_void_t gb_gl_render_stroke_fill(gb_gl_device_ref_t device, gb_path_ref_t path)
 {
     // check
@@ -318,109 +668,113 @@ tb_bool_t gb_gl_render_init(gb_gl_device_ref_t device)
     // check
     tb_assert_and_check_return_val(device && device->base.matrix && device->base.paint, tb_false);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // init shader
-        device->shader = gb_paint_shader(device->base.paint);
+    // init shader
+    device->shader = gb_paint_shader(device->base.paint);
 
-        // init vertex matrix
-        gb_gl_matrix_convert(device->matrix_vertex, device->base.matrix);
+    // init vertex matrix
+    gb_gl_matrix_convert(device->matrix_vertex, device->base.matrix);
 
-        // apply matrix for the fixed vertex if no GB_GL_FIXED macro
+    // apply matrix for the fixed vertex if no GB_GL_FIXED macro
 #if defined(GB_CONFIG_FLOAT_FIXED) && !defined(GB_GL_FIXED)
-        device->matrix_vertex[0] /= 65536.0f;
-        device->matrix_vertex[1] /= 65536.0f;
-        device->matrix_vertex[4] /= 65536.0f;
-        device->matrix_vertex[5] /= 65536.0f;
+    device->matrix_vertex[0] /= 65536.0f;
+    device->matrix_vertex[1] /= 65536.0f;
+    device->matrix_vertex[4] /= 65536.0f;
+    device->matrix_vertex[5] /= 65536.0f;
 #endif
 
-        // init antialiasing
-        if (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING) 
-        {
-            gb_glEnable(GB_GL_MULTISAMPLE);
-#if 0
-            gb_glEnable(GB_GL_LINE_SMOOTH);
-            gb_glHint(GB_GL_LINE_SMOOTH_HINT, GB_GL_NICEST);
-#endif
-        }
-        else gb_glDisable(GB_GL_MULTISAMPLE);
+    /* ok
+     *
+     * the gl states will be applied when the vertices are drawn,
+     * the filled vertices are batched and drawn in gb_gl_render_flush()
+     */
+    return tb_true;
+}
+tb_void_t gb_gl_render_exit(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert_and_check_return(device);
+
+    // clear shader, the batched vertices have saved it
+    device->shader = tb_null;
+}
+tb_void_t gb_gl_render_flush(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert_and_check_return(device);
+
+    // the batch
+    gb_gl_batch_t* batch = &device->batch;
+    tb_check_return(batch->count);
 
-        // init vertex and matrix
+    // enter the state of the batched vertices
+    if (gb_gl_render_enter_state(device, &batch->state))
+    {
+        // the stride
+        gb_GLsizei_t stride = sizeof(gb_gl_vertex_t);
+
+        // apply vertices and colors
         if (device->version >= 0x20)
-        {   
-            // the program type
-            tb_size_t program_type = device->shader? GB_GL_PROGRAM_TYPE_BITMAP : GB_GL_PROGRAM_TYPE_COLOR;
+        {
+            // check
+            tb_assert(device->program);
+
+            // the vertices
+            tb_byte_t const* vertices = (tb_byte_t const*)batch->vertices;
+
+            // stream the vertices to the vertex buffer object, the old storage will be orphaned
+            if (batch->buffer)
+            {
+                gb_glBindBuffer(GB_GL_ARRAY_BUFFER, batch->buffer);
+                gb_glBufferData(GB_GL_ARRAY_BUFFER, (gb_GLsizeiptr_t)(batch->count * sizeof(gb_gl_vertex_t)), vertices, GB_GL_STREAM_DRAW);
 
-            // program
-            device->program = device->programs[program_type];
-            tb_assert_and_check_break(device->program);
+                // the vertices are the offsets of the buffer now
+                vertices = tb_null;
+            }
 
-            // bind this program to the current gl context
-            gb_gl_program_bind(device->program);
+            // apply vertices
+            gb_glVertexAttribPointer(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES), 2, GB_GL_VERTEX_TYPE, GB_GL_FALSE, stride, vertices + tb_offsetof(gb_gl_vertex_t, point));
 
-            // enable vertex
-            gb_glEnableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES));
+            // apply colors
+            if (!batch->state.shader)
+            {
+                gb_glEnableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_COLORS));
+                gb_glVertexAttribPointer(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_COLORS), 4, GB_GL_UNSIGNED_BYTE, GB_GL_TRUE, stride, vertices + tb_offsetof(gb_gl_vertex_t, color));
+            }
 
-            // apply projection matrix
-            gb_glUniformMatrix4fv(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT), 1, GB_GL_FALSE, device->matrix_project);
+            // draw triangles
+            gb_gl_render_draw_arrays(device, GB_GL_TRIANGLES, 0, batch->count);
 
-            // apply vertex matrix
-            gb_glUniformMatrix4fv(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL), 1, GB_GL_FALSE, device->matrix_vertex);
+            // disable colors
+            if (!batch->state.shader) gb_glDisableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_COLORS));
+
+            // unbind the vertex buffer object for the client-side vertices
+            if (batch->buffer) gb_glBindBuffer(GB_GL_ARRAY_BUFFER, 0);
         }
         else
         {
-            // enable vertex
-            gb_glEnableClientState(GB_GL_VERTEX_ARRAY);
-    
-            // apply vertex matrix
-            gb_glMatrixMode(GB_GL_MODELVIEW);
-            gb_glPushMatrix();
-            gb_glLoadIdentity();
-            gb_glMultMatrixf(device->matrix_vertex);
-        }
+            // apply vertices
+            gb_glVertexPointer(2, GB_GL_VERTEX_TYPE, stride, &batch->vertices->point);
 
-        // ok
-        ok = tb_true;
+            // apply colors
+            if (!batch->state.shader)
+            {
+                gb_glEnableClientState(GB_GL_COLOR_ARRAY);
+                gb_glColorPointer(4, GB_GL_UNSIGNED_BYTE, stride, batch->vertices->color);
+            }
 
-    } while (0);
-
-    // ok?
-    return ok;
-}
-tb_void_t gb_gl_render_exit(gb_gl_device_ref_t device)
-{
-    // check
-    tb_assert_and_check_return(device);
+            // draw triangles
+            gb_gl_render_draw_arrays(device, GB_GL_TRIANGLES, 0, batch->count);
 
-    // exit vertex and matrix
-    if (device->version >= 0x20)
-    {   
-        // check
-        tb_assert_and_check_return(device->program);
+            // disable colors
+            if (!batch->state.shader) gb_glDisableClientState(GB_GL_COLOR_ARRAY);
+        }
 
-        // disable vertex
-        gb_glDisableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES));
- 
-        // disable texcoord
-        gb_glDisableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_TEXCOORDS));
+        // leave state
+        gb_gl_render_leave_state(device);
     }
-    else
-    {
-        // restore vertex matrix
-        gb_glMatrixMode(GB_GL_MODELVIEW);
-        gb_glPopMatrix();
 
-        // disable vertex
-        gb_glDisableClientState(GB_GL_VERTEX_ARRAY);
- 
-        // disable texcoord
-        gb_glDisableClientState(GB_GL_TEXTURE_COORD_ARRAY);
-    }
- 
-    // disable antialiasing
-    gb_glDisable(GB_GL_MULTISAMPLE);
+    // clear the batched vertices
+    batch->count = 0;
 }
 tb_void_t gb_gl_render_draw_path(gb_gl_device_ref_t device, gb_path_ref_t path)
 {
@@ -430,19 +784,25 @@ tb_void_t gb_gl_render_draw_path(gb_gl_device_ref_t device, gb_path_ref_t path)
     // the mode
     tb_size_t mode = gb_paint_mode(device->base.paint);
 
-    // fill it
-    if (mode & GB_PAINT_MODE_FILL)
+    // fill it, using the cached triangles if the path is not changed
+    if ((mode & GB_PAINT_MODE_FILL) && !gb_gl_render_fill_cached(device, path))
     {
-        gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        // only fill it here, the line and point have no area and all paths are stroked below
+        gb_shape_ref_t hint = gb_path_hint(path);
+        if (!hint || (hint->type != GB_SHAPE_TYPE_LINE && hint->type != GB_SHAPE_TYPE_POINT))
+        {
+            gb_polygon_ref_t polygon = gb_path_polygon2(path, device->base.matrix);
+            if (polygon) gb_gl_render_fill_polygon(device, polygon, gb_path_bounds(path), gb_paint_fill_rule(device->base.paint));
+        }
     }
 
     // stroke it
     if ((mode & GB_PAINT_MODE_STROKE) && (gb_paint_stroke_width(device->base.paint) > 0))
     {
         // only stroke?
-        if (gb_gl_render_stroke_only(device)) gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        if (gb_gl_render_stroke_only(device)) gb_gl_render_draw_polygon(device, gb_path_polygon2(path, device->base.matrix), gb_path_hint(path), gb_path_bounds(path));
         // fill the stroked path
-        else gb_gl_render_stroke_fill(device, gb_stroker_done_path(device->stroker, device->base.paint, path));
+        else gb_gl_render_stroke_fill(device, gb_gl_render_stroke_path(device, path));
     }
 }
 tb_void_t gb_gl_render_draw_lines(gb_gl_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
@@ -456,16 +816,21 @@ tb_void_t gb_gl_render_draw_lines(gb_gl_device_ref_t device, gb_point_ref_t poin
     // check width
     tb_check_return((gb_paint_stroke_width(device->base.paint) > 0));
 
-    // enter paint
-    gb_gl_render_enter_paint(device);
-
     // only stroke?
-    if (gb_gl_render_stroke_only(device)) gb_gl_render_stroke_lines(device, points, count);
+    if (gb_gl_render_stroke_only(device)) 
+    {
+        // enter paint
+        if (gb_gl_render_enter_paint(device))
+        {
+            // stroke lines
+            gb_gl_render_stroke_lines(device, points, count);
+
+            // leave paint
+            gb_gl_render_leave_paint(device);
+        }
+    }
     // fill the stroked lines
     else gb_gl_render_stroke_fill(device, gb_stroker_done_lines(device->stroker, device->base.paint, points, count));
-
-    // leave paint
-    gb_gl_render_leave_paint(device);
 }
 tb_void_t gb_gl_render_draw_points(gb_gl_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
@@ -478,16 +843,21 @@ tb_void_t gb_gl_render_draw_points(gb_gl_device_ref_t device, gb_point_ref_t poi
     // check width
     tb_check_return((gb_paint_stroke_width(device->base.paint) > 0));
 
-    // enter paint
-    gb_gl_render_enter_paint(device);
-
     // only stroke?
-    if (gb_gl_render_stroke_only(device)) gb_gl_render_stroke_points(device, points, count);
+    if (gb_gl_render_stroke_only(device)) 
+    {
+        // enter paint
+        if (gb_gl_render_enter_paint(device))
+        {
+            // stroke points
+            gb_gl_render_stroke_points(device, points, count);
+
+            // leave paint
+            gb_gl_render_leave_paint(device);
+        }
+    }
     // fill the stroked points
     else gb_gl_render_stroke_fill(device, gb_stroker_done_points(device->stroker, device->base.paint, points, count));
-
-    // leave paint
-    gb_gl_render_leave_paint(device);
 }
 tb_void_t gb_gl_render_draw_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
 {
@@ -510,9 +880,6 @@ tb_void_t gb_gl_render_draw_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t
         return ;
     }
 
-    // enter paint
-    gb_gl_render_enter_paint(device);
-
     // the mode
     tb_size_t mode = gb_paint_mode(device->base.paint);
 
@@ -527,12 +894,19 @@ tb_void_t gb_gl_render_draw_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t
     if ((mode & GB_PAINT_MODE_STROKE) && (gb_paint_stroke_width(device->base.paint) > 0))
     {
         // only stroke?
-        if (gb_gl_render_stroke_only(device)) gb_gl_render_stroke_polygon(device, polygon->points, polygon->counts);
+        if (gb_gl_render_stroke_only(device)) 
+        {
+            // enter paint
+            if (gb_gl_render_enter_paint(device))
+            {
+                // stroke polygon
+                gb_gl_render_stroke_polygon(device, polygon->points, polygon->counts);
+
+                // leave paint
+                gb_gl_render_leave_paint(device);
+            }
+        }
         // fill the stroked polygon
         else gb_gl_render_stroke_fill(device, gb_stroker_done_polygon(device->stroker, device->base.paint, polygon, hint));
     }
-
-    // leave paint
-    gb_gl_render_leave_paint(device);
 }
-
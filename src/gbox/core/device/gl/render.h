@@ -54,6 +54,12 @@ tb_bool_t           gb_gl_render_init(gb_gl_device_ref_t device);
  */
 tb_void_t           gb_gl_render_exit(gb_gl_device_ref_t device);
 
+/* flush the batched vertices 
+ *
+ * @param device    the device
+ */
+tb_void_t           gb_gl_render_flush(gb_gl_device_ref_t device);
+
 /* draw path
  *
  * @param device    the device
@@ -0,0 +1,310 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        tess_cache.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_tess_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "tess_cache.h"
+#include "../../impl/lru_cache.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default max vertex count of all triangles
+#ifdef __gb_small__
+#   define GB_GL_TESS_CACHE_BUDGET              (64 * 1024)
+#else
+#   define GB_GL_TESS_CACHE_BUDGET              (256 * 1024)
+#endif
+
+/* the vertex count charged for each item
+ *
+ * the items of the empty or tiny triangles are also limited by the budget
+ */
+#define GB_GL_TESS_CACHE_ITEM_COST              (8)
+
+/* the min vertex count of the triangles resident in the vertex buffer object
+ *
+ * the smaller triangles are appended to the batched vertices, it is cheaper than a draw call
+ */
+#define GB_GL_TESS_CACHE_RESIDENT_MINN          (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl tessellation cache key type
+typedef struct __gb_gl_tess_cache_key_t
+{
+    // the path generation
+    tb_size_t                           generation;
+
+    // the fill rule
+    tb_size_t                           rule;
+
+    // the flattening level
+    tb_long_t                           level;
+
+}gb_gl_tess_cache_key_t, *gb_gl_tess_cache_key_ref_t;
+
+// the gl tessellation cache item type
+typedef struct __gb_gl_tess_cache_item_t
+{
+    // the lru cache item, must be the first member
+    gb_lru_cache_item_t                 base;
+
+    // the key
+    gb_gl_tess_cache_key_t              key;
+
+    // the entry
+    gb_gl_tess_cache_entry_t            entry;
+
+}gb_gl_tess_cache_item_t, *gb_gl_tess_cache_item_ref_t;
+
+// the gl tessellation cache impl type
+typedef struct __gb_gl_tess_cache_impl_t
+{
+    // the lru cache, the size is the vertex count charged for all items, must be the first member
+    gb_lru_cache_t                      lru;
+
+    // the vertex count of all triangles
+    tb_size_t                           vertices;
+
+    // the vertex count of the triangles resident in the vertex buffer objects
+    tb_size_t                           resident_vertices;
+
+    // keep the large triangles resident in the vertex buffer objects?
+    tb_bool_t                           resident;
+
+}gb_gl_tess_cache_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_gl_tess_cache_key_make(gb_gl_tess_cache_key_ref_t key, gb_path_ref_t path, tb_size_t rule, tb_long_t level)
+{
+    // check
+    tb_assert(key && path);
+
+    // clear key, the padding bytes will be compared
+    tb_memset(key, 0, sizeof(gb_gl_tess_cache_key_t));
+
+    // make key
+    key->generation = gb_path_generation(path);
+    key->rule       = rule;
+    key->level      = level;
+}
+static tb_size_t gb_gl_tess_cache_key_hash(tb_cpointer_t data)
+{
+    // the generation is unique for each path
+    gb_gl_tess_cache_key_ref_t key = (gb_gl_tess_cache_key_ref_t)data;
+    return (key->generation * 31 + (tb_size_t)key->level) * 31 + key->rule;
+}
+static tb_void_t gb_gl_tess_cache_item_exit(gb_lru_cache_ref_t lru, gb_lru_cache_item_ref_t base)
+{
+    // check
+    gb_gl_tess_cache_impl_t*    impl = (gb_gl_tess_cache_impl_t*)lru;
+    gb_gl_tess_cache_item_ref_t item = (gb_gl_tess_cache_item_ref_t)base;
+    tb_assert(impl && item);
+
+    // exit the vertex buffer object
+    if (item->entry.buffer) 
+    {
+        // update the resident vertex count
+        tb_assert(impl->resident_vertices >= item->entry.count);
+        impl->resident_vertices -= item->entry.count;
+
+        // exit it
+        gb_glDeleteBuffers(1, &item->entry.buffer);
+        item->entry.buffer = 0;
+    }
+
+    // update the vertex count
+    tb_assert(impl->vertices >= item->entry.count);
+    impl->vertices -= item->entry.count;
+
+    // exit it, the client vertices are allocated with the item
+    tb_free(item);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_tess_cache_ref_t gb_gl_tess_cache_init(tb_size_t budget, tb_bool_t resident)
+{
+    // make cache
+    gb_gl_tess_cache_impl_t* impl = tb_malloc0_type(gb_gl_tess_cache_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init cache
+    impl->resident = resident;
+
+    // init lru cache, the items count is only limited by the vertices budget, about one bucket for 16 cached vertices
+    budget = budget? budget : GB_GL_TESS_CACHE_BUDGET;
+    if (!gb_lru_cache_init(&impl->lru, tb_max(budget >> 4, 16), 0, budget, tb_offsetof(gb_gl_tess_cache_item_t, key), sizeof(gb_gl_tess_cache_key_t), gb_gl_tess_cache_key_hash, gb_gl_tess_cache_item_exit))
+    {
+        gb_gl_tess_cache_exit((gb_gl_tess_cache_ref_t)impl);
+        return tb_null;
+    }
+
+    // ok
+    return (gb_gl_tess_cache_ref_t)impl;
+}
+tb_void_t gb_gl_tess_cache_exit(gb_gl_tess_cache_ref_t cache)
+{
+    // check
+    gb_gl_tess_cache_impl_t* impl = (gb_gl_tess_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // exit lru cache and all items
+    gb_lru_cache_exit(&impl->lru);
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_gl_tess_cache_clear(gb_gl_tess_cache_ref_t cache)
+{
+    // check
+    gb_gl_tess_cache_impl_t* impl = (gb_gl_tess_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // remove all items
+    gb_lru_cache_clear(&impl->lru);
+    tb_assert(!impl->vertices && !impl->resident_vertices);
+}
+gb_gl_tess_cache_entry_ref_t gb_gl_tess_cache_get(gb_gl_tess_cache_ref_t cache, gb_path_ref_t path, tb_size_t rule, tb_long_t level)
+{
+    // check
+    gb_gl_tess_cache_impl_t* impl = (gb_gl_tess_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl && path, tb_null);
+
+    // make key
+    gb_gl_tess_cache_key_t key;
+    gb_gl_tess_cache_key_make(&key, path, rule, level);
+
+    // get it
+    gb_gl_tess_cache_item_ref_t item = (gb_gl_tess_cache_item_ref_t)gb_lru_cache_get(&impl->lru, &key, tb_true);
+    return item? &item->entry : tb_null;
+}
+gb_gl_tess_cache_entry_ref_t gb_gl_tess_cache_add(gb_gl_tess_cache_ref_t cache, gb_path_ref_t path, tb_size_t rule, tb_long_t level, gb_point_ref_t points, tb_size_t count)
+{
+    // check
+    gb_gl_tess_cache_impl_t* impl = (gb_gl_tess_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl && path && (points || !count), tb_null);
+
+    // too large? not cache it
+    tb_check_return_val(count + GB_GL_TESS_CACHE_ITEM_COST <= impl->lru.maxs, tb_null);
+
+    // make key
+    gb_gl_tess_cache_key_t key;
+    gb_gl_tess_cache_key_make(&key, path, rule, level);
+
+    // exists? 
+    gb_gl_tess_cache_item_ref_t item = (gb_gl_tess_cache_item_ref_t)gb_lru_cache_get(&impl->lru, &key, tb_false);
+    if (item) return &item->entry;
+
+    // keep it resident in the vertex buffer object?
+    tb_bool_t resident = impl->resident && count >= GB_GL_TESS_CACHE_RESIDENT_MINN;
+
+    // make item, the client vertices are allocated with the item
+    item = (gb_gl_tess_cache_item_ref_t)tb_malloc0(sizeof(gb_gl_tess_cache_item_t) + (resident? 0 : count * sizeof(gb_point_t)));
+    tb_assert_and_check_return_val(item, tb_null);
+
+    // init item
+    item->key           = key;
+    item->base.size     = count + GB_GL_TESS_CACHE_ITEM_COST;
+    item->entry.count   = count;
+    impl->vertices      += count;
+
+    // upload the vertices to the vertex buffer object
+    if (resident)
+    {
+        // make buffer
+        gb_glGenBuffers(1, &item->entry.buffer);
+        if (!item->entry.buffer)
+        {
+            gb_gl_tess_cache_item_exit(&impl->lru, &item->base);
+            return tb_null;
+        }
+        impl->resident_vertices += count;
+
+        // upload it
+        gb_glBindBuffer(GB_GL_ARRAY_BUFFER, item->entry.buffer);
+        gb_glBufferData(GB_GL_ARRAY_BUFFER, (gb_GLsizeiptr_t)(count * sizeof(gb_point_t)), points, GB_GL_STATIC_DRAW);
+        gb_glBindBuffer(GB_GL_ARRAY_BUFFER, 0);
+    }
+    // copy the vertices to the client memory
+    else
+    {
+        item->entry.points = (gb_point_ref_t)(item + 1);
+        if (count) tb_memcpy(item->entry.points, points, count * sizeof(gb_point_t));
+    }
+
+    // insert it to the bucket and the head of the lru list, the least recently used items will be removed
+    if (!gb_lru_cache_insert(&impl->lru, &item->base))
+    {
+        gb_gl_tess_cache_item_exit(&impl->lru, &item->base);
+        return tb_null;
+    }
+
+    // ok
+    return &item->entry;
+}
+tb_void_t gb_gl_tess_cache_stats(gb_gl_tess_cache_ref_t cache, gb_device_gl_tess_cache_stats_ref_t stats)
+{
+    // check
+    gb_gl_tess_cache_impl_t* impl = (gb_gl_tess_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl && stats);
+
+    // the statistics
+    stats->hits         = impl->lru.hits;
+    stats->misses       = impl->lru.misses;
+    stats->evictions    = impl->lru.evictions;
+    stats->items        = gb_lru_cache_count(&impl->lru);
+    stats->vertices     = impl->vertices;
+    stats->resident     = impl->resident_vertices;
+}
+#ifdef __gb_debug__
+tb_void_t gb_gl_tess_cache_dump(gb_gl_tess_cache_ref_t cache)
+{
+    // check
+    gb_gl_tess_cache_impl_t* impl = (gb_gl_tess_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // the hit rate
+    tb_size_t total = impl->lru.hits + impl->lru.misses;
+    tb_size_t rate  = total? (impl->lru.hits * 100) / total : 0;
+
+    // trace
+    tb_trace_i("items: %lu, vertices: %lu/%lu, resident: %lu, hits: %lu, misses: %lu, rate: %lu%%, evictions: %lu", gb_lru_cache_count(&impl->lru), impl->vertices, impl->lru.maxs, impl->resident_vertices, impl->lru.hits, impl->lru.misses, rate, impl->lru.evictions);
+}
+#endif
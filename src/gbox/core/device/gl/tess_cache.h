@@ -0,0 +1,136 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        tess_cache.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_DEVICE_GL_TESS_CACHE_H
+#define GB_CORE_DEVICE_GL_TESS_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl tessellation cache entry type
+typedef struct __gb_gl_tess_cache_entry_t
+{
+    // the vertices of the triangles in the client memory, tb_null if they are resident in the vertex buffer object
+    gb_point_ref_t              points;
+
+    // the vertex buffer object of the triangles, zero if they are in the client memory
+    gb_GLuint_t                 buffer;
+
+    // the vertex count
+    tb_size_t                   count;
+
+}gb_gl_tess_cache_entry_t, *gb_gl_tess_cache_entry_ref_t;
+
+// the gl tessellation cache ref type
+typedef struct{}*               gb_gl_tess_cache_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the gl tessellation cache
+ *
+ * cache: path generation + fill rule + flattening level => triangles
+ *
+ * the least recently used triangles will be removed if the cached vertices exceed the budget
+ *
+ * @param budget        the max vertex count of all triangles, using the default budget if be zero
+ * @param resident      keep the large triangles resident in the vertex buffer objects? need gl >= 2.0
+ *
+ * @return              the cache
+ */
+gb_gl_tess_cache_ref_t  gb_gl_tess_cache_init(tb_size_t budget, tb_bool_t resident);
+
+/* exit the gl tessellation cache
+ *
+ * @note the gl context of the vertex buffer objects must be current
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_gl_tess_cache_exit(gb_gl_tess_cache_ref_t cache);
+
+/* clear the gl tessellation cache
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_gl_tess_cache_clear(gb_gl_tess_cache_ref_t cache);
+
+/* get the cached triangles of the given path
+ *
+ * @param cache         the cache
+ * @param path          the path
+ * @param rule          the fill rule
+ * @param level         the flattening level, @see gb_path_polygon2_level()
+ *
+ * @return              the cached entry, tb_null if be not cached
+ */
+gb_gl_tess_cache_entry_ref_t gb_gl_tess_cache_get(gb_gl_tess_cache_ref_t cache, gb_path_ref_t path, tb_size_t rule, tb_long_t level);
+
+/* add the triangles of the given path to cache
+ *
+ * @note the returned entry is only valid before adding the next triangles
+ *
+ * @param cache         the cache
+ * @param path          the path
+ * @param rule          the fill rule
+ * @param level         the flattening level, @see gb_path_polygon2_level()
+ * @param points        the vertices of the triangles
+ * @param count         the vertex count
+ *
+ * @return              the cached entry, tb_null if they are too large to be cached
+ */
+gb_gl_tess_cache_entry_ref_t gb_gl_tess_cache_add(gb_gl_tess_cache_ref_t cache, gb_path_ref_t path, tb_size_t rule, tb_long_t level, gb_point_ref_t points, tb_size_t count);
+
+/* the statistics of the gl tessellation cache
+ *
+ * @param cache         the cache
+ * @param stats         the statistics
+ */
+tb_void_t               gb_gl_tess_cache_stats(gb_gl_tess_cache_ref_t cache, gb_device_gl_tess_cache_stats_ref_t stats);
+
+#ifdef __gb_debug__
+/* dump the gl tessellation cache
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_gl_tess_cache_dump(gb_gl_tess_cache_ref_t cache);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -36,6 +36,7 @@
 #include "../device.h"
 #include "../bitmap.h"
 #include "../pixmap.h"
+#include "../impl/damage.h"
 #include "../../platform/platform.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -52,10 +53,10 @@ typedef struct __gb_device_impl_t
     tb_uint16_t             pixfmt;
 
     // the width
-    tb_uint16_t             width;
+    tb_uint32_t             width;
 
     // the height
-    tb_uint16_t             height;
+    tb_uint32_t             height;
 
     // the paint
     gb_paint_ref_t          paint;
@@ -66,6 +67,9 @@ typedef struct __gb_device_impl_t
     // the clipper
     gb_clipper_ref_t        clipper;
 
+    // the damaged rects of the current frame, null if the damage is not tracked by this device
+    gb_damage_ref_t         damage;
+
     /* resize
      *
      * @param device        the device
@@ -74,6 +78,12 @@ typedef struct __gb_device_impl_t
      */
     tb_void_t               (*resize)(struct __gb_device_impl_t* device, tb_size_t width, tb_size_t height);
 
+    /* flush the recorded draws, optional
+     *
+     * @param device        the device
+     */
+    tb_void_t               (*flush)(struct __gb_device_impl_t* device);
+
     /* clear draw
      *
      * @param device        the device
@@ -164,8 +174,8 @@ typedef struct __gb_shader_impl_t
     // the shader mode
     tb_uint8_t              mode;
 
-    // the reference count
-    tb_size_t               refn;
+    // the reference count, may be shared by the worker threads of the tiled device
+    tb_atomic_t             refn;
 
     // the matrix
     gb_matrix_t             matrix;
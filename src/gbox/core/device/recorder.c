@@ -0,0 +1,203 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        recorder.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "device_recorder"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../picture.h"
+#include "../impl/picture.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the recorder device type
+typedef struct __gb_recorder_device_t
+{
+    // the base
+    gb_device_impl_t                base;
+
+    // the recording picture
+    gb_picture_ref_t                picture;
+
+}gb_recorder_device_t, *gb_recorder_device_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static gb_picture_ref_t gb_device_recorder_picture(gb_recorder_device_ref_t impl)
+{
+    // check
+    tb_assert(impl);
+
+    // init the recording picture
+    if (!impl->picture) impl->picture = gb_picture_init(impl->base.width, impl->base.height);
+
+    // the picture
+    return impl->picture;
+}
+static tb_void_t gb_device_recorder_resize(gb_device_impl_t* device, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert_and_check_return(device && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
+
+    // resize
+    device->width   = (tb_uint32_t)width;
+    device->height  = (tb_uint32_t)height;
+}
+static tb_void_t gb_device_recorder_draw_clear(gb_device_impl_t* device, gb_color_t color)
+{
+    // check
+    gb_recorder_device_ref_t impl = (gb_recorder_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // record it with the bound clipper
+    gb_picture_record_clipper(gb_device_recorder_picture(impl), impl->base.clipper);
+    gb_picture_record_clear(gb_device_recorder_picture(impl), color);
+}
+static tb_void_t gb_device_recorder_draw_path(gb_device_impl_t* device, gb_path_ref_t path)
+{
+    // check
+    gb_recorder_device_ref_t impl = (gb_recorder_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->base.paint && impl->base.matrix);
+
+    // record it with the bound clipper
+    gb_picture_record_clipper(gb_device_recorder_picture(impl), impl->base.clipper);
+    gb_picture_record_path(gb_device_recorder_picture(impl), impl->base.paint, impl->base.matrix, path);
+}
+static tb_void_t gb_device_recorder_draw_lines(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_recorder_device_ref_t impl = (gb_recorder_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->base.paint && impl->base.matrix);
+
+    // record it with the bound clipper
+    gb_picture_record_clipper(gb_device_recorder_picture(impl), impl->base.clipper);
+    gb_picture_record_lines(gb_device_recorder_picture(impl), impl->base.paint, impl->base.matrix, points, count, bounds);
+}
+static tb_void_t gb_device_recorder_draw_points(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_recorder_device_ref_t impl = (gb_recorder_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->base.paint && impl->base.matrix);
+
+    // record it with the bound clipper
+    gb_picture_record_clipper(gb_device_recorder_picture(impl), impl->base.clipper);
+    gb_picture_record_points(gb_device_recorder_picture(impl), impl->base.paint, impl->base.matrix, points, count, bounds);
+}
+static tb_void_t gb_device_recorder_draw_polygon(gb_device_impl_t* device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
+{
+    // check
+    gb_recorder_device_ref_t impl = (gb_recorder_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->base.paint && impl->base.matrix);
+
+    // record it with the bound clipper
+    gb_picture_record_clipper(gb_device_recorder_picture(impl), impl->base.clipper);
+    gb_picture_record_polygon(gb_device_recorder_picture(impl), impl->base.paint, impl->base.matrix, polygon, hint, bounds);
+}
+static gb_shader_ref_t gb_device_recorder_shader_linear(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
+{
+    // trace
+    tb_trace_e("cannot make shader for the recorder, please make it from the canvas of the replaying device!");
+    return tb_null;
+}
+static gb_shader_ref_t gb_device_recorder_shader_radial(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle)
+{
+    // trace
+    tb_trace_e("cannot make shader for the recorder, please make it from the canvas of the replaying device!");
+    return tb_null;
+}
+static gb_shader_ref_t gb_device_recorder_shader_bitmap(gb_device_impl_t* device, tb_size_t mode, gb_bitmap_ref_t bitmap)
+{
+    // trace
+    tb_trace_e("cannot make shader for the recorder, please make it from the canvas of the replaying device!");
+    return tb_null;
+}
+static tb_void_t gb_device_recorder_exit(gb_device_impl_t* device)
+{
+    // check
+    gb_recorder_device_ref_t impl = (gb_recorder_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // exit the recording picture
+    if (impl->picture) gb_picture_exit(impl->picture);
+    impl->picture = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_device_ref_t gb_device_init_recorder(tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert_and_check_return_val(width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN, tb_null);
+
+    // make device
+    gb_recorder_device_ref_t impl = tb_malloc0_type(gb_recorder_device_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init base 
+    impl->base.type             = GB_DEVICE_TYPE_RECORDER;
+    impl->base.pixfmt           = GB_PIXFMT_NONE;
+    impl->base.width            = (tb_uint32_t)width;
+    impl->base.height           = (tb_uint32_t)height;
+    impl->base.resize           = gb_device_recorder_resize;
+    impl->base.draw_clear       = gb_device_recorder_draw_clear;
+    impl->base.draw_path        = gb_device_recorder_draw_path;
+    impl->base.draw_lines       = gb_device_recorder_draw_lines;
+    impl->base.draw_points      = gb_device_recorder_draw_points;
+    impl->base.draw_polygon     = gb_device_recorder_draw_polygon;
+    impl->base.shader_linear    = gb_device_recorder_shader_linear;
+    impl->base.shader_radial    = gb_device_recorder_shader_radial;
+    impl->base.shader_bitmap    = gb_device_recorder_shader_bitmap;
+    impl->base.exit             = gb_device_recorder_exit;
+
+    // ok
+    return (gb_device_ref_t)impl;
+}
+gb_picture_ref_t gb_device_recorder_done(gb_device_ref_t device)
+{
+    // check
+    gb_recorder_device_ref_t impl = (gb_recorder_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && impl->base.type == GB_DEVICE_TYPE_RECORDER, tb_null);
+
+    // the recorded picture, the next draws will be recorded into a new picture
+    gb_picture_ref_t picture = gb_device_recorder_picture(impl);
+    impl->picture = tb_null;
+
+    // ok
+    return picture;
+}
@@ -0,0 +1,478 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        clip_mask.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "clip_mask"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "clip_mask.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the runs grow count
+#ifdef __gb_small__
+#   define GB_CLIP_MASK_GROW            (64)
+#else
+#   define GB_CLIP_MASK_GROW            (256)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the clip mask line type, the runs cover the whole line without gaps
+typedef struct __gb_clip_mask_line_t
+{
+    // the runs
+    gb_clip_mask_run_ref_t      runs;
+
+    // the runs count
+    tb_size_t                   count;
+
+    // the runs maxn
+    tb_size_t                   maxn;
+
+}gb_clip_mask_line_t, *gb_clip_mask_line_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_clip_mask_runs_grow(gb_clip_mask_run_ref_t* runs, tb_size_t* maxn, tb_size_t count)
+{
+    // check
+    tb_assert(runs && maxn);
+
+    // enough?
+    tb_check_return_val(count > *maxn, tb_true);
+
+    // grow it
+    *maxn = count + GB_CLIP_MASK_GROW + (*maxn >> 1);
+    *runs = (gb_clip_mask_run_ref_t)tb_ralloc(*runs, *maxn * sizeof(gb_clip_mask_run_t));
+    tb_assert_and_check_return_val(*runs, tb_false);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_clip_mask_line_append(gb_clip_mask_line_ref_t line, tb_long_t left, tb_long_t right, tb_byte_t alpha)
+{
+    // check
+    tb_assert(line);
+
+    // empty?
+    tb_check_return(left < right);
+
+    // same alpha with the previous run? merge it
+    if (line->count && line->runs[line->count - 1].alpha == alpha)
+    {
+        line->runs[line->count - 1].right = (tb_int32_t)right;
+        return ;
+    }
+
+    // grow runs
+    if (!gb_clip_mask_runs_grow(&line->runs, &line->maxn, line->count + 1)) return ;
+
+    // append it
+    gb_clip_mask_run_ref_t run = line->runs + line->count++;
+    run->left   = (tb_int32_t)left;
+    run->right  = (tb_int32_t)right;
+    run->alpha  = alpha;
+}
+static tb_void_t gb_clip_mask_line_append_gap(gb_clip_mask_line_ref_t line, gb_clip_mask_ref_t mask, tb_long_t left, tb_long_t right)
+{
+    // the gap outside the left of the bounds
+    if (left < mask->left) 
+    {
+        gb_clip_mask_line_append(line, left, tb_min(right, mask->left), mask->outside);
+        left = mask->left;
+    }
+
+    // the gap inside the bounds
+    if (left < mask->right) 
+    {
+        gb_clip_mask_line_append(line, left, tb_min(right, mask->right), 0);
+        left = mask->right;
+    }
+
+    // the gap outside the right of the bounds
+    gb_clip_mask_line_append(line, left, right, mask->outside);
+}
+static tb_void_t gb_clip_mask_line_make(gb_clip_mask_line_ref_t line, gb_clip_mask_ref_t mask, tb_long_t y, tb_long_t left, tb_long_t right)
+{
+    // check
+    tb_assert(line && left < right);
+
+    // clear line
+    line->count = 0;
+
+    // not masked?
+    if (!mask)
+    {
+        gb_clip_mask_line_append(line, left, right, 0xff);
+        return ;
+    }
+
+    // outside the bounds?
+    if (y < mask->top || y >= mask->bottom)
+    {
+        gb_clip_mask_line_append(line, left, right, mask->outside);
+        return ;
+    }
+
+    // make the runs and the gaps
+    tb_long_t               x = left;
+    gb_clip_mask_run_ref_t  end = tb_null;
+    gb_clip_mask_run_ref_t  run = gb_clip_mask_run(mask, left, y, &end);
+    for (; run < end && run->left < right; run++)
+    {
+        // the gap before this run
+        if (x < run->left) gb_clip_mask_line_append_gap(line, mask, x, run->left);
+
+        // the run
+        tb_long_t r = tb_min(run->right, right);
+        gb_clip_mask_line_append(line, tb_max(x, run->left), r, run->alpha);
+        x = r;
+    }
+
+    // the gap after all runs
+    if (x < right) gb_clip_mask_line_append_gap(line, mask, x, right);
+}
+static tb_void_t gb_clip_mask_line_make_region(gb_clip_mask_line_ref_t line, gb_region_ref_t region, tb_long_t y, tb_long_t left, tb_long_t right)
+{
+    // check
+    tb_assert(line && region && left < right);
+
+    // clear line
+    line->count = 0;
+
+    // make the intervals and the gaps
+    tb_long_t               x = left;
+    gb_region_band_ref_t    band = gb_region_band(region, y);
+    if (band && band->top <= y)
+    {
+        gb_region_interval_ref_t interval       = region->intervals + band->index;
+        gb_region_interval_ref_t interval_end   = interval + band->count;
+        for (; interval < interval_end && interval->left < right; interval++)
+        {
+            // outside?
+            if (interval->right <= x) continue;
+
+            // the gap before this interval
+            if (x < interval->left) gb_clip_mask_line_append(line, x, interval->left, 0);
+
+            // the interval
+            tb_long_t r = tb_min(interval->right, right);
+            gb_clip_mask_line_append(line, tb_max(x, interval->left), r, 0xff);
+            x = r;
+        }
+    }
+
+    // the gap after all intervals
+    if (x < right) gb_clip_mask_line_append(line, x, right, 0);
+}
+static __tb_inline__ tb_byte_t gb_clip_mask_alpha_op(tb_size_t op, tb_byte_t a, tb_byte_t b)
+{
+    switch (op)
+    {
+    case GB_REGION_OP_SUBTRACT:     return gb_clip_mask_alpha_mul(a, 0xff - b);
+    case GB_REGION_OP_INTERSECT:    return gb_clip_mask_alpha_mul(a, b);
+    case GB_REGION_OP_UNION:        return (tb_byte_t)(a + b - gb_clip_mask_alpha_mul(a, b));
+    default:                        return b;
+    }
+}
+static tb_void_t gb_clip_mask_line_op(gb_clip_mask_line_ref_t result, gb_clip_mask_line_ref_t a, gb_clip_mask_line_ref_t b, tb_size_t op)
+{
+    // check
+    tb_assert(result && a && b && a->count && b->count);
+    tb_assert(a->runs[0].left == b->runs[0].left && a->runs[a->count - 1].right == b->runs[b->count - 1].right);
+
+    // clear result
+    result->count = 0;
+
+    // merge the runs of the two lines
+    gb_clip_mask_run_ref_t  ra = a->runs;
+    gb_clip_mask_run_ref_t  rb = b->runs;
+    gb_clip_mask_run_ref_t  ea = a->runs + a->count;
+    gb_clip_mask_run_ref_t  eb = b->runs + b->count;
+    tb_long_t               x = ra->left;
+    while (ra < ea && rb < eb)
+    {
+        // the right of this piece
+        tb_long_t r = tb_min(ra->right, rb->right);
+
+        // append it
+        gb_clip_mask_line_append(result, x, r, gb_clip_mask_alpha_op(op, ra->alpha, rb->alpha));
+        x = r;
+
+        // next runs
+        if (ra->right == r) ra++;
+        if (rb->right == r) rb++;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_clip_mask_ref_t gb_clip_mask_init(tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom, tb_byte_t outside)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_clip_mask_ref_t  mask = tb_null;
+    do
+    {
+        // check
+        tb_assert_and_check_break(left <= right && top <= bottom);
+
+        // make mask
+        mask = tb_malloc0_type(gb_clip_mask_t);
+        tb_assert_and_check_break(mask);
+
+        // init it
+        mask->refn      = 1;
+        mask->left      = left;
+        mask->top       = top;
+        mask->right     = right;
+        mask->bottom    = bottom;
+        mask->outside   = outside;
+        mask->row       = top;
+
+        // init rows
+        mask->rows = tb_nalloc0_type(bottom - top + 1, tb_uint32_t);
+        tb_assert_and_check_break(mask->rows);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (mask) gb_clip_mask_exit(mask);
+        mask = tb_null;
+    }
+
+    // ok?
+    return mask;
+}
+gb_clip_mask_ref_t gb_clip_mask_init_op(gb_clip_mask_ref_t mask, gb_region_ref_t region, gb_clip_mask_ref_t shape, tb_size_t op, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom)
+{
+    // check
+    tb_assert_and_check_return_val(shape, tb_null);
+
+    // init the result
+    gb_clip_mask_ref_t result = gb_clip_mask_init(left, top, right, bottom, 0xff);
+    tb_assert_and_check_return_val(result, tb_null);
+
+    // empty?
+    if (left >= right || top >= bottom)
+    {
+        gb_clip_mask_done(result);
+        return result;
+    }
+
+    // combine them line by line
+    tb_long_t           y = 0;
+    gb_clip_mask_line_t lines[4];
+    tb_memset(lines, 0, sizeof(lines));
+    for (y = top; y < bottom; y++)
+    {
+        // the line of the clip mask
+        gb_clip_mask_line_ref_t a = &lines[0];
+        gb_clip_mask_line_make(a, mask, y, left, right);
+
+        // multiply the clip region
+        if (region)
+        {
+            gb_clip_mask_line_make_region(&lines[1], region, y, left, right);
+            gb_clip_mask_line_op(&lines[2], &lines[1], a, GB_REGION_OP_INTERSECT);
+            a = &lines[2];
+        }
+
+        // the line of the shape
+        gb_clip_mask_line_make(&lines[1], shape, y, left, right);
+
+        // combine them
+        gb_clip_mask_line_op(&lines[3], a, &lines[1], op);
+
+        // append the result runs
+        tb_size_t               i = 0;
+        gb_clip_mask_run_ref_t  run = lines[3].runs;
+        for (i = 0; i < lines[3].count; i++, run++)
+            gb_clip_mask_append(result, run->left, run->right, y, run->alpha);
+    }
+
+    // exit lines
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(lines); i++)
+    {
+        if (lines[i].runs) tb_free(lines[i].runs);
+    }
+
+    // done it
+    gb_clip_mask_done(result);
+
+    // ok
+    return result;
+}
+gb_clip_mask_ref_t gb_clip_mask_retain(gb_clip_mask_ref_t mask)
+{
+    // check
+    tb_assert_and_check_return_val(mask, tb_null);
+
+    // retain it
+    mask->refn++;
+
+    // ok
+    return mask;
+}
+tb_void_t gb_clip_mask_exit(gb_clip_mask_ref_t mask)
+{
+    // check
+    tb_assert_and_check_return(mask && mask->refn);
+
+    // release it
+    tb_check_return(!--mask->refn);
+
+    // exit rows
+    if (mask->rows) tb_free(mask->rows);
+
+    // exit runs
+    if (mask->runs) tb_free(mask->runs);
+
+    // exit it
+    tb_free(mask);
+}
+tb_bool_t gb_clip_mask_append(gb_clip_mask_ref_t mask, tb_long_t left, tb_long_t right, tb_long_t y, tb_byte_t alpha)
+{
+    // check
+    tb_assert(mask && mask->rows && y >= mask->row);
+
+    // clip it
+    left    = tb_max(left, mask->left);
+    right   = tb_min(right, mask->right);
+
+    // transparent or outside? ignore it
+    tb_check_return_val(alpha && left < right && y >= mask->top && y < mask->bottom, tb_true);
+
+    // finish the previous rows
+    while (mask->row < y) mask->rows[++mask->row - mask->top] = (tb_uint32_t)mask->runs_count;
+
+    // adjacent to the previous run of this row and have the same alpha? merge it
+    if (mask->runs_count > mask->rows[y - mask->top])
+    {
+        gb_clip_mask_run_ref_t prev = mask->runs + mask->runs_count - 1;
+        tb_assert(left >= prev->right);
+        if (prev->right == left && prev->alpha == alpha)
+        {
+            prev->right = (tb_int32_t)right;
+            return tb_true;
+        }
+    }
+
+    // grow runs
+    if (!gb_clip_mask_runs_grow(&mask->runs, &mask->runs_maxn, mask->runs_count + 1)) return tb_false;
+
+    // append it
+    gb_clip_mask_run_ref_t run = mask->runs + mask->runs_count++;
+    run->left   = (tb_int32_t)left;
+    run->right  = (tb_int32_t)right;
+    run->alpha  = alpha;
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_clip_mask_done(gb_clip_mask_ref_t mask)
+{
+    // check
+    tb_assert_and_check_return(mask && mask->rows);
+
+    // finish the left rows
+    while (mask->row < mask->bottom) mask->rows[++mask->row - mask->top] = (tb_uint32_t)mask->runs_count;
+}
+tb_byte_t gb_clip_mask_alpha(gb_clip_mask_ref_t mask, tb_long_t x, tb_long_t y)
+{
+    // check
+    tb_assert(mask);
+
+    // outside?
+    tb_check_return_val(x >= mask->left && x < mask->right && y >= mask->top && y < mask->bottom, mask->outside);
+
+    // the run
+    gb_clip_mask_run_ref_t end = tb_null;
+    gb_clip_mask_run_ref_t run = gb_clip_mask_run(mask, x, y, &end);
+
+    // the alpha
+    return (run < end && run->left <= x)? run->alpha : 0;
+}
+gb_clip_mask_run_ref_t gb_clip_mask_run(gb_clip_mask_ref_t mask, tb_long_t x, tb_long_t y, gb_clip_mask_run_ref_t* end)
+{
+    // check
+    tb_assert(mask && mask->rows && end && y >= mask->top && y < mask->bottom);
+
+    // the runs of this row
+    gb_clip_mask_run_ref_t  runs = mask->runs + mask->rows[y - mask->top];
+    tb_size_t               count = mask->rows[y - mask->top + 1] - mask->rows[y - mask->top];
+
+    // find it
+    tb_size_t l = 0;
+    tb_size_t r = count;
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (runs[m].right <= x) l = m + 1;
+        else r = m;
+    }
+
+    // ok
+    *end = runs + count;
+    return runs + l;
+}
+#ifdef __gb_debug__
+tb_void_t gb_clip_mask_dump(gb_clip_mask_ref_t mask)
+{
+    // check
+    tb_assert_and_check_return(mask && mask->rows);
+
+    // trace
+    tb_trace_i("mask: bounds: %ld, %ld, %ld, %ld, outside: %u, runs: %lu, refn: %lu", mask->left, mask->top, mask->right, mask->bottom, mask->outside, mask->runs_count, mask->refn);
+
+    // dump rows
+    tb_long_t y = 0;
+    for (y = mask->top; y < mask->bottom; y++)
+    {
+        tb_uint32_t i = 0;
+        for (i = mask->rows[y - mask->top]; i < mask->rows[y - mask->top + 1]; i++)
+            tb_trace_i("    %ld: [%d, %d): %u", y, mask->runs[i].left, mask->runs[i].right, mask->runs[i].alpha);
+    }
+}
+#endif
@@ -0,0 +1,215 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        clip_mask.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_CLIP_MASK_H
+#define GB_CORE_IMPL_CLIP_MASK_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "region.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the clip mask run type, [left, right) with the same coverage
+typedef struct __gb_clip_mask_run_t
+{
+    // the left
+    tb_int32_t                  left;
+
+    // the right, exclusive
+    tb_int32_t                  right;
+
+    // the coverage alpha, 0xff: full covered
+    tb_byte_t                   alpha;
+
+}gb_clip_mask_run_t, *gb_clip_mask_run_ref_t;
+
+/* the clip mask type
+ *
+ * the coverage of the device pixels is stored as the run-length-encoded rows,
+ * the pixels inside the bounds but not covered by any run are transparent
+ * and the alpha of the pixels outside the bounds is the outside alpha.
+ *
+ * the mask is immutable after making it and is shared by the reference count,
+ * so the saved clippers only retain it and the combined mask is always a new one.
+ */
+typedef struct __gb_clip_mask_t
+{
+    // the reference count
+    tb_size_t                   refn;
+
+    // the left
+    tb_long_t                   left;
+
+    // the top
+    tb_long_t                   top;
+
+    // the right, exclusive
+    tb_long_t                   right;
+
+    // the bottom, exclusive
+    tb_long_t                   bottom;
+
+    // the alpha outside the bounds, 0: the shape coverage, 0xff: the clip mask
+    tb_byte_t                   outside;
+
+    // the current row when making it
+    tb_long_t                   row;
+
+    // the runs index of the rows, the runs of row y are [rows[y - top], rows[y - top + 1])
+    tb_uint32_t*                rows;
+
+    // the runs
+    gb_clip_mask_run_ref_t      runs;
+
+    // the runs count
+    tb_size_t                   runs_count;
+
+    // the runs maxn
+    tb_size_t                   runs_maxn;
+
+}gb_clip_mask_t, *gb_clip_mask_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init an empty mask for making it row by row
+ *
+ * @param left          the left
+ * @param top           the top
+ * @param right         the right, exclusive
+ * @param bottom        the bottom, exclusive
+ * @param outside       the alpha outside the bounds
+ *
+ * @return              the mask
+ */
+gb_clip_mask_ref_t      gb_clip_mask_init(tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom, tb_byte_t outside);
+
+/* init a new mask by combining the shape coverage to the clip mask
+ *
+ * the coverage inside the given bounds is op(region * mask, shape),
+ * the pixels outside the bounds are not masked
+ *
+ * @param mask          the clip mask, not masked if be null
+ * @param region        the clip region for the union op, ignored if be null
+ * @param shape         the shape coverage
+ * @param op            the op, same as gb_region_op_e
+ * @param left          the left
+ * @param top           the top
+ * @param right         the right, exclusive
+ * @param bottom        the bottom, exclusive
+ *
+ * @return              the new mask
+ */
+gb_clip_mask_ref_t      gb_clip_mask_init_op(gb_clip_mask_ref_t mask, gb_region_ref_t region, gb_clip_mask_ref_t shape, tb_size_t op, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom);
+
+/* retain the mask
+ *
+ * @param mask          the mask
+ *
+ * @return              the mask
+ */
+gb_clip_mask_ref_t      gb_clip_mask_retain(gb_clip_mask_ref_t mask);
+
+/* release the mask and exit it if no one retains it
+ *
+ * @param mask          the mask
+ */
+tb_void_t               gb_clip_mask_exit(gb_clip_mask_ref_t mask);
+
+/* append a run to the current or the next rows
+ *
+ * @param mask          the mask
+ * @param left          the left
+ * @param right         the right, exclusive
+ * @param y             the y-coordinate, must not be above the previous run
+ * @param alpha         the coverage alpha
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_clip_mask_append(gb_clip_mask_ref_t mask, tb_long_t left, tb_long_t right, tb_long_t y, tb_byte_t alpha);
+
+/* finish making the mask
+ *
+ * @param mask          the mask
+ */
+tb_void_t               gb_clip_mask_done(gb_clip_mask_ref_t mask);
+
+/* the alpha of the given pixel
+ *
+ * @param mask          the mask
+ * @param x             the x-coordinate
+ * @param y             the y-coordinate
+ *
+ * @return              the alpha
+ */
+tb_byte_t               gb_clip_mask_alpha(gb_clip_mask_ref_t mask, tb_long_t x, tb_long_t y);
+
+/* the first run of the row whose right is after the given x-coordinate
+ *
+ * @param mask          the mask
+ * @param x             the x-coordinate
+ * @param y             the y-coordinate, must be inside the bounds
+ * @param end           the end of the runs of this row
+ *
+ * @return              the run, it is equal to the end if no run is after x
+ */
+gb_clip_mask_run_ref_t  gb_clip_mask_run(gb_clip_mask_ref_t mask, tb_long_t x, tb_long_t y, gb_clip_mask_run_ref_t* end);
+
+/* multiply the two alphas: (a * b) / 255
+ *
+ * @param a             the alpha
+ * @param b             the other alpha
+ *
+ * @return              the alpha
+ */
+static __tb_inline__ tb_byte_t gb_clip_mask_alpha_mul(tb_size_t a, tb_size_t b)
+{
+    tb_size_t v = a * b + 0x80;
+    return (tb_byte_t)((v + (v >> 8)) >> 8);
+}
+
+#ifdef __gb_debug__
+/* dump the mask
+ *
+ * @param mask          the mask
+ */
+tb_void_t               gb_clip_mask_dump(gb_clip_mask_ref_t mask);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
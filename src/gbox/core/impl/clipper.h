@@ -0,0 +1,88 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        clipper.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_CLIPPER_H
+#define GB_CORE_IMPL_CLIPPER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "region.h"
+#include "clip_mask.h"
+#include "../clipper.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* the clipped region of the device pixels
+ *
+ * @param clipper               the clipper
+ *
+ * @return                      the region, tb_null if nothing is clipped
+ */
+gb_region_ref_t                 gb_clipper_region(gb_clipper_ref_t clipper);
+
+/* the coverage mask of the clipped non-rect shapes
+ *
+ * the clipped coverage of the device pixels is region * mask
+ *
+ * @param clipper               the clipper
+ *
+ * @return                      the mask, tb_null if only the region is clipped
+ */
+gb_clip_mask_ref_t              gb_clipper_mask(gb_clipper_ref_t clipper);
+
+/* the generation of the clipped region and mask
+ *
+ * it is changed after clipping the new shapes and the copied clipper has the same generation
+ *
+ * @param clipper               the clipper
+ *
+ * @return                      the generation, zero if nothing is clipped
+ */
+tb_size_t                       gb_clipper_generation(gb_clipper_ref_t clipper);
+
+/* intersect the clipped pixels of the other clipper
+ *
+ * the pixels of the other clipper are transformed by the matrix of the clipper,
+ * they are combined exactly for the identity matrix, 
+ * otherwise the pixels covered by half or more inside the max device bounds are clipped as the rects
+ *
+ * @param clipper               the clipper
+ * @param other                 the other clipper
+ */
+tb_void_t                       gb_clipper_intersect(gb_clipper_ref_t clipper, gb_clipper_ref_t other);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
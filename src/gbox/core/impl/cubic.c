@@ -287,4 +287,12 @@ tb_void_t gb_cubic_make_line(gb_point_t const points[4], gb_cubic_line_func_t fu
     // make line
     gb_cubic_make_line_impl(points, count, func, priv);
 }
+tb_void_t gb_cubic_make_line2(gb_point_t const points[4], tb_size_t count, gb_cubic_line_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(func && points);
+
+    // make line
+    gb_cubic_make_line_impl(points, count, func, priv);
+}
 
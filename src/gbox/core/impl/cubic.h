@@ -159,6 +159,17 @@ tb_size_t           gb_cubic_chop_at_max_curvature(gb_point_t const points[4], g
  */
 tb_void_t           gb_cubic_make_line(gb_point_t const points[4], gb_cubic_line_func_t func, tb_cpointer_t priv);
 
+/* make line-to points for the cubic curve with the given divided count
+ *
+ * the curve will be divided to (1 << count) line segments
+ *
+ * @param points    the points
+ * @param count     the divided count
+ * @param func      the make func
+ * @param priv      the make func private data for user
+ */
+tb_void_t           gb_cubic_make_line2(gb_point_t const points[4], tb_size_t count, gb_cubic_line_func_t func, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
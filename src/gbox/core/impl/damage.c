@@ -0,0 +1,153 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        damage.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "damage"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "damage.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_hize_t gb_damage_rect_area(tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom)
+{
+    return (tb_hize_t)(right - left) * (tb_hize_t)(bottom - top);
+}
+static __tb_inline__ tb_hize_t gb_damage_rect_union_area(gb_damage_rect_ref_t rect, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom)
+{
+    return gb_damage_rect_area(tb_min(rect->left, left), tb_min(rect->top, top), tb_max(rect->right, right), tb_max(rect->bottom, bottom));
+}
+static tb_void_t gb_damage_remove(gb_damage_ref_t damage, tb_size_t index)
+{
+    // check
+    tb_assert(damage && index < damage->count);
+
+    // move the last rect to this position
+    damage->items[index] = damage->items[--damage->count];
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_damage_clear(gb_damage_ref_t damage)
+{
+    // check
+    tb_assert_and_check_return(damage);
+
+    // clear it
+    damage->count = 0;
+}
+tb_void_t gb_damage_add(gb_damage_ref_t damage, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom)
+{
+    // check
+    tb_assert_and_check_return(damage && damage->count <= GB_DAMAGE_RECTS_MAXN);
+
+    // empty?
+    tb_check_return(left < right && top < bottom);
+
+    /* merge it with the damaged rects
+     *
+     * the rect will be merged with the damaged rect which will not increase the damaged area, 
+     * and the merged rect will be added again for merging the others
+     */
+    tb_size_t index = 0;
+    while (index < damage->count)
+    {
+        // the damaged rect
+        gb_damage_rect_ref_t rect = damage->items + index;
+
+        // contained by this rect? ok
+        if (left >= rect->left && top >= rect->top && right <= rect->right && bottom <= rect->bottom) return ;
+
+        // this rect will not increase the area after merging? remove it and add the merged rect
+        if (gb_damage_rect_union_area(rect, left, top, right, bottom) <= gb_damage_rect_area(rect->left, rect->top, rect->right, rect->bottom) + gb_damage_rect_area(left, top, right, bottom))
+        {
+            // merge it
+            left    = tb_min(rect->left, left);
+            top     = tb_min(rect->top, top);
+            right   = tb_max(rect->right, right);
+            bottom  = tb_max(rect->bottom, bottom);
+
+            // remove this rect and merge the others again
+            gb_damage_remove(damage, index);
+            index = 0;
+        }
+        else index++;
+    }
+
+    // full? merge it to the rect with the minimum increased area
+    if (damage->count == GB_DAMAGE_RECTS_MAXN)
+    {
+        // find the best rect
+        tb_size_t best = 0;
+        tb_hize_t best_area = (tb_hize_t)-1;
+        for (index = 0; index < damage->count; index++)
+        {
+            gb_damage_rect_ref_t    rect = damage->items + index;
+            tb_hize_t               area = gb_damage_rect_union_area(rect, left, top, right, bottom) - gb_damage_rect_area(rect->left, rect->top, rect->right, rect->bottom);
+            if (area < best_area)
+            {
+                best        = index;
+                best_area   = area;
+            }
+        }
+
+        // merge it and add the merged rect again, it may contain the others now
+        gb_damage_rect_t rect = damage->items[best];
+        gb_damage_remove(damage, best);
+        gb_damage_add(damage, tb_min(rect.left, left), tb_min(rect.top, top), tb_max(rect.right, right), tb_max(rect.bottom, bottom));
+        return ;
+    }
+
+    // append it
+    gb_damage_rect_ref_t rect = damage->items + damage->count++;
+    rect->left      = left;
+    rect->top       = top;
+    rect->right     = right;
+    rect->bottom    = bottom;
+}
+gb_rect_ref_t gb_damage_rects(gb_damage_ref_t damage, tb_size_t* count)
+{
+    // check
+    tb_assert_and_check_return_val(damage && count, tb_null);
+
+    // make the rects
+    tb_size_t index = 0;
+    for (index = 0; index < damage->count; index++)
+    {
+        gb_damage_rect_ref_t rect = damage->items + index;
+        gb_rect_imake(&damage->rects[index], rect->left, rect->top, rect->right - rect->left, rect->bottom - rect->top);
+    }
+
+    // ok
+    *count = damage->count;
+    return damage->rects;
+}
@@ -0,0 +1,122 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        damage.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_DAMAGE_H
+#define GB_CORE_IMPL_DAMAGE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the damaged rects maxn, the rects will be merged if be full
+#ifdef __gb_small__
+#   define GB_DAMAGE_RECTS_MAXN         (4)
+#else
+#   define GB_DAMAGE_RECTS_MAXN         (8)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the damaged pixels rect type: [left, right) x [top, bottom)
+typedef struct __gb_damage_rect_t
+{
+    // the left
+    tb_long_t               left;
+
+    // the top
+    tb_long_t               top;
+
+    // the right
+    tb_long_t               right;
+
+    // the bottom
+    tb_long_t               bottom;
+
+}gb_damage_rect_t, *gb_damage_rect_ref_t;
+
+/* the damage type
+ *
+ * a short list of the damaged rects in the device coordinate,
+ * the overlapped rects will be merged and the list will never exceed GB_DAMAGE_RECTS_MAXN
+ */
+typedef struct __gb_damage_t
+{
+    // the damaged rects
+    gb_damage_rect_t        items[GB_DAMAGE_RECTS_MAXN];
+
+    // the damaged rects for the interfaces
+    gb_rect_t               rects[GB_DAMAGE_RECTS_MAXN];
+
+    // the damaged rects count
+    tb_size_t               count;
+
+}gb_damage_t, *gb_damage_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* clear the damage
+ *
+ * @param damage        the damage
+ */
+tb_void_t               gb_damage_clear(gb_damage_ref_t damage);
+
+/* add the damaged rect
+ *
+ * @param damage        the damage
+ * @param left          the left
+ * @param top           the top
+ * @param right         the right
+ * @param bottom        the bottom
+ */
+tb_void_t               gb_damage_add(gb_damage_ref_t damage, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom);
+
+/* the damaged rects
+ *
+ * @param damage        the damage
+ * @param count         the rects count
+ *
+ * @return              the rects
+ */
+gb_rect_ref_t           gb_damage_rects(gb_damage_ref_t damage, tb_size_t* count);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,216 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        lru_cache.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "lru_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "lru_cache.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the key of the item
+#define gb_lru_cache_item_key(cache, item)      ((tb_byte_t const*)(item) + (cache)->key_offset)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_lru_cache_remove_last(gb_lru_cache_ref_t cache)
+{
+    // check
+    tb_assert(cache && cache->buckets && cache->exit);
+
+    // the least recently used item
+    gb_lru_cache_item_ref_t item = (gb_lru_cache_item_ref_t)tb_list_entry(&cache->list, tb_list_entry_last(&cache->list));
+    tb_assert(item);
+
+    // remove it from the bucket
+    gb_lru_cache_item_ref_t* link = &cache->buckets[item->hash & (cache->buckets_count - 1)];
+    while (*link && *link != item) link = &(*link)->next;
+    tb_assert(*link == item);
+    *link = item->next;
+
+    // remove it from the lru list
+    tb_list_entry_remove_last(&cache->list);
+
+    // update size
+    tb_assert(cache->size >= item->size);
+    cache->size -= item->size;
+
+    // exit it
+    cache->exit(cache, item);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_lru_cache_init(gb_lru_cache_ref_t cache, tb_size_t buckets, tb_size_t maxn, tb_size_t maxs, tb_size_t key_offset, tb_size_t key_size, gb_lru_cache_hash_func_t hash, gb_lru_cache_exit_func_t exit)
+{
+    // check
+    tb_assert_and_check_return_val(cache && key_offset >= sizeof(gb_lru_cache_item_t) && key_size && hash && exit, tb_false);
+
+    // init cache
+    tb_memset(cache, 0, sizeof(gb_lru_cache_t));
+    cache->key_offset   = key_offset;
+    cache->key_size     = key_size;
+    cache->hash         = hash;
+    cache->exit         = exit;
+    cache->maxn         = maxn;
+    cache->maxs         = maxs;
+
+    // init lru list, the entry is the first member of the item
+    tb_list_entry_init_(&cache->list, 0, sizeof(gb_lru_cache_item_t), tb_null);
+
+    // init buckets
+    cache->buckets_count = 1;
+    while (cache->buckets_count < buckets) cache->buckets_count <<= 1;
+    cache->buckets = tb_nalloc0_type(cache->buckets_count, gb_lru_cache_item_ref_t);
+    tb_assert_and_check_return_val(cache->buckets, tb_false);
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_lru_cache_exit(gb_lru_cache_ref_t cache)
+{
+    // check
+    tb_assert_and_check_return(cache);
+
+    // exit all items
+    if (cache->buckets) gb_lru_cache_clear(cache);
+
+    // exit lru list
+    tb_list_entry_exit(&cache->list);
+
+    // exit buckets
+    if (cache->buckets) tb_free(cache->buckets);
+    cache->buckets = tb_null;
+}
+tb_void_t gb_lru_cache_clear(gb_lru_cache_ref_t cache)
+{
+    // check
+    tb_assert_and_check_return(cache && cache->buckets);
+
+    // remove all items
+    while (!tb_list_entry_is_null(&cache->list)) gb_lru_cache_remove_last(cache);
+    tb_assert(!cache->size);
+
+    // clear counts
+    cache->hits         = 0;
+    cache->misses       = 0;
+    cache->evictions    = 0;
+}
+gb_lru_cache_item_ref_t gb_lru_cache_get(gb_lru_cache_ref_t cache, tb_cpointer_t key, tb_bool_t counted)
+{
+    // check
+    tb_assert(cache && cache->buckets && key);
+
+    // find the item in the bucket
+    tb_size_t               hash = cache->hash(key);
+    gb_lru_cache_item_ref_t item = cache->buckets[hash & (cache->buckets_count - 1)];
+    while (item)
+    {
+        if (item->hash == hash && !tb_memcmp(gb_lru_cache_item_key(cache, item), key, cache->key_size)) break;
+        item = item->next;
+    }
+
+    // not found?
+    if (!item)
+    {
+        if (counted) cache->misses++;
+        return tb_null;
+    }
+
+    // move it to the head of the lru list
+    tb_list_entry_moveto_head(&cache->list, &item->entry);
+
+    // hit it
+    if (counted) cache->hits++;
+    return item;
+}
+tb_bool_t gb_lru_cache_insert(gb_lru_cache_ref_t cache, gb_lru_cache_item_ref_t item)
+{
+    // check
+    tb_assert(cache && cache->buckets && item);
+
+    // too large? not cache it
+    tb_check_return_val(item->size <= cache->maxs, tb_false);
+
+    // remove the least recently used items
+    while (!tb_list_entry_is_null(&cache->list) && ((cache->maxn && gb_lru_cache_count(cache) >= cache->maxn) || cache->size + item->size > cache->maxs))
+    {
+        gb_lru_cache_remove_last(cache);
+        cache->evictions++;
+    }
+
+    // insert it to the bucket
+    item->hash = cache->hash(gb_lru_cache_item_key(cache, item));
+    gb_lru_cache_item_ref_t* link = &cache->buckets[item->hash & (cache->buckets_count - 1)];
+    item->next = *link;
+    *link = item;
+
+    // insert it to the head of the lru list
+    tb_list_entry_insert_head(&cache->list, &item->entry);
+
+    // update size
+    cache->size += item->size;
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_lru_cache_trim(gb_lru_cache_ref_t cache, tb_size_t maxn, tb_size_t maxs)
+{
+    // check
+    tb_assert_and_check_return(cache && cache->buckets);
+
+    // remove the least recently used items
+    while (!tb_list_entry_is_null(&cache->list) && ((maxn && gb_lru_cache_count(cache) > maxn) || cache->size > maxs))
+    {
+        gb_lru_cache_remove_last(cache);
+        cache->evictions++;
+    }
+}
+tb_size_t gb_lru_cache_hash_bytes(tb_cpointer_t key, tb_size_t size)
+{
+    // check
+    tb_assert(key);
+
+    // fnv-1a hash
+    tb_size_t           hash = 2166136261u;
+    tb_byte_t const*    p = (tb_byte_t const*)key;
+    tb_byte_t const*    e = p + size;
+    while (p < e)
+    {
+        hash ^= *p++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,216 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        lru_cache.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_LRU_CACHE_H
+#define GB_CORE_IMPL_LRU_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the lru cache item type
+ *
+ * it must be the first member of the cached item, and the key is stored in the cached item
+ */
+typedef struct __gb_lru_cache_item_t
+{
+    // the list entry for the lru order, the head is the most recently used item
+    tb_list_entry_t                 entry;
+
+    // the next item of the same bucket
+    struct __gb_lru_cache_item_t*   next;
+
+    // the key hash
+    tb_size_t                       hash;
+
+    // the size charged to the cache budget
+    tb_size_t                       size;
+
+}gb_lru_cache_item_t, *gb_lru_cache_item_ref_t;
+
+// the lru cache type
+struct __gb_lru_cache_t;
+
+/* the key hash func type
+ *
+ * @param key           the key, the equal keys are compared as bytes
+ *
+ * @return              the hash
+ */
+typedef tb_size_t       (*gb_lru_cache_hash_func_t)(tb_cpointer_t key);
+
+/* the item exit func type
+ *
+ * @param cache         the cache
+ * @param item          the removed item for freeing it
+ */
+typedef tb_void_t       (*gb_lru_cache_exit_func_t)(struct __gb_lru_cache_t* cache, gb_lru_cache_item_ref_t item);
+
+/* the intrusive hashed lru cache type
+ *
+ * it indexes the items, keeps the lru order and removes the least recently used items
+ * if the items count or the size of all items exceeds the limit,
+ * the caller allocates the items and frees them in the exit func
+ */
+typedef struct __gb_lru_cache_t
+{
+    // the lru list
+    tb_list_entry_head_t            list;
+
+    // the hash buckets
+    gb_lru_cache_item_ref_t*        buckets;
+
+    // the buckets count, must be power of 2
+    tb_size_t                       buckets_count;
+
+    // the key offset in the item
+    tb_size_t                       key_offset;
+
+    // the key size
+    tb_size_t                       key_size;
+
+    // the key hash func
+    gb_lru_cache_hash_func_t        hash;
+
+    // the item exit func
+    gb_lru_cache_exit_func_t        exit;
+
+    // the max items count, no limit if be zero
+    tb_size_t                       maxn;
+
+    // the max size of all items
+    tb_size_t                       maxs;
+
+    // the size of all items
+    tb_size_t                       size;
+
+    // the hit count
+    tb_size_t                       hits;
+
+    // the miss count
+    tb_size_t                       misses;
+
+    // the evicted items count
+    tb_size_t                       evictions;
+
+}gb_lru_cache_t, *gb_lru_cache_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the lru cache
+ *
+ * @param cache         the cache
+ * @param buckets       the min buckets count, it will be aligned to power of 2
+ * @param maxn          the max items count, no limit if be zero
+ * @param maxs          the max size of all items
+ * @param key_offset    the key offset in the item
+ * @param key_size      the key size
+ * @param hash          the key hash func
+ * @param exit          the item exit func
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_lru_cache_init(gb_lru_cache_ref_t cache, tb_size_t buckets, tb_size_t maxn, tb_size_t maxs, tb_size_t key_offset, tb_size_t key_size, gb_lru_cache_hash_func_t hash, gb_lru_cache_exit_func_t exit);
+
+/* exit the lru cache and all items
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_lru_cache_exit(gb_lru_cache_ref_t cache);
+
+/* remove all items and clear the counts
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_lru_cache_clear(gb_lru_cache_ref_t cache);
+
+/* get the item of the given key and move it to the head of the lru list
+ *
+ * @param cache         the cache
+ * @param key           the key
+ * @param counted       update the hit and miss counts?
+ *
+ * @return              the item, tb_null if be not found
+ */
+gb_lru_cache_item_ref_t gb_lru_cache_get(gb_lru_cache_ref_t cache, tb_cpointer_t key, tb_bool_t counted);
+
+/* insert the item to the head of the lru list
+ *
+ * the least recently used items will be removed for the size of this item
+ *
+ * @param cache         the cache
+ * @param item          the item, the key and the size of it must have been saved
+ *
+ * @return              tb_false if the item is too large to be cached, the caller need exit it
+ */
+tb_bool_t               gb_lru_cache_insert(gb_lru_cache_ref_t cache, gb_lru_cache_item_ref_t item);
+
+/* remove the least recently used items until the items count and the size of all items are in the given limit
+ *
+ * the cache inited with no limit can be trimmed by this after the items are no longer referenced
+ *
+ * @param cache         the cache
+ * @param maxn          the max items count, no limit if be zero
+ * @param maxs          the max size of all items
+ */
+tb_void_t               gb_lru_cache_trim(gb_lru_cache_ref_t cache, tb_size_t maxn, tb_size_t maxs);
+
+/* the fnv-1a hash of the key bytes
+ *
+ * @param key           the key
+ * @param size          the key size
+ *
+ * @return              the hash
+ */
+tb_size_t               gb_lru_cache_hash_bytes(tb_cpointer_t key, tb_size_t size);
+
+/* the items count
+ *
+ * @param cache         the cache
+ *
+ * @return              the items count
+ */
+static __tb_inline__ tb_size_t gb_lru_cache_count(gb_lru_cache_ref_t cache)
+{
+    return tb_list_entry_size(&cache->list);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
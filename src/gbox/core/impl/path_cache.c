@@ -23,34 +23,357 @@
  * @ingroup     core
  */
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "path_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
 #include "path_cache.h"
+#include "lru_cache.h"
 #include "../path.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default max items count
+#ifdef __gb_small__
+#   define GB_PATH_CACHE_MAXN               (256)
+#else
+#   define GB_PATH_CACHE_MAXN               (1024)
+#endif
+
+// the default max bytes of all paths
+#ifdef __gb_small__
+#   define GB_PATH_CACHE_SIZE               (256 * 1024)
+#else
+#   define GB_PATH_CACHE_SIZE               (2 * 1024 * 1024)
+#endif
+
+// the max floats of the shape key, the round rect: bounds + radius
+#define GB_PATH_CACHE_KEY_MAXN              (12)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the path cache key type
+typedef struct __gb_path_cache_key_t
+{
+    // the shape type
+    tb_uint16_t                     type;
+
+    // the quality
+    tb_uint16_t                     quality;
+
+    // the shape geometry
+    gb_float_t                      data[GB_PATH_CACHE_KEY_MAXN];
+
+}gb_path_cache_key_t, *gb_path_cache_key_ref_t;
+
+// the path cache item type
+typedef struct __gb_path_cache_item_t
+{
+    // the lru cache item, must be the first member
+    gb_lru_cache_item_t             base;
+
+    // the key
+    gb_path_cache_key_t             key;
+
+    // the path
+    gb_path_ref_t                   path;
+
+}gb_path_cache_item_t, *gb_path_cache_item_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_path_cache_key_make(gb_path_cache_key_ref_t key, gb_shape_ref_t shape)
+{
+    // check
+    tb_assert(key && shape);
+
+    // clear key
+    tb_memset(key, 0, sizeof(gb_path_cache_key_t));
+
+    // make key
+    gb_float_t* data = key->data;
+    switch (shape->type)
+    {
+    case GB_SHAPE_TYPE_ARC:
+        data[0] = shape->u.arc.c.x;
+        data[1] = shape->u.arc.c.y;
+        data[2] = shape->u.arc.rx;
+        data[3] = shape->u.arc.ry;
+        data[4] = shape->u.arc.ab;
+        data[5] = shape->u.arc.an;
+        break;
+    case GB_SHAPE_TYPE_LINE:
+        data[0] = shape->u.line.p0.x;
+        data[1] = shape->u.line.p0.y;
+        data[2] = shape->u.line.p1.x;
+        data[3] = shape->u.line.p1.y;
+        break;
+    case GB_SHAPE_TYPE_RECT:
+        data[0] = shape->u.rect.x;
+        data[1] = shape->u.rect.y;
+        data[2] = shape->u.rect.w;
+        data[3] = shape->u.rect.h;
+        break;
+    case GB_SHAPE_TYPE_CIRCLE:
+        data[0] = shape->u.circle.c.x;
+        data[1] = shape->u.circle.c.y;
+        data[2] = shape->u.circle.r;
+        break;
+    case GB_SHAPE_TYPE_ELLIPSE:
+        data[0] = shape->u.ellipse.c.x;
+        data[1] = shape->u.ellipse.c.y;
+        data[2] = shape->u.ellipse.rx;
+        data[3] = shape->u.ellipse.ry;
+        break;
+    case GB_SHAPE_TYPE_TRIANGLE:
+        data[0] = shape->u.triangle.p0.x;
+        data[1] = shape->u.triangle.p0.y;
+        data[2] = shape->u.triangle.p1.x;
+        data[3] = shape->u.triangle.p1.y;
+        data[4] = shape->u.triangle.p2.x;
+        data[5] = shape->u.triangle.p2.y;
+        break;
+    case GB_SHAPE_TYPE_ROUND_RECT:
+        {
+            tb_size_t i = 0;
+            data[0] = shape->u.round_rect.bounds.x;
+            data[1] = shape->u.round_rect.bounds.y;
+            data[2] = shape->u.round_rect.bounds.w;
+            data[3] = shape->u.round_rect.bounds.h;
+            for (i = 0; i < 4; i++)
+            {
+                data[4 + (i << 1)] = shape->u.round_rect.radius[i].x;
+                data[5 + (i << 1)] = shape->u.round_rect.radius[i].y;
+            }
+        }
+        break;
+    default:
+        // not supported
+        return tb_false;
+    }
+
+    // save type and quality
+    key->type       = (tb_uint16_t)shape->type;
+    key->quality    = (tb_uint16_t)gb_quality();
+
+    // ok
+    return tb_true;
+}
+static tb_size_t gb_path_cache_key_hash(tb_cpointer_t key)
+{
+    // the shape geometry is hashed as bytes
+    return gb_lru_cache_hash_bytes(key, sizeof(gb_path_cache_key_t));
+}
+static tb_void_t gb_path_cache_item_exit(gb_lru_cache_ref_t lru, gb_lru_cache_item_ref_t base)
+{
+    // check
+    gb_path_cache_item_ref_t item = (gb_path_cache_item_ref_t)base;
+    tb_assert(lru && item);
+
+    // exit path
+    if (item->path) gb_path_exit(item->path);
+    item->path = tb_null;
+
+    // exit it
+    tb_free(item);
+}
+static tb_bool_t gb_path_cache_make(gb_path_ref_t path, gb_shape_ref_t shape)
+{
+    // check
+    tb_assert(path && shape);
+
+    // make path
+    switch (shape->type)
+    {
+    case GB_SHAPE_TYPE_ARC:
+        gb_path_add_arc(path, &shape->u.arc);
+        break;
+    case GB_SHAPE_TYPE_LINE:
+        gb_path_add_line(path, &shape->u.line);
+        break;
+    case GB_SHAPE_TYPE_RECT:
+        gb_path_add_rect(path, &shape->u.rect, GB_ROTATE_DIRECTION_CW);
+        break;
+    case GB_SHAPE_TYPE_CIRCLE:
+        gb_path_add_circle(path, &shape->u.circle, GB_ROTATE_DIRECTION_CW);
+        break;
+    case GB_SHAPE_TYPE_ELLIPSE:
+        gb_path_add_ellipse(path, &shape->u.ellipse, GB_ROTATE_DIRECTION_CW);
+        break;
+    case GB_SHAPE_TYPE_TRIANGLE:
+        gb_path_add_triangle(path, &shape->u.triangle);
+        break;
+    case GB_SHAPE_TYPE_ROUND_RECT:
+        gb_path_add_round_rect(path, &shape->u.round_rect, GB_ROTATE_DIRECTION_CW);
+        break;
+    default:
+        return tb_false;
+    }
+
+    /* make the cached hint, bounds and polygon of the path now
+     *
+     * the cached path need not be flattened again for drawing it next time
+     */
+    gb_path_hint(path);
+    gb_path_bounds(path);
+    gb_path_polygon(path);
+
+    // ok
+    return tb_true;
+}
+static tb_size_t gb_path_cache_path_size(gb_path_ref_t path)
+{
+    // the items size, code + points
+    tb_size_t size = tb_iterator_size(path) * (sizeof(tb_uint8_t) + 3 * sizeof(gb_point_t));
+
+    // the polygon size
+    gb_polygon_ref_t polygon = gb_path_polygon(path);
+    if (polygon && polygon->counts)
+    {
+        tb_uint32_t* counts = polygon->counts;
+        while (*counts) size += *counts++ * sizeof(gb_point_t) + sizeof(tb_uint32_t);
+    }
+
+    // the path size, the path struct is not exported, so estimate it
+    return size + 256;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-gb_path_cache_ref_t gb_path_cache_init()
+gb_path_cache_ref_t gb_path_cache_init(tb_size_t maxn, tb_size_t size)
 {
-    return tb_null;
+    // make cache
+    gb_lru_cache_ref_t lru = tb_malloc0_type(gb_lru_cache_t);
+    tb_assert_and_check_return_val(lru, tb_null);
+
+    // init lru cache, the load factor is 0.5 - 1
+    maxn = maxn? maxn : GB_PATH_CACHE_MAXN;
+    if (!gb_lru_cache_init(lru, maxn, maxn, size? size : GB_PATH_CACHE_SIZE, tb_offsetof(gb_path_cache_item_t, key), sizeof(gb_path_cache_key_t), gb_path_cache_key_hash, gb_path_cache_item_exit))
+    {
+        gb_lru_cache_exit(lru);
+        tb_free(lru);
+        return tb_null;
+    }
+
+    // ok
+    return (gb_path_cache_ref_t)lru;
 }
 tb_void_t gb_path_cache_exit(gb_path_cache_ref_t cache)
 {
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return(lru);
+
+    // exit it
+    gb_lru_cache_exit(lru);
+    tb_free(lru);
 }
 tb_void_t gb_path_cache_clear(gb_path_cache_ref_t cache)
 {
+    // clear it
+    gb_lru_cache_clear((gb_lru_cache_ref_t)cache);
 }
 gb_path_ref_t gb_path_cache_get(gb_path_cache_ref_t cache, gb_shape_ref_t shape)
 {
-    return tb_null;
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return_val(lru && shape, tb_null);
+
+    // make key
+    gb_path_cache_key_t key;
+    if (!gb_path_cache_key_make(&key, shape)) return tb_null;
+
+    // get it
+    gb_path_cache_item_ref_t item = (gb_path_cache_item_ref_t)gb_lru_cache_get(lru, &key, tb_true);
+    return item? item->path : tb_null;
 }
 gb_path_ref_t gb_path_cache_add(gb_path_cache_ref_t cache, gb_shape_ref_t shape)
 {
-    return tb_null;
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return_val(lru && shape, tb_null);
+
+    // make key
+    gb_path_cache_key_t key;
+    if (!gb_path_cache_key_make(&key, shape)) return tb_null;
+
+    // exists? 
+    gb_path_cache_item_ref_t item = (gb_path_cache_item_ref_t)gb_lru_cache_get(lru, &key, tb_false);
+    if (item) return item->path;
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // make item
+        item = tb_malloc0_type(gb_path_cache_item_t);
+        tb_assert_and_check_break(item);
+
+        // init item
+        item->key   = key;
+        item->path  = gb_path_init();
+        tb_assert_and_check_break(item->path);
+
+        // make path
+        if (!gb_path_cache_make(item->path, shape)) break;
+
+        // insert it with the path size, not cache it if it is too large
+        item->base.size = gb_path_cache_path_size(item->path);
+        if (!gb_lru_cache_insert(lru, &item->base)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (item) gb_path_cache_item_exit(lru, &item->base);
+        item = tb_null;
+    }
+
+    // ok?
+    return item? item->path : tb_null;
+}
+tb_size_t gb_path_cache_hits(gb_path_cache_ref_t cache)
+{
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return_val(lru, 0);
+
+    // the hit count
+    return lru->hits;
+}
+tb_size_t gb_path_cache_misses(gb_path_cache_ref_t cache)
+{
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return_val(lru, 0);
+
+    // the miss count
+    return lru->misses;
+}
+#ifdef __gb_debug__
+tb_void_t gb_path_cache_dump(gb_path_cache_ref_t cache)
+{
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return(lru);
+
+    // trace
+    tb_trace_i("items: %lu/%lu, size: %lu/%lu, hits: %lu, misses: %lu", gb_lru_cache_count(lru), lru->maxn, lru->size, lru->maxs, lru->hits, lru->misses);
 }
+#endif
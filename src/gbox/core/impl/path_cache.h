@@ -48,11 +48,16 @@ typedef struct{}*       gb_path_cache_ref_t;
 
 /* init the path cache
  *
- * cache: shape => path
+ * cache: shape + quality => path
+ *
+ * the least recently used paths will be removed if the items count or the paths size exceeds the limit
+ *
+ * @param maxn          the max items count, using the default count if be zero
+ * @param size          the max bytes of all paths, using the default size if be zero
  *
  * @return              the path cache
  */
-gb_path_cache_ref_t     gb_path_cache_init(tb_noarg_t);
+gb_path_cache_ref_t     gb_path_cache_init(tb_size_t maxn, tb_size_t size);
 
 /* exit the path cache
  *
@@ -71,11 +76,13 @@ tb_void_t               gb_path_cache_clear(gb_path_cache_ref_t cache);
  * @param cache         the cache
  * @param shape         the shape
  * 
- * @return              the shape path
+ * @return              the shape path, tb_null if be not cached
  */
 gb_path_ref_t           gb_path_cache_get(gb_path_cache_ref_t cache, gb_shape_ref_t shape);
 
 /* add shape and make path to cache
+ *
+ * @note the returned path is only valid before adding the next shape
  *
  * @param cache         the cache
  * @param shape         the shape
@@ -84,6 +91,30 @@ gb_path_ref_t           gb_path_cache_get(gb_path_cache_ref_t cache, gb_shape_re
  */
 gb_path_ref_t           gb_path_cache_add(gb_path_cache_ref_t cache, gb_shape_ref_t shape);
 
+/* the hit count of the path cache
+ *
+ * @param cache         the cache
+ *
+ * @return              the hit count
+ */
+tb_size_t               gb_path_cache_hits(gb_path_cache_ref_t cache);
+
+/* the miss count of the path cache
+ *
+ * @param cache         the cache
+ *
+ * @return              the miss count
+ */
+tb_size_t               gb_path_cache_misses(gb_path_cache_ref_t cache);
+
+#ifdef __gb_debug__
+/* dump the path cache
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_path_cache_dump(gb_path_cache_ref_t cache);
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
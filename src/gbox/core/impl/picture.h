@@ -0,0 +1,128 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        picture.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_PICTURE_H
+#define GB_CORE_IMPL_PICTURE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init picture for recording
+ *
+ * @param width                 the width of the recorder device
+ * @param height                the height of the recorder device
+ *
+ * @return                      the picture
+ */
+gb_picture_ref_t                gb_picture_init(tb_size_t width, tb_size_t height);
+
+/* record clear
+ *
+ * @param picture               the picture
+ * @param color                 the color
+ */
+tb_void_t                       gb_picture_record_clear(gb_picture_ref_t picture, gb_color_t color);
+
+/* record clipper if be changed
+ *
+ * the clipper will be copied and the copied clipper shares the clip mask
+ *
+ * @param picture               the picture
+ * @param clipper               the clipper, nothing is clipped if be null
+ */
+tb_void_t                       gb_picture_record_clipper(gb_picture_ref_t picture, gb_clipper_ref_t clipper);
+
+/* record path
+ *
+ * the path will be copied and the copied path will cache the flattened polygon for replaying
+ *
+ * @param picture               the picture
+ * @param paint                 the paint
+ * @param matrix                the matrix
+ * @param path                  the path
+ */
+tb_void_t                       gb_picture_record_path(gb_picture_ref_t picture, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path);
+
+/* record lines
+ *
+ * @param picture               the picture
+ * @param paint                 the paint
+ * @param matrix                the matrix
+ * @param points                the points
+ * @param count                 the points count
+ * @param bounds                the bounds
+ */
+tb_void_t                       gb_picture_record_lines(gb_picture_ref_t picture, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds);
+
+/* record points
+ *
+ * @param picture               the picture
+ * @param paint                 the paint
+ * @param matrix                the matrix
+ * @param points                the points
+ * @param count                 the points count
+ * @param bounds                the bounds
+ */
+tb_void_t                       gb_picture_record_points(gb_picture_ref_t picture, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds);
+
+/* record polygon
+ *
+ * @param picture               the picture
+ * @param paint                 the paint
+ * @param matrix                the matrix
+ * @param polygon               the polygon
+ * @param hint                  the hint shape
+ * @param bounds                the bounds
+ */
+tb_void_t                       gb_picture_record_polygon(gb_picture_ref_t picture, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
+
+/* replay the recorded commands to the given device
+ *
+ * the recorded clippers are transformed by the matrix and intersected with the given clipper
+ *
+ * @note the paint and matrix bound to the device will be changed and the given clipper will be bound to it
+ *
+ * @param picture               the picture
+ * @param device                the device
+ * @param matrix                the matrix for all recorded draws
+ * @param clipper               the clipper of the device
+ */
+tb_void_t                       gb_picture_replay(gb_picture_ref_t picture, gb_device_ref_t device, gb_matrix_ref_t matrix, gb_clipper_ref_t clipper);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -0,0 +1,765 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pixmap_simd.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "pixmap_simd"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "pixmap_simd.h"
+#if defined(TB_ARCH_x86) || defined(TB_ARCH_x64)
+#   if defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG)
+#       include <immintrin.h>
+#       define GB_PIXMAP_SIMD_HAVE_SSE2
+#       define GB_PIXMAP_SIMD_HAVE_AVX2
+#   elif defined(TB_COMPILER_IS_MSVC) && (_MSC_VER >= 1700)
+#       include <intrin.h>
+#       include <immintrin.h>
+#       define GB_PIXMAP_SIMD_HAVE_SSE2
+#       define GB_PIXMAP_SIMD_HAVE_AVX2
+#   endif
+#elif defined(TB_ARCH_ARM64) || defined(TB_ARCH_ARM_NEON)
+#   include <arm_neon.h>
+#   define GB_PIXMAP_SIMD_HAVE_NEON
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the target attributes for the simd kernels
+ *
+ * we need not compile the whole library with -mavx2, 
+ * the kernels will be selected at runtime by the cpu features
+ */
+#if defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG)
+#   define GB_PIXMAP_SIMD_TARGET_SSE2       __attribute__((target("sse2")))
+#   define GB_PIXMAP_SIMD_TARGET_AVX2       __attribute__((target("avx2")))
+#else
+#   define GB_PIXMAP_SIMD_TARGET_SSE2
+#   define GB_PIXMAP_SIMD_TARGET_AVX2
+#endif
+
+// need swap the bytes of the 16-bits pixels?
+#define GB_PIXMAP_SIMD_SWAP16(pixfmt)       ((GB_PIXFMT_BE(pixfmt)? GB_PIXFMT_BENDIAN : 0) != GB_PIXFMT_NENDIAN)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* the scalar blend for the tail pixels of the simd kernels
+ *
+ * all kernels blend every channel by (s * a + d * (n - a)) >> bits,
+ * so the tail pixels must use the same formula for the same results
+ *
+ * sh = ((s >> 8) & 0x00ff00ff) * a
+ * sl = (s & 0x00ff00ff) * a
+ */
+static __tb_inline__ tb_uint32_t gb_pixmap_simd_blend32(tb_uint32_t d, tb_uint32_t sh, tb_uint32_t sl, tb_uint32_t ia)
+{
+    tb_uint32_t l = (((d & 0x00ff00ff) * ia + sl) >> 8) & 0x00ff00ff;
+    tb_uint32_t h = (((d >> 8) & 0x00ff00ff) * ia + sh) & 0xff00ff00;
+    return h | l;
+}
+static __tb_inline__ tb_uint16_t gb_pixmap_simd_blend565(tb_uint16_t d, tb_uint16_t sr, tb_uint16_t sg, tb_uint16_t sb, tb_uint16_t ia)
+{
+    tb_uint16_t r = ((d >> 11) * ia + sr) >> 5;
+    tb_uint16_t g = (((d >> 5) & 0x3f) * ia + sg) >> 5;
+    tb_uint16_t b = ((d & 0x1f) * ia + sb) >> 5;
+    return (tb_uint16_t)((r << 11) | (g << 5) | b);
+}
+static __tb_inline__ tb_uint16_t gb_pixmap_simd_blend4444(tb_uint16_t d, tb_uint16_t const* s, tb_uint16_t ia)
+{
+    tb_uint16_t c3 = ((d >> 12) * ia + s[3]) >> 5;
+    tb_uint16_t c2 = (((d >> 8) & 0xf) * ia + s[2]) >> 5;
+    tb_uint16_t c1 = (((d >> 4) & 0xf) * ia + s[1]) >> 5;
+    tb_uint16_t c0 = ((d & 0xf) * ia + s[0]) >> 5;
+    return (tb_uint16_t)((c3 << 12) | (c2 << 8) | (c1 << 4) | c0);
+}
+static __tb_inline__ tb_uint16_t gb_pixmap_simd_swap16(tb_uint16_t d, tb_bool_t swap)
+{
+    return swap? (tb_uint16_t)((d << 8) | (d >> 8)) : d;
+}
+static __tb_inline__ tb_void_t gb_pixmap_simd_fill32_tail(tb_uint32_t* p, tb_uint32_t s, tb_size_t count, tb_uint32_t a)
+{
+    tb_uint32_t sh = ((s >> 8) & 0x00ff00ff) * a;
+    tb_uint32_t sl = (s & 0x00ff00ff) * a;
+    while (count--) 
+    {
+        *p = gb_pixmap_simd_blend32(*p, sh, sl, 256 - a);
+        p++;
+    }
+}
+static __tb_inline__ tb_void_t gb_pixmap_simd_fill565_tail(tb_uint16_t* p, tb_uint16_t s, tb_size_t count, tb_uint16_t a, tb_bool_t swap)
+{
+    tb_uint16_t sr = (s >> 11) * a;
+    tb_uint16_t sg = ((s >> 5) & 0x3f) * a;
+    tb_uint16_t sb = (s & 0x1f) * a;
+    while (count--) 
+    {
+        *p = gb_pixmap_simd_swap16(gb_pixmap_simd_blend565(gb_pixmap_simd_swap16(*p, swap), sr, sg, sb, 32 - a), swap);
+        p++;
+    }
+}
+/* the scalar blend32 for the tail pixels of the blend32 kernels
+ *
+ * every byte is blended by (s * scale >> 8) + (d * (256 - (a * scale >> 8)) >> 8),
+ * the pixels are premultiplied, so the sum will never overflow to the next byte
+ */
+static __tb_inline__ tb_void_t gb_pixmap_simd_blend32_tail(tb_uint32_t* p, tb_uint32_t const* s, tb_byte_t const* a, tb_size_t count, tb_size_t scale)
+{
+    while (count--)
+    {
+        tb_uint32_t ia = 256 - ((*a++ * scale) >> 8);
+        tb_uint32_t sl = (((*s & 0x00ff00ff) * scale) >> 8) & 0x00ff00ff;
+        tb_uint32_t sh = (((*s >> 8) & 0x00ff00ff) * scale) & 0xff00ff00;
+        tb_uint32_t dl = (((*p & 0x00ff00ff) * ia) >> 8) & 0x00ff00ff;
+        tb_uint32_t dh = (((*p >> 8) & 0x00ff00ff) * ia) & 0xff00ff00;
+        *p++ = (dl + sl) | (dh + sh);
+        s++;
+    }
+}
+static __tb_inline__ tb_uint32_t gb_pixmap_simd_lerp32(tb_uint32_t a, tb_uint32_t b, tb_uint32_t w)
+{
+    tb_uint32_t l = (((a & 0x00ff00ff) * (256 - w) + (b & 0x00ff00ff) * w) >> 8) & 0x00ff00ff;
+    tb_uint32_t h = (((a >> 8) & 0x00ff00ff) * (256 - w) + ((b >> 8) & 0x00ff00ff) * w) & 0xff00ff00;
+    return h | l;
+}
+static __tb_inline__ tb_void_t gb_pixmap_simd_filter32_tail(tb_uint32_t* p, tb_uint32_t const* t, tb_byte_t const* w, tb_size_t count)
+{
+    while (count--)
+    {
+        *p++ = gb_pixmap_simd_lerp32(gb_pixmap_simd_lerp32(t[0], t[1], w[0]), gb_pixmap_simd_lerp32(t[2], t[3], w[0]), w[1]);
+        t += 4;
+        w += 2;
+    }
+}
+static __tb_inline__ tb_void_t gb_pixmap_simd_fill4444_tail(tb_uint16_t* p, tb_uint16_t s, tb_size_t count, tb_uint16_t a, tb_bool_t swap)
+{
+    tb_uint16_t sc[4];
+    sc[0] = (s & 0xf) * a;
+    sc[1] = ((s >> 4) & 0xf) * a;
+    sc[2] = ((s >> 8) & 0xf) * a;
+    sc[3] = (s >> 12) * a;
+    while (count--) 
+    {
+        *p = gb_pixmap_simd_swap16(gb_pixmap_simd_blend4444(gb_pixmap_simd_swap16(*p, swap), sc, 32 - a), swap);
+        p++;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * sse2 implementation
+ */
+#ifdef GB_PIXMAP_SIMD_HAVE_SSE2
+static GB_PIXMAP_SIMD_TARGET_SSE2 tb_void_t gb_pixmap_simd_sse2_fill32(tb_uint32_t* p, tb_uint32_t s, tb_size_t count, tb_uint32_t a)
+{
+    // the factors
+    __m128i z   = _mm_setzero_si128();
+    __m128i ia  = _mm_set1_epi16((tb_int16_t)(256 - a));
+    __m128i sa  = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((tb_int32_t)s), z), _mm_set1_epi16((tb_int16_t)a));
+
+    // blend 4 pixels
+    while (count >= 4)
+    {
+        __m128i d = _mm_loadu_si128((__m128i const*)p);
+        __m128i l = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, z), ia), sa), 8);
+        __m128i h = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, z), ia), sa), 8);
+        _mm_storeu_si128((__m128i*)p, _mm_packus_epi16(l, h));
+        p += 4;
+        count -= 4;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_fill32_tail(p, s, count, a);
+}
+static GB_PIXMAP_SIMD_TARGET_SSE2 tb_void_t gb_pixmap_simd_sse2_fill565(tb_uint16_t* p, tb_uint16_t s, tb_size_t count, tb_uint16_t a, tb_bool_t swap)
+{
+    // the factors
+    __m128i m5  = _mm_set1_epi16(0x1f);
+    __m128i m6  = _mm_set1_epi16(0x3f);
+    __m128i ia  = _mm_set1_epi16((tb_int16_t)(32 - a));
+    __m128i sr  = _mm_set1_epi16((tb_int16_t)((s >> 11) * a));
+    __m128i sg  = _mm_set1_epi16((tb_int16_t)(((s >> 5) & 0x3f) * a));
+    __m128i sb  = _mm_set1_epi16((tb_int16_t)((s & 0x1f) * a));
+
+    // blend 8 pixels
+    while (count >= 8)
+    {
+        __m128i d = _mm_loadu_si128((__m128i const*)p);
+        if (swap) d = _mm_or_si128(_mm_slli_epi16(d, 8), _mm_srli_epi16(d, 8));
+        __m128i r = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(d, 11), ia), sr), 5);
+        __m128i g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(d, 5), m6), ia), sg), 5);
+        __m128i b = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(d, m5), ia), sb), 5);
+        d = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+        if (swap) d = _mm_or_si128(_mm_slli_epi16(d, 8), _mm_srli_epi16(d, 8));
+        _mm_storeu_si128((__m128i*)p, d);
+        p += 8;
+        count -= 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_fill565_tail(p, s, count, a, swap);
+}
+static GB_PIXMAP_SIMD_TARGET_SSE2 tb_void_t gb_pixmap_simd_sse2_fill4444(tb_uint16_t* p, tb_uint16_t s, tb_size_t count, tb_uint16_t a, tb_bool_t swap)
+{
+    // the factors
+    __m128i m4  = _mm_set1_epi16(0xf);
+    __m128i ia  = _mm_set1_epi16((tb_int16_t)(32 - a));
+    __m128i s3  = _mm_set1_epi16((tb_int16_t)((s >> 12) * a));
+    __m128i s2  = _mm_set1_epi16((tb_int16_t)(((s >> 8) & 0xf) * a));
+    __m128i s1  = _mm_set1_epi16((tb_int16_t)(((s >> 4) & 0xf) * a));
+    __m128i s0  = _mm_set1_epi16((tb_int16_t)((s & 0xf) * a));
+
+    // blend 8 pixels
+    while (count >= 8)
+    {
+        __m128i d = _mm_loadu_si128((__m128i const*)p);
+        if (swap) d = _mm_or_si128(_mm_slli_epi16(d, 8), _mm_srli_epi16(d, 8));
+        __m128i c3 = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(d, 12), ia), s3), 5);
+        __m128i c2 = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(d, 8), m4), ia), s2), 5);
+        __m128i c1 = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(d, 4), m4), ia), s1), 5);
+        __m128i c0 = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(d, m4), ia), s0), 5);
+        d = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(c3, 12), _mm_slli_epi16(c2, 8)), _mm_or_si128(_mm_slli_epi16(c1, 4), c0));
+        if (swap) d = _mm_or_si128(_mm_slli_epi16(d, 8), _mm_srli_epi16(d, 8));
+        _mm_storeu_si128((__m128i*)p, d);
+        p += 8;
+        count -= 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_fill4444_tail(p, s, count, a, swap);
+}
+static GB_PIXMAP_SIMD_TARGET_SSE2 tb_void_t gb_pixmap_simd_sse2_blend32(tb_uint32_t* p, tb_uint32_t const* s, tb_byte_t const* a, tb_size_t count, tb_size_t scale)
+{
+    // the factors
+    __m128i z   = _mm_setzero_si128();
+    __m128i n   = _mm_set1_epi16(256);
+    __m128i sc  = _mm_set1_epi16((tb_int16_t)scale);
+
+    // blend 4 pixels
+    while (count >= 4)
+    {
+        // the inverse alphas: [ia0 x 4, ia1 x 4] and [ia2 x 4, ia3 x 4]
+        __m128i ia = _mm_sub_epi16(n, _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((tb_int32_t)tb_bits_get_u32_ne(a)), z), sc), 8));
+        ia = _mm_unpacklo_epi16(ia, ia);
+        __m128i il = _mm_unpacklo_epi32(ia, ia);
+        __m128i ih = _mm_unpackhi_epi32(ia, ia);
+
+        // blend them
+        __m128i d = _mm_loadu_si128((__m128i const*)p);
+        __m128i c = _mm_loadu_si128((__m128i const*)s);
+        __m128i l = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, z), il), 8), _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(c, z), sc), 8));
+        __m128i h = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, z), ih), 8), _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(c, z), sc), 8));
+        _mm_storeu_si128((__m128i*)p, _mm_packus_epi16(l, h));
+        p += 4;
+        s += 4;
+        a += 4;
+        count -= 4;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_blend32_tail(p, s, a, count, scale);
+}
+static GB_PIXMAP_SIMD_TARGET_SSE2 tb_void_t gb_pixmap_simd_sse2_filter32(tb_uint32_t* p, tb_uint32_t const* t, tb_byte_t const* w, tb_size_t count)
+{
+    // the factors
+    __m128i z = _mm_setzero_si128();
+
+    // filter 1 pixel, all bytes of the two taps are done in the 16-bits lanes
+    while (count--)
+    {
+        // the weights: [256 - fx x 4, fx x 4] and [256 - fy x 4, fy x 4]
+        __m128i wx = _mm_unpacklo_epi64(_mm_set1_epi16(256 - w[0]), _mm_set1_epi16(w[0]));
+        __m128i wy = _mm_unpacklo_epi64(_mm_set1_epi16(256 - w[1]), _mm_set1_epi16(w[1]));
+
+        // [tl, tr] and [bl, br] => [t, b]
+        __m128i d = _mm_loadu_si128((__m128i const*)t);
+        __m128i l = _mm_mullo_epi16(_mm_unpacklo_epi8(d, z), wx);
+        __m128i h = _mm_mullo_epi16(_mm_unpackhi_epi8(d, z), wx);
+        l = _mm_srli_epi16(_mm_add_epi16(l, _mm_srli_si128(l, 8)), 8);
+        h = _mm_srli_epi16(_mm_add_epi16(h, _mm_srli_si128(h, 8)), 8);
+
+        // [t, b] => d
+        l = _mm_mullo_epi16(_mm_unpacklo_epi64(l, h), wy);
+        l = _mm_srli_epi16(_mm_add_epi16(l, _mm_srli_si128(l, 8)), 8);
+        *p++ = (tb_uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(l, z));
+        t += 4;
+        w += 2;
+    }
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * avx2 implementation
+ */
+#ifdef GB_PIXMAP_SIMD_HAVE_AVX2
+static GB_PIXMAP_SIMD_TARGET_AVX2 tb_void_t gb_pixmap_simd_avx2_fill32(tb_uint32_t* p, tb_uint32_t s, tb_size_t count, tb_uint32_t a)
+{
+    // the factors
+    __m256i z   = _mm256_setzero_si256();
+    __m256i ia  = _mm256_set1_epi16((tb_int16_t)(256 - a));
+    __m256i sa  = _mm256_mullo_epi16(_mm256_unpacklo_epi8(_mm256_set1_epi32((tb_int32_t)s), z), _mm256_set1_epi16((tb_int16_t)a));
+
+    // blend 8 pixels, unpack and pack are done in the 128-bits lanes, so the order is kept
+    while (count >= 8)
+    {
+        __m256i d = _mm256_loadu_si256((__m256i const*)p);
+        __m256i l = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, z), ia), sa), 8);
+        __m256i h = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, z), ia), sa), 8);
+        _mm256_storeu_si256((__m256i*)p, _mm256_packus_epi16(l, h));
+        p += 8;
+        count -= 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_fill32_tail(p, s, count, a);
+}
+static GB_PIXMAP_SIMD_TARGET_AVX2 tb_void_t gb_pixmap_simd_avx2_fill565(tb_uint16_t* p, tb_uint16_t s, tb_size_t count, tb_uint16_t a, tb_bool_t swap)
+{
+    // the factors
+    __m256i m5  = _mm256_set1_epi16(0x1f);
+    __m256i m6  = _mm256_set1_epi16(0x3f);
+    __m256i ia  = _mm256_set1_epi16((tb_int16_t)(32 - a));
+    __m256i sr  = _mm256_set1_epi16((tb_int16_t)((s >> 11) * a));
+    __m256i sg  = _mm256_set1_epi16((tb_int16_t)(((s >> 5) & 0x3f) * a));
+    __m256i sb  = _mm256_set1_epi16((tb_int16_t)((s & 0x1f) * a));
+
+    // blend 16 pixels
+    while (count >= 16)
+    {
+        __m256i d = _mm256_loadu_si256((__m256i const*)p);
+        if (swap) d = _mm256_or_si256(_mm256_slli_epi16(d, 8), _mm256_srli_epi16(d, 8));
+        __m256i r = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(d, 11), ia), sr), 5);
+        __m256i g = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(d, 5), m6), ia), sg), 5);
+        __m256i b = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(d, m5), ia), sb), 5);
+        d = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), b);
+        if (swap) d = _mm256_or_si256(_mm256_slli_epi16(d, 8), _mm256_srli_epi16(d, 8));
+        _mm256_storeu_si256((__m256i*)p, d);
+        p += 16;
+        count -= 16;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_fill565_tail(p, s, count, a, swap);
+}
+static GB_PIXMAP_SIMD_TARGET_AVX2 tb_void_t gb_pixmap_simd_avx2_fill4444(tb_uint16_t* p, tb_uint16_t s, tb_size_t count, tb_uint16_t a, tb_bool_t swap)
+{
+    // the factors
+    __m256i m4  = _mm256_set1_epi16(0xf);
+    __m256i ia  = _mm256_set1_epi16((tb_int16_t)(32 - a));
+    __m256i s3  = _mm256_set1_epi16((tb_int16_t)((s >> 12) * a));
+    __m256i s2  = _mm256_set1_epi16((tb_int16_t)(((s >> 8) & 0xf) * a));
+    __m256i s1  = _mm256_set1_epi16((tb_int16_t)(((s >> 4) & 0xf) * a));
+    __m256i s0  = _mm256_set1_epi16((tb_int16_t)((s & 0xf) * a));
+
+    // blend 16 pixels
+    while (count >= 16)
+    {
+        __m256i d = _mm256_loadu_si256((__m256i const*)p);
+        if (swap) d = _mm256_or_si256(_mm256_slli_epi16(d, 8), _mm256_srli_epi16(d, 8));
+        __m256i c3 = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(d, 12), ia), s3), 5);
+        __m256i c2 = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(d, 8), m4), ia), s2), 5);
+        __m256i c1 = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(d, 4), m4), ia), s1), 5);
+        __m256i c0 = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(d, m4), ia), s0), 5);
+        d = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(c3, 12), _mm256_slli_epi16(c2, 8)), _mm256_or_si256(_mm256_slli_epi16(c1, 4), c0));
+        if (swap) d = _mm256_or_si256(_mm256_slli_epi16(d, 8), _mm256_srli_epi16(d, 8));
+        _mm256_storeu_si256((__m256i*)p, d);
+        p += 16;
+        count -= 16;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_fill4444_tail(p, s, count, a, swap);
+}
+static GB_PIXMAP_SIMD_TARGET_AVX2 tb_void_t gb_pixmap_simd_avx2_blend32(tb_uint32_t* p, tb_uint32_t const* s, tb_byte_t const* a, tb_size_t count, tb_size_t scale)
+{
+    // the factors
+    __m256i z   = _mm256_setzero_si256();
+    __m128i n   = _mm_set1_epi16(256);
+    __m256i sc  = _mm256_set1_epi16((tb_int16_t)scale);
+
+    // blend 8 pixels
+    while (count >= 8)
+    {
+        /* the inverse alphas, the unpack operations are done in the 128-bits lanes
+         *
+         * lane0: [ia0 x 4, ia1 x 4] and [ia2 x 4, ia3 x 4]
+         * lane1: [ia4 x 4, ia5 x 4] and [ia6 x 4, ia7 x 4]
+         */
+        __m128i ia = _mm_sub_epi16(n, _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((__m128i const*)a), _mm_setzero_si128()), _mm256_castsi256_si128(sc)), 8));
+        __m256i iq = _mm256_permute4x64_epi64(_mm256_castsi128_si256(ia), 0x50);
+        iq = _mm256_unpacklo_epi16(iq, iq);
+        __m256i il = _mm256_unpacklo_epi32(iq, iq);
+        __m256i ih = _mm256_unpackhi_epi32(iq, iq);
+
+        // blend them
+        __m256i d = _mm256_loadu_si256((__m256i const*)p);
+        __m256i c = _mm256_loadu_si256((__m256i const*)s);
+        __m256i l = _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, z), il), 8), _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(c, z), sc), 8));
+        __m256i h = _mm256_add_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, z), ih), 8), _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(c, z), sc), 8));
+        _mm256_storeu_si256((__m256i*)p, _mm256_packus_epi16(l, h));
+        p += 8;
+        s += 8;
+        a += 8;
+        count -= 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_blend32_tail(p, s, a, count, scale);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * neon implementation
+ */
+#ifdef GB_PIXMAP_SIMD_HAVE_NEON
+static tb_void_t gb_pixmap_simd_neon_fill32(tb_uint32_t* p, tb_uint32_t s, tb_size_t count, tb_uint32_t a)
+{
+    // the factors, a > 0 here, so 256 - a can be saved to the 8-bits lanes
+    uint8x8_t   va  = vdup_n_u8((tb_uint8_t)a);
+    uint8x8_t   via = vdup_n_u8((tb_uint8_t)(256 - a));
+    uint16x8_t  sa  = vmull_u8(vreinterpret_u8_u32(vdup_n_u32(s)), va);
+
+    // blend 4 pixels
+    while (count >= 4)
+    {
+        uint8x16_t d = vld1q_u8((tb_uint8_t const*)p);
+        uint16x8_t l = vmlal_u8(sa, vget_low_u8(d), via);
+        uint16x8_t h = vmlal_u8(sa, vget_high_u8(d), via);
+        vst1q_u8((tb_uint8_t*)p, vcombine_u8(vshrn_n_u16(l, 8), vshrn_n_u16(h, 8)));
+        p += 4;
+        count -= 4;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_fill32_tail(p, s, count, a);
+}
+static tb_void_t gb_pixmap_simd_neon_fill565(tb_uint16_t* p, tb_uint16_t s, tb_size_t count, tb_uint16_t a, tb_bool_t swap)
+{
+    // the factors
+    uint16x8_t  m5  = vdupq_n_u16(0x1f);
+    uint16x8_t  m6  = vdupq_n_u16(0x3f);
+    uint16x8_t  ia  = vdupq_n_u16(32 - a);
+    uint16x8_t  sr  = vdupq_n_u16((s >> 11) * a);
+    uint16x8_t  sg  = vdupq_n_u16(((s >> 5) & 0x3f) * a);
+    uint16x8_t  sb  = vdupq_n_u16((s & 0x1f) * a);
+
+    // blend 8 pixels
+    while (count >= 8)
+    {
+        uint16x8_t d = vld1q_u16(p);
+        if (swap) d = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(d)));
+        uint16x8_t r = vshrq_n_u16(vmlaq_u16(sr, vshrq_n_u16(d, 11), ia), 5);
+        uint16x8_t g = vshrq_n_u16(vmlaq_u16(sg, vandq_u16(vshrq_n_u16(d, 5), m6), ia), 5);
+        uint16x8_t b = vshrq_n_u16(vmlaq_u16(sb, vandq_u16(d, m5), ia), 5);
+        d = vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b);
+        if (swap) d = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(d)));
+        vst1q_u16(p, d);
+        p += 8;
+        count -= 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_fill565_tail(p, s, count, a, swap);
+}
+static tb_void_t gb_pixmap_simd_neon_fill4444(tb_uint16_t* p, tb_uint16_t s, tb_size_t count, tb_uint16_t a, tb_bool_t swap)
+{
+    // the factors
+    uint16x8_t  m4  = vdupq_n_u16(0xf);
+    uint16x8_t  ia  = vdupq_n_u16(32 - a);
+    uint16x8_t  s3  = vdupq_n_u16((s >> 12) * a);
+    uint16x8_t  s2  = vdupq_n_u16(((s >> 8) & 0xf) * a);
+    uint16x8_t  s1  = vdupq_n_u16(((s >> 4) & 0xf) * a);
+    uint16x8_t  s0  = vdupq_n_u16((s & 0xf) * a);
+
+    // blend 8 pixels
+    while (count >= 8)
+    {
+        uint16x8_t d = vld1q_u16(p);
+        if (swap) d = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(d)));
+        uint16x8_t c3 = vshrq_n_u16(vmlaq_u16(s3, vshrq_n_u16(d, 12), ia), 5);
+        uint16x8_t c2 = vshrq_n_u16(vmlaq_u16(s2, vandq_u16(vshrq_n_u16(d, 8), m4), ia), 5);
+        uint16x8_t c1 = vshrq_n_u16(vmlaq_u16(s1, vandq_u16(vshrq_n_u16(d, 4), m4), ia), 5);
+        uint16x8_t c0 = vshrq_n_u16(vmlaq_u16(s0, vandq_u16(d, m4), ia), 5);
+        d = vorrq_u16(vorrq_u16(vshlq_n_u16(c3, 12), vshlq_n_u16(c2, 8)), vorrq_u16(vshlq_n_u16(c1, 4), c0));
+        if (swap) d = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(d)));
+        vst1q_u16(p, d);
+        p += 8;
+        count -= 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_fill4444_tail(p, s, count, a, swap);
+}
+static tb_void_t gb_pixmap_simd_neon_blend32(tb_uint32_t* p, tb_uint32_t const* s, tb_byte_t const* a, tb_size_t count, tb_size_t scale)
+{
+    // the factors
+    uint16x8_t  n   = vdupq_n_u16(256);
+    uint16x8_t  sc  = vdupq_n_u16((tb_uint16_t)scale);
+
+    // blend 8 pixels, the bytes are deinterleaved, so the inverse alphas can be used for all bytes directly
+    while (count >= 8)
+    {
+        uint16x8_t  ia = vsubq_u16(n, vshrq_n_u16(vmulq_u16(vmovl_u8(vld1_u8(a)), sc), 8));
+        uint8x8x4_t d = vld4_u8((tb_uint8_t const*)p);
+        uint8x8x4_t c = vld4_u8((tb_uint8_t const*)s);
+        tb_size_t   i = 0;
+        for (i = 0; i < 4; i++)
+            d.val[i] = vmovn_u16(vaddq_u16(vshrq_n_u16(vmulq_u16(vmovl_u8(d.val[i]), ia), 8), vshrq_n_u16(vmulq_u16(vmovl_u8(c.val[i]), sc), 8)));
+        vst4_u8((tb_uint8_t*)p, d);
+        p += 8;
+        s += 8;
+        a += 8;
+        count -= 8;
+    }
+
+    // blend the left pixels
+    gb_pixmap_simd_blend32_tail(p, s, a, count, scale);
+}
+static tb_void_t gb_pixmap_simd_neon_filter32(tb_uint32_t* p, tb_uint32_t const* t, tb_byte_t const* w, tb_size_t count)
+{
+    // filter 1 pixel, all bytes of the two taps are done in the 16-bits lanes
+    while (count--)
+    {
+        // the weights: [256 - fx x 4, fx x 4] and [256 - fy x 4, fy x 4]
+        uint16x8_t  wx = vcombine_u16(vdup_n_u16(256 - w[0]), vdup_n_u16(w[0]));
+        uint16x8_t  wy = vcombine_u16(vdup_n_u16(256 - w[1]), vdup_n_u16(w[1]));
+
+        // [tl, tr] and [bl, br] => [t, b]
+        uint8x16_t  d = vld1q_u8((tb_uint8_t const*)t);
+        uint16x8_t  l = vmulq_u16(vmovl_u8(vget_low_u8(d)), wx);
+        uint16x8_t  h = vmulq_u16(vmovl_u8(vget_high_u8(d)), wx);
+        uint16x8_t  r = vcombine_u16(vshr_n_u16(vadd_u16(vget_low_u16(l), vget_high_u16(l)), 8), vshr_n_u16(vadd_u16(vget_low_u16(h), vget_high_u16(h)), 8));
+
+        // [t, b] => d
+        r = vmulq_u16(r, wy);
+        uint8x8_t   o = vmovn_u16(vcombine_u16(vshr_n_u16(vadd_u16(vget_low_u16(r), vget_high_u16(r)), 8), vdup_n_u16(0)));
+        vst1_lane_u32(p, vreinterpret_u32_u8(o), 0);
+        p++;
+        t += 4;
+        w += 2;
+    }
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * kernels
+ */
+
+// the scalar blend32 kernel
+static tb_void_t gb_pixmap_simd_blend32_scalar(tb_uint32_t* data, tb_uint32_t const* pixels, tb_byte_t const* alphas, tb_size_t count, tb_size_t scale)
+{
+    gb_pixmap_simd_blend32_tail(data, pixels, alphas, count, scale);
+}
+
+// the scalar filter32 kernel
+static tb_void_t gb_pixmap_simd_filter32_scalar(tb_uint32_t* data, tb_uint32_t const* taps, tb_byte_t const* weights, tb_size_t count)
+{
+    gb_pixmap_simd_filter32_tail(data, taps, weights, count);
+}
+
+/* make the pixels_fill kernels for the given simd extension
+ *
+ * the alpha of the 16-bits pixels is 5-bits, same as the scalar kernels
+ * and do nothing if alpha == 0, it will not change the pixels
+ *
+ * only argb4444 uses the 4444 kernel, the scalar kernels of the other 4444 pixfmts
+ * keep the x channel or order the channels differently, so they are not same as it
+ */
+#define GB_PIXMAP_SIMD_KERNELS(simd) \
+static tb_void_t gb_pixmap_simd_##simd##_pixels_fill32_l(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha) \
+{ \
+    if (alpha) gb_pixmap_simd_##simd##_fill32((tb_uint32_t*)data, tb_bits_ne_to_le_u32(pixel), count, alpha); \
+} \
+static tb_void_t gb_pixmap_simd_##simd##_pixels_fill32_b(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha) \
+{ \
+    if (alpha) gb_pixmap_simd_##simd##_fill32((tb_uint32_t*)data, tb_bits_ne_to_be_u32(pixel), count, alpha); \
+} \
+static tb_void_t gb_pixmap_simd_##simd##_pixels_fill565_l(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha) \
+{ \
+    if (alpha >>= 3) gb_pixmap_simd_##simd##_fill565((tb_uint16_t*)data, (tb_uint16_t)pixel, count, alpha, GB_PIXMAP_SIMD_SWAP16(0)); \
+} \
+static tb_void_t gb_pixmap_simd_##simd##_pixels_fill565_b(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha) \
+{ \
+    if (alpha >>= 3) gb_pixmap_simd_##simd##_fill565((tb_uint16_t*)data, (tb_uint16_t)pixel, count, alpha, GB_PIXMAP_SIMD_SWAP16(GB_PIXFMT_BENDIAN)); \
+} \
+static tb_void_t gb_pixmap_simd_##simd##_pixels_fill4444_l(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha) \
+{ \
+    if (alpha >>= 3) gb_pixmap_simd_##simd##_fill4444((tb_uint16_t*)data, (tb_uint16_t)pixel, count, alpha, GB_PIXMAP_SIMD_SWAP16(0)); \
+} \
+static tb_void_t gb_pixmap_simd_##simd##_pixels_fill4444_b(tb_pointer_t data, gb_pixel_t pixel, tb_size_t count, tb_byte_t alpha) \
+{ \
+    if (alpha >>= 3) gb_pixmap_simd_##simd##_fill4444((tb_uint16_t*)data, (tb_uint16_t)pixel, count, alpha, GB_PIXMAP_SIMD_SWAP16(GB_PIXFMT_BENDIAN)); \
+} \
+static gb_pixmap_func_pixels_fill_t gb_pixmap_simd_##simd##_pixels_fill(tb_size_t pixfmt) \
+{ \
+    tb_bool_t be = GB_PIXFMT_BE(pixfmt)? tb_true : tb_false; \
+    switch (GB_PIXFMT(pixfmt)) \
+    { \
+    case GB_PIXFMT(GB_PIXFMT_ARGB8888): \
+    case GB_PIXFMT(GB_PIXFMT_XRGB8888): \
+    case GB_PIXFMT(GB_PIXFMT_RGBA8888): \
+    case GB_PIXFMT(GB_PIXFMT_RGBX8888): \
+        return be? gb_pixmap_simd_##simd##_pixels_fill32_b : gb_pixmap_simd_##simd##_pixels_fill32_l; \
+    case GB_PIXFMT(GB_PIXFMT_RGB565): \
+        return be? gb_pixmap_simd_##simd##_pixels_fill565_b : gb_pixmap_simd_##simd##_pixels_fill565_l; \
+    case GB_PIXFMT(GB_PIXFMT_ARGB4444): \
+        return be? gb_pixmap_simd_##simd##_pixels_fill4444_b : gb_pixmap_simd_##simd##_pixels_fill4444_l; \
+    default: \
+        break; \
+    } \
+    return tb_null; \
+}
+
+#ifdef GB_PIXMAP_SIMD_HAVE_SSE2
+GB_PIXMAP_SIMD_KERNELS(sse2)
+#endif
+
+#ifdef GB_PIXMAP_SIMD_HAVE_AVX2
+GB_PIXMAP_SIMD_KERNELS(avx2)
+#endif
+
+#ifdef GB_PIXMAP_SIMD_HAVE_NEON
+GB_PIXMAP_SIMD_KERNELS(neon)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t gb_pixmap_simd_probe()
+{
+    // the supported simd mask
+    tb_size_t mask = 1 << GB_PIXMAP_SIMD_NONE;
+
+#if defined(GB_PIXMAP_SIMD_HAVE_SSE2) && (defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG))
+
+    // probe the cpu features, the os support of the ymm registers has been checked for avx2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) mask |= 1 << GB_PIXMAP_SIMD_SSE2;
+    if (__builtin_cpu_supports("avx2")) mask |= 1 << GB_PIXMAP_SIMD_AVX2;
+
+#elif defined(GB_PIXMAP_SIMD_HAVE_SSE2) && defined(TB_COMPILER_IS_MSVC)
+
+    // probe the cpu features
+    tb_int_t info[4];
+    __cpuid(info, 0);
+    tb_int_t maxn = info[0];
+    __cpuid(info, 1);
+    tb_bool_t osxsave = (info[2] & (1 << 27))? tb_true : tb_false;
+    if (info[3] & (1 << 26)) mask |= 1 << GB_PIXMAP_SIMD_SSE2;
+    if (maxn >= 7 && osxsave && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) mask |= 1 << GB_PIXMAP_SIMD_AVX2;
+    }
+
+#elif defined(GB_PIXMAP_SIMD_HAVE_NEON)
+
+    // the neon is enabled at compile time
+    mask |= 1 << GB_PIXMAP_SIMD_NEON;
+
+#endif
+
+    // ok
+    return mask;
+}
+gb_pixmap_func_pixels_fill_t gb_pixmap_simd_pixels_fill(tb_size_t pixfmt, tb_size_t simd)
+{
+    // done
+    switch (simd)
+    {
+#ifdef GB_PIXMAP_SIMD_HAVE_SSE2
+    case GB_PIXMAP_SIMD_SSE2:
+        return gb_pixmap_simd_sse2_pixels_fill(pixfmt);
+#endif
+#ifdef GB_PIXMAP_SIMD_HAVE_AVX2
+    case GB_PIXMAP_SIMD_AVX2:
+        return gb_pixmap_simd_avx2_pixels_fill(pixfmt);
+#endif
+#ifdef GB_PIXMAP_SIMD_HAVE_NEON
+    case GB_PIXMAP_SIMD_NEON:
+        return gb_pixmap_simd_neon_pixels_fill(pixfmt);
+#endif
+    default:
+        break;
+    }
+
+    // no kernel
+    return tb_null;
+}
+gb_pixmap_simd_func_blend32_t gb_pixmap_simd_pixels_blend32(tb_size_t simd)
+{
+    // done
+    switch (simd)
+    {
+#ifdef GB_PIXMAP_SIMD_HAVE_SSE2
+    case GB_PIXMAP_SIMD_SSE2:
+        return gb_pixmap_simd_sse2_blend32;
+#endif
+#ifdef GB_PIXMAP_SIMD_HAVE_AVX2
+    case GB_PIXMAP_SIMD_AVX2:
+        return gb_pixmap_simd_avx2_blend32;
+#endif
+#ifdef GB_PIXMAP_SIMD_HAVE_NEON
+    case GB_PIXMAP_SIMD_NEON:
+        return gb_pixmap_simd_neon_blend32;
+#endif
+    default:
+        break;
+    }
+
+    // the scalar kernel
+    return gb_pixmap_simd_blend32_scalar;
+}
+gb_pixmap_simd_func_filter32_t gb_pixmap_simd_pixels_filter32(tb_size_t simd)
+{
+    // done
+    switch (simd)
+    {
+#ifdef GB_PIXMAP_SIMD_HAVE_SSE2
+    case GB_PIXMAP_SIMD_SSE2:
+        return gb_pixmap_simd_sse2_filter32;
+#endif
+#ifdef GB_PIXMAP_SIMD_HAVE_AVX2
+    case GB_PIXMAP_SIMD_AVX2:
+        // only one pixel is filtered in the 128-bits register, the sse2 kernel is enough
+        return gb_pixmap_simd_sse2_filter32;
+#endif
+#ifdef GB_PIXMAP_SIMD_HAVE_NEON
+    case GB_PIXMAP_SIMD_NEON:
+        return gb_pixmap_simd_neon_filter32;
+#endif
+    default:
+        break;
+    }
+
+    // the scalar kernel
+    return gb_pixmap_simd_filter32_scalar;
+}
@@ -0,0 +1,108 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pixmap_simd.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_PIXMAP_SIMD_H
+#define GB_CORE_IMPL_PIXMAP_SIMD_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../pixmap.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the blend32 kernel for the 32-bits pixels with the per-pixel alpha
+ *
+ * d = s * scale / 256 + d * (256 - a * scale / 256) / 256 for every byte
+ *
+ * @param data          the data
+ * @param pixels        the premultiplied pixels with the same byte order as the data
+ * @param alphas        the alphas of the pixels
+ * @param count         the pixels count
+ * @param scale         the alpha scale, [1, 256]
+ */
+typedef tb_void_t       (*gb_pixmap_simd_func_blend32_t)(tb_uint32_t* data, tb_uint32_t const* pixels, tb_byte_t const* alphas, tb_size_t count, tb_size_t scale);
+
+/* the filter32 kernel for the bilinear filtering of the 32-bits pixels
+ *
+ * t = (tl * (256 - fx) + tr * fx) >> 8
+ * b = (bl * (256 - fx) + br * fx) >> 8
+ * d = (t * (256 - fy) + b * fy) >> 8 for every byte
+ *
+ * @param data          the filtered pixels
+ * @param taps          the taps of the pixels: [tl, tr, bl, br], ...
+ * @param weights       the weights of the pixels: [fx, fy], ...
+ * @param count         the pixels count
+ */
+typedef tb_void_t       (*gb_pixmap_simd_func_filter32_t)(tb_uint32_t* data, tb_uint32_t const* taps, tb_byte_t const* weights, tb_size_t count);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* probe the simd extensions of the current cpu
+ *
+ * @return              the supported simd mask, (1 << GB_PIXMAP_SIMD_XXX) | ...
+ */
+tb_size_t               gb_pixmap_simd_probe(tb_noarg_t);
+
+/* get the simd pixels_fill kernel for blending
+ *
+ * @param pixfmt        the pixfmt with endian
+ * @param simd          the simd extension
+ *
+ * @return              the kernel, return tb_null if no kernel for this pixfmt
+ */
+gb_pixmap_func_pixels_fill_t gb_pixmap_simd_pixels_fill(tb_size_t pixfmt, tb_size_t simd);
+
+/* get the blend32 kernel for blending the premultiplied 32-bits pixels
+ *
+ * @param simd          the simd extension
+ *
+ * @return              the kernel, return the scalar kernel if no kernel for this simd
+ */
+gb_pixmap_simd_func_blend32_t gb_pixmap_simd_pixels_blend32(tb_size_t simd);
+
+/* get the filter32 kernel for filtering the 32-bits pixels
+ *
+ * @param simd          the simd extension
+ *
+ * @return              the kernel, return the scalar kernel if no kernel for this simd
+ */
+gb_pixmap_simd_func_filter32_t gb_pixmap_simd_pixels_filter32(tb_size_t simd);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -33,6 +33,7 @@
  * includes
  */
 #include "polygon_raster.h"
+#include "stats.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -45,6 +46,26 @@
 #   define GB_POLYGON_RASTER_EDGES_GROW     (2048)
 #endif
 
+// the polygon coverage edges grow
+#ifdef __gb_small__
+#   define GB_POLYGON_RASTER_COVERAGE_EDGES_GROW    (256)
+#else
+#   define GB_POLYGON_RASTER_COVERAGE_EDGES_GROW    (1024)
+#endif
+
+/* the y-coordinates of the coverage edges are 48.16 fixed-point
+ *
+ * the 16.16 fixed-point will overflow for the bitmap higher than 32767,
+ * so the edges are converted to the 64-bits fixed-point directly
+ */
+#ifdef GB_CONFIG_FLOAT_FIXED
+#   define gb_polygon_raster_float_to_fixed64(x)    ((tb_hong_t)(x))
+#else
+#   define gb_polygon_raster_float_to_fixed64(x)    ((tb_hong_t)((x) * TB_FIXED_ONE))
+#endif
+#define gb_polygon_raster_long_to_fixed64(x)        ((tb_hong_t)(x) << 16)
+#define gb_polygon_raster_fixed64_floor(x)          ((tb_long_t)((x) >> 16))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -65,13 +86,13 @@ typedef struct __gb_polygon_raster_edge_t
      * 1:  top => bottom
      * -1: bottom => top
      */
-    tb_int8_t       winding     : 2;
+    tb_int32_t      winding     : 2;
 
-    // the index of next edge at the edge pool 
-    tb_uint16_t     next;
+    // the bottom y-coordinate, packed with the winding
+    tb_int32_t      y_bottom    : 30;
 
-    // the bottom y-coordinate
-    tb_int16_t      y_bottom;
+    // the index of next edge at the edge pool 
+    tb_uint32_t     next;
 
     // the x-coordinate of the active edge
     tb_fixed_t      x;
@@ -81,6 +102,42 @@ typedef struct __gb_polygon_raster_edge_t
 
 }gb_polygon_raster_edge_t, *gb_polygon_raster_edge_ref_t;
 
+/* the polygon raster coverage edge type
+ *
+ * the edge keeps the exact end-points instead of the sampled x-coordinate 
+ * and slope, because the anti-aliasing raster need compute the covered area 
+ * of every pixel cell which be crossed by this edge
+ *
+ *      y0 . (x0, y0)
+ *          .
+ *           .
+ *            .
+ *      y1     . (x1, y1)
+ *
+ * y0 < y1, the coordinates are relative to the left-top of the bounds
+ */
+typedef struct __gb_polygon_raster_coverage_edge_t
+{
+    // the winding, 1: top => bottom, -1: bottom => top
+    tb_long_t       winding;
+
+    // the index of next edge at the coverage edge pool 
+    tb_size_t       next;
+
+    // the top x-coordinate
+    tb_fixed_t      x0;
+
+    // the top y-coordinate, 48.16 fixed-point
+    tb_hong_t       y0;
+
+    // the bottom x-coordinate
+    tb_fixed_t      x1;
+
+    // the bottom y-coordinate, 48.16 fixed-point
+    tb_hong_t       y1;
+
+}gb_polygon_raster_coverage_edge_t, *gb_polygon_raster_coverage_edge_ref_t;
+
 /* the polygon raster type
  *
  * 1. make the edge table    
@@ -168,7 +225,7 @@ typedef struct __gb_polygon_raster_impl_t
     tb_size_t                       edge_pool_maxn;
     
     // the edge table
-    tb_uint16_t*                    edge_table;
+    tb_uint32_t*                    edge_table;
 
     // the edge table base for the y-coordinate
     tb_long_t                       edge_table_base;
@@ -177,7 +234,7 @@ typedef struct __gb_polygon_raster_impl_t
     tb_size_t                       edge_table_maxn;
 
     // the active edges
-    tb_uint16_t                     active_edges;
+    tb_uint32_t                     active_edges;
 
     // the top of the polygon bounds
     tb_long_t                       top;
@@ -185,6 +242,40 @@ typedef struct __gb_polygon_raster_impl_t
     // the bottom of the polygon bounds
     tb_long_t                       bottom;
 
+    // the top of the clipped scan-lines
+    tb_long_t                       clip_top;
+
+    // the bottom of the clipped scan-lines, no clip if clip_bottom <= clip_top
+    tb_long_t                       clip_bottom;
+
+    // the coverage edge pool, tail: 0, index: > 0
+    gb_polygon_raster_coverage_edge_ref_t coverage_edge_pool;
+
+    // the coverage edge pool size
+    tb_size_t                       coverage_edge_pool_size;
+
+    // the coverage edge pool maxn
+    tb_size_t                       coverage_edge_pool_maxn;
+
+    // the coverage edge table
+    tb_size_t*                      coverage_edge_table;
+
+    // the coverage edge table maxn
+    tb_size_t                       coverage_edge_table_maxn;
+
+    // the active coverage edges
+    tb_size_t                       coverage_active_edges;
+
+    /* the accumulated area of the current scan-line
+     *
+     * covers[x] saves the signed area delta of the pixel x, 
+     * and the coverage of the pixel x is the sum of covers[0 ... x]
+     */
+    tb_fixed_t*                     covers;
+
+    // the covers maxn
+    tb_size_t                       covers_maxn;
+
 }gb_polygon_raster_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -214,14 +305,14 @@ static tb_void_t gb_polygon_raster_edge_pool_exit(gb_polygon_raster_impl_t* impl
     if (impl->edge_pool) tb_free(impl->edge_pool);
     impl->edge_pool = tb_null;
 }
-static tb_uint16_t gb_polygon_raster_edge_pool_aloc(gb_polygon_raster_impl_t* impl)
+static tb_uint32_t gb_polygon_raster_edge_pool_aloc(gb_polygon_raster_impl_t* impl)
 {
     // check
     tb_assert(impl && impl->edge_pool);
 
     // the new index
     tb_size_t index = ++impl->edge_pool_size;
-    tb_assert(index < TB_MAXU16);
+    tb_assert(index < TB_MAXU32);
 
     // grow the edge pool
     if (index >= impl->edge_pool_maxn)
@@ -232,7 +323,7 @@ static tb_uint16_t gb_polygon_raster_edge_pool_aloc(gb_polygon_raster_impl_t* im
     }
 
     // make a new edge from the edge pool
-    return (tb_uint16_t)index;
+    return (tb_uint32_t)index;
 }
 static tb_bool_t gb_polygon_raster_edge_table_init(gb_polygon_raster_impl_t* impl, tb_long_t table_base, tb_size_t table_size)
 {
@@ -243,17 +334,17 @@ static tb_bool_t gb_polygon_raster_edge_table_init(gb_polygon_raster_impl_t* imp
     if (!impl->edge_table)
     {
         impl->edge_table_maxn = table_size;
-        impl->edge_table = tb_nalloc_type(impl->edge_table_maxn, tb_uint16_t);
+        impl->edge_table = tb_nalloc_type(impl->edge_table_maxn, tb_uint32_t);
     }
     else if (table_size > impl->edge_table_maxn)
     {
         impl->edge_table_maxn = table_size;
-        impl->edge_table = tb_ralloc_type(impl->edge_table, impl->edge_table_maxn, tb_uint16_t);
+        impl->edge_table = tb_ralloc_type(impl->edge_table, impl->edge_table_maxn, tb_uint32_t);
     }
-    tb_assert_and_check_return_val(impl->edge_table && table_size <= TB_MAXU16, tb_false);
+    tb_assert_and_check_return_val(impl->edge_table, tb_false);
 
     // clear the edge table
-    tb_memset(impl->edge_table, 0, table_size * sizeof(tb_uint16_t));
+    tb_memset(impl->edge_table, 0, table_size * sizeof(tb_uint32_t));
 
     // init the edge table base
     impl->edge_table_base = table_base;
@@ -287,12 +378,12 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
     tb_bool_t           first       = tb_true;
     tb_long_t           top         = 0;
     tb_long_t           bottom      = 0;
-    tb_uint16_t         index       = 0;
+    tb_uint32_t         index       = 0;
     tb_long_t           table_index = 0;
     gb_point_ref_t      points      = polygon->points;
-    tb_uint16_t*        counts      = polygon->counts;
-    tb_uint16_t         count       = *counts++;
-    tb_uint16_t*        edge_table  = impl->edge_table;
+    tb_uint32_t*        counts      = polygon->counts;
+    tb_uint32_t         count       = *counts++;
+    tb_uint32_t*        edge_table  = impl->edge_table;
     while (index < count)
     {
         // the point
@@ -319,7 +410,7 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
                 tb_fixed6_t dy = ye - yb;
 
                 // make a new edge from the edge pool
-                tb_uint16_t edge_index = gb_polygon_raster_edge_pool_aloc(impl);
+                tb_uint32_t edge_index = gb_polygon_raster_edge_pool_aloc(impl);
                 tb_assert(edge_index);
 
                 // the edge
@@ -367,8 +458,8 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
                 edge->x = tb_fixed6_to_fixed(xb) + ((edge->slope * ((TB_FIXED6_HALF - yb) & 63)) >> 6);
 
                 // init bottom y-coordinate
-                edge->y_bottom = (tb_int16_t)(iye - 1);
-                tb_assert(iye - 1 > TB_MINS16 && iye - 1 <= TB_MAXS16);
+                edge->y_bottom = (tb_int32_t)(iye - 1);
+                tb_assert(iye - 1 > -(1 << 29) && iye - 1 < (1 << 29));
 
                 // the table index
                 table_index = iyb - impl->edge_table_base;
@@ -404,6 +495,9 @@ static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* imp
     impl->top     = top;
     impl->bottom  = bottom;
 
+    // update the stats of the edges
+    gb_stats_size(GB_STATS_STAGE_RASTER, impl->edge_pool_size);
+
     // ok
     return tb_true;
 }
@@ -413,14 +507,14 @@ static tb_void_t gb_polygon_raster_active_scan_line_convex(gb_polygon_raster_imp
     tb_assert(impl && impl->edge_pool && func);
 
     // the edge index
-    tb_uint16_t index = impl->active_edges; 
+    tb_uint32_t index = impl->active_edges; 
     tb_check_return(index);
 
     // the edge
     gb_polygon_raster_edge_ref_t edge = impl->edge_pool + index; 
 
     // the next edge index
-    tb_uint16_t index_next = edge->next; 
+    tb_uint32_t index_next = edge->next; 
     tb_check_return(index_next);
 
     // the next edge
@@ -446,7 +540,7 @@ static tb_void_t gb_polygon_raster_active_scan_line_convex(gb_polygon_raster_imp
         // get the min and max edge for the y-bottom
         gb_polygon_raster_edge_ref_t    edge_min    = edge; 
         gb_polygon_raster_edge_ref_t    edge_max    = edge_next; 
-        tb_uint16_t                     index_max   = index_next;
+        tb_uint32_t                     index_max   = index_next;
         if (edge_min->y_bottom > edge_max->y_bottom)
         {
             edge_min    = edge_next; 
@@ -488,8 +582,8 @@ static tb_void_t gb_polygon_raster_active_scan_line_concave(gb_polygon_raster_im
     // done
     tb_long_t                       done            = 0;
     tb_long_t                       winding         = 0; 
-    tb_uint16_t                     index           = impl->active_edges; 
-    tb_uint16_t                     index_next      = 0; 
+    tb_uint32_t                     index           = impl->active_edges; 
+    tb_uint32_t                     index_next      = 0; 
     gb_polygon_raster_edge_ref_t    edge            = tb_null; 
     gb_polygon_raster_edge_ref_t    edge_next       = tb_null; 
     gb_polygon_raster_edge_ref_t    edge_cache      = tb_null; 
@@ -623,12 +717,12 @@ static tb_void_t gb_polygon_raster_active_scan_next(gb_polygon_raster_impl_t* im
     tb_size_t                       first = 1;
     tb_size_t                       order = 1;
     tb_fixed_t                      x_prev = 0;
-    tb_uint16_t                     index_prev = 0;
-    tb_uint16_t                     index = impl->active_edges;
+    tb_uint32_t                     index_prev = 0;
+    tb_uint32_t                     index = impl->active_edges;
     gb_polygon_raster_edge_ref_t    edge = tb_null; 
     gb_polygon_raster_edge_ref_t    edge_prev = tb_null; 
     gb_polygon_raster_edge_ref_t    edge_pool = impl->edge_pool;
-    tb_uint16_t                     active_edges = impl->active_edges;
+    tb_uint32_t                     active_edges = impl->active_edges;
     while (index)
     {
         // the edge
@@ -691,16 +785,16 @@ static tb_void_t gb_polygon_raster_active_scan_next(gb_polygon_raster_impl_t* im
     // update the active edges 
     impl->active_edges = active_edges;
 }
-static tb_void_t gb_polygon_raster_active_append(gb_polygon_raster_impl_t* impl, tb_uint16_t index)
+static tb_void_t gb_polygon_raster_active_append(gb_polygon_raster_impl_t* impl, tb_uint32_t index)
 {
     // check
     tb_assert(impl && impl->edge_pool);
 
     // done
-    tb_uint16_t                     next = 0;
+    tb_uint32_t                     next = 0;
     gb_polygon_raster_edge_ref_t    edge = tb_null;
     gb_polygon_raster_edge_ref_t    edge_pool = impl->edge_pool;
-    tb_uint16_t                     active_edges = impl->active_edges;
+    tb_uint32_t                     active_edges = impl->active_edges;
     while (index)
     {
         // the edge
@@ -720,205 +814,95 @@ static tb_void_t gb_polygon_raster_active_append(gb_polygon_raster_impl_t* impl,
     // update the active edges 
     impl->active_edges = active_edges;
 }
-static tb_void_t gb_polygon_raster_active_sorted_insert(gb_polygon_raster_impl_t* impl, tb_uint16_t edge_index)
+/* the edge is at the left-hand of the other edge?
+ *
+ * x: 1 2 3     5 6
+ *               |   .
+ *               5    .
+ *             .       .
+ *           .          .
+ *         .          other
+ *       .
+ *     edge
+ *
+ * compare the slopes if they are at the same vertex: edge->dx / edge->dy < other->dx / other->dy
+ */
+static __tb_inline__ tb_bool_t gb_polygon_raster_active_less(gb_polygon_raster_edge_ref_t edge, gb_polygon_raster_edge_ref_t other)
+{
+    return (edge->x < other->x || (edge->x == other->x && edge->slope < other->slope))? tb_true : tb_false;
+}
+static tb_uint32_t gb_polygon_raster_active_merge(gb_polygon_raster_edge_ref_t edge_pool, tb_uint32_t index, tb_uint32_t index_other)
 {
-    // check
-    tb_assert(impl && impl->edge_pool && edge_index);
-
-    // the edge pool
-    gb_polygon_raster_edge_ref_t edge_pool = impl->edge_pool;
-
-    // the edge
-    gb_polygon_raster_edge_ref_t edge = edge_pool + edge_index;
-
-    // insert edge to the active edges by x in ascending
-    edge->next = 0;
-    if (!impl->active_edges) impl->active_edges = edge_index;
-    else 
+    /* merge two sorted edge lists by x in ascending
+     *
+     * the edges of the first list are kept before the same edges of the other list,
+     * so the order of the same edges will not be changed
+     */
+    tb_uint32_t     head = 0;
+    tb_uint32_t*    tail = &head;
+    while (index && index_other)
     {
-        // find an inserted position
-        gb_polygon_raster_edge_ref_t    edge_prev       = tb_null;
-        gb_polygon_raster_edge_ref_t    edge_active     = tb_null;
-        tb_uint16_t                     index_active    = impl->active_edges;
-        while (index_active)
+        if (gb_polygon_raster_active_less(edge_pool + index_other, edge_pool + index))
         {
-            // the active edge
-            edge_active = edge_pool + index_active;
-
-            // check
-            tb_assert(edge_index != index_active);
-
-            /* is this?
-             *
-             * x: 1 2 3     5 6
-             *               |
-             *             4 or 5
-             */
-            if (edge->x <= edge_active->x) 
-            {
-                /* same vertex?
-                 *
-                 *
-                 * x: 1 2 3     5 6
-                 *               |   .
-                 *               5    .
-                 *             .       .
-                 *           .          .
-                 *         .          active_edge
-                 *       .
-                 *     edge
-                 *
-                 * x: 1 2 3   5         6
-                 *                 .    |
-                 *                  .   5
-                 *                   .    .
-                 *                    .     .
-                 *          active_edge       .
-                 *                              . 
-                 *                                .  
-                 *                                  .
-                 *                                   edge
-                 *
-                 *  x: 1 2 3   5         6
-                 *                 .    |
-                 *                .     5
-                 *              .    .
-                 *            .     .
-                 *  active_edge    .
-                 *                . 
-                 *               .  
-                 *              .
-                 *             edge
-                 *
-                 *
-                 * x: 1 2 3     5 6
-                 *               |   .
-                 *               5      .
-                 *                 .       .
-                 *                   .       active_edge 
-                 *                     .           
-                 *                       .
-                 *                         .
-                 *                           .
-                 *                             .
-                 *                               .
-                 *                                 .
-                 *                                 edge
-                 */
-                if (edge->x == edge_active->x)
-                {
-                    /* the edge is at the left-hand of the active edge?
-                     * 
-                     * x: 1 2 3     5 6    <- active_edges
-                     *               |   .
-                     *               5    .
-                     *             .       .
-                     *           .          .
-                     *         .        active_edge
-                     *       .
-                     *     edge
-                     *
-                     * if (edge->dx / edge->dy < active->dx / active->dy)?
-                     */
-                    if (edge->slope < edge_active->slope) break;
-                }
-                else break;
-            }
-            
-            // the previous active edge
-            edge_prev = edge_active;
-
-            // the next active edge index
-            index_active = edge_prev->next;
-        }
-
-        // insert edge to the active edges: edge_prev -> edge -> edge_active
-        if (!edge_prev)
-        {
-            // insert to the head
-            edge->next          = impl->active_edges;
-            impl->active_edges  = edge_index;
+            *tail = index_other;
+            tail = &edge_pool[index_other].next;
+            index_other = edge_pool[index_other].next;
         }
         else
         {
-            // insert to the body
-            edge->next      = index_active;
-            edge_prev->next = edge_index;
+            *tail = index;
+            tail = &edge_pool[index].next;
+            index = edge_pool[index].next;
         }
     }
+
+    // append the left edges
+    *tail = index? index : index_other;
+    return head;
 }
-static tb_void_t gb_polygon_raster_active_sorted_append(gb_polygon_raster_impl_t* impl, tb_uint16_t edge_index)
+static tb_uint32_t gb_polygon_raster_active_merge_sort(gb_polygon_raster_edge_ref_t edge_pool, tb_uint32_t index)
 {
-    // check
-    tb_assert(impl && impl->edge_pool);
+    // only one edge?
+    tb_check_return_val(index && edge_pool[index].next, index);
 
-    // done
-    tb_uint16_t                     index_next = 0;
-    gb_polygon_raster_edge_ref_t    edge = tb_null;
-    gb_polygon_raster_edge_ref_t    edge_pool = impl->edge_pool;
-    while (edge_index)
+    // find the middle edge
+    tb_uint32_t middle  = index;
+    tb_uint32_t fast    = edge_pool[index].next;
+    while (fast && edge_pool[fast].next)
     {
-        // the edge
-        edge = edge_pool + edge_index;
-
-        // save the next edge index
-        index_next = edge->next;
+        middle  = edge_pool[middle].next;
+        fast    = edge_pool[edge_pool[fast].next].next;
+    }
 
-        // insert the edge to the active edges
-        gb_polygon_raster_active_sorted_insert(impl, edge_index);
+    // split it to two lists
+    tb_uint32_t index_other = edge_pool[middle].next;
+    edge_pool[middle].next = 0;
 
-        // the next edge index
-        edge_index = index_next;
-    }
+    // sort and merge them
+    return gb_polygon_raster_active_merge(edge_pool, gb_polygon_raster_active_merge_sort(edge_pool, index), gb_polygon_raster_active_merge_sort(edge_pool, index_other));
 }
-static tb_void_t gb_polygon_raster_active_sort(gb_polygon_raster_impl_t* impl)
+static tb_void_t gb_polygon_raster_active_sorted_append(gb_polygon_raster_impl_t* impl, tb_uint32_t edge_index)
 {
     // check
     tb_assert(impl && impl->edge_pool);
 
-    // done
-    tb_uint16_t                     index       = impl->active_edges;
-    tb_uint16_t                     index_next  = 0;
-    gb_polygon_raster_edge_ref_t    edge        = tb_null;
-    gb_polygon_raster_edge_ref_t    edge_next   = tb_null;
-    gb_polygon_raster_edge_t        edge_tmp;
-    gb_polygon_raster_edge_ref_t    edge_pool   = impl->edge_pool;
-    while (index)
-    {
-        // the edge
-        edge = edge_pool + index;
-
-        // the next edge index
-        index_next = edge->next;
-        while (index_next)
-        {
-            // the next edge
-            edge_next = edge_pool + index_next;
-
-            // need sort? swap them
-            if (edge->x > edge_next->x || (edge->x == edge_next->x && edge->slope > edge_next->slope))
-            {
-                // save the edge
-                edge_tmp = *edge;
-
-                // swap the edge
-                *edge = *edge_next;
-
-                // restore the next index
-                edge->next = edge_tmp.next;
-                edge_tmp.next = edge_next->next;
+    // no edges?
+    tb_check_return(edge_index);
 
-                // swap the next edge
-                *edge_next = edge_tmp;
-            }
-        
-            // the next edge index
-            index_next = edge_next->next;
-        }
+    /* sort the new edges and merge them to the sorted active edges by x in ascending
+     *
+     * the new edges are placed after the same active edges, and it is O(n + m * log(m)),
+     * inserting the edges one by one will be too slow if there are thousands of active edges
+     */
+    impl->active_edges = gb_polygon_raster_active_merge(impl->edge_pool, impl->active_edges, gb_polygon_raster_active_merge_sort(impl->edge_pool, edge_index));
+}
+static tb_void_t gb_polygon_raster_active_sort(gb_polygon_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->edge_pool);
 
-        // the next edge index
-        index = edge->next;
-    }
+    // sort by x in ascending at the active edges, O(n * log(n))
+    impl->active_edges = gb_polygon_raster_active_merge_sort(impl->edge_pool, impl->active_edges);
 }
 static tb_void_t gb_polygon_raster_done_convex(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_polygon_raster_func_t func, tb_cpointer_t priv)
 {
@@ -936,7 +920,10 @@ static tb_void_t gb_polygon_raster_done_convex(gb_polygon_raster_impl_t* impl, g
     tb_long_t       top         = impl->top; 
     tb_long_t       bottom      = impl->bottom; 
     tb_long_t       base        = impl->edge_table_base; 
-    tb_uint16_t*    edge_table  = impl->edge_table;
+    tb_uint32_t*    edge_table  = impl->edge_table;
+
+    // clip the bottom, the scan-lines above the clip top need be done for updating the active edges
+    if (impl->clip_bottom > impl->clip_top && bottom > impl->clip_bottom) bottom = impl->clip_bottom;
     for (y = top; y < bottom; y++)
     {
         // append edges to the sorted active edges by x in ascending
@@ -955,7 +942,7 @@ static tb_void_t gb_polygon_raster_done_convex(gb_polygon_raster_impl_t* impl, g
 static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
 {
     // check
-    tb_assert(impl && polygon && !polygon->convex && bounds);
+    tb_assert(impl && polygon && bounds);
 
     // init the active edges
     impl->active_edges = 0;
@@ -969,7 +956,10 @@ static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl,
     tb_long_t       top         = impl->top; 
     tb_long_t       bottom      = impl->bottom; 
     tb_long_t       base        = impl->edge_table_base; 
-    tb_uint16_t*    edge_table  = impl->edge_table;
+    tb_uint32_t*    edge_table  = impl->edge_table;
+
+    // clip the bottom, the scan-lines above the clip top need be done for updating the active edges
+    if (impl->clip_bottom > impl->clip_top && bottom > impl->clip_bottom) bottom = impl->clip_bottom;
     for (y = top; y < bottom; y++)
     {
         // order? append edges to the sorted active edges by x in ascending
@@ -994,6 +984,459 @@ static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl,
     }
 }
 
+static tb_size_t gb_polygon_raster_coverage_edge_pool_aloc(gb_polygon_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // the new index
+    tb_size_t index = ++impl->coverage_edge_pool_size;
+
+    // grow the coverage edge pool
+    if (index >= impl->coverage_edge_pool_maxn)
+    {
+        impl->coverage_edge_pool_maxn = index + GB_POLYGON_RASTER_COVERAGE_EDGES_GROW;
+        impl->coverage_edge_pool = impl->coverage_edge_pool? tb_ralloc_type(impl->coverage_edge_pool, impl->coverage_edge_pool_maxn, gb_polygon_raster_coverage_edge_t) 
+                                                           : tb_nalloc_type(impl->coverage_edge_pool_maxn, gb_polygon_raster_coverage_edge_t);
+        tb_assert_and_check_return_val(impl->coverage_edge_pool, 0);
+    }
+
+    // make a new edge from the coverage edge pool
+    return index;
+}
+static tb_bool_t gb_polygon_raster_coverage_init(gb_polygon_raster_impl_t* impl, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert(impl && width && height);
+
+    // init the coverage edge pool size
+    impl->coverage_edge_pool_size   = 0;
+    impl->coverage_active_edges     = 0;
+
+    // init the coverage edge table
+    if (height > impl->coverage_edge_table_maxn)
+    {
+        impl->coverage_edge_table_maxn = height;
+        impl->coverage_edge_table = impl->coverage_edge_table? tb_ralloc_type(impl->coverage_edge_table, height, tb_size_t) : tb_nalloc_type(height, tb_size_t);
+    }
+    tb_assert_and_check_return_val(impl->coverage_edge_table, tb_false);
+
+    // clear the coverage edge table
+    tb_memset(impl->coverage_edge_table, 0, height * sizeof(tb_size_t));
+
+    /* init the covers 
+     *
+     * the right-most pixel may spill it's area to the next pixel, 
+     * so we need two more cells for the scan-line
+     */
+    if (width + 2 > impl->covers_maxn)
+    {
+        // make the new covers
+        if (impl->covers) tb_free(impl->covers);
+        impl->covers_maxn   = width + 2;
+        impl->covers        = tb_nalloc0_type(impl->covers_maxn, tb_fixed_t);
+    }
+    tb_assert_and_check_return_val(impl->covers, tb_false);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_polygon_raster_coverage_exit(gb_polygon_raster_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // exit the coverage edge pool
+    if (impl->coverage_edge_pool) tb_free(impl->coverage_edge_pool);
+    impl->coverage_edge_pool = tb_null;
+
+    // exit the coverage edge table
+    if (impl->coverage_edge_table) tb_free(impl->coverage_edge_table);
+    impl->coverage_edge_table = tb_null;
+
+    // exit the covers
+    if (impl->covers) tb_free(impl->covers);
+    impl->covers = tb_null;
+}
+static tb_bool_t gb_polygon_raster_coverage_edge_table_make(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, tb_long_t left, tb_long_t top, tb_long_t height)
+{
+    // check
+    tb_assert(impl && polygon && polygon->points && polygon->counts);
+
+    // make the coverage edge table
+    gb_point_t          pb;
+    gb_point_t          pe;
+    tb_uint32_t         index       = 0;
+    gb_point_ref_t      points      = polygon->points;
+    tb_uint32_t*        counts      = polygon->counts;
+    tb_uint32_t         count       = *counts++;
+    tb_fixed_t          fleft       = tb_long_to_fixed(left);
+    tb_hong_t           ftop        = gb_polygon_raster_long_to_fixed64(top);
+    tb_size_t*          edge_table  = impl->coverage_edge_table;
+    while (index < count)
+    {
+        // the point
+        pe = *points++;
+
+        // exists edge?
+        if (index)
+        {
+            // get the fixed-point coordinates relative to the left-top of the bounds
+            tb_fixed_t xb = gb_float_to_fixed(pb.x) - fleft;
+            tb_hong_t  yb = gb_polygon_raster_float_to_fixed64(pb.y) - ftop;
+            tb_fixed_t xe = gb_float_to_fixed(pe.x) - fleft;
+            tb_hong_t  ye = gb_polygon_raster_float_to_fixed64(pe.y) - ftop;
+
+            // not horizontal edge? the horizontal edge does not cover any area
+            if (yb != ye)
+            {
+                // make a new edge from the coverage edge pool
+                tb_size_t edge_index = gb_polygon_raster_coverage_edge_pool_aloc(impl);
+                tb_assert_and_check_return_val(edge_index, tb_false);
+
+                // the edge
+                gb_polygon_raster_coverage_edge_ref_t edge = impl->coverage_edge_pool + edge_index;
+
+                // init the edge and sort the points of the edge by the y-coordinate
+                if (yb < ye)
+                {
+                    edge->winding   = 1;
+                    edge->x0        = xb;
+                    edge->y0        = yb;
+                    edge->x1        = xe;
+                    edge->y1        = ye;
+                }
+                else
+                {
+                    edge->winding   = -1;
+                    edge->x0        = xe;
+                    edge->y0        = ye;
+                    edge->x1        = xb;
+                    edge->y1        = yb;
+                }
+
+                // the table index
+                tb_long_t table_index = gb_polygon_raster_fixed64_floor(edge->y0);
+                if (table_index < 0) table_index = 0;
+                tb_assert(table_index < height);
+
+                // insert edge to the head of the coverage edge table
+                edge->next = edge_table[table_index];
+                edge_table[table_index] = edge_index;
+            }
+        }
+
+        // save the previous point
+        pb = pe;
+        
+        // next point
+        index++;
+
+        // next polygon
+        if (index == count) 
+        {
+            // next
+            count = *counts++;
+            index = 0;
+        }
+    }
+
+    // update the stats of the edges
+    gb_stats_size(GB_STATS_STAGE_RASTER, impl->coverage_edge_pool_size);
+
+    // ok
+    return tb_true;
+}
+static __tb_inline__ tb_fixed_t gb_polygon_raster_coverage_edge_x(gb_polygon_raster_coverage_edge_ref_t edge, tb_hong_t y)
+{
+    // the end-points?
+    if (y <= edge->y0) return edge->x0;
+    if (y >= edge->y1) return edge->x1;
+
+    // x0 + (y - y0) * (x1 - x0) / (y1 - y0)
+    return edge->x0 + (tb_fixed_t)(((y - edge->y0) * (edge->x1 - edge->x0)) / (edge->y1 - edge->y0));
+}
+static __tb_inline__ tb_void_t gb_polygon_raster_coverage_cell(tb_fixed_t* covers, tb_long_t x, tb_fixed_t dy, tb_fixed_t xm)
+{
+    /* accumulate the area of the cell
+     *
+     *     x        x + 1     x + 2
+     *     |----------|---------|
+     *     |       .  |         |
+     *     |      .   |         |
+     *     |     .    |         |
+     *     |----------|---------|
+     *          xm
+     *
+     * the area at the left-hand of the line: dy * xm
+     * the area at the right-hand of the line: dy * (1 - xm)
+     *
+     * the pixel x is covered by the right-hand area, 
+     * and the rest pixels (> x) will be covered by dy fully
+     */
+    tb_fixed_t area = (tb_fixed_t)(((tb_hong_t)dy * xm) >> 16);
+    covers[x]       += dy - area;
+    covers[x + 1]   += area;
+}
+static tb_void_t gb_polygon_raster_coverage_line(tb_fixed_t* covers, tb_fixed_t xa, tb_fixed_t xb, tb_fixed_t dy)
+{
+    // check
+    tb_assert(covers);
+
+    // sort the x-coordinates, the area only depends on the x-range of the line in this scan-line
+    if (xa > xb) tb_swap(tb_fixed_t, xa, xb);
+
+    // the start and end cells
+    tb_long_t ib = tb_fixed_floor(xa);
+    tb_long_t ie = tb_fixed_ceil(xb) - 1;
+    if (ie < ib) ie = ib;
+
+    // only one cell?
+    if (ib == ie) 
+    {
+        gb_polygon_raster_coverage_cell(covers, ib, dy, ((xa + xb) >> 1) - tb_long_to_fixed(ib));
+        return ;
+    }
+
+    /* split the line at the boundaries of the cells
+     *
+     *     ib                          ie
+     *     |-------|-------|-------|-------|
+     *     |     . |       |       |       |
+     *     |       | .     |       |       |
+     *     |       |    .  |       |       |
+     *     |       |       | .     |       |
+     *     |       |       |     . |       |
+     *     |       |       |       |   .   |
+     *     |-------|-------|-------|-------|
+     *
+     * dy(i) = (x(i + 1) - x(i)) * dy / (xb - xa)
+     */
+    tb_long_t   i;
+    tb_fixed_t  dx      = xb - xa;
+    tb_fixed_t  xl      = xa;
+    tb_fixed_t  xr      = 0;
+    tb_fixed_t  yl      = 0;
+    tb_fixed_t  yr      = 0;
+    for (i = ib; i <= ie; i++)
+    {
+        // the right x-coordinate of this segment
+        xr = (i < ie)? tb_long_to_fixed(i + 1) : xb;
+
+        // the accumulated y-delta at the right x-coordinate, keep the sum exactly equal to dy
+        yr = (i < ie)? (tb_fixed_t)(((tb_hong_t)(xr - xa) * dy) / dx) : dy;
+
+        // accumulate this cell
+        gb_polygon_raster_coverage_cell(covers, i, yr - yl, ((xl + xr) >> 1) - tb_long_to_fixed(i));
+
+        // next segment
+        xl = xr;
+        yl = yr;
+    }
+}
+static tb_void_t gb_polygon_raster_coverage_scan_line(gb_polygon_raster_impl_t* impl, tb_long_t y, tb_long_t left, tb_long_t top, tb_long_t width, tb_size_t rule, gb_polygon_raster_coverage_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(impl && impl->coverage_edge_pool && impl->covers && func);
+
+    // the scan-line range
+    tb_hong_t   yt = gb_polygon_raster_long_to_fixed64(y);
+    tb_hong_t   yb = yt + TB_FIXED_ONE;
+
+    // the width of the scan-line
+    tb_fixed_t  fwidth = tb_long_to_fixed(width);
+
+    // accumulate the area of the active edges, the order of the active edges is not necessary 
+    tb_long_t                               xmin        = width;
+    tb_long_t                               xmax        = -1;
+    tb_size_t                               index       = impl->coverage_active_edges;
+    tb_size_t                               index_prev  = 0;
+    tb_fixed_t*                             covers      = impl->covers;
+    gb_polygon_raster_coverage_edge_ref_t   edge        = tb_null;
+    gb_polygon_raster_coverage_edge_ref_t   edge_pool   = impl->coverage_edge_pool;
+    while (index)
+    {
+        // the edge
+        edge = edge_pool + index;
+
+        // the part of the edge in this scan-line
+        tb_hong_t ya = tb_max(edge->y0, yt);
+        tb_hong_t ye = tb_min(edge->y1, yb);
+        if (ye > ya)
+        {
+            // the x-coordinates
+            tb_fixed_t xa = gb_polygon_raster_coverage_edge_x(edge, ya);
+            tb_fixed_t xe = gb_polygon_raster_coverage_edge_x(edge, ye);
+
+            // clip the x-coordinates to the bounds for the precision error
+            xa = tb_max(xa, 0); xa = tb_min(xa, fwidth);
+            xe = tb_max(xe, 0); xe = tb_min(xe, fwidth);
+
+            // accumulate the area
+            gb_polygon_raster_coverage_line(covers, xa, xe, (tb_fixed_t)(edge->winding > 0? ye - ya : ya - ye));
+
+            // update the touched range
+            tb_long_t xl = tb_fixed_floor(tb_min(xa, xe));
+            tb_long_t xr = tb_fixed_ceil(tb_max(xa, xe));
+            if (xl < xmin) xmin = xl;
+            if (xr > xmax) xmax = xr;
+        }
+
+        // remove the finished edge from the active edges
+        if (edge->y1 <= yb)
+        {
+            if (index_prev) edge_pool[index_prev].next = edge->next;
+            else impl->coverage_active_edges = edge->next;
+        }
+        else index_prev = index;
+
+        // the next edge index
+        index = edge->next;
+    }
+
+    // no touched cells?
+    tb_check_return(xmax >= 0);
+
+    // check
+    tb_assert(xmin >= 0 && xmax <= width);
+
+    /* sweep the scan-line and make the coverage spans
+     *
+     * the sum of the covers is the signed winding area of the pixel:
+     *
+     * nonzero: coverage = min(|sum|, 1)
+     * odd:     coverage = 1 - |(|sum| % 2) - 1|
+     *
+     * the conjoint pixels with the same alpha will be merged to one span,
+     * so the interior of the polygon will be done as one solid span
+     */
+    tb_long_t   x;
+    tb_long_t   run_x       = xmin;
+    tb_size_t   run_alpha   = 0;
+    tb_fixed_t  sum         = 0;
+    tb_fixed_t  cover       = 0;
+    tb_size_t   alpha       = 0;
+    for (x = xmin; x < xmax; x++)
+    {
+        // accumulate the cover and clear this cell for the next scan-line
+        sum += covers[x];
+        covers[x] = 0;
+
+        // compute the coverage
+        cover = tb_fixed_abs(sum);
+        if (rule == GB_POLYGON_RASTER_RULE_ODD)
+        {
+            cover &= (TB_FIXED_ONE << 1) - 1;
+            if (cover > TB_FIXED_ONE) cover = (TB_FIXED_ONE << 1) - cover;
+        }
+        else if (cover > TB_FIXED_ONE) cover = TB_FIXED_ONE;
+
+        // compute the alpha
+        alpha = (tb_size_t)((cover * 0xff + TB_FIXED_HALF) >> 16);
+
+        // the alpha is changed? done the previous span
+        if (alpha != run_alpha)
+        {
+            if (run_alpha) func(left + run_x, left + x, top + y, (tb_byte_t)run_alpha, priv);
+            run_x       = x;
+            run_alpha   = alpha;
+        }
+    }
+
+    // done the last span
+    if (run_alpha) func(left + run_x, left + xmax, top + y, (tb_byte_t)run_alpha, priv);
+
+    // clear the spilled cells
+    covers[xmax] = 0;
+    covers[xmax + 1] = 0;
+}
+static tb_void_t gb_polygon_raster_coverage_active_remove(gb_polygon_raster_impl_t* impl, tb_hong_t yb)
+{
+    // check
+    tb_assert(impl && impl->coverage_edge_pool);
+
+    // remove the edges finished at the bottom of this scan-line
+    tb_size_t                               index       = impl->coverage_active_edges;
+    tb_size_t                               index_prev  = 0;
+    gb_polygon_raster_coverage_edge_ref_t   edge_pool   = impl->coverage_edge_pool;
+    while (index)
+    {
+        if (edge_pool[index].y1 <= yb)
+        {
+            if (index_prev) edge_pool[index_prev].next = edge_pool[index].next;
+            else impl->coverage_active_edges = edge_pool[index].next;
+        }
+        else index_prev = index;
+        index = edge_pool[index].next;
+    }
+}
+static tb_void_t gb_polygon_raster_coverage_done(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_coverage_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(impl && polygon && bounds && func);
+
+    // empty polygon?
+    tb_check_return(!gb_near0(bounds->w) && !gb_near0(bounds->h));
+
+    // the pixel bounds of the polygon
+    tb_long_t left      = gb_floor(bounds->x);
+    tb_long_t top       = gb_floor(bounds->y);
+    tb_long_t width     = gb_ceil(bounds->x + bounds->w) - left;
+    tb_long_t height    = gb_ceil(bounds->y + bounds->h) - top;
+    tb_check_return(width > 0 && height > 0);
+
+    // init the coverage
+    if (!gb_polygon_raster_coverage_init(impl, width, height)) return ;
+
+    // make the coverage edge table
+    if (!gb_polygon_raster_coverage_edge_table_make(impl, polygon, left, top, height)) return ;
+
+    // the clipped scan-lines
+    tb_long_t y_top     = 0;
+    tb_long_t y_bottom  = height;
+    if (impl->clip_bottom > impl->clip_top)
+    {
+        y_top       = tb_max(impl->clip_top - top, 0);
+        y_bottom    = tb_min(impl->clip_bottom - top, height);
+    }
+
+    // done scan
+    tb_long_t                               y;
+    tb_size_t                               index       = 0;
+    tb_size_t                               index_next  = 0;
+    tb_size_t*                              edge_table  = impl->coverage_edge_table;
+    gb_polygon_raster_coverage_edge_ref_t   edge_pool   = impl->coverage_edge_pool;
+    for (y = 0; y < y_bottom; y++)
+    {
+        // append edges to the active edges from the coverage edge table
+        index = edge_table[y];
+        while (index)
+        {
+            index_next = edge_pool[index].next;
+            edge_pool[index].next = impl->coverage_active_edges;
+            impl->coverage_active_edges = index;
+            index = index_next;
+        }
+
+        // no active edges? skip this scan-line
+        tb_check_continue(impl->coverage_active_edges);
+
+        /* above the clipped scan-lines? only remove the finished edges
+         *
+         * the coverage of every scan-line is computed from the edge end-points directly,
+         * so skipping the scan-lines will not change the coverage of the next scan-lines
+         */
+        if (y < y_top)
+        {
+            gb_polygon_raster_coverage_active_remove(impl, gb_polygon_raster_long_to_fixed64(y + 1));
+            continue ;
+        }
+
+        // scan line from the active coverage edges
+        gb_polygon_raster_coverage_scan_line(impl, y, left, top, width, rule, func, priv);
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -1014,40 +1457,67 @@ tb_void_t gb_polygon_raster_exit(gb_polygon_raster_ref_t raster)
     // exit the edge pool
     gb_polygon_raster_edge_pool_exit(impl);
 
+    // exit the coverage
+    gb_polygon_raster_coverage_exit(impl);
+
     // exit it
     tb_free(impl);
 }
+tb_void_t gb_polygon_raster_clip(gb_polygon_raster_ref_t raster, tb_long_t top, tb_long_t bottom)
+{
+    // check
+    gb_polygon_raster_impl_t* impl = (gb_polygon_raster_impl_t*)raster;
+    tb_assert_and_check_return(impl);
+
+    // clip it
+    impl->clip_top      = top;
+    impl->clip_bottom   = bottom;
+}
 tb_void_t gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
 {
     // check
     gb_polygon_raster_impl_t* impl = (gb_polygon_raster_impl_t*)raster;
     tb_assert_and_check_return(impl && polygon && polygon->points && polygon->counts && bounds && func);
 
-    // is convex polygon for each contour?
-    if (polygon->convex)
-    {
-        // done
-        tb_size_t       index               = 0;
-        gb_point_ref_t  points              = polygon->points;
-        tb_uint16_t*    counts              = polygon->counts;
-        tb_uint16_t     contour_counts[2]   = {0, 0};
-        gb_polygon_t    contour             = {tb_null, contour_counts, tb_true};
-        while ((contour_counts[0] = *counts++))
-        {
-            // init the polygon for this contour
-            contour.points = points + index;
+    // enter the stats
+    gb_stats_enter();
 
-            // done raster for the convex contour, will be faster
-            gb_polygon_raster_done_convex(impl, &contour, bounds, func, priv);
-
-            // update the contour index
-            index += contour_counts[0];
-        }
+    /* is the single convex contour?
+     *
+     * the overlapped convex contours need the fill rule,
+     * so only the single convex contour is done as the convex polygon
+     */
+    if (polygon->convex && polygon->counts[0] && !polygon->counts[1])
+    {
+        // done raster for the convex contour, will be faster
+        gb_polygon_raster_done_convex(impl, polygon, bounds, func, priv);
     }
     else
     {
         // done raster for the concave polygon
         gb_polygon_raster_done_concave(impl, polygon, bounds, rule, func, priv);
     }
+
+    // leave the stats, the edges have been counted when making the edge table
+    gb_stats_leave(GB_STATS_STAGE_RASTER, 0);
+}
+tb_void_t gb_polygon_raster_done_coverage(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_coverage_func_t func, tb_cpointer_t priv)
+{
+    // check
+    gb_polygon_raster_impl_t* impl = (gb_polygon_raster_impl_t*)raster;
+    tb_assert_and_check_return(impl && polygon && polygon->points && polygon->counts && bounds && func);
+
+    // enter the stats
+    gb_stats_enter();
+
+    /* done raster for the coverage
+     *
+     * we need not split the convex contours for the area coverage,
+     * and the fill rule is kept for the overlapped contours
+     */
+    gb_polygon_raster_coverage_done(impl, polygon, bounds, rule, func, priv);
+
+    // leave the stats, the edges have been counted when making the edge table
+    gb_stats_leave(GB_STATS_STAGE_RASTER, 0);
 }
 
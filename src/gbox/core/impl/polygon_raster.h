@@ -62,6 +62,16 @@ typedef struct{}*       gb_polygon_raster_ref_t;
  */
 typedef tb_void_t       (*gb_polygon_raster_func_t)(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv);
 
+/* the polygon raster coverage func type
+ *
+ * @param lx            the left x-coordinate
+ * @param rx            the right x-coordinate 
+ * @param y             the y-coordinate
+ * @param alpha         the coverage alpha of the span, 0xff: full covered
+ * @param priv          the private data
+ */
+typedef tb_void_t       (*gb_polygon_raster_coverage_func_t)(tb_long_t lx, tb_long_t rx, tb_long_t y, tb_byte_t alpha, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -78,6 +88,17 @@ gb_polygon_raster_ref_t gb_polygon_raster_init(tb_noarg_t);
  */
 tb_void_t               gb_polygon_raster_exit(gb_polygon_raster_ref_t raster);
 
+/* clip the scan-lines of the raster 
+ *
+ * the scan-lines outside [top, bottom) will not be done, 
+ * e.g. only rendering the scan-lines of the tile
+ *
+ * @param raster        the raster
+ * @param top           the top y-coordinate
+ * @param bottom        the bottom y-coordinate, exclusive, no clip if bottom <= top
+ */
+tb_void_t               gb_polygon_raster_clip(gb_polygon_raster_ref_t raster, tb_long_t top, tb_long_t bottom);
+
 /* done raster
  *
  * @param raster        the raster
@@ -89,6 +110,21 @@ tb_void_t               gb_polygon_raster_exit(gb_polygon_raster_ref_t raster);
  */
 tb_void_t               gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv);
 
+/* done raster with the anti-aliasing coverage
+ *
+ * compute the exact area coverage of every pixel, 
+ * the interior pixels will be merged to the solid spans with alpha 0xff
+ * and the edge pixels will be done with the partial alpha
+ *
+ * @param raster        the raster
+ * @param polygon       the polygon
+ * @param bounds        the bounds
+ * @param rule          the raster rule
+ * @param func          the raster coverage func
+ * @param priv          the private data
+ */
+tb_void_t               gb_polygon_raster_done_coverage(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_coverage_func_t func, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -304,4 +304,12 @@ tb_void_t gb_quad_make_line(gb_point_t const points[3], gb_quad_line_func_t func
     // make line
     gb_quad_make_line_impl(points, count, func, priv);
 }
+tb_void_t gb_quad_make_line2(gb_point_t const points[3], tb_size_t count, gb_quad_line_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(func && points);
+
+    // make line
+    gb_quad_make_line_impl(points, count, func, priv);
+}
 
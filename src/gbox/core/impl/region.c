@@ -0,0 +1,523 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        region.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "region"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "region.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bands and intervals grow count
+#ifdef __gb_small__
+#   define GB_REGION_GROW               (8)
+#else
+#   define GB_REGION_GROW               (16)
+#endif
+
+// the x-coordinate after all intervals 
+#define GB_REGION_X_END                 (TB_MAXS32)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_region_bands_grow(gb_region_ref_t region, tb_size_t count)
+{
+    // check
+    tb_assert(region);
+
+    // enough?
+    tb_check_return_val(count > region->bands_maxn, tb_true);
+
+    // grow it
+    region->bands_maxn  = count + GB_REGION_GROW + (region->bands_maxn >> 1);
+    region->bands       = (gb_region_band_ref_t)tb_ralloc(region->bands, region->bands_maxn * sizeof(gb_region_band_t));
+    tb_assert_and_check_return_val(region->bands, tb_false);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_region_intervals_grow(gb_region_ref_t region, tb_size_t count)
+{
+    // check
+    tb_assert(region);
+
+    // enough?
+    tb_check_return_val(count > region->intervals_maxn, tb_true);
+
+    // grow it
+    region->intervals_maxn  = count + GB_REGION_GROW + (region->intervals_maxn >> 1);
+    region->intervals       = (gb_region_interval_ref_t)tb_ralloc(region->intervals, region->intervals_maxn * sizeof(gb_region_interval_t));
+    tb_assert_and_check_return_val(region->intervals, tb_false);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_region_append_interval(gb_region_ref_t region, tb_long_t left, tb_long_t right)
+{
+    // check
+    tb_assert(region && left < right);
+
+    // grow intervals
+    if (!gb_region_intervals_grow(region, region->intervals_count + 1)) return tb_false;
+
+    // append it
+    gb_region_interval_ref_t interval = region->intervals + region->intervals_count++;
+    interval->left  = left;
+    interval->right = right;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_region_append_band(gb_region_ref_t region, tb_long_t top, tb_long_t bottom, tb_size_t index)
+{
+    // check
+    tb_assert(region && top < bottom && index <= region->intervals_count);
+
+    // the intervals count of this band
+    tb_size_t count = region->intervals_count - index;
+
+    // empty band? ignore it
+    tb_check_return_val(count, tb_true);
+
+    // the previous band is adjacent and have the same intervals? merge them
+    if (region->bands_count)
+    {
+        gb_region_band_ref_t prev = region->bands + region->bands_count - 1;
+        if (    prev->bottom == top 
+            &&  prev->count == count
+            &&  !tb_memcmp(region->intervals + prev->index, region->intervals + index, count * sizeof(gb_region_interval_t)))
+        {
+            // extend the previous band
+            prev->bottom = bottom;
+
+            // remove the intervals of this band
+            region->intervals_count = index;
+            return tb_true;
+        }
+    }
+
+    // grow bands
+    if (!gb_region_bands_grow(region, region->bands_count + 1)) return tb_false;
+
+    // append it
+    gb_region_band_ref_t band = region->bands + region->bands_count++;
+    band->top       = top;
+    band->bottom    = bottom;
+    band->index     = index;
+    band->count     = count;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_region_make_bounds(gb_region_ref_t region)
+{
+    // check
+    tb_assert(region);
+
+    // empty?
+    if (!region->bands_count)
+    {
+        region->left    = 0;
+        region->top     = 0;
+        region->right   = 0;
+        region->bottom  = 0;
+        return ;
+    }
+
+    // the top and bottom
+    region->top     = region->bands[0].top;
+    region->bottom  = region->bands[region->bands_count - 1].bottom;
+
+    // the left and right
+    tb_size_t i = 0;
+    region->left    = GB_REGION_X_END;
+    region->right   = -GB_REGION_X_END;
+    for (i = 0; i < region->bands_count; i++)
+    {
+        gb_region_band_ref_t band = region->bands + i;
+        region->left    = tb_min(region->left, region->intervals[band->index].left);
+        region->right   = tb_max(region->right, region->intervals[band->index + band->count - 1].right);
+    }
+}
+static __tb_inline__ tb_bool_t gb_region_op_inside(tb_size_t op, tb_bool_t ina, tb_bool_t inb)
+{
+    switch (op)
+    {
+    case GB_REGION_OP_SUBTRACT:     return ina && !inb;
+    case GB_REGION_OP_INTERSECT:    return ina && inb;
+    case GB_REGION_OP_UNION:        return ina || inb;
+    default:                        return inb;
+    }
+}
+static tb_bool_t gb_region_op_intervals(gb_region_ref_t result, gb_region_interval_ref_t a, tb_size_t an, gb_region_interval_ref_t b, tb_size_t bn, tb_size_t op)
+{
+    // check
+    tb_assert(result);
+
+    /* walk the edges of the intervals from left to right
+     *
+     * a:      [      )     [   )
+     * b:          [     )   [     )
+     * a & b:      [  )      [  )
+     */
+    tb_size_t   i       = 0;
+    tb_size_t   j       = 0;
+    tb_bool_t   ina     = tb_false;
+    tb_bool_t   inb     = tb_false;
+    tb_bool_t   inside  = tb_false;
+    tb_long_t   left    = 0;
+    while (i < an || j < bn)
+    {
+        // the next edge
+        tb_long_t xa = i < an? (ina? a[i].right : a[i].left) : GB_REGION_X_END;
+        tb_long_t xb = j < bn? (inb? b[j].right : b[j].left) : GB_REGION_X_END;
+        tb_long_t x  = tb_min(xa, xb);
+
+        // cross it
+        if (xa == x)
+        {
+            if (ina) i++;
+            ina = !ina;
+        }
+        if (xb == x)
+        {
+            if (inb) j++;
+            inb = !inb;
+        }
+
+        // enter or leave the result interval
+        tb_bool_t inside_new = gb_region_op_inside(op, ina, inb);
+        if (inside_new != inside)
+        {
+            if (inside_new) left = x;
+            else if (!gb_region_append_interval(result, left, x)) return tb_false;
+            inside = inside_new;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_region_op_bands(gb_region_ref_t result, gb_region_ref_t a, gb_region_ref_t b, tb_size_t op)
+{
+    // check
+    tb_assert(result && a && b && a->bands_count && b->bands_count);
+
+    // walk the bands from top to bottom and split them at the top and bottom of all bands
+    tb_size_t   ia = 0;
+    tb_size_t   ib = 0;
+    tb_size_t   na = a->bands_count;
+    tb_size_t   nb = b->bands_count;
+    tb_long_t   y  = tb_min(a->top, b->top);
+    while (1)
+    {
+        // skip the finished bands
+        while (ia < na && a->bands[ia].bottom <= y) ia++;
+        while (ib < nb && b->bands[ib].bottom <= y) ib++;
+
+        // end? the left bands of the other region will be not changed for the intersection or subtraction 
+        if (ia == na && (ib == nb || op != GB_REGION_OP_UNION)) break;
+        if (ib == nb && op == GB_REGION_OP_INTERSECT) break;
+
+        // the current bands
+        gb_region_band_ref_t ba = ia < na? a->bands + ia : tb_null;
+        gb_region_band_ref_t bb = ib < nb? b->bands + ib : tb_null;
+
+        // inside the current bands?
+        tb_bool_t ina = ba && ba->top <= y;
+        tb_bool_t inb = bb && bb->top <= y;
+
+        // the bottom of the split band
+        tb_long_t bottom = TB_MAXS32;
+        if (ba) bottom = tb_min(bottom, ina? ba->bottom : ba->top);
+        if (bb) bottom = tb_min(bottom, inb? bb->bottom : bb->top);
+        tb_assert(bottom > y);
+
+        // make the split band
+        if (ina || inb)
+        {
+            tb_size_t index = result->intervals_count;
+            if (!gb_region_op_intervals(result, ina? a->intervals + ba->index : tb_null, ina? ba->count : 0, inb? b->intervals + bb->index : tb_null, inb? bb->count : 0, op)) return tb_false;
+            if (!gb_region_append_band(result, y, bottom, index)) return tb_false;
+        }
+
+        // next band
+        y = bottom;
+    }
+
+    // make bounds
+    gb_region_make_bounds(result);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_region_init(gb_region_ref_t region)
+{
+    // check
+    tb_assert_and_check_return(region);
+
+    // init it
+    tb_memset(region, 0, sizeof(gb_region_t));
+}
+tb_void_t gb_region_exit(gb_region_ref_t region)
+{
+    // check
+    tb_assert_and_check_return(region);
+
+    // exit bands
+    if (region->bands) tb_free(region->bands);
+
+    // exit intervals
+    if (region->intervals) tb_free(region->intervals);
+
+    // clear it
+    tb_memset(region, 0, sizeof(gb_region_t));
+}
+tb_void_t gb_region_clear(gb_region_ref_t region)
+{
+    // check
+    tb_assert_and_check_return(region);
+
+    // clear it
+    region->bands_count     = 0;
+    region->intervals_count = 0;
+    gb_region_make_bounds(region);
+}
+tb_bool_t gb_region_copy(gb_region_ref_t region, gb_region_ref_t copied)
+{
+    // check
+    tb_assert_and_check_return_val(region && copied, tb_false);
+
+    // same?
+    tb_check_return_val(region != copied, tb_true);
+
+    // grow bands and intervals
+    if (!gb_region_bands_grow(region, copied->bands_count)) return tb_false;
+    if (!gb_region_intervals_grow(region, copied->intervals_count)) return tb_false;
+
+    // copy it
+    if (copied->bands_count) tb_memcpy(region->bands, copied->bands, copied->bands_count * sizeof(gb_region_band_t));
+    if (copied->intervals_count) tb_memcpy(region->intervals, copied->intervals, copied->intervals_count * sizeof(gb_region_interval_t));
+    region->bands_count     = copied->bands_count;
+    region->intervals_count = copied->intervals_count;
+    region->left            = copied->left;
+    region->top             = copied->top;
+    region->right           = copied->right;
+    region->bottom          = copied->bottom;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_region_set_rect(gb_region_ref_t region, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom)
+{
+    // check
+    tb_assert_and_check_return_val(region, tb_false);
+
+    // clear it first
+    gb_region_clear(region);
+
+    // empty rect?
+    tb_check_return_val(left < right && top < bottom, tb_true);
+
+    // make it
+    if (!gb_region_append_interval(region, left, right)) return tb_false;
+    if (!gb_region_append_band(region, top, bottom, 0)) return tb_false;
+
+    // make bounds
+    gb_region_make_bounds(region);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_region_op(gb_region_ref_t region, gb_region_ref_t other, tb_size_t op)
+{
+    // check
+    tb_assert_and_check_return_val(region && other && region != other, tb_false);
+
+    // done
+    switch (op)
+    {
+    case GB_REGION_OP_REPLACE:
+        return gb_region_copy(region, other);
+    case GB_REGION_OP_UNION:
+        if (gb_region_is_empty(other)) return tb_true;
+        if (gb_region_is_empty(region)) return gb_region_copy(region, other);
+        break;
+    case GB_REGION_OP_INTERSECT:
+        if (    gb_region_is_empty(region) || gb_region_is_empty(other)
+            ||  region->left >= other->right || other->left >= region->right
+            ||  region->top >= other->bottom || other->top >= region->bottom)
+        {
+            gb_region_clear(region);
+            return tb_true;
+        }
+        if (gb_region_is_rect(region) && gb_region_is_rect(other))
+        {
+            return gb_region_set_rect(region,   tb_max(region->left, other->left)
+                                            ,   tb_max(region->top, other->top)
+                                            ,   tb_min(region->right, other->right)
+                                            ,   tb_min(region->bottom, other->bottom));
+        }
+        break;
+    case GB_REGION_OP_SUBTRACT:
+        if (    gb_region_is_empty(region) || gb_region_is_empty(other)
+            ||  region->left >= other->right || other->left >= region->right
+            ||  region->top >= other->bottom || other->top >= region->bottom)
+            return tb_true;
+        break;
+    default:
+        tb_assert_and_check_return_val(0, tb_false);
+        break;
+    }
+
+    // make the result region
+    gb_region_t result;
+    gb_region_init(&result);
+    if (!gb_region_op_bands(&result, region, other, op)) 
+    {
+        gb_region_exit(&result);
+        return tb_false;
+    }
+
+    // save it
+    gb_region_exit(region);
+    *region = result;
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_region_op_rect(gb_region_ref_t region, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom, tb_size_t op)
+{
+    // check
+    tb_assert_and_check_return_val(region, tb_false);
+
+    // make the rect region on the stack
+    gb_region_band_t        band;
+    gb_region_interval_t    interval;
+    gb_region_t             other;
+    gb_region_init(&other);
+    if (left < right && top < bottom)
+    {
+        interval.left       = left;
+        interval.right      = right;
+        band.top            = top;
+        band.bottom         = bottom;
+        band.index          = 0;
+        band.count          = 1;
+        other.bands         = &band;
+        other.bands_count   = 1;
+        other.intervals     = &interval;
+        other.intervals_count = 1;
+        other.left          = left;
+        other.top           = top;
+        other.right         = right;
+        other.bottom        = bottom;
+    }
+
+    // done it, the other region will be not grown
+    return gb_region_op(region, &other, op);
+}
+gb_region_band_ref_t gb_region_band(gb_region_ref_t region, tb_long_t y)
+{
+    // check
+    tb_assert(region);
+
+    // below all bands?
+    tb_check_return_val(y < region->bottom, tb_null);
+
+    // find it
+    tb_size_t l = 0;
+    tb_size_t r = region->bands_count;
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (region->bands[m].bottom <= y) l = m + 1;
+        else r = m;
+    }
+
+    // ok
+    return l < region->bands_count? region->bands + l : tb_null;
+}
+tb_bool_t gb_region_intersects(gb_region_ref_t region, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom)
+{
+    // check
+    tb_assert(region);
+
+    // outside the bounds?
+    tb_check_return_val(left < region->right && right > region->left && top < region->bottom && bottom > region->top, tb_false);
+
+    // rect? 
+    tb_check_return_val(!gb_region_is_rect(region), tb_true);
+
+    // walk the bands above the bottom
+    gb_region_band_ref_t band       = gb_region_band(region, top);
+    gb_region_band_ref_t band_end   = region->bands + region->bands_count;
+    for (; band && band < band_end && band->top < bottom; band++)
+    {
+        gb_region_interval_ref_t    interval = region->intervals + band->index;
+        gb_region_interval_ref_t    interval_end = interval + band->count;
+        for (; interval < interval_end && interval->left < right; interval++)
+        {
+            if (interval->right > left) return tb_true;
+        }
+    }
+
+    // no intersection
+    return tb_false;
+}
+#ifdef __gb_debug__
+tb_void_t gb_region_dump(gb_region_ref_t region)
+{
+    // check
+    tb_assert_and_check_return(region);
+
+    // trace
+    tb_trace_i("region: bounds: %ld, %ld, %ld, %ld, bands: %lu, intervals: %lu", region->left, region->top, region->right, region->bottom, region->bands_count, region->intervals_count);
+
+    // dump bands
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (i = 0; i < region->bands_count; i++)
+    {
+        gb_region_band_ref_t band = region->bands + i;
+        tb_trace_i("    band: [%ld, %ld)", band->top, band->bottom);
+        for (j = 0; j < band->count; j++)
+            tb_trace_i("        [%ld, %ld)", region->intervals[band->index + j].left, region->intervals[band->index + j].right);
+    }
+}
+#endif
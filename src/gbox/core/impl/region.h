@@ -0,0 +1,251 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        region.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_REGION_H
+#define GB_CORE_IMPL_REGION_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the region op enum, the values are same as gb_clipper_mode_e
+typedef enum __gb_region_op_e
+{
+    GB_REGION_OP_SUBTRACT   = 0x01  //< region - other
+,   GB_REGION_OP_INTERSECT  = 0x02  //< region & other
+,   GB_REGION_OP_UNION      = 0x03  //< region | other
+,   GB_REGION_OP_REPLACE    = 0x04  //< other
+
+}gb_region_op_e;
+
+// the region interval type, [left, right)
+typedef struct __gb_region_interval_t
+{
+    // the left
+    tb_long_t                   left;
+
+    // the right, exclusive
+    tb_long_t                   right;
+
+}gb_region_interval_t, *gb_region_interval_ref_t;
+
+// the region band type, [top, bottom)
+typedef struct __gb_region_band_t
+{
+    // the top
+    tb_long_t                   top;
+
+    // the bottom, exclusive
+    tb_long_t                   bottom;
+
+    // the index of the first interval
+    tb_size_t                   index;
+
+    // the intervals count
+    tb_size_t                   count;
+
+}gb_region_band_t, *gb_region_band_ref_t;
+
+/* the region type
+ *
+ * the y-banded region of the device pixels
+ *
+ *  top ---------------------------------------------
+ *       band0:      [    ]        [        ]
+ *      ---------------------------------------------
+ *       band1:      [                      ]
+ *      ---------------------------------------------
+ *       band2:   [    ]     [  ]     [  ]
+ *  bottom -----------------------------------------
+ *
+ * the bands are sorted by y, do not overlap and do not have the same intervals if they are adjacent,
+ * the intervals of every band are sorted by x and do not overlap or touch
+ */
+typedef struct __gb_region_t
+{
+    // the bands
+    gb_region_band_ref_t        bands;
+
+    // the bands count
+    tb_size_t                   bands_count;
+
+    // the bands maxn
+    tb_size_t                   bands_maxn;
+
+    // the intervals
+    gb_region_interval_ref_t    intervals;
+
+    // the intervals count
+    tb_size_t                   intervals_count;
+
+    // the intervals maxn
+    tb_size_t                   intervals_maxn;
+
+    // the left bounds
+    tb_long_t                   left;
+
+    // the top bounds
+    tb_long_t                   top;
+
+    // the right bounds, exclusive
+    tb_long_t                   right;
+
+    // the bottom bounds, exclusive
+    tb_long_t                   bottom;
+
+}gb_region_t, *gb_region_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the empty region
+ *
+ * @param region        the region
+ */
+tb_void_t               gb_region_init(gb_region_ref_t region);
+
+/* exit the region
+ *
+ * @param region        the region
+ */
+tb_void_t               gb_region_exit(gb_region_ref_t region);
+
+/* clear the region to be empty
+ *
+ * @param region        the region
+ */
+tb_void_t               gb_region_clear(gb_region_ref_t region);
+
+/* copy the region
+ *
+ * @param region        the region
+ * @param copied        the copied region
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_region_copy(gb_region_ref_t region, gb_region_ref_t copied);
+
+/* set the region to the given rect
+ *
+ * @param region        the region
+ * @param left          the left
+ * @param top           the top
+ * @param right         the right, exclusive
+ * @param bottom        the bottom, exclusive
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_region_set_rect(gb_region_ref_t region, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom);
+
+/* combine the other region to the region
+ *
+ * @param region        the region
+ * @param other         the other region
+ * @param op            the op
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_region_op(gb_region_ref_t region, gb_region_ref_t other, tb_size_t op);
+
+/* combine the given rect to the region
+ *
+ * @param region        the region
+ * @param left          the left
+ * @param top           the top
+ * @param right         the right, exclusive
+ * @param bottom        the bottom, exclusive
+ * @param op            the op
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_region_op_rect(gb_region_ref_t region, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom, tb_size_t op);
+
+/* the first band whose bottom is below the given y-coordinate
+ *
+ * @param region        the region
+ * @param y             the y-coordinate
+ *
+ * @return              the band, it contains y if band->top <= y, tb_null if no band is below y
+ */
+gb_region_band_ref_t    gb_region_band(gb_region_ref_t region, tb_long_t y);
+
+/* the region intersects the given rect?
+ *
+ * @param region        the region
+ * @param left          the left
+ * @param top           the top
+ * @param right         the right, exclusive
+ * @param bottom        the bottom, exclusive
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_region_intersects(gb_region_ref_t region, tb_long_t left, tb_long_t top, tb_long_t right, tb_long_t bottom);
+
+/* the region is empty?
+ *
+ * @param region        the region
+ *
+ * @return              tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t gb_region_is_empty(gb_region_ref_t region)
+{
+    return !region->bands_count;
+}
+
+/* the region is a rect?
+ *
+ * @param region        the region
+ *
+ * @return              tb_true or tb_false
+ */
+static __tb_inline__ tb_bool_t gb_region_is_rect(gb_region_ref_t region)
+{
+    return region->bands_count == 1 && region->bands[0].count == 1;
+}
+
+#ifdef __gb_debug__
+/* dump the region
+ *
+ * @param region        the region
+ */
+tb_void_t               gb_region_dump(gb_region_ref_t region);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
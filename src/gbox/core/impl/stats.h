@@ -0,0 +1,155 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        stats.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_STATS_H
+#define GB_CORE_IMPL_STATS_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../stats.h"
+#if defined(GB_CONFIG_CORE_HAVE_STATS) && (defined(TB_ARCH_x86) || defined(TB_ARCH_x64))
+#   if defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG)
+#       include <x86intrin.h>
+#       define GB_STATS_HAVE_RDTSC
+#   elif defined(TB_COMPILER_IS_MSVC)
+#       include <intrin.h>
+#       define GB_STATS_HAVE_RDTSC
+#   endif
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the stats of the pipeline stages
+ *
+ * all macros will be empty and their arguments will not be evaluated if the stats is disabled at compile time
+ *
+ * @code
+ *
+    gb_stats_enter();
+    ...
+    gb_stats_leave(GB_STATS_STAGE_FLATTEN, points_count);
+ *
+ * @endcode
+ */
+#ifdef GB_CONFIG_CORE_HAVE_STATS
+#   define gb_stats_enter()                 tb_hize_t __gb_stats_clock = gb_stats_clock()
+#   define gb_stats_leave(stage, size)      gb_stats_done(stage, 1, (tb_hize_t)(size), gb_stats_clock() - __gb_stats_clock)
+#   define gb_stats_size(stage, size)       gb_stats_done(stage, 0, (tb_hize_t)(size), 0)
+#   define gb_stats_pixels(pixels)          gb_stats_done_pixels((tb_hize_t)(pixels))
+#else
+#   define gb_stats_enter()
+#   define gb_stats_leave(stage, size)
+#   define gb_stats_size(stage, size)
+#   define gb_stats_pixels(pixels)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the stats stage enum
+typedef enum __gb_stats_stage_e
+{
+    GB_STATS_STAGE_FLATTEN      = 0
+,   GB_STATS_STAGE_STROKE       = 1
+,   GB_STATS_STAGE_TESSELLATE   = 2
+,   GB_STATS_STAGE_RASTER       = 3
+,   GB_STATS_STAGE_BLEND        = 4
+,   GB_STATS_STAGE_MAXN         = 5
+
+}gb_stats_stage_e;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+#ifdef GB_CONFIG_CORE_HAVE_STATS
+/* done the stats of the given stage
+ *
+ * @param stage         the stage
+ * @param count         the call count
+ * @param size          the input size
+ * @param time          the elapsed time
+ */
+tb_void_t               gb_stats_done(tb_size_t stage, tb_size_t count, tb_hize_t size, tb_hize_t time);
+
+/* done the stats of the blended pixels
+ *
+ * @param pixels        the pixels count
+ */
+tb_void_t               gb_stats_done_pixels(tb_hize_t pixels);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+#ifdef GB_CONFIG_CORE_HAVE_STATS
+/* the current clock of the stats
+ *
+ * @return              the cpu cycles if the cycle counter exists, otherwise the nanoseconds
+ */
+static __tb_inline__ tb_hize_t gb_stats_clock(tb_noarg_t)
+{
+#ifdef GB_STATS_HAVE_RDTSC
+    return (tb_hize_t)__rdtsc();
+#else
+    return (tb_hize_t)tb_uclock() * 1000;
+#endif
+}
+
+/* the points count of the polygon
+ *
+ * @param polygon       the polygon
+ *
+ * @return              the points count of all contours
+ */
+static __tb_inline__ tb_size_t gb_stats_polygon_size(gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(polygon && polygon->counts);
+
+    // count the points of all contours
+    tb_size_t       size = 0;
+    tb_uint32_t*    counts = polygon->counts;
+    while (*counts) size += *counts++;
+    return size;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
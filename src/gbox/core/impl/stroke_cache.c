@@ -0,0 +1,282 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        stroke_cache.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "stroke_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "stroke_cache.h"
+#include "lru_cache.h"
+#include "../path.h"
+#include "../paint.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default max items count
+#ifdef __gb_small__
+#   define GB_STROKE_CACHE_MAXN             (256)
+#else
+#   define GB_STROKE_CACHE_MAXN             (1024)
+#endif
+
+// the default max bytes of all paths
+#ifdef __gb_small__
+#   define GB_STROKE_CACHE_SIZE             (512 * 1024)
+#else
+#   define GB_STROKE_CACHE_SIZE             (4 * 1024 * 1024)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the stroke cache key type
+typedef struct __gb_stroke_cache_key_t
+{
+    // the path generation
+    tb_size_t                       generation;
+
+    // the scale bucket, the flattening level of the path for the matrix
+    tb_long_t                       level;
+
+    // the width
+    gb_float_t                      width;
+
+    // the miter limit
+    gb_float_t                      miter;
+
+    // the cap
+    tb_uint16_t                     cap;
+
+    // the join
+    tb_uint16_t                     join;
+
+}gb_stroke_cache_key_t, *gb_stroke_cache_key_ref_t;
+
+// the stroke cache item type
+typedef struct __gb_stroke_cache_item_t
+{
+    // the lru cache item, must be the first member
+    gb_lru_cache_item_t             base;
+
+    // the key
+    gb_stroke_cache_key_t           key;
+
+    // the stroked path
+    gb_path_ref_t                   path;
+
+}gb_stroke_cache_item_t, *gb_stroke_cache_item_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_stroke_cache_key_make(gb_stroke_cache_key_ref_t key, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path)
+{
+    // check
+    tb_assert(key && paint && path);
+
+    // clear key, the padding bytes will be compared
+    tb_memset(key, 0, sizeof(gb_stroke_cache_key_t));
+
+    // make key
+    key->generation = gb_path_generation(path);
+    key->level      = gb_path_polygon2_level(path, matrix);
+    key->width      = gb_paint_stroke_width(paint);
+    key->miter      = gb_paint_stroke_miter(paint);
+    key->cap        = (tb_uint16_t)gb_paint_stroke_cap(paint);
+    key->join       = (tb_uint16_t)gb_paint_stroke_join(paint);
+}
+static tb_size_t gb_stroke_cache_key_hash(tb_cpointer_t data)
+{
+    // the generation is unique for each path, the strokes of the same path are only compared in the bucket
+    gb_stroke_cache_key_ref_t key = (gb_stroke_cache_key_ref_t)data;
+    return (key->generation * 31 + (tb_size_t)key->level) * 31 + ((tb_size_t)key->cap << 8 | key->join);
+}
+static tb_void_t gb_stroke_cache_item_exit(gb_lru_cache_ref_t lru, gb_lru_cache_item_ref_t base)
+{
+    // check
+    gb_stroke_cache_item_ref_t item = (gb_stroke_cache_item_ref_t)base;
+    tb_assert(lru && item);
+
+    // exit path
+    if (item->path) gb_path_exit(item->path);
+    item->path = tb_null;
+
+    // exit it
+    tb_free(item);
+}
+static tb_size_t gb_stroke_cache_path_size(gb_path_ref_t path)
+{
+    // the items size, code + points
+    tb_size_t size = tb_iterator_size(path) * (sizeof(tb_uint8_t) + 3 * sizeof(gb_point_t));
+
+    // the polygons size
+    size += gb_path_polygon_cache_size(path);
+
+    // the path size, the path struct is not exported, so estimate it
+    return size + 256;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_stroke_cache_ref_t gb_stroke_cache_init(tb_size_t maxn, tb_size_t size)
+{
+    // make cache
+    gb_lru_cache_ref_t lru = tb_malloc0_type(gb_lru_cache_t);
+    tb_assert_and_check_return_val(lru, tb_null);
+
+    // init lru cache
+    maxn = maxn? maxn : GB_STROKE_CACHE_MAXN;
+    if (!gb_lru_cache_init(lru, maxn, maxn, size? size : GB_STROKE_CACHE_SIZE, tb_offsetof(gb_stroke_cache_item_t, key), sizeof(gb_stroke_cache_key_t), gb_stroke_cache_key_hash, gb_stroke_cache_item_exit))
+    {
+        gb_lru_cache_exit(lru);
+        tb_free(lru);
+        return tb_null;
+    }
+
+    // ok
+    return (gb_stroke_cache_ref_t)lru;
+}
+tb_void_t gb_stroke_cache_exit(gb_stroke_cache_ref_t cache)
+{
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return(lru);
+
+    // exit it
+    gb_lru_cache_exit(lru);
+    tb_free(lru);
+}
+tb_void_t gb_stroke_cache_clear(gb_stroke_cache_ref_t cache)
+{
+    // clear it
+    gb_lru_cache_clear((gb_lru_cache_ref_t)cache);
+}
+gb_path_ref_t gb_stroke_cache_get(gb_stroke_cache_ref_t cache, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path)
+{
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return_val(lru && paint && path, tb_null);
+
+    // make key
+    gb_stroke_cache_key_t key;
+    gb_stroke_cache_key_make(&key, paint, matrix, path);
+
+    // get it
+    gb_stroke_cache_item_ref_t item = (gb_stroke_cache_item_ref_t)gb_lru_cache_get(lru, &key, tb_true);
+    return item? item->path : tb_null;
+}
+gb_path_ref_t gb_stroke_cache_add(gb_stroke_cache_ref_t cache, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path, gb_path_ref_t stroked)
+{
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return_val(lru && paint && path && stroked, tb_null);
+
+    // make key
+    gb_stroke_cache_key_t key;
+    gb_stroke_cache_key_make(&key, paint, matrix, path);
+
+    // exists? 
+    gb_stroke_cache_item_ref_t item = (gb_stroke_cache_item_ref_t)gb_lru_cache_get(lru, &key, tb_false);
+    if (item) return item->path;
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // make item
+        item = tb_malloc0_type(gb_stroke_cache_item_t);
+        tb_assert_and_check_break(item);
+
+        // init item
+        item->key   = key;
+        item->path  = gb_path_init();
+        tb_assert_and_check_break(item->path);
+
+        // copy the stroked path
+        gb_path_copy(item->path, stroked);
+
+        // make the cached hint, bounds and polygon of the stroked path now
+        gb_path_hint(item->path);
+        gb_path_bounds(item->path);
+        gb_path_polygon(item->path);
+
+        // insert it with the path size, not cache it if it is too large
+        item->base.size = gb_stroke_cache_path_size(item->path);
+        if (!gb_lru_cache_insert(lru, &item->base)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (item) gb_stroke_cache_item_exit(lru, &item->base);
+        item = tb_null;
+    }
+
+    // ok?
+    return item? item->path : tb_null;
+}
+tb_size_t gb_stroke_cache_hits(gb_stroke_cache_ref_t cache)
+{
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return_val(lru, 0);
+
+    // the hit count
+    return lru->hits;
+}
+tb_size_t gb_stroke_cache_misses(gb_stroke_cache_ref_t cache)
+{
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return_val(lru, 0);
+
+    // the miss count
+    return lru->misses;
+}
+#ifdef __gb_debug__
+tb_void_t gb_stroke_cache_dump(gb_stroke_cache_ref_t cache)
+{
+    // check
+    gb_lru_cache_ref_t lru = (gb_lru_cache_ref_t)cache;
+    tb_assert_and_check_return(lru);
+
+    // trace
+    tb_trace_i("items: %lu/%lu, size: %lu/%lu, hits: %lu, misses: %lu", gb_lru_cache_count(lru), lru->maxn, lru->size, lru->maxs, lru->hits, lru->misses);
+}
+#endif
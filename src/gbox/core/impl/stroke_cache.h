@@ -0,0 +1,131 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        stroke_cache.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_STROKE_CACHE_H
+#define GB_CORE_IMPL_STROKE_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the stroke cache ref type
+typedef struct{}*       gb_stroke_cache_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the stroke cache
+ *
+ * cache: path generation + scale bucket + width + cap + join + miter => stroked path
+ *
+ * the scale bucket is the flattening level of the path for the matrix,
+ * so the outlines of the curves are flattened again only if the level is changed
+ *
+ * the least recently used paths will be removed if the items count or the paths size exceeds the limit
+ *
+ * @param maxn          the max items count, using the default count if be zero
+ * @param size          the max bytes of all paths, using the default size if be zero
+ *
+ * @return              the stroke cache
+ */
+gb_stroke_cache_ref_t   gb_stroke_cache_init(tb_size_t maxn, tb_size_t size);
+
+/* exit the stroke cache
+ *
+ * @param cache         the stroke cache
+ */
+tb_void_t               gb_stroke_cache_exit(gb_stroke_cache_ref_t cache);
+
+/* clear the stroke cache
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_stroke_cache_clear(gb_stroke_cache_ref_t cache);
+
+/* get the stroked path of the given path
+ *
+ * @param cache         the cache
+ * @param paint         the paint
+ * @param matrix        the matrix
+ * @param path          the path
+ * 
+ * @return              the stroked path, tb_null if be not cached
+ */
+gb_path_ref_t           gb_stroke_cache_get(gb_stroke_cache_ref_t cache, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path);
+
+/* add the stroked path of the given path to cache
+ *
+ * @note the returned path is only valid before adding the next path
+ *
+ * @param cache         the cache
+ * @param paint         the paint
+ * @param matrix        the matrix
+ * @param path          the path
+ * @param stroked       the stroked path
+ *
+ * @return              the cached stroked path, tb_null if it is too large to be cached
+ */
+gb_path_ref_t           gb_stroke_cache_add(gb_stroke_cache_ref_t cache, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path, gb_path_ref_t stroked);
+
+/* the hit count of the stroke cache
+ *
+ * @param cache         the cache
+ *
+ * @return              the hit count
+ */
+tb_size_t               gb_stroke_cache_hits(gb_stroke_cache_ref_t cache);
+
+/* the miss count of the stroke cache
+ *
+ * @param cache         the cache
+ *
+ * @return              the miss count
+ */
+tb_size_t               gb_stroke_cache_misses(gb_stroke_cache_ref_t cache);
+
+#ifdef __gb_debug__
+/* dump the stroke cache
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_stroke_cache_dump(gb_stroke_cache_ref_t cache);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -32,6 +32,7 @@
 #include "cubic.h"
 #include "../path.h"
 #include "../paint.h"
+#include "stats.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -1910,8 +1911,8 @@ tb_void_t gb_stroker_add_polygon(gb_stroker_ref_t stroker, gb_polygon_ref_t poly
     gb_point_ref_t  first = tb_null;
     gb_point_ref_t  point = tb_null;
     gb_point_ref_t  points = polygon->points;
-    tb_uint16_t*    counts = polygon->counts;
-    tb_uint16_t     count = *counts++;
+    tb_uint32_t*    counts = polygon->counts;
+    tb_uint32_t     count = *counts++;
     tb_size_t       index = 0;
     while (index < count)
     {
@@ -1968,6 +1969,9 @@ gb_path_ref_t gb_stroker_done(gb_stroker_ref_t stroker, tb_bool_t convex)
 }
 gb_path_ref_t gb_stroker_done_path(gb_stroker_ref_t stroker, gb_paint_ref_t paint, gb_path_ref_t path)
 {
+    // enter the stats
+    gb_stats_enter();
+
     // clear the stroker
     gb_stroker_clear(stroker);
 
@@ -1983,10 +1987,19 @@ gb_path_ref_t gb_stroker_done_path(gb_stroker_ref_t stroker, gb_paint_ref_t pain
     }
 
     // done the stroker
-    return gb_stroker_done(stroker, convex);
+    gb_path_ref_t stroked = gb_stroker_done(stroker, convex);
+
+    // leave the stats with the items of the stroked path
+    gb_stats_leave(GB_STATS_STAGE_STROKE, stroked? tb_iterator_size((tb_iterator_ref_t)stroked) : 0);
+
+    // ok
+    return stroked;
 }
 gb_path_ref_t gb_stroker_done_lines(gb_stroker_ref_t stroker, gb_paint_ref_t paint, gb_point_ref_t points, tb_size_t count)
 {
+    // enter the stats
+    gb_stats_enter();
+
     // clear the stroker
     gb_stroker_clear(stroker);
 
@@ -1997,10 +2010,19 @@ gb_path_ref_t gb_stroker_done_lines(gb_stroker_ref_t stroker, gb_paint_ref_t pai
     gb_stroker_add_lines(stroker, points, count);
 
     // done the stroker
-    return gb_stroker_done(stroker, tb_true);
+    gb_path_ref_t stroked = gb_stroker_done(stroker, tb_true);
+
+    // leave the stats with the items of the stroked path
+    gb_stats_leave(GB_STATS_STAGE_STROKE, stroked? tb_iterator_size((tb_iterator_ref_t)stroked) : 0);
+
+    // ok
+    return stroked;
 }
 gb_path_ref_t gb_stroker_done_points(gb_stroker_ref_t stroker, gb_paint_ref_t paint, gb_point_ref_t points, tb_size_t count)
 {
+    // enter the stats
+    gb_stats_enter();
+
     // clear the stroker
     gb_stroker_clear(stroker);
 
@@ -2011,10 +2033,19 @@ gb_path_ref_t gb_stroker_done_points(gb_stroker_ref_t stroker, gb_paint_ref_t pa
     gb_stroker_add_points(stroker, points, count);
 
     // done the stroker
-    return gb_stroker_done(stroker, tb_true);
+    gb_path_ref_t stroked = gb_stroker_done(stroker, tb_true);
+
+    // leave the stats with the items of the stroked path
+    gb_stats_leave(GB_STATS_STAGE_STROKE, stroked? tb_iterator_size((tb_iterator_ref_t)stroked) : 0);
+
+    // ok
+    return stroked;
 }
 gb_path_ref_t gb_stroker_done_polygon(gb_stroker_ref_t stroker, gb_paint_ref_t paint, gb_polygon_ref_t polygon, gb_shape_ref_t hint)
 {
+    // enter the stats
+    gb_stats_enter();
+
     // clear the stroker
     gb_stroker_clear(stroker);
 
@@ -2030,5 +2061,11 @@ gb_path_ref_t gb_stroker_done_polygon(gb_stroker_ref_t stroker, gb_paint_ref_t p
     }
 
     // done the stroker
-    return gb_stroker_done(stroker, convex);
+    gb_path_ref_t stroked = gb_stroker_done(stroker, convex);
+
+    // leave the stats with the items of the stroked path
+    gb_stats_leave(GB_STATS_STAGE_STROKE, stroked? tb_iterator_size((tb_iterator_ref_t)stroked) : 0);
+
+    // ok
+    return stroked;
 }
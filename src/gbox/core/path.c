@@ -37,6 +37,7 @@
 #include "impl/quad.h"
 #include "impl/cubic.h"
 #include "impl/bounds.h"
+#include "impl/stats.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -52,6 +53,32 @@
 // the point step for code
 #define gb_path_point_step(code)    ((code) < 1? 1 : (code) - 1)
 
+/* the iterator bits of the point index
+ *
+ * itor: (code index << GB_PATH_ITOR_BITS) | point index
+ */
+#if TB_CPU_BIT64
+#   define GB_PATH_ITOR_BITS        (32)
+#else
+#   define GB_PATH_ITOR_BITS        (16)
+#endif
+
+// the iterator mask of the point index
+#define GB_PATH_ITOR_MASK           (((tb_size_t)1 << GB_PATH_ITOR_BITS) - 1)
+
+// the cached polygons maximum count for the other flattening levels
+#ifdef __gb_small__
+#   define GB_PATH_POLYGONS_MAXN    (2)
+#else
+#   define GB_PATH_POLYGONS_MAXN    (4)
+#endif
+
+/* the maximum flattening level
+ *
+ * each level will divide the curves once more (or less) for the scale with 4x
+ */
+#define GB_PATH_POLYGON_LEVEL_MAXN  (2)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -63,7 +90,9 @@ typedef enum __gb_path_flag_e
 ,   GB_PATH_FLAG_DIRTY_BOUNDS           = 2
 ,   GB_PATH_FLAG_DIRTY_POLYGON          = 4
 ,   GB_PATH_FLAG_DIRTY_CONVEX           = 8
-,   GB_PATH_FLAG_DIRTY_ALL              = GB_PATH_FLAG_DIRTY_HINT | GB_PATH_FLAG_DIRTY_BOUNDS | GB_PATH_FLAG_DIRTY_POLYGON | GB_PATH_FLAG_DIRTY_CONVEX
+,   GB_PATH_FLAG_DIRTY_POLYGONS         = 256   //< the cached polygons for the other flattening levels
+,   GB_PATH_FLAG_DIRTY_GENERATION       = 512
+,   GB_PATH_FLAG_DIRTY_ALL              = GB_PATH_FLAG_DIRTY_HINT | GB_PATH_FLAG_DIRTY_BOUNDS | GB_PATH_FLAG_DIRTY_POLYGON | GB_PATH_FLAG_DIRTY_CONVEX | GB_PATH_FLAG_DIRTY_POLYGONS | GB_PATH_FLAG_DIRTY_GENERATION
 ,   GB_PATH_FLAG_CURVE                  = 16    //< have curve contour?
 ,   GB_PATH_FLAG_CONVEX                 = 32    //< all contours are convex polygon?
 ,   GB_PATH_FLAG_CLOSED                 = 64    //< the contour is closed now?
@@ -71,6 +100,23 @@ typedef enum __gb_path_flag_e
 
 }gb_path_flag_e;
 
+// the path polygon entry type for the other flattening level
+typedef struct __gb_path_polygon_entry_t
+{
+    // the polygon
+    gb_polygon_t        polygon;
+
+    // the polygon points, gb_point_t[]
+    tb_vector_ref_t     points;
+
+    // the polygon counts, tb_uint32_t[]
+    tb_vector_ref_t     counts;
+
+    // the flattening level
+    tb_long_t           level;
+
+}gb_path_polygon_entry_t;
+
 // the path impl type
 typedef struct __gb_path_impl_t
 {
@@ -78,7 +124,7 @@ typedef struct __gb_path_impl_t
     tb_iterator_t       itor;
 
     // the flag
-    tb_uint8_t          flag;
+    tb_uint16_t         flag;
 
     // the hint shape
     gb_shape_t          hint;
@@ -104,11 +150,30 @@ typedef struct __gb_path_impl_t
     // the polygon points, gb_point_t[]
     tb_vector_ref_t     polygon_points;
 
-    // the polygon counts, gb_uint16_t[]
+    // the polygon counts, tb_uint32_t[]
     tb_vector_ref_t     polygon_counts;
 
+    /* the cached polygons for the other flattening levels, gb_path_polygon_entry_t[GB_PATH_POLYGONS_MAXN]
+     *
+     * the recently used polygon is at the head
+     */
+    gb_path_polygon_entry_t*    polygons;
+
+    // the cached polygons count
+    tb_size_t           polygons_count;
+
+    // the generation
+    tb_size_t           generation;
+
 }gb_path_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the path generation
+static tb_atomic_t      g_generation = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -148,7 +213,7 @@ static tb_size_t gb_path_itor_last(tb_iterator_ref_t iterator)
     if (point_last >= point_step) point_last -= point_step;
 
     // last
-    return ((code_last << 16) | point_last);
+    return ((code_last << GB_PATH_ITOR_BITS) | point_last);
 }
 static tb_size_t gb_path_itor_tail(tb_iterator_ref_t iterator)
 {
@@ -159,10 +224,10 @@ static tb_size_t gb_path_itor_tail(tb_iterator_ref_t iterator)
     // the code and point tail
     tb_size_t code_tail     = tb_vector_size(impl->codes);
     tb_size_t point_tail    = tb_vector_size(impl->points);
-    tb_assert(code_tail <= TB_MAXU16 && point_tail <= TB_MAXU16);
+    tb_assert(code_tail <= GB_PATH_ITOR_MASK && point_tail <= GB_PATH_ITOR_MASK);
 
     // tail
-    return ((code_tail << 16) | point_tail);
+    return ((code_tail << GB_PATH_ITOR_BITS) | point_tail);
 }
 static tb_size_t gb_path_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
 {
@@ -171,7 +236,7 @@ static tb_size_t gb_path_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
     tb_assert_and_check_return_val(impl && impl->codes, 0);
 
     // the code
-    tb_long_t code = (tb_long_t)tb_iterator_item(impl->codes, itor >> 16);
+    tb_long_t code = (tb_long_t)tb_iterator_item(impl->codes, itor >> GB_PATH_ITOR_BITS);
     tb_assert(code >= 0 && code < GB_PATH_CODE_MAXN);
 
     /* the next
@@ -179,7 +244,7 @@ static tb_size_t gb_path_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
      * code_index++
      * point_index += point_step
      */
-    return itor + (0x10000 | gb_path_point_step(code));
+    return itor + (((tb_size_t)1 << GB_PATH_ITOR_BITS) | gb_path_point_step(code));
 }
 static tb_size_t gb_path_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
 {
@@ -188,21 +253,21 @@ static tb_size_t gb_path_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
     tb_assert_and_check_return_val(impl && impl->codes, 0);
 
     // check the code index
-    tb_assert(itor >> 16);
+    tb_assert(itor >> GB_PATH_ITOR_BITS);
 
     // the code
-    tb_long_t code = (tb_size_t)tb_iterator_item(impl->codes, (itor >> 16) - 1);
+    tb_long_t code = (tb_size_t)tb_iterator_item(impl->codes, (itor >> GB_PATH_ITOR_BITS) - 1);
     tb_assert(code >= 0 && code < GB_PATH_CODE_MAXN);
 
     // check the point index
-    tb_assert((itor & 0xffff) >= gb_path_point_step(code));
+    tb_assert((itor & GB_PATH_ITOR_MASK) >= gb_path_point_step(code));
 
     /* the prev
      *
      * code_index--
      * point_index -= point_step
      */
-    return itor - (0x10000 | gb_path_point_step(code));
+    return itor - (((tb_size_t)1 << GB_PATH_ITOR_BITS) | gb_path_point_step(code));
 }
 static tb_pointer_t gb_path_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
 {
@@ -211,8 +276,8 @@ static tb_pointer_t gb_path_itor_item(tb_iterator_ref_t iterator, tb_size_t itor
     tb_assert_and_check_return_val(impl && impl->codes && impl->points, tb_null);
     
     // the code and point index
-    tb_size_t code_index    = itor >> 16;
-    tb_size_t point_index   = itor & 0xffff;
+    tb_size_t code_index    = itor >> GB_PATH_ITOR_BITS;
+    tb_size_t point_index   = itor & GB_PATH_ITOR_MASK;
 
     // the code
     tb_size_t code = (tb_size_t)tb_iterator_item(impl->codes, code_index);
@@ -328,6 +393,31 @@ static tb_bool_t gb_path_make_hint(gb_path_impl_t* impl)
     // ok
     return tb_true;
 }
+static tb_bool_t gb_path_hint_convex(gb_path_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // the hint shape
+    gb_shape_ref_t hint = gb_path_hint((gb_path_ref_t)impl);
+    tb_check_return_val(hint, tb_false);
+
+    // is convex shape?
+    switch (hint->type)
+    {
+    case GB_SHAPE_TYPE_RECT:
+    case GB_SHAPE_TYPE_CIRCLE:
+    case GB_SHAPE_TYPE_ELLIPSE:
+    case GB_SHAPE_TYPE_TRIANGLE:
+    case GB_SHAPE_TYPE_ROUND_RECT:
+        return tb_true;
+    default:
+        break;
+    }
+
+    // no
+    return tb_false;
+}
 static tb_bool_t gb_path_make_convex(gb_path_impl_t* impl)
 {
     // check
@@ -337,23 +427,7 @@ static tb_bool_t gb_path_make_convex(gb_path_impl_t* impl)
     impl->flag &= ~GB_PATH_FLAG_CONVEX;
 
     // attempt to analyze convex from the hint shape first
-    gb_shape_ref_t hint = gb_path_hint((gb_path_ref_t)impl);
-    if (hint && hint->type)
-    {
-        // done
-        switch (hint->type)
-        {
-        case GB_SHAPE_TYPE_RECT:
-        case GB_SHAPE_TYPE_CIRCLE:
-        case GB_SHAPE_TYPE_ELLIPSE:
-        case GB_SHAPE_TYPE_TRIANGLE:
-        case GB_SHAPE_TYPE_ROUND_RECT:
-            impl->flag |= GB_PATH_FLAG_CONVEX;
-            break;
-        default:
-            break;
-        }
-    }
+    if (gb_path_hint_convex(impl)) impl->flag |= GB_PATH_FLAG_CONVEX;
 
     // analyze convex from the single closed contour 
     if (    !(impl->flag & GB_PATH_FLAG_CONVEX) 
@@ -610,32 +684,43 @@ static tb_void_t gb_path_make_line_for_curve_to(gb_point_ref_t point, tb_cpointe
     tb_vector_insert_tail(polygon_points, point);
 
     // update the points count
-    values[1].u16++;
+    values[1].u32++;
 }
-static tb_bool_t gb_path_make_python(gb_path_impl_t* impl)
+static __tb_inline__ tb_size_t gb_path_make_divided_count(tb_size_t count, tb_long_t level)
+{
+    // adjust the divided count for the flattening level
+    tb_long_t divided = (tb_long_t)count + level;
+
+    // divide it once at least
+    return divided > 0? (tb_size_t)divided : 1;
+}
+static tb_bool_t gb_path_make_python(gb_path_impl_t* impl, tb_long_t level, gb_polygon_ref_t polygon, tb_vector_ref_t* polygon_points, tb_vector_ref_t* polygon_counts)
 { 
     // check
-    tb_assert_and_check_return_val(impl && impl->codes && impl->points, tb_false);
+    tb_assert_and_check_return_val(impl && impl->codes && impl->points && polygon && polygon_points && polygon_counts, tb_false);
+
+    // enter the stats
+    gb_stats_enter();
 
     // make polygon counts
-    if (!impl->polygon_counts) impl->polygon_counts = tb_vector_init(8, tb_element_uint16());
-    tb_assert_and_check_return_val(impl->polygon_counts, tb_false);
+    if (!*polygon_counts) *polygon_counts = tb_vector_init(8, tb_element_uint32());
+    tb_assert_and_check_return_val(*polygon_counts, tb_false);
 
     // have curve?
     if (impl->flag & GB_PATH_FLAG_CURVE)
     {
         // make polygon points
-        if (!impl->polygon_points) impl->polygon_points = tb_vector_init(tb_vector_size(impl->points), tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
-        tb_assert_and_check_return_val(impl->polygon_points, tb_false);
+        if (!*polygon_points) *polygon_points = tb_vector_init(tb_vector_size(impl->points), tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+        tb_assert_and_check_return_val(*polygon_points, tb_false);
 
         // clear polygon points and counts
-        tb_vector_clear(impl->polygon_points);
-        tb_vector_clear(impl->polygon_counts);
+        tb_vector_clear(*polygon_points);
+        tb_vector_clear(*polygon_counts);
 
         // init values
         tb_value_t values[2];
-        values[0].ptr = impl->polygon_points;
-        values[1].u16 = 0;
+        values[0].ptr = *polygon_points;
+        values[1].u32 = 0;
 
         // done
         tb_for_all_if (gb_path_item_ref_t, item, (gb_path_ref_t)impl, item)
@@ -645,34 +730,34 @@ static tb_bool_t gb_path_make_python(gb_path_impl_t* impl)
             case GB_PATH_CODE_MOVE:
                 {
                     // append count
-                    if (values[1].u16) tb_vector_insert_tail(impl->polygon_counts, tb_u2p(values[1].u16));
+                    if (values[1].u32) tb_vector_insert_tail(*polygon_counts, tb_u2p(values[1].u32));
 
                     // make point
-                    tb_vector_insert_tail(impl->polygon_points, &item->points[0]);
+                    tb_vector_insert_tail(*polygon_points, &item->points[0]);
 
                     // init the points count
-                    values[1].u16 = 1;
+                    values[1].u32 = 1;
                 }
                 break;
             case GB_PATH_CODE_LINE:
                 {
                     // make point
-                    tb_vector_insert_tail(impl->polygon_points, &item->points[1]);
+                    tb_vector_insert_tail(*polygon_points, &item->points[1]);
 
                     // update the points count
-                    values[1].u16++;
+                    values[1].u32++;
                 }
                 break;
             case GB_PATH_CODE_QUAD:
                 {
                     // make quad points
-                    gb_quad_make_line(item->points, gb_path_make_line_for_curve_to, values);
+                    gb_quad_make_line2(item->points, gb_path_make_divided_count(gb_quad_divide_line_count(item->points), level), gb_path_make_line_for_curve_to, values);
                 }
                 break;
             case GB_PATH_CODE_CUBIC:
                 {
                     // make cubic points
-                    gb_cubic_make_line(item->points, gb_path_make_line_for_curve_to, values);
+                    gb_cubic_make_line2(item->points, gb_path_make_divided_count(gb_cubic_divide_line_count(item->points), level), gb_path_make_line_for_curve_to, values);
                 }
                 break;
             case GB_PATH_CODE_CLOS:
@@ -682,25 +767,25 @@ static tb_bool_t gb_path_make_python(gb_path_impl_t* impl)
         }
 
         // append the last count
-        if (values[1].u16)
+        if (values[1].u32)
         {
-            tb_vector_insert_tail(impl->polygon_counts, tb_u2p(values[1].u16));
-            values[1].u16 = 0;
+            tb_vector_insert_tail(*polygon_counts, tb_u2p(values[1].u32));
+            values[1].u32 = 0;
         }
 
         // append the tail count
-        tb_vector_insert_tail(impl->polygon_counts, (tb_cpointer_t)0);
+        tb_vector_insert_tail(*polygon_counts, (tb_cpointer_t)0);
 
         // init polygon
-        impl->polygon.points = (gb_point_ref_t)tb_vector_data(impl->polygon_points);
-        impl->polygon.counts = (tb_uint16_t*)tb_vector_data(impl->polygon_counts);
+        polygon->points = (gb_point_ref_t)tb_vector_data(*polygon_points);
+        polygon->counts = (tb_uint32_t*)tb_vector_data(*polygon_counts);
     }
     // only move-to and line-to? using the points directly
     else
     {
         // init polygon counts
-        tb_uint16_t count = 0;
-        tb_vector_clear(impl->polygon_counts);
+        tb_uint32_t count = 0;
+        tb_vector_clear(*polygon_counts);
         tb_for_all (tb_long_t, code, impl->codes)
         {
             // check
@@ -709,39 +794,48 @@ static tb_bool_t gb_path_make_python(gb_path_impl_t* impl)
             // append count
             if (code == GB_PATH_CODE_MOVE) 
             {
-                if (count) tb_vector_insert_tail(impl->polygon_counts, tb_u2p(count));
+                if (count) tb_vector_insert_tail(*polygon_counts, tb_u2p(count));
                 count = 0;
             }
 
             // update count
-            count += (tb_uint16_t)gb_path_point_step(code);
+            count += (tb_uint32_t)gb_path_point_step(code);
         }
 
         // append the last count
         if (count)
         {
-            tb_vector_insert_tail(impl->polygon_counts, tb_u2p(count));
+            tb_vector_insert_tail(*polygon_counts, tb_u2p(count));
             count = 0;
         }
 
         // append the tail count
-        tb_vector_insert_tail(impl->polygon_counts, (tb_cpointer_t)0);
+        tb_vector_insert_tail(*polygon_counts, (tb_cpointer_t)0);
 
         // init polygon
-        impl->polygon.points = (gb_point_ref_t)tb_vector_data(impl->points);
-        impl->polygon.counts = (tb_uint16_t*)tb_vector_data(impl->polygon_counts);
+        polygon->points = (gb_point_ref_t)tb_vector_data(impl->points);
+        polygon->counts = (tb_uint32_t*)tb_vector_data(*polygon_counts);
     }
 
     // check
-    tb_assert_and_check_return_val(impl->polygon.points && impl->polygon.counts, tb_false);
+    tb_assert_and_check_return_val(polygon->points && polygon->counts, tb_false);
 
     // is convex polygon?
-    impl->polygon.convex = gb_path_convex((gb_path_ref_t)impl);
+    polygon->convex = gb_path_convex((gb_path_ref_t)impl);
+
+    /* the convex contour is only analyzed from the control points,
+     * the coarser chords of the nearly coincident curves may cross each other, e.g. the thin crescent,
+     * so only the convex hint shape is trusted for the coarser flattening levels
+     */
+    if (polygon->convex && level < 0 && (impl->flag & GB_PATH_FLAG_CURVE))
+        polygon->convex = gb_path_hint_convex(impl);
+
+    // leave the stats with the flattened points
+    gb_stats_leave(GB_STATS_STAGE_FLATTEN, (impl->flag & GB_PATH_FLAG_CURVE)? tb_vector_size(*polygon_points) : tb_vector_size(impl->points));
 
     // ok
     return tb_true;
 }
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -804,6 +898,20 @@ tb_void_t gb_path_exit(gb_path_ref_t path)
     gb_path_impl_t* impl = (gb_path_impl_t*)path;
     tb_assert_and_check_return(impl);
 
+    // exit the cached polygons
+    if (impl->polygons)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < GB_PATH_POLYGONS_MAXN; i++)
+        {
+            if (impl->polygons[i].points) tb_vector_exit(impl->polygons[i].points);
+            if (impl->polygons[i].counts) tb_vector_exit(impl->polygons[i].counts);
+        }
+        tb_free(impl->polygons);
+        impl->polygons = tb_null;
+    }
+    impl->polygons_count = 0;
+
     // exit polygon points
     if (impl->polygon_points) tb_vector_exit(impl->polygon_points);
     impl->polygon_points = tb_null;
@@ -860,7 +968,10 @@ tb_void_t gb_path_copy(gb_path_ref_t path, gb_path_ref_t copied)
     tb_vector_copy(impl->points, impl_copied->points);
 
     // copy flag
-    impl->flag = impl_copied->flag | GB_PATH_FLAG_DIRTY_POLYGON;
+    impl->flag = impl_copied->flag | GB_PATH_FLAG_DIRTY_POLYGON | GB_PATH_FLAG_DIRTY_POLYGONS;
+
+    // copy generation, the copied path has the same contours
+    impl->generation = impl_copied->generation;
 
     // copy hint
     impl->hint = impl_copied->hint;
@@ -1024,6 +1135,9 @@ tb_void_t gb_path_last_set(gb_path_ref_t path, gb_point_ref_t point)
 
     // save it
     if (last) *last = *point;
+
+    // mark dirty
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
 }
 gb_shape_ref_t gb_path_hint(gb_path_ref_t path)
 {
@@ -1060,7 +1174,7 @@ gb_polygon_ref_t gb_path_polygon(gb_path_ref_t path)
     if (impl->flag & GB_PATH_FLAG_DIRTY_POLYGON)
     {
         // make polygon
-        if (!gb_path_make_python(impl)) return tb_null; 
+        if (!gb_path_make_python(impl, 0, &impl->polygon, &impl->polygon_points, &impl->polygon_counts)) return tb_null; 
 
         // remove dirty
         impl->flag &= ~GB_PATH_FLAG_DIRTY_POLYGON;
@@ -1069,6 +1183,160 @@ gb_polygon_ref_t gb_path_polygon(gb_path_ref_t path)
     // ok?
     return &impl->polygon;
 }
+gb_polygon_ref_t gb_path_polygon2(gb_path_ref_t path, gb_matrix_ref_t matrix)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // no matrix or no curve? the polygon is same for all levels
+    if (!matrix || !(impl->flag & GB_PATH_FLAG_CURVE)) return gb_path_polygon(path);
+
+    // the flattening level
+    tb_long_t level = gb_path_polygon_level(matrix);
+    tb_check_return_val(level, gb_path_polygon(path));
+
+    // null?
+    if (gb_path_null(path)) return tb_null;
+
+    // the cached polygons are dirty? clear them
+    if (impl->flag & GB_PATH_FLAG_DIRTY_POLYGONS)
+    {
+        impl->polygons_count = 0;
+        impl->flag &= ~GB_PATH_FLAG_DIRTY_POLYGONS;
+    }
+
+    // init the cached polygons
+    if (!impl->polygons) impl->polygons = tb_nalloc0_type(GB_PATH_POLYGONS_MAXN, gb_path_polygon_entry_t);
+    tb_assert_and_check_return_val(impl->polygons, tb_null);
+
+    // find the cached polygon for this level
+    tb_size_t i = 0;
+    tb_size_t n = impl->polygons_count;
+    for (i = 0; i < n && impl->polygons[i].level != level; i++) ;
+
+    // not found?
+    if (i == n)
+    {
+        // reuse the least recently used entry if the cache is full
+        if (n < GB_PATH_POLYGONS_MAXN) impl->polygons_count++;
+        else i = n - 1;
+
+        // make polygon
+        gb_path_polygon_entry_t* entry = &impl->polygons[i];
+        entry->level = level;
+        if (!gb_path_make_python(impl, level, &entry->polygon, &entry->points, &entry->counts))
+        {
+            // failed? drop this entry 
+            impl->polygons_count = i;
+            return tb_null;
+        }
+    }
+
+    // move it to the head
+    if (i)
+    {
+        gb_path_polygon_entry_t entry = impl->polygons[i];
+        tb_memmov(impl->polygons + 1, impl->polygons, i * sizeof(gb_path_polygon_entry_t));
+        impl->polygons[0] = entry;
+    }
+
+    // ok?
+    return &impl->polygons[0].polygon;
+}
+tb_long_t gb_path_polygon_level(gb_matrix_ref_t matrix)
+{
+    // check
+    tb_assert_and_check_return_val(matrix, 0);
+
+    // compute the approximate maximum scale of the matrix
+    gb_float_t sx = gb_abs(matrix->sx) + gb_half(gb_abs(matrix->ky));
+    gb_float_t sy = gb_abs(matrix->sy) + gb_half(gb_abs(matrix->kx));
+    gb_float_t scale = tb_max(sx, sy);
+
+    /* compute the flattening level
+     *
+     * the flattening error of the curve will be reduced to 1/4 if it is divided once more,
+     * so we need divide it once more (or less) for each 4x scale:
+     *
+     * level: ... |  -1  |   0   |  1  |  2  | ...
+     * scale: ... | 1/8  |  1/2  |  2  |  8  | ...
+     */
+    tb_long_t level = 0;
+    while (scale >= gb_long_to_float(2) && level < GB_PATH_POLYGON_LEVEL_MAXN)
+    {
+        scale = gb_rsh(scale, 2);
+        level++;
+    }
+    while (scale < gb_half(GB_ONE) && level > -GB_PATH_POLYGON_LEVEL_MAXN)
+    {
+        scale = gb_lsh(scale, 2);
+        level--;
+    }
+
+    // divide it once less for the low quality
+    if (gb_quality() == GB_QUALITY_LOW && level > -GB_PATH_POLYGON_LEVEL_MAXN) level--;
+
+    // ok
+    return level;
+}
+tb_long_t gb_path_polygon2_level(gb_path_ref_t path, gb_matrix_ref_t matrix)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // no matrix or no curve? the polygon is same for all levels
+    if (!matrix || !(impl->flag & GB_PATH_FLAG_CURVE)) return 0;
+
+    // the flattening level
+    return gb_path_polygon_level(matrix);
+}
+tb_size_t gb_path_generation(gb_path_ref_t path)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // modified? make a new generation
+    if (impl->flag & GB_PATH_FLAG_DIRTY_GENERATION)
+    {
+        // the generation is unique for all paths
+        impl->generation = (tb_size_t)tb_atomic_fetch_and_inc(&g_generation) + 1;
+
+        // remove dirty
+        impl->flag &= ~GB_PATH_FLAG_DIRTY_GENERATION;
+    }
+
+    // ok?
+    return impl->generation;
+}
+tb_size_t gb_path_polygon_cache_size(gb_path_ref_t path)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the polygon size
+    tb_size_t size = 0;
+    if (impl->polygon_points) size += tb_vector_maxn(impl->polygon_points) * sizeof(gb_point_t);
+    if (impl->polygon_counts) size += tb_vector_maxn(impl->polygon_counts) * sizeof(tb_uint32_t);
+
+    // the cached polygons size
+    if (impl->polygons)
+    {
+        tb_size_t i = 0;
+        size += GB_PATH_POLYGONS_MAXN * sizeof(gb_path_polygon_entry_t);
+        for (i = 0; i < GB_PATH_POLYGONS_MAXN; i++)
+        {
+            if (impl->polygons[i].points) size += tb_vector_maxn(impl->polygons[i].points) * sizeof(gb_point_t);
+            if (impl->polygons[i].counts) size += tb_vector_maxn(impl->polygons[i].counts) * sizeof(tb_uint32_t);
+        }
+    }
+
+    // ok
+    return size;
+}
 tb_void_t gb_path_apply(gb_path_ref_t path, gb_matrix_ref_t matrix)
 {
     // check
@@ -1078,12 +1346,11 @@ tb_void_t gb_path_apply(gb_path_ref_t path, gb_matrix_ref_t matrix)
     // empty?
     tb_check_return(!gb_path_null(path));
 
-    // done
-    tb_for_all_if (gb_point_ref_t, point, impl->points, point)
-    {
-        // apply it
-        gb_point_apply(point, matrix);
-    }
+    // apply it
+    gb_matrix_apply_points(matrix, (gb_point_ref_t)tb_vector_data(impl->points), tb_vector_size(impl->points));
+
+    // mark dirty, the hint, bounds and polygons need be remade
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
 }
 tb_void_t gb_path_clos(gb_path_ref_t path)
 {
@@ -166,6 +166,60 @@ gb_shape_ref_t      gb_path_hint(gb_path_ref_t path);
  */
 gb_polygon_ref_t    gb_path_polygon(gb_path_ref_t path);
 
+/*! the path polygon for drawing it with the given matrix
+ *
+ * the curves will be flattened more finely for the larger scale of the matrix and the higher quality,
+ * and the flattened polygons will be cached in the path until it is modified
+ *
+ * @param path      the path
+ * @param matrix    the matrix
+ *
+ * @return          the polygon
+ */
+gb_polygon_ref_t    gb_path_polygon2(gb_path_ref_t path, gb_matrix_ref_t matrix);
+
+/*! the flattening level of the path polygon for drawing it with the given matrix
+ *
+ * the polygons returned by gb_path_polygon2() are same for the matrices with the same level,
+ * so it can be used as the scale key of the data made from these polygons
+ *
+ * @param path      the path
+ * @param matrix    the matrix
+ *
+ * @return          the level, zero if the path has no curve
+ */
+tb_long_t           gb_path_polygon2_level(gb_path_ref_t path, gb_matrix_ref_t matrix);
+
+/*! the flattening level of the curves for drawing them with the given matrix
+ *
+ * it is same as gb_path_polygon2_level() for the path with curves,
+ * so it can be used as the scale key of the paths made later, e.g. the stroked outline with the round joins
+ *
+ * @param matrix    the matrix
+ *
+ * @return          the level
+ */
+tb_long_t           gb_path_polygon_level(gb_matrix_ref_t matrix);
+
+/*! the path generation
+ *
+ * the generation will be changed after the path is modified 
+ * and it is unique for all paths, so it can be used as the cache key of the path contours
+ *
+ * @param path      the path
+ *
+ * @return          the generation
+ */
+tb_size_t           gb_path_generation(gb_path_ref_t path);
+
+/*! the memory size of the flattened polygons cached in the path
+ *
+ * @param path      the path
+ *
+ * @return          the size
+ */
+tb_size_t           gb_path_polygon_cache_size(gb_path_ref_t path);
+
 /*! apply the matrix to the path 
  *
  * @param path      the path
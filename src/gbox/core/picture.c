@@ -0,0 +1,705 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        picture.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "picture"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "picture.h"
+#include "path.h"
+#include "paint.h"
+#include "device.h"
+#include "clipper.h"
+#include "impl/bounds.h"
+#include "impl/picture.h"
+#include "impl/clipper.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the commands data grow size
+#ifdef __gb_small__
+#   define GB_PICTURE_DATA_GROW             (4096)
+#else
+#   define GB_PICTURE_DATA_GROW             (16384)
+#endif
+
+// the paints, paths and clippers grow count
+#define GB_PICTURE_OBJECTS_GROW             (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the picture command type enum
+typedef enum __gb_picture_command_type_e
+{
+    GB_PICTURE_COMMAND_TYPE_NONE        = 0
+,   GB_PICTURE_COMMAND_TYPE_CLEAR       = 1
+,   GB_PICTURE_COMMAND_TYPE_MATRIX      = 2
+,   GB_PICTURE_COMMAND_TYPE_PAINT       = 3
+,   GB_PICTURE_COMMAND_TYPE_PATH        = 4
+,   GB_PICTURE_COMMAND_TYPE_LINES       = 5
+,   GB_PICTURE_COMMAND_TYPE_POINTS      = 6
+,   GB_PICTURE_COMMAND_TYPE_POLYGON     = 7
+,   GB_PICTURE_COMMAND_TYPE_CLIPPER     = 8
+
+}gb_picture_command_type_e;
+
+// the picture command flag enum
+typedef enum __gb_picture_command_flag_e
+{
+    GB_PICTURE_COMMAND_FLAG_NONE        = 0
+,   GB_PICTURE_COMMAND_FLAG_HINT        = 1
+,   GB_PICTURE_COMMAND_FLAG_BOUNDS      = 2
+,   GB_PICTURE_COMMAND_FLAG_CONVEX      = 4
+
+}gb_picture_command_flag_e;
+
+/* the picture command type
+ *
+ * the commands are stored in a contiguous buffer, 
+ * and the data of the command follows it, each part of the data is aligned by 8 bytes
+ *
+ * clear:   color
+ * matrix:  matrix
+ * paint:   no data, the paint index is the count
+ * path:    no data, the path index is the count
+ * clipper: no data, the clipper index is the count, nothing is clipped if the count is TB_MAXU32
+ * lines:   points, [bounds]
+ * points:  points, [bounds]
+ * polygon: points, counts, [hint], [bounds]
+ */
+typedef struct __gb_picture_command_t
+{
+    // the type
+    tb_uint16_t                 type;
+
+    // the flag
+    tb_uint16_t                 flag;
+
+    // the command size, including the data
+    tb_uint32_t                 size;
+
+    // the points count or the index of the paint and path
+    tb_uint32_t                 count;
+
+    // the contours count of the polygon
+    tb_uint32_t                 contours;
+
+}gb_picture_command_t, *gb_picture_command_ref_t;
+
+// the picture impl type
+typedef struct __gb_picture_impl_t
+{
+    // the width of the recorder device
+    tb_size_t                   width;
+
+    // the height of the recorder device
+    tb_size_t                   height;
+
+    // the commands data
+    tb_byte_t*                  data;
+
+    // the commands data size
+    tb_size_t                   data_size;
+
+    // the commands data maxn
+    tb_size_t                   data_maxn;
+
+    // the commands count
+    tb_size_t                   count;
+
+    // the paints
+    gb_paint_ref_t*             paints;
+
+    // the paints count
+    tb_size_t                   paints_count;
+
+    // the paints maxn
+    tb_size_t                   paints_maxn;
+
+    // the paths
+    gb_path_ref_t*              paths;
+
+    // the paths count
+    tb_size_t                   paths_count;
+
+    // the paths maxn
+    tb_size_t                   paths_maxn;
+
+    // the clippers
+    gb_clipper_ref_t*           clippers;
+
+    // the clippers count
+    tb_size_t                   clippers_count;
+
+    // the clippers maxn
+    tb_size_t                   clippers_maxn;
+
+    // the generation of the last recorded clipper, zero if nothing is clipped
+    tb_size_t                   clipper_generation;
+
+    // the bounds of all draws
+    gb_rect_t                   bounds;
+
+    // have bounds?
+    tb_bool_t                   has_bounds;
+
+    // have the recorded matrix?
+    tb_bool_t                   has_matrix;
+
+    // the last recorded matrix
+    gb_matrix_t                 matrix;
+
+}gb_picture_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_pointer_t gb_picture_objects_grow(tb_pointer_t objects, tb_size_t count, tb_size_t* maxn)
+{
+    // check
+    tb_assert(maxn);
+
+    // no full? 
+    tb_check_return_val(count == *maxn, objects);
+
+    // grow it
+    *maxn += GB_PICTURE_OBJECTS_GROW + (*maxn >> 1);
+    return tb_ralloc(objects, *maxn * sizeof(tb_pointer_t));
+}
+static gb_picture_command_ref_t gb_picture_command_make(gb_picture_impl_t* impl, tb_size_t type, tb_size_t size)
+{
+    // check
+    tb_assert(impl);
+
+    // the command size
+    size = sizeof(gb_picture_command_t) + tb_align8(size);
+    tb_assert_and_check_return_val(size <= TB_MAXU32, tb_null);
+
+    // grow data
+    if (impl->data_size + size > impl->data_maxn)
+    {
+        // the new maxn
+        tb_size_t maxn = impl->data_size + size + GB_PICTURE_DATA_GROW + (impl->data_maxn >> 1);
+
+        // grow it
+        impl->data = (tb_byte_t*)tb_ralloc(impl->data, maxn);
+        tb_assert_and_check_return_val(impl->data, tb_null);
+        impl->data_maxn = maxn;
+    }
+
+    // make command
+    gb_picture_command_ref_t command = (gb_picture_command_ref_t)(impl->data + impl->data_size);
+    command->type       = (tb_uint16_t)type;
+    command->flag       = GB_PICTURE_COMMAND_FLAG_NONE;
+    command->size       = (tb_uint32_t)size;
+    command->count      = 0;
+    command->contours   = 0;
+
+    // save it
+    impl->data_size += size;
+    impl->count++;
+
+    // ok
+    return command;
+}
+static tb_bool_t gb_picture_paint_equal(gb_paint_ref_t paint, gb_paint_ref_t other)
+{
+    return  gb_paint_mode(paint) == gb_paint_mode(other)
+        &&  gb_paint_flag(paint) == gb_paint_flag(other)
+        &&  gb_color_pixel(gb_paint_color(paint)) == gb_color_pixel(gb_paint_color(other))
+        &&  gb_paint_alpha(paint) == gb_paint_alpha(other)
+        &&  gb_paint_stroke_width(paint) == gb_paint_stroke_width(other)
+        &&  gb_paint_stroke_cap(paint) == gb_paint_stroke_cap(other)
+        &&  gb_paint_stroke_join(paint) == gb_paint_stroke_join(other)
+        &&  gb_paint_stroke_miter(paint) == gb_paint_stroke_miter(other)
+        &&  gb_paint_fill_rule(paint) == gb_paint_fill_rule(other)
+        &&  gb_paint_shader(paint) == gb_paint_shader(other);
+}
+static tb_bool_t gb_picture_record_state(gb_picture_impl_t* impl, gb_paint_ref_t paint, gb_matrix_ref_t matrix)
+{
+    // check
+    tb_assert(impl && paint && matrix);
+
+    // record matrix if be changed
+    if (!impl->has_matrix || tb_memcmp(&impl->matrix, matrix, sizeof(gb_matrix_t)))
+    {
+        // make command
+        gb_picture_command_ref_t command = gb_picture_command_make(impl, GB_PICTURE_COMMAND_TYPE_MATRIX, sizeof(gb_matrix_t));
+        tb_assert_and_check_return_val(command, tb_false);
+
+        // save matrix
+        tb_memcpy(command + 1, matrix, sizeof(gb_matrix_t));
+        impl->matrix        = *matrix;
+        impl->has_matrix    = tb_true;
+    }
+
+    // record paint if be changed
+    if (!impl->paints_count || !gb_picture_paint_equal(impl->paints[impl->paints_count - 1], paint))
+    {
+        // grow paints
+        impl->paints = (gb_paint_ref_t*)gb_picture_objects_grow(impl->paints, impl->paints_count, &impl->paints_maxn);
+        tb_assert_and_check_return_val(impl->paints, tb_false);
+
+        // save paint, the shader will be referenced by it
+        gb_paint_ref_t saved = gb_paint_init();
+        tb_assert_and_check_return_val(saved, tb_false);
+        gb_paint_copy(saved, paint);
+        impl->paints[impl->paints_count] = saved;
+
+        // make command
+        gb_picture_command_ref_t command = gb_picture_command_make(impl, GB_PICTURE_COMMAND_TYPE_PAINT, 0);
+        tb_assert_and_check_return_val(command, tb_false);
+        command->count = (tb_uint32_t)impl->paints_count++;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_picture_bounds_add(gb_picture_impl_t* impl, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert(impl && paint && matrix && bounds);
+
+    // apply matrix to bounds
+    gb_rect_t  device_bounds;
+    gb_point_t pt[4];
+    gb_point_make(&pt[0], bounds->x, bounds->y);
+    gb_point_make(&pt[1], bounds->x, bounds->y + bounds->h);
+    gb_point_make(&pt[2], bounds->x + bounds->w, bounds->y + bounds->h);
+    gb_point_make(&pt[3], bounds->x + bounds->w, bounds->y);
+    gb_matrix_apply_points(matrix, pt, tb_arrayn(pt));
+    gb_bounds_make(&device_bounds, pt, tb_arrayn(pt));
+
+    // the margin for the antialiasing and stroking
+    gb_float_t margin = GB_ONE;
+    if (gb_paint_mode(paint) & GB_PAINT_MODE_STROKE)
+    {
+        // the max scale of the matrix 
+        gb_float_t scale = gb_abs(matrix->sx) + gb_abs(matrix->kx) + gb_abs(matrix->ky) + gb_abs(matrix->sy);
+
+        // the max extension of the join and cap
+        gb_float_t miter = gb_paint_stroke_miter(paint);
+        if (gb_paint_stroke_join(paint) != GB_PAINT_STROKE_JOIN_MITER || miter < GB_TWO) miter = GB_TWO;
+
+        // the stroke margin
+        margin += gb_mul(gb_mul(gb_paint_stroke_width(paint), scale), miter);
+    }
+    gb_rect_inflate(&device_bounds, margin, margin);
+
+    // merge bounds
+    if (impl->has_bounds)
+    {
+        gb_float_t x0 = tb_min(impl->bounds.x, device_bounds.x);
+        gb_float_t y0 = tb_min(impl->bounds.y, device_bounds.y);
+        gb_float_t x1 = tb_max(impl->bounds.x + impl->bounds.w, device_bounds.x + device_bounds.w);
+        gb_float_t y1 = tb_max(impl->bounds.y + impl->bounds.h, device_bounds.y + device_bounds.h);
+        gb_rect_make(&impl->bounds, x0, y0, x1 - x0, y1 - y0);
+    }
+    else 
+    {
+        impl->bounds        = device_bounds;
+        impl->has_bounds    = tb_true;
+    }
+}
+static tb_void_t gb_picture_record_points_impl(gb_picture_impl_t* impl, tb_size_t type, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_and_check_return(impl && points && count);
+
+    // record paint and matrix
+    if (!gb_picture_record_state(impl, paint, matrix)) return ;
+
+    // make command
+    tb_size_t                   points_size = tb_align8(count * sizeof(gb_point_t));
+    gb_picture_command_ref_t    command = gb_picture_command_make(impl, type, points_size + (bounds? sizeof(gb_rect_t) : 0));
+    tb_assert_and_check_return(command);
+
+    // save points
+    tb_byte_t* data = (tb_byte_t*)(command + 1);
+    tb_memcpy(data, points, count * sizeof(gb_point_t));
+    command->count = (tb_uint32_t)count;
+
+    // save bounds
+    if (bounds)
+    {
+        tb_memcpy(data + points_size, bounds, sizeof(gb_rect_t));
+        command->flag |= GB_PICTURE_COMMAND_FLAG_BOUNDS;
+    }
+
+    // update the picture bounds
+    gb_rect_t points_bounds;
+    if (!bounds) gb_bounds_make(&points_bounds, points, count);
+    gb_picture_bounds_add(impl, paint, matrix, bounds? bounds : &points_bounds);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_picture_ref_t gb_picture_init(tb_size_t width, tb_size_t height)
+{
+    // make picture
+    gb_picture_impl_t* impl = tb_malloc0_type(gb_picture_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init picture
+    impl->width     = width;
+    impl->height    = height;
+
+    // ok
+    return (gb_picture_ref_t)impl;
+}
+tb_void_t gb_picture_exit(gb_picture_ref_t picture)
+{
+    // check
+    gb_picture_impl_t* impl = (gb_picture_impl_t*)picture;
+    tb_assert_and_check_return(impl);
+
+    // exit paints
+    if (impl->paints)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < impl->paints_count; i++) gb_paint_exit(impl->paints[i]);
+        tb_free(impl->paints);
+    }
+    impl->paints = tb_null;
+
+    // exit paths
+    if (impl->paths)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < impl->paths_count; i++) gb_path_exit(impl->paths[i]);
+        tb_free(impl->paths);
+    }
+    impl->paths = tb_null;
+
+    // exit clippers
+    if (impl->clippers)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < impl->clippers_count; i++) gb_clipper_exit(impl->clippers[i]);
+        tb_free(impl->clippers);
+    }
+    impl->clippers = tb_null;
+
+    // exit data
+    if (impl->data) tb_free(impl->data);
+    impl->data = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_size_t gb_picture_size(gb_picture_ref_t picture)
+{
+    // check
+    gb_picture_impl_t* impl = (gb_picture_impl_t*)picture;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the commands count
+    return impl->count;
+}
+gb_rect_ref_t gb_picture_bounds(gb_picture_ref_t picture)
+{
+    // check
+    gb_picture_impl_t* impl = (gb_picture_impl_t*)picture;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the bounds
+    return impl->has_bounds? &impl->bounds : tb_null;
+}
+tb_void_t gb_picture_record_clear(gb_picture_ref_t picture, gb_color_t color)
+{
+    // check
+    gb_picture_impl_t* impl = (gb_picture_impl_t*)picture;
+    tb_assert_and_check_return(impl);
+
+    // make command
+    gb_picture_command_ref_t command = gb_picture_command_make(impl, GB_PICTURE_COMMAND_TYPE_CLEAR, sizeof(gb_color_t));
+    tb_assert_and_check_return(command);
+
+    // save color
+    tb_memcpy(command + 1, &color, sizeof(gb_color_t));
+
+    // the whole device will be covered
+    gb_rect_imake(&impl->bounds, 0, 0, impl->width, impl->height);
+    impl->has_bounds = tb_true;
+}
+tb_void_t gb_picture_record_clipper(gb_picture_ref_t picture, gb_clipper_ref_t clipper)
+{
+    // check
+    gb_picture_impl_t* impl = (gb_picture_impl_t*)picture;
+    tb_assert_and_check_return(impl);
+
+    // not changed?
+    tb_size_t generation = clipper? gb_clipper_generation(clipper) : 0;
+    tb_check_return(generation != impl->clipper_generation);
+
+    // make command
+    gb_picture_command_ref_t command = gb_picture_command_make(impl, GB_PICTURE_COMMAND_TYPE_CLIPPER, 0);
+    tb_assert_and_check_return(command);
+    command->count = TB_MAXU32;
+
+    // save clipper if something is clipped, the clip mask will be shared with it
+    if (generation)
+    {
+        // grow clippers
+        impl->clippers = (gb_clipper_ref_t*)gb_picture_objects_grow(impl->clippers, impl->clippers_count, &impl->clippers_maxn);
+        tb_assert_and_check_return(impl->clippers);
+
+        // save it
+        gb_clipper_ref_t saved = gb_clipper_init();
+        tb_assert_and_check_return(saved);
+        gb_clipper_copy(saved, clipper);
+        impl->clippers[impl->clippers_count] = saved;
+        command->count = (tb_uint32_t)impl->clippers_count++;
+    }
+
+    // update the recorded generation
+    impl->clipper_generation = generation;
+}
+tb_void_t gb_picture_record_path(gb_picture_ref_t picture, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path)
+{
+    // check
+    gb_picture_impl_t* impl = (gb_picture_impl_t*)picture;
+    tb_assert_and_check_return(impl && path);
+
+    // nothing to draw?
+    gb_rect_ref_t bounds = gb_path_bounds(path);
+    tb_check_return(bounds);
+
+    // record paint and matrix
+    if (!gb_picture_record_state(impl, paint, matrix)) return ;
+
+    // grow paths
+    impl->paths = (gb_path_ref_t*)gb_picture_objects_grow(impl->paths, impl->paths_count, &impl->paths_maxn);
+    tb_assert_and_check_return(impl->paths);
+
+    // save path
+    gb_path_ref_t saved = gb_path_init();
+    tb_assert_and_check_return(saved);
+    gb_path_copy(saved, path);
+    impl->paths[impl->paths_count] = saved;
+
+    // make the cached hint and polygon of the path now, the replaying need not flatten it again
+    gb_path_hint(saved);
+    gb_path_polygon(saved);
+
+    // make command
+    gb_picture_command_ref_t command = gb_picture_command_make(impl, GB_PICTURE_COMMAND_TYPE_PATH, 0);
+    tb_assert_and_check_return(command);
+    command->count = (tb_uint32_t)impl->paths_count++;
+
+    // update the picture bounds
+    gb_picture_bounds_add(impl, paint, matrix, bounds);
+}
+tb_void_t gb_picture_record_lines(gb_picture_ref_t picture, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    gb_picture_record_points_impl((gb_picture_impl_t*)picture, GB_PICTURE_COMMAND_TYPE_LINES, paint, matrix, points, count, bounds);
+}
+tb_void_t gb_picture_record_points(gb_picture_ref_t picture, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    gb_picture_record_points_impl((gb_picture_impl_t*)picture, GB_PICTURE_COMMAND_TYPE_POINTS, paint, matrix, points, count, bounds);
+}
+tb_void_t gb_picture_record_polygon(gb_picture_ref_t picture, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
+{
+    // check
+    gb_picture_impl_t* impl = (gb_picture_impl_t*)picture;
+    tb_assert_and_check_return(impl && polygon && polygon->points && polygon->counts);
+
+    // the points and contours count
+    tb_size_t       count = 0;
+    tb_size_t       contours = 0;
+    tb_uint32_t*    counts = polygon->counts;
+    while (*counts) 
+    {
+        count += *counts++;
+        contours++;
+    }
+    tb_check_return(count);
+
+    // record paint and matrix
+    if (!gb_picture_record_state(impl, paint, matrix)) return ;
+
+    // the polygon hint refers to the outside points, ignore it
+    if (hint && hint->type == GB_SHAPE_TYPE_POLYGON) hint = tb_null;
+
+    // make command
+    tb_size_t                   points_size = tb_align8(count * sizeof(gb_point_t));
+    tb_size_t                   counts_size = tb_align8((contours + 1) * sizeof(tb_uint32_t));
+    tb_size_t                   hint_size   = hint? tb_align8(sizeof(gb_shape_t)) : 0;
+    gb_picture_command_ref_t    command     = gb_picture_command_make(impl, GB_PICTURE_COMMAND_TYPE_POLYGON, points_size + counts_size + hint_size + (bounds? sizeof(gb_rect_t) : 0));
+    tb_assert_and_check_return(command);
+
+    // save points and counts
+    tb_byte_t* data = (tb_byte_t*)(command + 1);
+    tb_memcpy(data, polygon->points, count * sizeof(gb_point_t));
+    tb_memcpy(data + points_size, polygon->counts, (contours + 1) * sizeof(tb_uint32_t));
+    command->count      = (tb_uint32_t)count;
+    command->contours   = (tb_uint32_t)contours;
+    if (polygon->convex) command->flag |= GB_PICTURE_COMMAND_FLAG_CONVEX;
+    data += points_size + counts_size;
+
+    // save hint
+    if (hint)
+    {
+        tb_memcpy(data, hint, sizeof(gb_shape_t));
+        command->flag |= GB_PICTURE_COMMAND_FLAG_HINT;
+        data += hint_size;
+    }
+
+    // save bounds
+    if (bounds)
+    {
+        tb_memcpy(data, bounds, sizeof(gb_rect_t));
+        command->flag |= GB_PICTURE_COMMAND_FLAG_BOUNDS;
+    }
+
+    // update the picture bounds
+    gb_rect_t points_bounds;
+    if (!bounds) gb_bounds_make(&points_bounds, polygon->points, count);
+    gb_picture_bounds_add(impl, paint, matrix, bounds? bounds : &points_bounds);
+}
+tb_void_t gb_picture_replay(gb_picture_ref_t picture, gb_device_ref_t device, gb_matrix_ref_t matrix, gb_clipper_ref_t clipper)
+{
+    // check
+    gb_picture_impl_t* impl = (gb_picture_impl_t*)picture;
+    tb_assert_and_check_return(impl && device);
+
+    // the recorded matrix need not be applied if the given matrix is identity
+    tb_bool_t identity = !matrix || gb_matrix_identity(matrix);
+
+    // done
+    gb_matrix_t                 applied;
+    gb_clipper_ref_t            clipped = tb_null;
+    tb_byte_t*                  data = tb_null;
+    tb_byte_t*                  p = impl->data;
+    tb_byte_t*                  e = impl->data + impl->data_size;
+    gb_picture_command_ref_t    command = tb_null;
+    while (p < e)
+    {
+        // the command and data
+        command = (gb_picture_command_ref_t)p;
+        data    = p + sizeof(gb_picture_command_t);
+        tb_assert(command->size >= sizeof(gb_picture_command_t) && p + command->size <= e);
+
+        // done it
+        switch (command->type)
+        {
+        case GB_PICTURE_COMMAND_TYPE_CLEAR:
+            gb_device_draw_clear(device, *((gb_color_ref_t)data));
+            break;
+        case GB_PICTURE_COMMAND_TYPE_MATRIX:
+            if (identity) gb_device_bind_matrix(device, (gb_matrix_ref_t)data);
+            else
+            {
+                applied = *matrix;
+                gb_matrix_multiply(&applied, (gb_matrix_ref_t)data);
+                gb_device_bind_matrix(device, &applied);
+            }
+            break;
+        case GB_PICTURE_COMMAND_TYPE_PAINT:
+            tb_assert(command->count < impl->paints_count);
+            gb_device_bind_paint(device, impl->paints[command->count]);
+            break;
+        case GB_PICTURE_COMMAND_TYPE_CLIPPER:
+            {
+                // nothing is clipped by the recorder? only clip it by the given clipper
+                if (command->count == TB_MAXU32)
+                {
+                    gb_device_bind_clipper(device, clipper);
+                    break;
+                }
+                tb_assert(command->count < impl->clippers_count);
+
+                // init the clipped clipper
+                if (!clipped) clipped = gb_clipper_init();
+                tb_assert_and_check_break(clipped);
+
+                // intersect the recorded clipper with the given clipper
+                if (clipper) gb_clipper_copy(clipped, clipper);
+                else gb_clipper_clear(clipped);
+                gb_clipper_matrix_set(clipped, identity? tb_null : matrix);
+                gb_clipper_intersect(clipped, impl->clippers[command->count]);
+
+                // bind it
+                gb_device_bind_clipper(device, clipped);
+            }
+            break;
+        case GB_PICTURE_COMMAND_TYPE_PATH:
+            tb_assert(command->count < impl->paths_count);
+            gb_device_draw_path(device, impl->paths[command->count]);
+            break;
+        case GB_PICTURE_COMMAND_TYPE_LINES:
+            gb_device_draw_lines(device, (gb_point_ref_t)data, command->count, (command->flag & GB_PICTURE_COMMAND_FLAG_BOUNDS)? (gb_rect_ref_t)(data + tb_align8(command->count * sizeof(gb_point_t))) : tb_null);
+            break;
+        case GB_PICTURE_COMMAND_TYPE_POINTS:
+            gb_device_draw_points(device, (gb_point_ref_t)data, command->count, (command->flag & GB_PICTURE_COMMAND_FLAG_BOUNDS)? (gb_rect_ref_t)(data + tb_align8(command->count * sizeof(gb_point_t))) : tb_null);
+            break;
+        case GB_PICTURE_COMMAND_TYPE_POLYGON:
+            {
+                // the polygon
+                gb_polygon_t polygon;
+                polygon.points  = (gb_point_ref_t)data;
+                polygon.counts  = (tb_uint32_t*)(data + tb_align8(command->count * sizeof(gb_point_t)));
+                polygon.convex  = (command->flag & GB_PICTURE_COMMAND_FLAG_CONVEX)? tb_true : tb_false;
+                data = (tb_byte_t*)polygon.counts + tb_align8((command->contours + 1) * sizeof(tb_uint32_t));
+
+                // the hint
+                gb_shape_ref_t hint = tb_null;
+                if (command->flag & GB_PICTURE_COMMAND_FLAG_HINT)
+                {
+                    hint = (gb_shape_ref_t)data;
+                    data += tb_align8(sizeof(gb_shape_t));
+                }
+
+                // draw it
+                gb_device_draw_polygon(device, &polygon, hint, (command->flag & GB_PICTURE_COMMAND_FLAG_BOUNDS)? (gb_rect_ref_t)data : tb_null);
+            }
+            break;
+        default:
+            tb_assert(0);
+            break;
+        }
+
+        // next command
+        p += command->size;
+    }
+
+    // restore the given clipper
+    if (clipped)
+    {
+        gb_device_bind_clipper(device, clipper);
+        gb_clipper_exit(clipped);
+    }
+}
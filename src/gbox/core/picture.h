@@ -0,0 +1,70 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        picture.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_PICTURE_H
+#define GB_CORE_PICTURE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! exit picture
+ *
+ * @note the picture is made by gb_device_recorder_done()
+ *
+ * @param picture           the picture
+ */
+tb_void_t                   gb_picture_exit(gb_picture_ref_t picture);
+
+/*! the recorded commands count of the picture
+ *
+ * @param picture           the picture
+ *
+ * @return                  the commands count
+ */
+tb_size_t                   gb_picture_size(gb_picture_ref_t picture);
+
+/*! the bounds of all recorded draws, using the coordinates of the recorder device
+ *
+ * @param picture           the picture
+ *
+ * @return                  the bounds, tb_null if nothing will be drawn
+ */
+gb_rect_ref_t               gb_picture_bounds(gb_picture_ref_t picture);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -23,6 +23,12 @@
  * @ingroup     core
  *
  */
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "pixmap"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
@@ -42,6 +48,7 @@
 #include "pixmap/rgbx4444.h"
 #include "pixmap/rgba8888.h"
 #include "pixmap/rgbx8888.h"
+#include "impl/pixmap_simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals 
@@ -191,9 +198,98 @@ static gb_pixmap_ref_t g_pixmaps_ba[] =
 
 };
 
+// the pixmaps with the simd kernels for alpha and little endian
+static gb_pixmap_t      g_pixmaps_simd_la[GB_PIXMAP_SIMD_MAXN][tb_arrayn(g_pixmaps_la)];
+
+// the pixmaps with the simd kernels for alpha and big endian
+static gb_pixmap_t      g_pixmaps_simd_ba[GB_PIXMAP_SIMD_MAXN][tb_arrayn(g_pixmaps_ba)];
+
+// the supported simd mask
+static tb_size_t        g_pixmaps_simd_mask = 1 << GB_PIXMAP_SIMD_NONE;
+
+// the current simd
+static tb_atomic_t      g_pixmaps_simd = GB_PIXMAP_SIMD_NONE;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_pixmap_simd_make(gb_pixmap_t* pixmaps_simd, gb_pixmap_ref_t* pixmaps, tb_size_t count, tb_size_t simd)
+{
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // no pixmap?
+        gb_pixmap_ref_t pixmap = pixmaps[i];
+        tb_check_continue(pixmap);
+
+        // the simd kernel for this pixfmt
+        gb_pixmap_func_pixels_fill_t pixels_fill = gb_pixmap_simd_pixels_fill(pixmap->pixfmt, simd);
+        tb_check_continue(pixels_fill);
+
+        // make the pixmap with the simd kernel, the other operations are same as the scalar pixmap
+        pixmaps_simd[i]             = *pixmap;
+        pixmaps_simd[i].pixels_fill = pixels_fill;
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementions
  */
+tb_bool_t gb_pixmap_init()
+{
+    // inited?
+    tb_check_return_val(g_pixmaps_simd_mask == (1 << GB_PIXMAP_SIMD_NONE), tb_true);
+
+    // probe the supported simd extensions
+    tb_size_t mask = gb_pixmap_simd_probe();
+
+    // make the pixmaps for all supported simd extensions
+    tb_size_t simd = 0;
+    tb_size_t best = GB_PIXMAP_SIMD_NONE;
+    for (simd = GB_PIXMAP_SIMD_NONE + 1; simd < GB_PIXMAP_SIMD_MAXN; simd++)
+    {
+        // not supported?
+        tb_check_continue(mask & (1 << simd));
+
+        // make pixmaps
+        gb_pixmap_simd_make(g_pixmaps_simd_la[simd], g_pixmaps_la, tb_arrayn(g_pixmaps_la), simd);
+        gb_pixmap_simd_make(g_pixmaps_simd_ba[simd], g_pixmaps_ba, tb_arrayn(g_pixmaps_ba), simd);
+
+        // the better simd extension has the larger value
+        best = simd;
+    }
+
+    // save the simd mask
+    g_pixmaps_simd_mask = mask;
+
+    // use the best simd kernels
+    tb_atomic_set(&g_pixmaps_simd, best);
+
+    // trace
+    tb_trace_d("simd: %lu, mask: %#lx", best, mask);
+
+    // ok
+    return tb_true;
+}
+tb_size_t gb_pixmap_simd()
+{
+    return (tb_size_t)tb_atomic_get(&g_pixmaps_simd);
+}
+tb_bool_t gb_pixmap_simd_set(tb_size_t simd)
+{
+    // check
+    tb_assert_and_check_return_val(simd < GB_PIXMAP_SIMD_MAXN, tb_false);
+
+    // not supported?
+    tb_check_return_val(g_pixmaps_simd_mask & (1 << simd), tb_false);
+
+    // save simd
+    tb_atomic_set(&g_pixmaps_simd, simd);
+
+    // ok
+    return tb_true;
+}
 gb_pixmap_ref_t gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha)
 {
     // big endian?
@@ -218,6 +314,14 @@ gb_pixmap_ref_t gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha)
         // check
 		tb_assert(pixfmt && (pixfmt - 1) < tb_arrayn(g_pixmaps_la));
 
+        // exists the simd kernels for this pixfmt?
+        tb_size_t simd = (tb_size_t)tb_atomic_get(&g_pixmaps_simd);
+        if (simd)
+        {
+            gb_pixmap_ref_t pixmap = bendian? &g_pixmaps_simd_ba[simd][pixfmt - 1] : &g_pixmaps_simd_la[simd][pixfmt - 1];
+            if (pixmap->pixels_fill) return pixmap;
+        }
+
         // ok
 		return bendian? g_pixmaps_ba[pixfmt - 1] : g_pixmaps_la[pixfmt - 1];
 	}
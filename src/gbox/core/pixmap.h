@@ -146,6 +146,17 @@ typedef struct __gb_pixmap_t
 /// the pixmap ref type
 typedef gb_pixmap_t const*      gb_pixmap_ref_t;
 
+/// the pixmap simd enum
+typedef enum __gb_pixmap_simd_e
+{
+    GB_PIXMAP_SIMD_NONE         = 0 //!< the scalar kernels
+,   GB_PIXMAP_SIMD_SSE2         = 1 //!< the sse2 kernels
+,   GB_PIXMAP_SIMD_AVX2         = 2 //!< the avx2 kernels
+,   GB_PIXMAP_SIMD_NEON         = 3 //!< the neon kernels
+,   GB_PIXMAP_SIMD_MAXN         = 4
+
+}gb_pixmap_simd_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -159,6 +170,28 @@ typedef gb_pixmap_t const*      gb_pixmap_ref_t;
  */
 gb_pixmap_ref_t 		gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha);
 
+/*! init the pixmaps
+ *
+ * probe the cpu features and make the simd kernels for blending
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_pixmap_init(tb_noarg_t);
+
+/*! the simd kernels used by gb_pixmap()
+ *
+ * @return              the simd extension, GB_PIXMAP_SIMD_NONE if only the scalar kernels
+ */
+tb_size_t               gb_pixmap_simd(tb_noarg_t);
+
+/*! set the simd kernels used by gb_pixmap()
+ *
+ * @param simd          the simd extension
+ *
+ * @return              tb_true or tb_false if the cpu does not support it
+ */
+tb_bool_t               gb_pixmap_simd_set(tb_size_t simd);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -54,20 +54,23 @@
  * 0000 0000 0000 0000 aaaa rrrr gggg bbbb
  *
  * (s * a + d * (32 - a)) >> 5 => ((s - d) * a) >> 5 + d
+ *
+ * (s - d) * a needs 9-bits, but the channel has only 8-bits in d,
+ * so blend 0000 gggg 0000 bbbb and 0000 aaaa 0000 rrrr with the 16-bits channels
  */
-static __tb_inline__ tb_uint16_t gb_pixmap_argb4444_blend(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
+static __tb_inline__ tb_uint16_t gb_pixmap_argb4444_blend2(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
 {
-    // FIXME: s - d? overflow?
-    s = (s | (s << 12)) & 0x0f0f0f0f;
     d = (d | (d << 12)) & 0x0f0f0f0f;
-    d = ((((s - d) * a) >> 5) + d) & 0x0f0f0f0f;
+    tb_uint32_t l = d & 0x000f000f;
+    tb_uint32_t h = (d >> 8) & 0x000f000f;
+    l = (((((s & 0x000f000f) - l) * a) >> 5) + l) & 0x000f000f;
+    h = ((((((s >> 8) & 0x000f000f) - h) * a) >> 5) + h) & 0x000f000f;
+    d = l | (h << 8);
     return (tb_uint16_t)((d & 0xffff) | (d >> 12));
 }
-static __tb_inline__ tb_uint16_t gb_pixmap_argb4444_blend2(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
+static __tb_inline__ tb_uint16_t gb_pixmap_argb4444_blend(tb_uint32_t d, tb_uint32_t s, tb_byte_t a)
 {
-    d = (d | (d << 12)) & 0x0f0f0f0f;
-    d = ((((s - d) * a) >> 5) + d) & 0x0f0f0f0f;
-    return (tb_uint16_t)((d & 0xffff) | (d >> 12));
+    return gb_pixmap_argb4444_blend2(d, (s | (s << 12)) & 0x0f0f0f0f, a);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -131,7 +134,7 @@ static __tb_inline__ tb_void_t gb_pixmap_argb4444_pixels_fill_la(tb_pointer_t da
     tb_size_t       l = count & 0x3; count -= l; alpha >>= 3;
     tb_uint16_t*    p = (tb_uint16_t*)data;
     tb_uint16_t*    e = p + count;
-    tb_uint32_t     s = (pixel | (pixel << 16)) & 0x0f0f0f0f;
+    tb_uint32_t     s = (pixel | (pixel << 12)) & 0x0f0f0f0f;
     while (p < e)
     {
         tb_bits_set_u16_le(&p[0], gb_pixmap_argb4444_blend2(tb_bits_get_u16_le(&p[0]), s, alpha));
@@ -151,7 +154,7 @@ static __tb_inline__ tb_void_t gb_pixmap_argb4444_pixels_fill_ba(tb_pointer_t da
     tb_size_t       l = count & 0x3; count -= l; alpha >>= 3;
     tb_uint16_t*    p = (tb_uint16_t*)data;
     tb_uint16_t*    e = p + count;
-    tb_uint32_t     s = (pixel | (pixel << 16)) & 0x0f0f0f0f;
+    tb_uint32_t     s = (pixel | (pixel << 12)) & 0x0f0f0f0f;
     while (p < e)
     {
         tb_bits_set_u16_be(&p[0], gb_pixmap_argb4444_blend2(tb_bits_get_u16_be(&p[0]), s, alpha));
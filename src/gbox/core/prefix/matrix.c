@@ -173,6 +173,8 @@ tb_bool_t gb_matrix_invert(gb_matrix_ref_t matrix)
             mx.sx = gb_invert(matrix->sx);
             mx.tx = gb_div(-matrix->tx, matrix->sx);
         }
+        // only translate it
+        else mx.tx = -matrix->tx;
 
         // invert it if sy != 1.0
         if (GB_ONE != matrix->sy)
@@ -184,6 +186,8 @@ tb_bool_t gb_matrix_invert(gb_matrix_ref_t matrix)
             mx.sy = gb_invert(matrix->sy);
             mx.ty = gb_div(-matrix->ty, matrix->sy);
         }
+        // only translate it
+        else mx.ty = -matrix->ty;
     }
     else
     {
@@ -489,6 +493,51 @@ tb_void_t gb_matrix_apply_points(gb_matrix_ref_t matrix, gb_point_ref_t points,
     tb_assert_and_check_return(matrix && points && count);
 
     // apply it
-    tb_size_t i = 0;
-    for (i = 0; i < count; i++) gb_point_apply(points + i, matrix);
+    gb_matrix_apply_points2(matrix, points, points, count);
+}
+tb_void_t gb_matrix_apply_points2(gb_matrix_ref_t matrix, gb_point_ref_t points, gb_point_ref_t output, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return(matrix && points && output && count);
+
+    // the factors
+    gb_float_t  sx = matrix->sx;
+    gb_float_t  sy = matrix->sy;
+    gb_float_t  kx = matrix->kx;
+    gb_float_t  ky = matrix->ky;
+    gb_float_t  tx = matrix->tx;
+    gb_float_t  ty = matrix->ty;
+    tb_size_t   i = 0;
+
+    // rotated or skewed? 
+    if (kx != 0 || ky != 0)
+    {
+        for (i = 0; i < count; i++)
+        {
+            gb_float_t x = points[i].x;
+            gb_float_t y = points[i].y;
+            output[i].x = gb_mul(x, sx) + gb_mul(y, kx) + tx;
+            output[i].y = gb_mul(x, ky) + gb_mul(y, sy) + ty;
+        }
+    }
+    // scaled?
+    else if (sx != GB_ONE || sy != GB_ONE)
+    {
+        for (i = 0; i < count; i++)
+        {
+            output[i].x = gb_mul(points[i].x, sx) + tx;
+            output[i].y = gb_mul(points[i].y, sy) + ty;
+        }
+    }
+    // translated?
+    else if (tx != 0 || ty != 0)
+    {
+        for (i = 0; i < count; i++)
+        {
+            output[i].x = points[i].x + tx;
+            output[i].y = points[i].y + ty;
+        }
+    }
+    // identity? only copy it
+    else if (output != points) tb_memcpy(output, points, count * sizeof(gb_point_t));
 }
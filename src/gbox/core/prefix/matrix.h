@@ -417,6 +417,17 @@ tb_bool_t 		    gb_matrix_multiply_lhs(gb_matrix_ref_t matrix, gb_matrix_ref_t f
  */
 tb_void_t           gb_matrix_apply_points(gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count);
 
+/*! apply matrix to the points and save them to the output points
+ *
+ * the identity, translate and scale matrices are applied by the specialized loops
+ *
+ * @param matrix    the matrix 
+ * @param points    the points
+ * @param output    the output points, it can be the same as the points
+ * @param count     the count
+ */
+tb_void_t           gb_matrix_apply_points2(gb_matrix_ref_t matrix, gb_point_ref_t points, gb_point_ref_t output, tb_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * inlines
  */
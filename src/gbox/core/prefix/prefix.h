@@ -48,11 +48,25 @@
  * macros
  */
 
-/// the width maxn
-#define GB_WIDTH_MAXN           (8192)
+/*! the width maxn
+ *
+ * the x-coordinate of the raster edges is 16.16 fixed-point
+ */
+#define GB_WIDTH_MAXN           (16384)
 
-/// the height maxn
-#define GB_HEIGHT_MAXN          (8192)
+/*! the height maxn
+ *
+ * the y-coordinates of the raster edges are 48.16 fixed-point, so the height is only limited by gb_float_t.
+ *
+ * gb_float_t is 16.16 fixed-point in [-32768, 32768) if GB_CONFIG_FLOAT_FIXED,
+ * the shapes across the bottom edge, the stroke bounds and the transformed points
+ * need the coordinates beyond the bitmap, so only the half range is used for the height.
+ */
+#ifdef GB_CONFIG_FLOAT_FIXED
+#   define GB_HEIGHT_MAXN       (16384)
+#else
+#   define GB_HEIGHT_MAXN       (65536)
+#endif
 
 /*! the min-alpha
  *
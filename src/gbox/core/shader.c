@@ -153,7 +153,7 @@ tb_size_t gb_shader_ref(gb_shader_ref_t shader)
     tb_assert_and_check_return_val(impl, 0);
 
     // the reference count
-    return impl->refn;
+    return (tb_size_t)tb_atomic_get(&impl->refn);
 }
 tb_void_t gb_shader_inc(gb_shader_ref_t shader)
 {
@@ -162,7 +162,7 @@ tb_void_t gb_shader_inc(gb_shader_ref_t shader)
     tb_assert_and_check_return(impl);
 
     // increase the reference count
-    impl->refn++;
+    tb_atomic_fetch_and_inc(&impl->refn);
 }
 tb_void_t gb_shader_dec(gb_shader_ref_t shader)
 {
@@ -170,12 +170,12 @@ tb_void_t gb_shader_dec(gb_shader_ref_t shader)
     gb_shader_impl_t* impl = (gb_shader_impl_t*)shader;
     tb_assert_and_check_return(impl);
 
-    // check refn
-    tb_assert_and_check_return(impl->refn);
-
     // refn--
-    impl->refn--;
+    tb_long_t refn = tb_atomic_fetch_and_dec(&impl->refn);
+
+    // check refn
+    tb_assert_and_check_return(refn > 0);
 
     // exit it?
-    if (!impl->refn && impl->exit) impl->exit(impl);
+    if (refn == 1 && impl->exit) impl->exit(impl);
 }
@@ -0,0 +1,122 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        stats.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "stats"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "stats.h"
+#include "impl/stats.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+#ifdef GB_CONFIG_CORE_HAVE_STATS
+/* the stats of all stages: count, size, time
+ *
+ * the tiled device will rasterize and blend on the worker threads, so we use the atomic counters
+ */
+static tb_atomic64_t    g_stats[GB_STATS_STAGE_MAXN][3];
+
+// the blended pixels
+static tb_atomic64_t    g_stats_pixels = 0;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef GB_CONFIG_CORE_HAVE_STATS
+tb_void_t gb_stats_done(tb_size_t stage, tb_size_t count, tb_hize_t size, tb_hize_t time)
+{
+    // check
+    tb_assert_and_check_return(stage < GB_STATS_STAGE_MAXN);
+
+    // update the stats
+    if (count) tb_atomic64_fetch_and_add(&g_stats[stage][0], (tb_hong_t)count);
+    if (size) tb_atomic64_fetch_and_add(&g_stats[stage][1], (tb_hong_t)size);
+    if (time) tb_atomic64_fetch_and_add(&g_stats[stage][2], (tb_hong_t)time);
+}
+tb_void_t gb_stats_done_pixels(tb_hize_t pixels)
+{
+    // update the pixels
+    if (pixels) tb_atomic64_fetch_and_add(&g_stats_pixels, (tb_hong_t)pixels);
+}
+#endif
+tb_bool_t gb_stats_get(gb_stats_ref_t stats)
+{
+    // check
+    tb_assert_and_check_return_val(stats, tb_false);
+
+    // clear it first
+    tb_memset(stats, 0, sizeof(gb_stats_t));
+
+#ifdef GB_CONFIG_CORE_HAVE_STATS
+    // get the stats of all stages
+    gb_stats_stage_ref_t        stages[GB_STATS_STAGE_MAXN] = {&stats->flatten, &stats->stroke, &stats->tessellate, &stats->raster, &stats->blend};
+    tb_size_t                   stage = 0;
+    for (stage = 0; stage < GB_STATS_STAGE_MAXN; stage++)
+    {
+        stages[stage]->count    = (tb_hize_t)tb_atomic64_get(&g_stats[stage][0]);
+        stages[stage]->size     = (tb_hize_t)tb_atomic64_get(&g_stats[stage][1]);
+        stages[stage]->time     = (tb_hize_t)tb_atomic64_get(&g_stats[stage][2]);
+    }
+
+    // get the blended pixels
+    stats->pixels = (tb_hize_t)tb_atomic64_get(&g_stats_pixels);
+
+    // the time unit
+#ifdef GB_STATS_HAVE_RDTSC
+    stats->cycles = tb_true;
+#endif
+
+    // ok
+    return tb_true;
+#else
+    // disabled
+    return tb_false;
+#endif
+}
+tb_void_t gb_stats_reset()
+{
+#ifdef GB_CONFIG_CORE_HAVE_STATS
+    // reset the stats of all stages
+    tb_size_t stage = 0;
+    for (stage = 0; stage < GB_STATS_STAGE_MAXN; stage++)
+    {
+        tb_atomic64_set0(&g_stats[stage][0]);
+        tb_atomic64_set0(&g_stats[stage][1]);
+        tb_atomic64_set0(&g_stats[stage][2]);
+    }
+
+    // reset the blended pixels
+    tb_atomic64_set0(&g_stats_pixels);
+#endif
+}
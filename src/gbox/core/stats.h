@@ -0,0 +1,111 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        stats.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_STATS_H
+#define GB_CORE_STATS_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the stats stage type
+typedef struct __gb_stats_stage_t
+{
+    // the call count
+    tb_hize_t                   count;
+
+    // the input size
+    tb_hize_t                   size;
+
+    // the cumulative time, in cpu cycles or nanoseconds
+    tb_hize_t                   time;
+
+}gb_stats_stage_t, *gb_stats_stage_ref_t;
+
+/* the stats type
+ *
+ * the time of the raster stage includes the blending of the spans flushed while scanning
+ */
+typedef struct __gb_stats_t
+{
+    // the flattening of the paths, size: the flattened points
+    gb_stats_stage_t            flatten;
+
+    // the stroking of the outlines, size: the items of the stroked paths
+    gb_stats_stage_t            stroke;
+
+    // the tessellation of the polygons, size: the polygon points
+    gb_stats_stage_t            tessellate;
+
+    // the rasterization of the polygons, size: the edges
+    gb_stats_stage_t            raster;
+
+    // the blending of the biltters, size: the spans
+    gb_stats_stage_t            blend;
+
+    // the blended pixels
+    tb_hize_t                   pixels;
+
+    // the time is in cpu cycles? otherwise in nanoseconds
+    tb_bool_t                   cycles;
+
+}gb_stats_t, *gb_stats_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! get the stats of the pipeline stages
+ *
+ * the stats are collected only if gbox is configured with --stats=y.
+ *
+ * the stats are process-wide: the stages know nothing about the canvas,
+ * so the draws of all canvases and all threads are counted together
+ *
+ * @param stats     the stats
+ *
+ * @return          tb_false if the stats are disabled at compile time
+ */
+tb_bool_t           gb_stats_get(gb_stats_ref_t stats);
+
+/*! reset the process-wide stats of the pipeline stages
+ */
+tb_void_t           gb_stats_reset(tb_noarg_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -66,10 +66,10 @@ typedef struct __gb_window_glut_impl_t
     tb_size_t               button;
 
     // the normal width before fullscreen
-    tb_uint16_t             normal_width;
+    tb_uint32_t             normal_width;
 
     // the normal height before fullscreen
-    tb_uint16_t             normal_height;
+    tb_uint32_t             normal_height;
 
 }gb_window_glut_impl_t;
 
@@ -75,14 +75,47 @@ tb_hong_t gb_window_impl_spak(gb_window_ref_t window)
     // the spak time
     return time;
 }
-tb_void_t gb_window_impl_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
+tb_bool_t gb_window_impl_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
 {
     // check
     gb_window_impl_t* impl = (gb_window_impl_t*)window;
     tb_assert(impl && impl->info.draw && canvas);
 
+    // only redraw the invalidated rects?
+    gb_clipper_ref_t clipper = tb_null;
+    if (impl->mode == GB_WINDOW_MODE_BITMAP && (impl->flag & GB_WINDOW_FLAG_DAMAGE))
+    {
+        // nothing is invalidated?
+        tb_size_t       count = 0;
+        gb_rect_ref_t   rects = gb_damage_rects(&impl->invalid, &count);
+        tb_check_return_val(count, tb_false);
+
+        // clip the canvas to the invalidated rects in the device coordinate
+        clipper = gb_canvas_save_clipper(canvas);
+        if (clipper)
+        {
+            tb_size_t index = 0;
+            gb_clipper_matrix_set(clipper, tb_null);
+            for (index = 0; index < count; index++)
+                gb_clipper_add_rect(clipper, index? GB_CLIPPER_MODE_UNION : GB_CLIPPER_MODE_REPLACE, rects + index);
+        }
+    }
+
+    // clear the damaged rects of the previous frame
+    gb_device_damage_clear(gb_canvas_device(canvas));
+
     // done draw
     impl->info.draw((gb_window_ref_t)impl, canvas, impl->info.priv);
+
+    // flush the recorded draws
+    gb_canvas_flush(canvas);
+
+    // restore the clipper and clear the invalidated rects
+    if (clipper) gb_canvas_load_clipper(canvas);
+    gb_damage_clear(&impl->invalid);
+
+    // ok
+    return tb_true;
 }
 tb_void_t gb_window_impl_event(gb_window_ref_t window, gb_event_ref_t event)
 {
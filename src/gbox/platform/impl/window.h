@@ -34,6 +34,8 @@
 #include "../../core/canvas.h"
 #include "../../core/pixmap.h"
 #include "../../core/bitmap.h"
+#include "../../core/clipper.h"
+#include "../../core/impl/damage.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -67,10 +69,10 @@ typedef struct __gb_window_impl_t
     tb_uint16_t             pixfmt;
 
     // the window width
-    tb_uint16_t             width;
+    tb_uint32_t             width;
 
     // the window height
-    tb_uint16_t             height;
+    tb_uint32_t             height;
 
     // the window info
     gb_window_info_t        info;
@@ -90,6 +92,9 @@ typedef struct __gb_window_impl_t
     // the frame count for fps
     tb_size_t               fps_count;
 
+    // the invalidated rects for GB_WINDOW_FLAG_DAMAGE
+    gb_damage_t             invalid;
+
     /* loop window
      *
      * @param window        the window
@@ -145,11 +150,15 @@ typedef struct __gb_window_impl_t
 tb_hong_t                   gb_window_impl_spak(gb_window_ref_t window);
 
 /* draw window
+ *
+ * the damaged rects of the canvas device will be presented after drawing 
  *
  * @param window            the window
  * @param canvas            the canvas
+ *
+ * @return                  tb_false if nothing need be drawn and presented
  */
-tb_void_t                   gb_window_impl_draw(gb_window_ref_t window, gb_canvas_ref_t canvas);
+tb_bool_t                   gb_window_impl_draw(gb_window_ref_t window, gb_canvas_ref_t canvas);
 
 /* the window event
  *
@@ -0,0 +1,169 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        window.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "window_offscreen"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../impl/window.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the offscreen window impl type
+typedef struct __gb_window_offscreen_impl_t
+{
+    // the base
+    gb_window_impl_t        base;
+
+    // the canvas
+    gb_canvas_ref_t         canvas;
+
+}gb_window_offscreen_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_window_offscreen_exit(gb_window_ref_t window)
+{
+    // check
+    gb_window_offscreen_impl_t* impl = (gb_window_offscreen_impl_t*)window;
+    tb_assert_and_check_return(impl);
+
+    // exit canvas
+    if (impl->canvas) gb_canvas_exit(impl->canvas);
+    impl->canvas = tb_null;
+
+    // exit bitmap
+    if (impl->base.bitmap) gb_bitmap_exit(impl->base.bitmap);
+    impl->base.bitmap = tb_null;
+
+    // exit it
+    tb_free(window);
+}
+static tb_void_t gb_window_offscreen_loop(gb_window_ref_t window)
+{
+    // check
+    gb_window_offscreen_impl_t* impl = (gb_window_offscreen_impl_t*)window;
+    tb_assert_and_check_return(impl);
+
+    // init canvas
+    if (!impl->canvas) impl->canvas = gb_canvas_init_from_window(window);
+    tb_assert_and_check_return(impl->canvas);
+
+    // done init
+    if (impl->base.info.init && !impl->base.info.init((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv)) return ;
+
+    // loop, draw the frames as fast as possible if the framerate is zero
+    tb_hong_t time;
+    tb_size_t wait;
+    tb_bool_t stop = tb_false;
+    tb_size_t delay = impl->base.info.framerate? 1000 / impl->base.info.framerate : 0;
+    while (!stop)
+    {
+        // spak
+        time = gb_window_impl_spak((gb_window_ref_t)impl);
+
+        // draw and pass the frame to the sink, the frame will be dropped if there is no sink
+        wait = delay;
+        if (gb_window_impl_draw((gb_window_ref_t)impl, impl->canvas))
+        {
+            if (impl->base.info.frame) stop = !impl->base.info.frame((gb_window_ref_t)impl, impl->base.bitmap, impl->base.info.priv);
+        }
+        // nothing is invalidated for the damage flag? wait the next invalidated rects without spinning
+        else if (!wait) wait = 1000 / GB_WINDOW_DEFAULT_FRAMERATE;
+
+        // wait 
+        if (wait && !stop)
+        {
+            // compute the delta time
+            time = tb_cache_time_spak() - time;
+            if (wait > (tb_size_t)time) tb_msleep(wait - (tb_size_t)time);
+        }
+    }
+ 
+    // done exit
+    if (impl->base.info.exit) impl->base.info.exit((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_window_ref_t gb_window_init_offscreen(gb_window_info_ref_t info)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    gb_window_offscreen_impl_t* impl = tb_null;
+    do
+    {
+        // check
+        tb_assert_and_check_break(info);
+        tb_assert_and_check_break(info->width && info->width <= GB_WIDTH_MAXN && info->height && info->height <= GB_HEIGHT_MAXN);
+
+        // make window
+        impl = tb_malloc0_type(gb_window_offscreen_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init base, the fullscreen and cursor flags are meaningless without any display
+        impl->base.type         = GB_WINDOW_TYPE_OFFSCREEN;
+        impl->base.mode         = GB_WINDOW_MODE_BITMAP;
+        impl->base.flag         = (info->flag & GB_WINDOW_FLAG_DAMAGE) | GB_WINDOW_FLAG_OFFSCREEN;
+        impl->base.width        = info->width;
+        impl->base.height       = info->height;
+        impl->base.loop         = gb_window_offscreen_loop;
+        impl->base.exit         = gb_window_offscreen_exit;
+        impl->base.info         = *info;
+
+        // init pixfmt
+        impl->base.pixfmt       = gb_quality() < GB_QUALITY_TOP? GB_PIXFMT_RGB565 : GB_PIXFMT_XRGB8888;
+
+        // init bitmap
+        impl->base.bitmap = gb_bitmap_init(tb_null, impl->base.pixfmt, impl->base.width, impl->base.height, 0, tb_false);
+        tb_assert_and_check_break(impl->base.bitmap);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_window_exit((gb_window_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_window_ref_t)impl;
+}
@@ -57,16 +57,46 @@ typedef struct __gb_window_sdl_impl_t
     tb_size_t               button;
 
     // the normal width before fullscreen
-    tb_uint16_t             normal_width;
+    tb_uint32_t             normal_width;
 
     // the normal height before fullscreen
-    tb_uint16_t             normal_height;
+    tb_uint32_t             normal_height;
 
 }gb_window_sdl_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static tb_bool_t gb_window_sdl_present(gb_window_sdl_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->surface && impl->canvas);
+
+    // the damaged rects
+    tb_size_t       count = 0;
+    gb_rect_ref_t   rects = gb_device_damage(gb_canvas_device(impl->canvas), &count);
+
+    // not tracked or double buffered? flip the whole surface
+    if (!rects || (impl->surface->flags & SDL_DOUBLEBUF)) return SDL_Flip(impl->surface) >= 0;
+
+    // nothing has been drawn?
+    tb_check_return_val(count, tb_true);
+
+    // only update the damaged rects
+    SDL_Rect    update[GB_DAMAGE_RECTS_MAXN];
+    tb_size_t   index = 0;
+    for (index = 0; index < count && index < tb_arrayn(update); index++)
+    {
+        update[index].x = (Sint16)gb_float_to_long(rects[index].x);
+        update[index].y = (Sint16)gb_float_to_long(rects[index].y);
+        update[index].w = (Uint16)gb_float_to_long(rects[index].w);
+        update[index].h = (Uint16)gb_float_to_long(rects[index].h);
+    }
+    SDL_UpdateRects(impl->surface, (tb_int_t)index, update);
+
+    // ok
+    return tb_true;
+}
 static tb_void_t gb_window_sdl_exit(gb_window_ref_t window)
 {
     // check
@@ -118,13 +148,13 @@ static tb_void_t gb_window_sdl_loop(gb_window_ref_t window)
         SDL_LockSurface(impl->surface);
 
         // draw
-        gb_window_impl_draw((gb_window_ref_t)impl, impl->canvas);
+        tb_bool_t drawn = gb_window_impl_draw((gb_window_ref_t)impl, impl->canvas);
 
         // unlock the surface
         SDL_UnlockSurface(impl->surface);
 
-        // flip 
-        if (SDL_Flip(impl->surface) < 0) stop = tb_true;
+        // present the damaged rects
+        if (drawn && !gb_window_sdl_present(impl)) stop = tb_true;
 
         // poll
         while (SDL_PollEvent(&evet))
@@ -313,8 +343,8 @@ static tb_void_t gb_window_sdl_fullscreen(gb_window_ref_t window, tb_bool_t full
 
         // TODO
         // the screen width and height
-        tb_uint16_t screen_width  = 0;//tb_screen_width();
-        tb_uint16_t screen_height = 0;//tb_screen_height();
+        tb_uint32_t screen_width  = 0;//tb_screen_width();
+        tb_uint32_t screen_height = 0;//tb_screen_height();
         tb_assert(screen_width && screen_height && screen_width <= GB_WIDTH_MAXN && screen_height <= GB_HEIGHT_MAXN);
 
         // init surface
@@ -326,8 +356,8 @@ static tb_void_t gb_window_sdl_fullscreen(gb_window_ref_t window, tb_bool_t full
         impl->base.flag |= GB_WINDOW_FLAG_FULLSCREEN;
 
         // save the normal width and height
-        impl->normal_width      = (tb_uint16_t)gb_window_width(window);
-        impl->normal_height     = (tb_uint16_t)gb_window_height(window);
+        impl->normal_width      = (tb_uint32_t)gb_window_width(window);
+        impl->normal_height     = (tb_uint32_t)gb_window_height(window);
 
         // update the window width and height
         impl->base.width        = screen_width;
@@ -382,6 +412,9 @@ static tb_void_t gb_window_sdl_fullscreen(gb_window_ref_t window, tb_bool_t full
 
         // done resize
         if (impl->base.info.resize) impl->base.info.resize((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv);
+
+        // redraw the whole window
+        gb_window_invalidate(window, tb_null);
     }
 }
 
@@ -457,8 +490,8 @@ gb_window_ref_t gb_window_init_sdl(gb_window_info_ref_t info)
         if (info->flag & GB_WINDOW_FLAG_FULLSCREEN)
         {
             // TODO
-            impl->base.width    = 0;//(tb_uint16_t)tb_screen_width();
-            impl->base.height   = 0;//(tb_uint16_t)tb_screen_height();
+            impl->base.width    = 0;//(tb_uint32_t)tb_screen_width();
+            impl->base.height   = 0;//(tb_uint32_t)tb_screen_height();
             tb_assert_and_check_break(impl->base.width && impl->base.height && impl->base.width <= GB_WIDTH_MAXN && impl->base.height <= GB_HEIGHT_MAXN);
         }
 
@@ -53,6 +53,9 @@ __tb_extern_c__ gb_window_ref_t gb_window_init_android(gb_window_info_ref_t info
  */
 gb_window_ref_t gb_window_init(gb_window_info_ref_t info)
 {
+    // offscreen?
+    if (info && (info->flag & GB_WINDOW_FLAG_OFFSCREEN)) return gb_window_init_offscreen(info);
+
 #if defined(TB_CONFIG_OS_IOS)
     return gb_window_init_ios(info);
 #elif defined(TB_CONFIG_OS_ANDROID)
@@ -90,6 +93,9 @@ tb_void_t gb_window_loop(gb_window_ref_t window)
     gb_window_impl_t* impl = (gb_window_impl_t*)window;
     tb_assert_and_check_return(impl && impl->loop);
 
+    // draw the whole window at the first frame
+    gb_window_invalidate(window, tb_null);
+
     // loop it
     impl->loop(window);
 }
@@ -210,6 +216,35 @@ gb_float_t gb_window_framerate(gb_window_ref_t window)
     // the framerate
     return impl->framerate;
 }
+tb_void_t gb_window_invalidate(gb_window_ref_t window, gb_rect_ref_t rect)
+{
+    // check
+    gb_window_impl_t* impl = (gb_window_impl_t*)window;
+    tb_assert_and_check_return(impl);
+
+    // invalidate the whole window?
+    if (!rect)
+    {
+        gb_damage_add(&impl->invalid, 0, 0, impl->width, impl->height);
+        return ;
+    }
+
+    // invalidate the pixels of the rect inside the window
+    tb_long_t left      = tb_max(gb_floor(rect->x), 0);
+    tb_long_t top       = tb_max(gb_floor(rect->y), 0);
+    tb_long_t right     = tb_min(gb_ceil(rect->x + rect->w), (tb_long_t)impl->width);
+    tb_long_t bottom    = tb_min(gb_ceil(rect->y + rect->h), (tb_long_t)impl->height);
+    gb_damage_add(&impl->invalid, left, top, right, bottom);
+}
+gb_rect_ref_t gb_window_invalid(gb_window_ref_t window, tb_size_t* count)
+{
+    // check
+    gb_window_impl_t* impl = (gb_window_impl_t*)window;
+    tb_assert_and_check_return_val(impl && count, tb_null);
+
+    // the invalidated rects
+    return gb_damage_rects(&impl->invalid, count);
+}
 tb_timer_ref_t gb_window_timer(gb_window_ref_t window)
 {
     // check
@@ -51,6 +51,7 @@ typedef enum __gb_window_type_e
 ,   GB_WINDOW_TYPE_ANDROID          = 3
 ,   GB_WINDOW_TYPE_SDL              = 4
 ,   GB_WINDOW_TYPE_X11              = 5
+,   GB_WINDOW_TYPE_OFFSCREEN        = 6
 
 }gb_window_type_e;
 
@@ -71,6 +72,8 @@ typedef enum __gb_window_flag_e
 ,   GB_WINDOW_FLAG_HIHE_TITLEBAR    = 2
 ,   GB_WINDOW_FLAG_HIHE_CURSOR      = 4
 ,   GB_WINDOW_FLAG_NOT_REISZE       = 8
+,   GB_WINDOW_FLAG_DAMAGE           = 16    //!< only redraw the invalidated rects for the bitmap mode
+,   GB_WINDOW_FLAG_OFFSCREEN        = 32    //!< init the offscreen window without any display
 
 }gb_window_flag_e;
 
@@ -111,6 +114,16 @@ typedef tb_void_t           (*gb_window_draw_func_t)(gb_window_ref_t window, gb_
  */
 typedef tb_void_t           (*gb_window_resize_func_t)(gb_window_ref_t window, gb_canvas_ref_t canvas, tb_cpointer_t priv);
 
+/*! the window frame func type for the offscreen window
+ *
+ * @param window            the window
+ * @param bitmap            the bitmap of the drawn frame
+ * @param priv              the user private data
+ *
+ * @return                  tb_false if stop the window loop
+ */
+typedef tb_bool_t           (*gb_window_frame_func_t)(gb_window_ref_t window, gb_bitmap_ref_t bitmap, tb_cpointer_t priv);
+
 /*! the window event func type
  *
  * @param window            the window
@@ -132,10 +145,10 @@ typedef struct __gb_window_info_t
     tb_uint8_t                      flag;
 
     /// the width
-    tb_uint16_t                     width;
+    tb_uint32_t                     width;
 
     /// the height
-    tb_uint16_t                     height;
+    tb_uint32_t                     height;
 
     /// the init func
     gb_window_init_func_t           init;
@@ -152,6 +165,9 @@ typedef struct __gb_window_info_t
     /// the event func
     gb_window_event_func_t          event;
 
+    /// the frame func, only for the offscreen window, the frames will be dropped if it is null
+    gb_window_frame_func_t          frame;
+
     /// the user private data
     tb_cpointer_t                   priv;
 
@@ -205,6 +221,18 @@ gb_window_ref_t         gb_window_init_sdl(gb_window_info_ref_t info);
 gb_window_ref_t         gb_window_init_x11(gb_window_info_ref_t info);
 #endif
 
+/*! init offscreen window 
+ *
+ * the frames will be drawn as fast as possible if the framerate is zero 
+ * and be passed to the frame func without any display, 
+ * the frames will be dropped if there is no frame func
+ *
+ * @param info          the window info
+ *
+ * @return              the window
+ */
+gb_window_ref_t         gb_window_init_offscreen(gb_window_info_ref_t info);
+
 /*! exit window 
  *
  * @param window        the window
@@ -289,6 +317,28 @@ gb_bitmap_ref_t         gb_window_bitmap(gb_window_ref_t window);
  */
 gb_float_t              gb_window_framerate(gb_window_ref_t window);
 
+/*! invalidate the given rect of the window and redraw it at the next frame
+ *
+ * only the invalidated rects will be clipped, drawn and presented 
+ * if the window is the bitmap mode with GB_WINDOW_FLAG_DAMAGE,
+ * the draw func should not replace the clipper of the canvas
+ *
+ * @param window        the window
+ * @param rect          the rect, invalidate the whole window if be null
+ */
+tb_void_t               gb_window_invalidate(gb_window_ref_t window, gb_rect_ref_t rect);
+
+/*! the invalidated rects of the current frame
+ *
+ * it is used to skip the shapes outside the invalidated rects in the draw func
+ *
+ * @param window        the window
+ * @param count         the rects count
+ *
+ * @return              the rects 
+ */
+gb_rect_ref_t           gb_window_invalid(gb_window_ref_t window, tb_size_t* count);
+
 /*! enter or leave the fullscreen only for the desktop window
  *
  * @param window        the window
@@ -23,12 +23,702 @@
  * @ingroup     platform
  *
  */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "window_x11"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
 #include "prefix.h"
+#include "../impl/window.h"
+#include "x11/x11.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the x11 window impl type
+typedef struct __gb_window_x11_impl_t
+{
+    // the base
+    gb_window_impl_t        base;
+
+    // the canvas
+    gb_canvas_ref_t         canvas;
+
+    // the display
+    Display*                display;
+
+    // the window
+    Window                  window;
+
+    // the graphic context
+    GC                      gc;
+
+    // the visual
+    Visual*                 visual;
+
+    // the depth
+    tb_int_t                depth;
+
+    // the image, the bitmap pixels are rendered into it directly
+    XImage*                 image;
+
+    // the shared memory segment of the image if uses mit-shm
+    XShmSegmentInfo         shm;
+
+    // the event type of the shm completion, -1 if the shm is not used
+    tb_int_t                shm_completion;
+
+    // the count of the presented shm images which are not completed, the pixels cannot be drawn until they are completed
+    tb_size_t               shm_pending;
+
+    // the atom of the WM_DELETE_WINDOW
+    Atom                    atom_delete;
+
+    // the button
+    tb_size_t               button;
+
+}gb_window_x11_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the shm attaching failed?
+static tb_bool_t    g_shm_failed = tb_false;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_int_t gb_window_x11_shm_error(Display* display, XErrorEvent* event)
+{
+    // the shm cannot be attached to the remote display
+    g_shm_failed = tb_true;
+    return 0;
+}
+static Bool gb_window_x11_shm_completed(Display* display, XEvent* event, XPointer priv)
+{
+    // check
+    gb_window_x11_impl_t* impl = (gb_window_x11_impl_t*)priv;
+    tb_assert(impl);
+
+    // is the shm completion event?
+    return event->type == impl->shm_completion? True : False;
+}
+static tb_void_t gb_window_x11_shm_wait(gb_window_x11_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->display);
+
+    // wait all presenting images
+    XEvent event;
+    while (impl->shm_pending)
+    {
+        XIfEvent(impl->display, &event, gb_window_x11_shm_completed, (XPointer)impl);
+        impl->shm_pending--;
+    }
+}
+static tb_void_t gb_window_x11_image_exit(gb_window_x11_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->display);
+
+    // exit bitmap
+    if (impl->base.bitmap) gb_bitmap_exit(impl->base.bitmap);
+    impl->base.bitmap = tb_null;
+
+    // exit image
+    if (impl->image)
+    {
+        // exit the shared memory
+        if (impl->shm_completion >= 0)
+        {
+            // wait the presenting images
+            gb_window_x11_shm_wait(impl);
+
+            // detach it
+            XShmDetach(impl->display, &impl->shm);
+            XSync(impl->display, False);
+            shmdt(impl->shm.shmaddr);
+        }
+        // exit the image data
+        else if (impl->image->data) tb_free(impl->image->data);
+
+        // exit it, the data has been freed
+        impl->image->data = tb_null;
+        XDestroyImage(impl->image);
+    }
+    impl->image = tb_null;
+}
+static tb_bool_t gb_window_x11_image_init_shm(gb_window_x11_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->display && !impl->image);
+
+    // no shm extension?
+    tb_check_return_val(XShmQueryExtension(impl->display), tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // init image
+        impl->shm.shmid     = -1;
+        impl->shm.shmaddr   = (tb_char_t*)-1;
+        impl->image = XShmCreateImage(impl->display, impl->visual, impl->depth, ZPixmap, tb_null, &impl->shm, impl->base.width, impl->base.height);
+        tb_check_break(impl->image);
+
+        // init the shared memory
+        impl->shm.shmid = shmget(IPC_PRIVATE, impl->image->bytes_per_line * impl->image->height, IPC_CREAT | 0600);
+        tb_check_break(impl->shm.shmid >= 0);
+        impl->shm.shmaddr = (tb_char_t*)shmat(impl->shm.shmid, tb_null, 0);
+        tb_check_break(impl->shm.shmaddr != (tb_char_t*)-1);
+        impl->shm.readOnly = False;
+
+        // attach it to the display, it will be failed for the remote display
+        g_shm_failed = tb_true;
+        if (XShmAttach(impl->display, &impl->shm))
+        {
+            g_shm_failed = tb_false;
+            XErrorHandler handler = XSetErrorHandler(gb_window_x11_shm_error);
+            XSync(impl->display, False);
+            XSetErrorHandler(handler);
+        }
+        tb_check_break(!g_shm_failed);
+
+        // init the image data
+        impl->image->data = impl->shm.shmaddr;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // remove the shared memory id, it will be freed after detaching it from the display and us
+    if (impl->shm.shmid >= 0) shmctl(impl->shm.shmid, IPC_RMID, tb_null);
+
+    // failed?
+    if (!ok)
+    {
+        // exit the shared memory
+        if (impl->shm.shmaddr != (tb_char_t*)-1) shmdt(impl->shm.shmaddr);
+        impl->shm.shmaddr = tb_null;
+
+        // exit image
+        if (impl->image) XDestroyImage(impl->image);
+        impl->image = tb_null;
+    }
+
+    // ok?
+    return ok;
+}
+static tb_bool_t gb_window_x11_image_init(gb_window_x11_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->display && !impl->image && !impl->base.bitmap);
+
+    // save the event type of the shm completion
+    tb_int_t shm_completion = impl->shm_completion;
+
+    // init the shared image first
+    impl->shm_completion = -1;
+    if (gb_window_x11_image_init_shm(impl)) impl->shm_completion = shm_completion;
+    else
+    {
+        // trace
+        tb_trace_d("the mit-shm is not available, put the image directly");
+
+        // init image
+        impl->image = XCreateImage(impl->display, impl->visual, impl->depth, ZPixmap, 0, tb_null, impl->base.width, impl->base.height, 32, 0);
+        tb_assert_and_check_return_val(impl->image, tb_false);
+
+        // init the image data
+        impl->image->data = (tb_char_t*)tb_malloc0(impl->image->bytes_per_line * impl->image->height);
+        tb_assert_and_check_return_val(impl->image->data, tb_false);
+    }
+
+    // the pixmap
+    gb_pixmap_ref_t pixmap = gb_pixmap(impl->base.pixfmt, 0xff);
+    tb_assert_and_check_return_val(pixmap && pixmap->bpp == (tb_size_t)impl->image->bits_per_pixel, tb_false);
+
+    // init bitmap, render the pixels into the image directly
+    impl->base.bitmap = gb_bitmap_init(impl->image->data, impl->base.pixfmt, impl->base.width, impl->base.height, impl->image->bytes_per_line, tb_false);
+    tb_assert_and_check_return_val(impl->base.bitmap, tb_false);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_window_x11_present(gb_window_x11_impl_t* impl, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_bool_t completion)
+{
+    // check
+    tb_assert(impl && impl->display && impl->image);
+
+    // clip it
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    w = tb_min(w, (tb_long_t)impl->base.width - x);
+    h = tb_min(h, (tb_long_t)impl->base.height - y);
+    tb_check_return(w > 0 && h > 0);
+
+    // put the shared image, the server will send the completion event after reading it
+    if (impl->shm_completion >= 0)
+    {
+        XShmPutImage(impl->display, impl->window, impl->gc, impl->image, x, y, x, y, w, h, completion? True : False);
+        if (completion) impl->shm_pending++;
+    }
+    // put the image
+    else XPutImage(impl->display, impl->window, impl->gc, impl->image, x, y, x, y, w, h);
+}
+static tb_void_t gb_window_x11_present_damage(gb_window_x11_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->display && impl->canvas);
+
+    // the damaged rects
+    tb_size_t       count = 0;
+    gb_rect_ref_t   rects = gb_device_damage(gb_canvas_device(impl->canvas), &count);
+
+    // not tracked? present the whole image
+    if (!rects) gb_window_x11_present(impl, 0, 0, impl->base.width, impl->base.height, tb_true);
+    else
+    {
+        // only present the damaged rects, we need only wait the completion of the last rect
+        tb_size_t index = 0;
+        for (index = 0; index < count; index++)
+        {
+            gb_rect_ref_t rect = rects + index;
+            gb_window_x11_present(impl, gb_float_to_long(rect->x), gb_float_to_long(rect->y), gb_float_to_long(rect->w), gb_float_to_long(rect->h), index + 1 == count);
+        }
+    }
+
+    // flush it
+    XFlush(impl->display);
+}
+static tb_void_t gb_window_x11_resize(gb_window_x11_impl_t* impl, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert(impl);
+
+    // not changed?
+    tb_check_return(width && height && (width != impl->base.width || height != impl->base.height));
+    tb_assert_and_check_return(width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
+
+    // trace
+    tb_trace_d("resize: %lux%lu", width, height);
+
+    // exit canvas first
+    if (impl->canvas) gb_canvas_exit(impl->canvas);
+    impl->canvas = tb_null;
+
+    // exit image
+    gb_window_x11_image_exit(impl);
+
+    // update the window width and height
+    impl->base.width    = (tb_uint32_t)width;
+    impl->base.height   = (tb_uint32_t)height;
+
+    // init image
+    if (!gb_window_x11_image_init(impl))
+    {
+        // trace
+        tb_trace_e("resize image failed!");
+        return ;
+    }
+
+    // init canvas
+    impl->canvas = gb_canvas_init_from_window((gb_window_ref_t)impl);
+    tb_assert_and_check_return(impl->canvas);
+
+    // done resize
+    if (impl->base.info.resize) impl->base.info.resize((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv);
+
+    // redraw the whole window
+    gb_window_invalidate((gb_window_ref_t)impl, tb_null);
+}
+static tb_size_t gb_window_x11_key(KeySym key)
+{
+    // done
+    switch (key)
+    {
+    case XK_F1:             return GB_KEY_F1;
+    case XK_F2:             return GB_KEY_F2;
+    case XK_F3:             return GB_KEY_F3;
+    case XK_F4:             return GB_KEY_F4;
+    case XK_F5:             return GB_KEY_F5;
+    case XK_F6:             return GB_KEY_F6;
+    case XK_F7:             return GB_KEY_F7;
+    case XK_F8:             return GB_KEY_F8;
+    case XK_F9:             return GB_KEY_F9;
+    case XK_F10:            return GB_KEY_F10;
+    case XK_F11:            return GB_KEY_F11;
+    case XK_F12:            return GB_KEY_F12;
+
+    case XK_Left:           return GB_KEY_LEFT;
+    case XK_Up:             return GB_KEY_UP;
+    case XK_Right:          return GB_KEY_RIGHT;
+    case XK_Down:           return GB_KEY_DOWN;
+
+    case XK_Home:           return GB_KEY_HOME;
+    case XK_End:            return GB_KEY_END;
+    case XK_Insert:         return GB_KEY_INSERT;
+    case XK_Page_Up:        return GB_KEY_PAGEUP;
+    case XK_Page_Down:      return GB_KEY_PAGEDOWN;
+
+    case XK_Help:           return GB_KEY_HELP;
+    case XK_Print:          return GB_KEY_PRINT;
+    case XK_Sys_Req:        return GB_KEY_SYSREQ;
+    case XK_Break:          return GB_KEY_BREAK;
+    case XK_Menu:           return GB_KEY_MENU;
+    case XK_Undo:           return GB_KEY_UNDO;
+
+    case XK_Num_Lock:       return GB_KEY_NUMLOCK;
+    case XK_Caps_Lock:      return GB_KEY_CAPSLOCK;
+    case XK_Scroll_Lock:    return GB_KEY_SCROLLLOCK;
+    case XK_Shift_R:        return GB_KEY_RSHIFT;
+    case XK_Shift_L:        return GB_KEY_LSHIFT;
+    case XK_Control_R:      return GB_KEY_RCTRL;
+    case XK_Control_L:      return GB_KEY_LCTRL;
+    case XK_Alt_R:          return GB_KEY_RALT;
+    case XK_Alt_L:          return GB_KEY_LALT;
+    case XK_Super_R:        return GB_KEY_RCMD;
+    case XK_Super_L:        return GB_KEY_LCMD;
+
+    case XK_Pause:          return GB_KEY_PAUSE;
+
+    // the char code
+    default:                return key < 256? (tb_size_t)key : 0;
+    }
+}
+static tb_bool_t gb_window_x11_event(gb_window_x11_impl_t* impl, XEvent* evet)
+{
+    // check
+    tb_assert(impl && evet);
+
+    // the shm completion? 
+    if (evet->type == impl->shm_completion)
+    {
+        if (impl->shm_pending) impl->shm_pending--;
+        return tb_true;
+    }
+
+    // done
+    switch (evet->type)
+    {
+    case MotionNotify:
+        {
+            // init event
+            gb_event_t              event = {0};
+            event.type              = GB_EVENT_TYPE_MOUSE;
+            event.u.mouse.code      = GB_MOUSE_MOVE;
+            event.u.mouse.button    = impl->button;
+            gb_point_imake(&event.u.mouse.cursor, evet->xmotion.x, evet->xmotion.y);
+
+            // done event
+            gb_window_impl_event((gb_window_ref_t)impl, &event);
+        }
+        break;
+    case ButtonPress:
+    case ButtonRelease:
+        {
+            // init event
+            gb_event_t              event = {0};
+            event.type              = GB_EVENT_TYPE_MOUSE;
+            event.u.mouse.code      = evet->type == ButtonPress? GB_MOUSE_DOWN : GB_MOUSE_UP;
+            gb_point_imake(&event.u.mouse.cursor, evet->xbutton.x, evet->xbutton.y);
+
+            // init button
+            switch (evet->xbutton.button)
+            {
+            case Button1:   event.u.mouse.button = GB_MOUSE_BUTTON_LEFT;    break;
+            case Button2:   event.u.mouse.button = GB_MOUSE_BUTTON_MIDDLE;  break;
+            case Button3:   event.u.mouse.button = GB_MOUSE_BUTTON_RIGHT;   break;
+            default:        event.u.mouse.button = GB_MOUSE_BUTTON_NONE;    break;
+            }
+
+            // save button
+            impl->button = evet->type == ButtonPress? event.u.mouse.button : GB_MOUSE_BUTTON_NONE;
+
+            // done event
+            gb_window_impl_event((gb_window_ref_t)impl, &event);
+        }
+        break;
+    case KeyPress:
+    case KeyRelease:
+        {
+            // init event
+            gb_event_t                  event = {0};
+            event.type                  = GB_EVENT_TYPE_KEYBOARD;
+            event.u.keyboard.pressed    = evet->type == KeyPress? tb_true : tb_false;
+            event.u.keyboard.code       = gb_window_x11_key(XLookupKeysym(&evet->xkey, 0));
+
+            // done event
+            if (event.u.keyboard.code) gb_window_impl_event((gb_window_ref_t)impl, &event);
+        }
+        break;
+    case Expose:
+        {
+            // present the exposed pixels of the last frame, the next frame cannot be drawn until it is completed
+            gb_window_x11_present(impl, evet->xexpose.x, evet->xexpose.y, evet->xexpose.width, evet->xexpose.height, tb_true);
+        }
+        break;
+    case ConfigureNotify:
+        {
+            // resize it
+            gb_window_x11_resize(impl, evet->xconfigure.width, evet->xconfigure.height);
+        }
+        break;
+    case FocusIn:
+    case FocusOut:
+        {
+            // init event
+            gb_event_t              event = {0};
+            event.type              = GB_EVENT_TYPE_ACTIVE;
+            event.u.active.code     = evet->type == FocusIn? GB_ACTIVE_FOREGROUND : GB_ACTIVE_BACKGROUND;
+
+            // done event
+            gb_window_impl_event((gb_window_ref_t)impl, &event);
+        }
+        break;
+    case ClientMessage:
+        {
+            // stop it if the window is closed
+            if ((Atom)evet->xclient.data.l[0] == impl->atom_delete) return tb_false;
+        }
+        break;
+    default:
+        break;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_window_x11_exit(gb_window_ref_t window)
+{
+    // check
+    gb_window_x11_impl_t* impl = (gb_window_x11_impl_t*)window;
+    tb_assert_and_check_return(impl);
+
+    // exit canvas
+    if (impl->canvas) gb_canvas_exit(impl->canvas);
+    impl->canvas = tb_null;
+
+    // exit display
+    if (impl->display)
+    {
+        // exit image
+        gb_window_x11_image_exit(impl);
+
+        // exit gc
+        if (impl->gc) XFreeGC(impl->display, impl->gc);
+        impl->gc = tb_null;
+
+        // exit window
+        if (impl->window) XDestroyWindow(impl->display, impl->window);
+        impl->window = 0;
+
+        // close it
+        XCloseDisplay(impl->display);
+        impl->display = tb_null;
+    }
+
+    // exit it
+    tb_free(window);
+}
+static tb_void_t gb_window_x11_loop(gb_window_ref_t window)
+{
+    // check
+    gb_window_x11_impl_t* impl = (gb_window_x11_impl_t*)window;
+    tb_assert_and_check_return(impl && impl->display);
+
+    // init canvas
+    if (!impl->canvas) impl->canvas = gb_canvas_init_from_window(window);
+    tb_assert(impl->canvas);
+
+    // done init
+    if (impl->base.info.init && !impl->base.info.init((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv)) return ;
+
+    // loop
+    XEvent    evet;
+    tb_hong_t time;
+    tb_bool_t stop = tb_false;
+    tb_size_t delay = 1000 / (impl->base.info.framerate? impl->base.info.framerate : GB_WINDOW_DEFAULT_FRAMERATE);
+    while (!stop)
+    {
+        // spak
+        time = gb_window_impl_spak((gb_window_ref_t)impl);
+
+        // wait the presenting images before drawing them
+        gb_window_x11_shm_wait(impl);
+
+        // draw and present the damaged rects
+        if (impl->canvas && gb_window_impl_draw((gb_window_ref_t)impl, impl->canvas))
+            gb_window_x11_present_damage(impl);
+
+        // poll
+        while (!stop && XPending(impl->display))
+        {
+            XNextEvent(impl->display, &evet);
+            if (!gb_window_x11_event(impl, &evet)) stop = tb_true;
+        }
+
+        // compute the delta time
+        time = tb_cache_time_spak() - time;
+
+        // wait 
+        if (delay > (tb_size_t)time) tb_msleep(delay - (tb_size_t)time);
+    }
+ 
+    // done exit
+    if (impl->base.info.exit) impl->base.info.exit((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv);
+}
+static tb_void_t gb_window_x11_fullscreen(gb_window_ref_t window, tb_bool_t fullscreen)
+{
+    // check
+    gb_window_x11_impl_t* impl = (gb_window_x11_impl_t*)window;
+    tb_assert_and_check_return(impl && impl->display);
+
+    // not changed?
+    tb_check_return(!fullscreen != !(impl->base.flag & GB_WINDOW_FLAG_FULLSCREEN));
+
+    // ask the window manager to change the fullscreen state, the window will be resized by ConfigureNotify
+    XEvent event;
+    tb_memset(&event, 0, sizeof(event));
+    event.xclient.type          = ClientMessage;
+    event.xclient.window        = impl->window;
+    event.xclient.message_type  = XInternAtom(impl->display, "_NET_WM_STATE", False);
+    event.xclient.format        = 32;
+    event.xclient.data.l[0]     = fullscreen? 1 : 0;
+    event.xclient.data.l[1]     = (long)XInternAtom(impl->display, "_NET_WM_STATE_FULLSCREEN", False);
+    XSendEvent(impl->display, DefaultRootWindow(impl->display), False, SubstructureRedirectMask | SubstructureNotifyMask, &event);
+    XFlush(impl->display);
+
+    // update flag
+    if (fullscreen) impl->base.flag |= GB_WINDOW_FLAG_FULLSCREEN;
+    else impl->base.flag &= ~GB_WINDOW_FLAG_FULLSCREEN;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+gb_window_ref_t gb_window_init_x11(gb_window_info_ref_t info)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_window_x11_impl_t*   impl = tb_null;
+    do
+    {
+        // check
+        tb_assert_and_check_break(info && info->framerate);
+        tb_assert_and_check_break(info->width && info->width <= GB_WIDTH_MAXN && info->height && info->height <= GB_HEIGHT_MAXN);
+
+        // make window
+        impl = tb_malloc0_type(gb_window_x11_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init base
+        impl->base.type         = GB_WINDOW_TYPE_X11;
+        impl->base.mode         = GB_WINDOW_MODE_BITMAP;
+        impl->base.flag         = info->flag & ~GB_WINDOW_FLAG_FULLSCREEN;
+        impl->base.width        = info->width;
+        impl->base.height       = info->height;
+        impl->base.loop         = gb_window_x11_loop;
+        impl->base.exit         = gb_window_x11_exit;
+        impl->base.fullscreen   = gb_window_x11_fullscreen;
+        impl->base.info         = *info;
+        impl->shm_completion    = -1;
+
+        // open display
+        impl->display = XOpenDisplay(tb_null);
+        tb_check_break(impl->display);
+
+        // the screen
+        tb_int_t screen = DefaultScreen(impl->display);
+        impl->visual    = DefaultVisual(impl->display, screen);
+        impl->depth     = DefaultDepth(impl->display, screen);
+
+        /* init pixfmt
+         * 
+         * supports: 
+         * - xrgb8888_le
+         * - xrgb8888_be
+         * - rgb565_le
+         */
+        switch (impl->depth)
+        {
+        case 24:
+        case 32:
+            impl->base.pixfmt = ImageByteOrder(impl->display) == MSBFirst? (GB_PIXFMT_XRGB8888 | GB_PIXFMT_BENDIAN) : GB_PIXFMT_XRGB8888;
+            break;
+        case 16:
+            impl->base.pixfmt = GB_PIXFMT_RGB565;
+            break;
+        default:
+            break;
+        }
+        tb_assert_and_check_break(impl->base.pixfmt);
+
+        // init window
+        impl->window = XCreateSimpleWindow(impl->display, RootWindow(impl->display, screen), 0, 0, impl->base.width, impl->base.height, 0, BlackPixel(impl->display, screen), BlackPixel(impl->display, screen));
+        tb_assert_and_check_break(impl->window);
+
+        // init events
+        XSelectInput(impl->display, impl->window, ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask | PointerMotionMask | StructureNotifyMask | FocusChangeMask);
+
+        // close the window by the window manager
+        impl->atom_delete = XInternAtom(impl->display, "WM_DELETE_WINDOW", False);
+        XSetWMProtocols(impl->display, impl->window, &impl->atom_delete, 1);
+
+        // init title
+        if (impl->base.info.title) XStoreName(impl->display, impl->window, impl->base.info.title);
+
+        // not resize? 
+        if (info->flag & GB_WINDOW_FLAG_NOT_REISZE)
+        {
+            XSizeHints* hints = XAllocSizeHints();
+            if (hints)
+            {
+                hints->flags        = PMinSize | PMaxSize;
+                hints->min_width    = hints->max_width  = impl->base.width;
+                hints->min_height   = hints->max_height = impl->base.height;
+                XSetWMNormalHints(impl->display, impl->window, hints);
+                XFree(hints);
+            }
+        }
+
+        // init gc
+        impl->gc = XCreateGC(impl->display, impl->window, 0, tb_null);
+        tb_assert_and_check_break(impl->gc);
+
+        // init the event type of the shm completion
+        impl->shm_completion = XShmGetEventBase(impl->display) + ShmCompletion;
+
+        // init image and bitmap
+        if (!gb_window_x11_image_init(impl)) break;
+
+        // show it
+        XMapWindow(impl->display, impl->window);
+
+        // fullscreen?
+        if (info->flag & GB_WINDOW_FLAG_FULLSCREEN) gb_window_x11_fullscreen((gb_window_ref_t)impl, tb_true);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_window_exit((gb_window_ref_t)impl);
+        impl = tb_null;
+    }
 
+    // ok?
+    return (gb_window_ref_t)impl;
+}
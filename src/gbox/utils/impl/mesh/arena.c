@@ -0,0 +1,194 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.c
+ * @ingroup     utils
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "mesh_arena"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "arena.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the mesh arena chunk type
+typedef struct __gb_mesh_arena_chunk_t
+{
+    // the next chunk
+    struct __gb_mesh_arena_chunk_t*     next;
+
+    // the data size
+    tb_size_t                           size;
+
+}gb_mesh_arena_chunk_t, *gb_mesh_arena_chunk_ref_t;
+
+// the mesh arena impl type
+typedef struct __gb_mesh_arena_impl_t
+{
+    // the first chunk
+    gb_mesh_arena_chunk_ref_t           chunks;
+
+    // the current chunk
+    gb_mesh_arena_chunk_ref_t           chunk;
+
+    // the current data position of the current chunk
+    tb_byte_t*                          data;
+
+    // the data end of the current chunk
+    tb_byte_t*                          tail;
+
+    // the default chunk size
+    tb_size_t                           chunk_size;
+
+}gb_mesh_arena_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_byte_t* gb_mesh_arena_chunk_data(gb_mesh_arena_chunk_ref_t chunk)
+{
+    // the data follows the chunk head
+    return (tb_byte_t*)chunk + tb_align_cpu(sizeof(gb_mesh_arena_chunk_t));
+}
+static tb_void_t gb_mesh_arena_chunk_switch(gb_mesh_arena_impl_t* impl, gb_mesh_arena_chunk_ref_t chunk)
+{
+    // check
+    tb_assert(impl && chunk);
+
+    // switch to this chunk
+    impl->chunk = chunk;
+    impl->data  = gb_mesh_arena_chunk_data(chunk);
+    impl->tail  = impl->data + chunk->size;
+}
+static gb_mesh_arena_chunk_ref_t gb_mesh_arena_chunk_make(gb_mesh_arena_impl_t* impl, tb_size_t size)
+{
+    // check
+    tb_assert(impl);
+
+    // make chunk
+    size = tb_max(size, impl->chunk_size);
+    gb_mesh_arena_chunk_ref_t chunk = (gb_mesh_arena_chunk_ref_t)tb_malloc(tb_align_cpu(sizeof(gb_mesh_arena_chunk_t)) + size);
+    tb_assert_and_check_return_val(chunk, tb_null);
+
+    // init chunk
+    chunk->size = size;
+
+    // insert it after the current chunk, so all chunks will be reused in order after clearing
+    if (impl->chunk)
+    {
+        chunk->next         = impl->chunk->next;
+        impl->chunk->next   = chunk;
+    }
+    else 
+    {
+        chunk->next         = tb_null;
+        impl->chunks        = chunk;
+    }
+
+    // trace
+    tb_trace_d("make chunk: %lu bytes", size);
+
+    // ok
+    return chunk;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_mesh_arena_ref_t gb_mesh_arena_init(tb_size_t chunk_size)
+{
+    // check
+    tb_assert_and_check_return_val(chunk_size, tb_null);
+
+    // make arena
+    gb_mesh_arena_impl_t* impl = tb_malloc0_type(gb_mesh_arena_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init arena, the chunks will be made when carving data
+    impl->chunk_size = tb_align_cpu(chunk_size);
+
+    // ok
+    return (gb_mesh_arena_ref_t)impl;
+}
+tb_void_t gb_mesh_arena_exit(gb_mesh_arena_ref_t arena)
+{
+    // check
+    gb_mesh_arena_impl_t* impl = (gb_mesh_arena_impl_t*)arena;
+    tb_assert_and_check_return(impl);
+
+    // exit all chunks
+    gb_mesh_arena_chunk_ref_t chunk = impl->chunks;
+    while (chunk)
+    {
+        gb_mesh_arena_chunk_ref_t next = chunk->next;
+        tb_free(chunk);
+        chunk = next;
+    }
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_mesh_arena_clear(gb_mesh_arena_ref_t arena)
+{
+    // check
+    gb_mesh_arena_impl_t* impl = (gb_mesh_arena_impl_t*)arena;
+    tb_assert_and_check_return(impl);
+
+    // rewind to the first chunk
+    if (impl->chunks) gb_mesh_arena_chunk_switch(impl, impl->chunks);
+}
+tb_pointer_t gb_mesh_arena_malloc(gb_mesh_arena_ref_t arena, tb_size_t size)
+{
+    // check
+    gb_mesh_arena_impl_t* impl = (gb_mesh_arena_impl_t*)arena;
+    tb_assert_and_check_return_val(impl && size, tb_null);
+
+    // align size
+    size = tb_align_cpu(size);
+
+    // no chunk or no enough space in the current chunk?
+    if (!impl->data || size > (tb_size_t)(impl->tail - impl->data))
+    {
+        // reuse the next chunk if it is large enough, otherwise make a new chunk after the current chunk
+        gb_mesh_arena_chunk_ref_t chunk = impl->chunk? impl->chunk->next : tb_null;
+        if (!chunk || chunk->size < size) chunk = gb_mesh_arena_chunk_make(impl, size);
+        tb_assert_and_check_return_val(chunk, tb_null);
+
+        // switch to this chunk
+        gb_mesh_arena_chunk_switch(impl, chunk);
+    }
+
+    // carve it
+    tb_pointer_t data = impl->data;
+    impl->data += size;
+
+    // ok
+    return data;
+}
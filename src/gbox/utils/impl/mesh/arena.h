@@ -0,0 +1,90 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.h
+ * @ingroup     utils
+ */
+#ifndef GB_UTILS_IMPL_MESH_ARENA_H
+#define GB_UTILS_IMPL_MESH_ARENA_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the mesh arena ref type
+typedef struct{}*           gb_mesh_arena_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the mesh arena 
+ *
+ * all edges, faces and vertices of the mesh are carved from the arena chunks,
+ * and the chunks are kept and reused after clearing it.
+ *
+ * @param chunk_size        the default chunk size
+ *
+ * @return                  the arena
+ */
+gb_mesh_arena_ref_t         gb_mesh_arena_init(tb_size_t chunk_size);
+
+/* exit the mesh arena and free all chunks
+ *
+ * @param arena             the arena
+ */
+tb_void_t                   gb_mesh_arena_exit(gb_mesh_arena_ref_t arena);
+
+/* clear the mesh arena and rewind it to the first chunk 
+ *
+ * all carved data will be invalid, but no chunk will be freed
+ *
+ * @param arena             the arena
+ */
+tb_void_t                   gb_mesh_arena_clear(gb_mesh_arena_ref_t arena);
+
+/* carve a data from the arena
+ *
+ * @param arena             the arena
+ * @param size              the data size
+ *
+ * @return                  the data, it is not cleared
+ */
+tb_pointer_t                gb_mesh_arena_malloc(gb_mesh_arena_ref_t arena, tb_size_t size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
@@ -38,13 +38,6 @@
  * macros
  */
 
-// the mesh edge list grow
-#ifdef __tb_small__ 
-#   define GB_MESH_EDGE_LIST_GROW               (128)
-#else
-#   define GB_MESH_EDGE_LIST_GROW               (256)
-#endif
-
 // the mesh edge list maxn
 #ifdef __tb_small__
 #   define GB_MESH_EDGE_LIST_MAXN               (1 << 16)
@@ -65,8 +58,14 @@ typedef struct __gb_mesh_edge_list_impl_t
     // the iterator
     tb_iterator_t                   itor;
 
-    // the pool
-    tb_fixed_pool_ref_t             pool;
+    // the arena
+    gb_mesh_arena_ref_t             arena;
+
+    // the free edges
+    gb_mesh_edge_ref_t              free;
+
+    // the edge count
+    tb_size_t                       size;
 
     // the head edge
     gb_mesh_edge_t                  head[2];
@@ -90,15 +89,34 @@ typedef struct __gb_mesh_edge_list_impl_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_void_t gb_mesh_edge_exit(tb_pointer_t data, tb_cpointer_t priv)
+static tb_void_t gb_mesh_edge_exit(gb_mesh_edge_list_impl_t* impl, gb_mesh_edge_ref_t edge)
 {
     // check
-    gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)priv;
-    tb_assert_and_check_return(impl && data);
+    tb_assert_and_check_return(impl && edge);
 
     // exit the user data
-    impl->element.free(&impl->element, (tb_pointer_t)((gb_mesh_edge_ref_t)data + 1));
-    impl->element.free(&impl->element, (tb_pointer_t)((gb_mesh_edge_ref_t)((tb_byte_t*)data + impl->edge_size) + 1));
+    impl->element.free(&impl->element, (tb_pointer_t)(edge + 1));
+    impl->element.free(&impl->element, (tb_pointer_t)((gb_mesh_edge_ref_t)((tb_byte_t*)edge + impl->edge_size) + 1));
+}
+static gb_mesh_edge_ref_t gb_mesh_edge_malloc0(gb_mesh_edge_list_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->arena);
+
+    // reuse a free edge first, otherwise carve it from the arena, item = (edge + data) + (edge->sym + data)
+    gb_mesh_edge_ref_t edge = impl->free;
+    if (edge) impl->free = edge->next;
+    else edge = (gb_mesh_edge_ref_t)gb_mesh_arena_malloc(impl->arena, impl->edge_size << 1);
+    tb_assert_and_check_return_val(edge, tb_null);
+
+    // clear it
+    tb_memset(edge, 0, impl->edge_size << 1);
+
+    // update the edge count
+    impl->size++;
+
+    // ok
+    return edge;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -248,10 +266,10 @@ static tb_pointer_t gb_mesh_edge_itor_item(tb_iterator_ref_t iterator, tb_size_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-gb_mesh_edge_list_ref_t gb_mesh_edge_list_init(tb_element_t element)
+gb_mesh_edge_list_ref_t gb_mesh_edge_list_init(gb_mesh_arena_ref_t arena, tb_element_t element)
 {
     // check
-    tb_assert_and_check_return_val(element.data && element.dupl && element.repl, tb_null);
+    tb_assert_and_check_return_val(arena && element.data && element.dupl && element.repl, tb_null);
 
     // done
     tb_bool_t                   ok = tb_false;
@@ -283,9 +301,8 @@ gb_mesh_edge_list_ref_t gb_mesh_edge_list_init(tb_element_t element)
         impl->itor.next = gb_mesh_edge_itor_next;
         impl->itor.item = gb_mesh_edge_itor_item;
 
-        // init pool, item = (edge + data) + (edge->sym + data)
-        impl->pool = tb_fixed_pool_init(tb_null, GB_MESH_EDGE_LIST_GROW, impl->edge_size << 1, tb_null, gb_mesh_edge_exit, (tb_cpointer_t)impl);
-        tb_assert_and_check_break(impl->pool);
+        // init arena
+        impl->arena = arena;
 
         // init head edge
         impl->head[0].sym = &impl->head[1];
@@ -319,10 +336,6 @@ tb_void_t gb_mesh_edge_list_exit(gb_mesh_edge_list_ref_t list)
     // clear it first
     gb_mesh_edge_list_clear(list);
 
-    // exit pool
-    if (impl->pool) tb_fixed_pool_exit(impl->pool);
-    impl->pool = tb_null;
-
     // exit it
     tb_free(impl);
 }
@@ -332,8 +345,20 @@ tb_void_t gb_mesh_edge_list_clear(gb_mesh_edge_list_ref_t list)
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
     tb_assert_and_check_return(impl);
    
-    // clear pool
-    if (impl->pool) tb_fixed_pool_clear(impl->pool);
+    // exit the user data of all edges
+    gb_mesh_edge_ref_t edge = impl->head->next;
+    while (edge != impl->head)
+    {
+        gb_mesh_edge_exit(impl, edge);
+        edge = edge->next;
+    }
+
+    /* clear the free edges and the edge count
+     *
+     * the storage will be reused after the arena is cleared by the mesh
+     */
+    impl->free = tb_null;
+    impl->size = 0;
 
     // clear list
     gb_mesh_edge_init(impl->head);
@@ -352,10 +377,10 @@ tb_size_t gb_mesh_edge_list_size(gb_mesh_edge_list_ref_t list)
 {
     // check
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, 0);
+    tb_assert_and_check_return_val(impl, 0);
 
     // the size
-    return tb_fixed_pool_size(impl->pool);
+    return impl->size;
 }
 tb_size_t gb_mesh_edge_list_maxn(gb_mesh_edge_list_ref_t list)
 {
@@ -366,10 +391,10 @@ gb_mesh_edge_ref_t gb_mesh_edge_list_make(gb_mesh_edge_list_ref_t list)
 {
     // check
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, tb_null);
+    tb_assert_and_check_return_val(impl && impl->arena, tb_null);
 
     // make it
-    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)tb_fixed_pool_malloc0(impl->pool);
+    gb_mesh_edge_ref_t edge = gb_mesh_edge_malloc0(impl);
     tb_assert_and_check_return_val(edge, tb_null);
 
     // the sym edge
@@ -414,10 +439,10 @@ gb_mesh_edge_ref_t gb_mesh_edge_list_make_loop(gb_mesh_edge_list_ref_t list, tb_
 {
     // check
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, tb_null);
+    tb_assert_and_check_return_val(impl && impl->arena, tb_null);
 
     // make it
-    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)tb_fixed_pool_malloc0(impl->pool);
+    gb_mesh_edge_ref_t edge = gb_mesh_edge_malloc0(impl);
     tb_assert_and_check_return_val(edge, tb_null);
 
     // the sym edge
@@ -483,7 +508,7 @@ tb_void_t gb_mesh_edge_list_kill(gb_mesh_edge_list_ref_t list, gb_mesh_edge_ref_
 {
     // check
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
-    tb_assert_and_check_return(impl && impl->pool && edge);
+    tb_assert_and_check_return(impl && impl->arena && edge);
 
     // make sure the edge points to the first half-edge
     if (edge->sym < edge) edge = edge->sym;
@@ -500,8 +525,16 @@ tb_void_t gb_mesh_edge_list_kill(gb_mesh_edge_list_ref_t list, gb_mesh_edge_ref_
     // remove it from the list
     gb_mesh_edge_remove_done(edge);
 
-    // exit it
-    tb_fixed_pool_free(impl->pool, edge);
+    // exit the user data
+    gb_mesh_edge_exit(impl, edge);
+
+    // put it to the free edges
+    edge->next = impl->free;
+    impl->free = edge;
+
+    // update the edge count
+    tb_assert(impl->size);
+    impl->size--;
 }
 tb_cpointer_t gb_mesh_edge_list_data(gb_mesh_edge_list_ref_t list, gb_mesh_edge_ref_t edge)
 {
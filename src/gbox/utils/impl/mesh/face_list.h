@@ -30,6 +30,7 @@
  * includes
  */
 #include "prefix.h"
+#include "arena.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -49,11 +50,12 @@ typedef struct{}*           gb_mesh_face_list_ref_t;
 
 /* init the mesh face list 
  *
+ * @param arena             the arena for carving the faces
  * @param element           the element
  *
  * @return                  the face list
  */
-gb_mesh_face_list_ref_t     gb_mesh_face_list_init(tb_element_t element);
+gb_mesh_face_list_ref_t     gb_mesh_face_list_init(gb_mesh_arena_ref_t arena, tb_element_t element);
 
 /* exit the mesh face list
  *
@@ -38,13 +38,6 @@
  * macros
  */
 
-// the mesh vertex list grow
-#ifdef __tb_small__ 
-#   define GB_MESH_VERTEX_LIST_GROW                 (128)
-#else
-#   define GB_MESH_VERTEX_LIST_GROW                 (256)
-#endif
-
 // the mesh vertex list maxn
 #ifdef __tb_small__
 #   define GB_MESH_VERTEX_LIST_MAXN                 (1 << 16)
@@ -62,8 +55,14 @@
 // the mesh vertex list impl type
 typedef struct __gb_mesh_vertex_list_impl_t
 {
-    // the pool
-    tb_fixed_pool_ref_t         pool;
+    // the arena
+    gb_mesh_arena_ref_t         arena;
+
+    // the free vertices
+    gb_mesh_vertex_ref_t        free;
+
+    // the vertex count
+    tb_size_t                   size;
 
     // the head
     tb_list_entry_head_t        head;
@@ -84,23 +83,42 @@ typedef struct __gb_mesh_vertex_list_impl_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_void_t gb_mesh_vertex_exit(tb_pointer_t data, tb_cpointer_t priv)
+static tb_void_t gb_mesh_vertex_exit(gb_mesh_vertex_list_impl_t* impl, gb_mesh_vertex_ref_t vertex)
 {
     // check
-    gb_mesh_vertex_list_impl_t* impl = (gb_mesh_vertex_list_impl_t*)priv;
-    tb_assert_and_check_return(impl && data);
+    tb_assert_and_check_return(impl && vertex);
 
     // exit the user data
-    impl->element.free(&impl->element, (tb_pointer_t)((gb_mesh_vertex_ref_t)data + 1));
+    impl->element.free(&impl->element, (tb_pointer_t)(vertex + 1));
+}
+static gb_mesh_vertex_ref_t gb_mesh_vertex_malloc0(gb_mesh_vertex_list_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->arena);
+
+    // reuse a free vertex first, otherwise carve it from the arena, item = vertex + data
+    gb_mesh_vertex_ref_t vertex = impl->free;
+    if (vertex) impl->free = (gb_mesh_vertex_ref_t)vertex->entry.next;
+    else vertex = (gb_mesh_vertex_ref_t)gb_mesh_arena_malloc(impl->arena, sizeof(gb_mesh_vertex_t) + impl->element.size);
+    tb_assert_and_check_return_val(vertex, tb_null);
+
+    // clear it
+    tb_memset(vertex, 0, sizeof(gb_mesh_vertex_t) + impl->element.size);
+
+    // update the vertex count
+    impl->size++;
+
+    // ok
+    return vertex;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-gb_mesh_vertex_list_ref_t gb_mesh_vertex_list_init(tb_element_t element)
+gb_mesh_vertex_list_ref_t gb_mesh_vertex_list_init(gb_mesh_arena_ref_t arena, tb_element_t element)
 {
     // check
-    tb_assert_and_check_return_val(element.data && element.dupl && element.repl, tb_null);
+    tb_assert_and_check_return_val(arena && element.data && element.dupl && element.repl, tb_null);
 
     // done
     tb_bool_t                       ok = tb_false;
@@ -114,9 +132,8 @@ gb_mesh_vertex_list_ref_t gb_mesh_vertex_list_init(tb_element_t element)
         // init element
         impl->element = element;
 
-        // init pool, item = vertex + data
-        impl->pool = tb_fixed_pool_init(tb_null, GB_MESH_VERTEX_LIST_GROW, sizeof(gb_mesh_vertex_t) + element.size, tb_null, gb_mesh_vertex_exit, (tb_cpointer_t)impl);
-        tb_assert_and_check_break(impl->pool);
+        // init arena
+        impl->arena = arena;
 
         // init head
         tb_list_entry_init_(&impl->head, 0, sizeof(gb_mesh_vertex_t) + element.size, tb_null);
@@ -149,10 +166,6 @@ tb_void_t gb_mesh_vertex_list_exit(gb_mesh_vertex_list_ref_t list)
     // clear it first
     gb_mesh_vertex_list_clear(list);
 
-    // exit pool
-    if (impl->pool) tb_fixed_pool_exit(impl->pool);
-    impl->pool = tb_null;
-
     // exit it
     tb_free(impl);
 }
@@ -162,8 +175,18 @@ tb_void_t gb_mesh_vertex_list_clear(gb_mesh_vertex_list_ref_t list)
     gb_mesh_vertex_list_impl_t* impl = (gb_mesh_vertex_list_impl_t*)list;
     tb_assert_and_check_return(impl);
    
-    // clear pool
-    if (impl->pool) tb_fixed_pool_clear(impl->pool);
+    // exit the user data of all vertices
+    tb_for_all_if (gb_mesh_vertex_ref_t, vertex, tb_list_entry_itor(&impl->head), vertex)
+    {
+        gb_mesh_vertex_exit(impl, vertex);
+    }
+
+    /* clear the free vertices and the vertex count
+     *
+     * the storage will be reused after the arena is cleared by the mesh
+     */
+    impl->free = tb_null;
+    impl->size = 0;
 
     // clear head
     tb_list_entry_clear(&impl->head);
@@ -186,8 +209,8 @@ tb_size_t gb_mesh_vertex_list_size(gb_mesh_vertex_list_ref_t list)
 {
     // check
     gb_mesh_vertex_list_impl_t* impl = (gb_mesh_vertex_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, 0);
-    tb_assert(tb_list_entry_size(&impl->head) == tb_fixed_pool_size(impl->pool));
+    tb_assert_and_check_return_val(impl, 0);
+    tb_assert(tb_list_entry_size(&impl->head) == impl->size);
 
     // the size
     return tb_list_entry_size(&impl->head);
@@ -201,10 +224,10 @@ gb_mesh_vertex_ref_t gb_mesh_vertex_list_make(gb_mesh_vertex_list_ref_t list)
 {
     // check
     gb_mesh_vertex_list_impl_t* impl = (gb_mesh_vertex_list_impl_t*)list;
-    tb_assert_and_check_return_val(impl && impl->pool, tb_null);
+    tb_assert_and_check_return_val(impl && impl->arena, tb_null);
 
     // make it
-    gb_mesh_vertex_ref_t vertex = (gb_mesh_vertex_ref_t)tb_fixed_pool_malloc0(impl->pool);
+    gb_mesh_vertex_ref_t vertex = gb_mesh_vertex_malloc0(impl);
     tb_assert_and_check_return_val(vertex, tb_null);
 
 #ifdef __gb_debug__
@@ -247,7 +270,7 @@ tb_void_t gb_mesh_vertex_list_kill(gb_mesh_vertex_list_ref_t list, gb_mesh_verte
 {
     // check
     gb_mesh_vertex_list_impl_t* impl = (gb_mesh_vertex_list_impl_t*)list;
-    tb_assert_and_check_return(impl && impl->pool && vertex);
+    tb_assert_and_check_return(impl && impl->arena && vertex);
 
 #ifdef __gb_debug__
     // check
@@ -260,8 +283,16 @@ tb_void_t gb_mesh_vertex_list_kill(gb_mesh_vertex_list_ref_t list, gb_mesh_verte
     // remove from the vertex list
     tb_list_entry_remove(&impl->head, &vertex->entry);
 
-    // exit it
-    tb_fixed_pool_free(impl->pool, vertex);
+    // exit the user data
+    gb_mesh_vertex_exit(impl, vertex);
+
+    // put it to the free vertices
+    vertex->entry.next = (tb_list_entry_ref_t)impl->free;
+    impl->free = vertex;
+
+    // update the vertex count
+    tb_assert(impl->size);
+    impl->size--;
 }
 tb_cpointer_t gb_mesh_vertex_list_data(gb_mesh_vertex_list_ref_t list, gb_mesh_vertex_ref_t vertex)
 {
@@ -30,6 +30,7 @@
  * includes
  */
 #include "prefix.h"
+#include "arena.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -53,11 +54,12 @@ typedef struct{}*           gb_mesh_vertex_list_ref_t;
 
 /* init the mesh vertex list 
  *
+ * @param arena             the arena for carving the vertices
  * @param element           the element
  *
  * @returned                the vertex list
  */
-gb_mesh_vertex_list_ref_t   gb_mesh_vertex_list_init(tb_element_t element);
+gb_mesh_vertex_list_ref_t   gb_mesh_vertex_list_init(gb_mesh_arena_ref_t arena, tb_element_t element);
 
 /* exit the mesh vertex list
  *
@@ -245,6 +245,166 @@ static tb_long_t gb_tessellator_active_region_printf(tb_cpointer_t object, tb_ch
                     ,   region->inside);
 }
 #endif
+/* rotate the given region up to the position of its parent in the search tree
+ *
+ *        parent              region
+ *        /    \              /    \
+ *     region   c    =>      a    parent
+ *     /    \                      /   \
+ *    a      b                    b     c
+ */
+static tb_void_t gb_tessellator_active_regions_tree_rotate(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
+{
+    // check
+    tb_assert(impl && region && region->parent);
+
+    // the parent and grandparent
+    gb_tessellator_active_region_ref_t parent       = region->parent;
+    gb_tessellator_active_region_ref_t grandparent  = parent->parent;
+
+    // rotate right?
+    if (parent->lchild == region)
+    {
+        parent->lchild = region->rchild;
+        if (region->rchild) region->rchild->parent = parent;
+        region->rchild = parent;
+    }
+    // rotate left
+    else
+    {
+        tb_assert(parent->rchild == region);
+        parent->rchild = region->lchild;
+        if (region->lchild) region->lchild->parent = parent;
+        region->lchild = parent;
+    }
+    parent->parent = region;
+    region->parent = grandparent;
+
+    // update the child of the grandparent
+    if (!grandparent) impl->active_regions_root = region;
+    else if (grandparent->lchild == parent) grandparent->lchild = region;
+    else grandparent->rchild = region;
+}
+/* insert the new region into the search tree after its previous region in the list
+ *
+ * the in-order sequence of the tree is always same as the active regions list,
+ * so we need not compare regions here.
+ */
+static tb_void_t gb_tessellator_active_regions_tree_insert(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_prev, gb_tessellator_active_region_ref_t region)
+{
+    // check
+    tb_assert(impl && region);
+
+    // init the tree node, the priority is generated by xorshift
+    tb_uint32_t seed = impl->active_regions_seed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    impl->active_regions_seed   = seed;
+    region->priority            = seed;
+    region->parent              = tb_null;
+    region->lchild              = tb_null;
+    region->rchild              = tb_null;
+
+    // the first region?
+    if (!impl->active_regions_root)
+    {
+        impl->active_regions_root = region;
+        return ;
+    }
+
+    /* attach it to the leftmost position of the right subtree of the previous region
+     * or to the leftmost position of the whole tree if no previous region
+     */
+    gb_tessellator_active_region_ref_t parent = tb_null;
+    if (region_prev && !region_prev->rchild)
+    {
+        parent = region_prev;
+        parent->rchild = region;
+    }
+    else
+    {
+        parent = region_prev? region_prev->rchild : impl->active_regions_root;
+        while (parent->lchild) parent = parent->lchild;
+        parent->lchild = region;
+    }
+    region->parent = parent;
+
+    // rotate it up to keep the heap order of the priorities
+    while (region->parent && region->parent->priority < region->priority)
+        gb_tessellator_active_regions_tree_rotate(impl, region);
+}
+// remove the given region from the search tree
+static tb_void_t gb_tessellator_active_regions_tree_remove(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
+{
+    // check
+    tb_assert(impl && region);
+
+    // rotate it down until it has only one child at most
+    while (region->lchild && region->rchild)
+    {
+        gb_tessellator_active_regions_tree_rotate(impl, (region->lchild->priority > region->rchild->priority)? region->lchild : region->rchild);
+    }
+
+    // splice it
+    gb_tessellator_active_region_ref_t child = region->lchild? region->lchild : region->rchild;
+    if (child) child->parent = region->parent;
+    if (!region->parent) impl->active_regions_root = child;
+    else if (region->parent->lchild == region) region->parent->lchild = child;
+    else region->parent->rchild = child;
+
+    // clear it
+    region->parent = tb_null;
+    region->lchild = tb_null;
+    region->rchild = tb_null;
+}
+/* find the last region which is in the left of the given region (region_last <= region) from the search tree
+ *
+ * the regions are sorted, so we need only O(log(n)) comparisons
+ */
+static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_tree_find(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
+{
+    // check
+    tb_assert(impl && region);
+
+    // done
+    gb_tessellator_active_region_ref_t found = tb_null;
+    gb_tessellator_active_region_ref_t node  = impl->active_regions_root;
+    while (node)
+    {
+        // node <= region? find it in the right subtree
+        if (gb_tessellator_active_region_leq(node, region))
+        {
+            found   = node;
+            node    = node->rchild;
+        }
+        // find it in the left subtree
+        else node = node->lchild;
+    }
+
+    // ok?
+    return found;
+}
+#ifdef __gb_debug__
+// get the next region of the given region in the search tree
+static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_tree_next(gb_tessellator_active_region_ref_t region)
+{
+    // check
+    tb_assert(region);
+
+    // the leftmost region of the right subtree
+    if (region->rchild)
+    {
+        region = region->rchild;
+        while (region->lchild) region = region->lchild;
+        return region;
+    }
+
+    // the first ancestor which contains it in the left subtree
+    while (region->parent && region->parent->rchild == region) region = region->parent;
+    return region->parent;
+}
+#endif
 /* insert region in ascending order and save the region position
  *
  * r0 ----> r1 ------> r2 -------> r3 ---> ... ---->
@@ -264,7 +424,7 @@ static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_d
     // trace
     tb_trace_d("insert: %{mesh_edge}", region->edge);
 
-    // reverse to find the inserted position
+    // find the inserted position
     tb_size_t itor = tb_find_if(impl->active_regions, prev, tb_iterator_tail(impl->active_regions), tb_predicate_beq, region);
 
     // trace
@@ -281,6 +441,9 @@ static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_d
     // save the region position
     region->position = itor;
 
+    // insert it to the search tree after the previous region 
+    gb_tessellator_active_regions_tree_insert(impl, gb_tessellator_active_regions_left(impl, region), region);
+
     // save the region reference to the edge
     gb_tessellator_edge_region_set(region->edge, region);
 
@@ -317,6 +480,7 @@ static tb_void_t gb_tessellator_active_regions_insert_bounds(gb_tessellator_impl
     gb_tessellator_active_region_t region;
     region.edge     = edge;
     region.winding  = 0;
+    region.dirty    = 0;
     region.inside   = 0;
     region.fixedge  = 0;
     region.bounds   = 1;
@@ -350,7 +514,9 @@ static tb_void_t gb_tessellator_active_regions_test_insert(gb_tessellator_impl_t
     gb_tessellator_active_region_t region;
     region.edge     = edge;
     region.winding  = 0;
+    region.dirty    = 0;
     region.inside   = 0;
+    region.fixedge  = 0;
     region.bounds   = 1;
 
     // insert region
@@ -440,6 +606,10 @@ tb_bool_t gb_tessellator_active_regions_make(gb_tessellator_impl_t* impl, gb_rec
     // clear active regions first
     tb_list_clear(impl->active_regions);
 
+    // clear the search tree
+    impl->active_regions_root = tb_null;
+    impl->active_regions_seed = 2463534242ul;
+
     /* insert two regions for the bounds to avoid special cases
      *
      * their coordinates are big enough that they will never be merged with real input features.
@@ -477,7 +647,7 @@ gb_tessellator_active_region_ref_t gb_tessellator_active_regions_find(gb_tessell
     // the edge must go up
     tb_assertf(gb_tessellator_edge_go_up(edge), "%{mesh_edge}", edge);
 
-    /* reverse to find the region containing the given edge from the regions
+    /* find the region containing the given edge from the regions
      *
      * region.edge
      * |
@@ -489,14 +659,11 @@ gb_tessellator_active_region_ref_t gb_tessellator_active_regions_find(gb_tessell
      * .       .        . region2  .
      * .     . edge     .
      *          |
-     *        found                <= find direction
-     *
+     *        found
      *
+     * it is the last region with region.edge <= edge, we find it from the search tree
      */
-    tb_size_t itor = tb_rfind_all_if(impl->active_regions, tb_predicate_le, &region_temp);
-
-    // get the found item
-    return (itor != tb_iterator_tail(impl->active_regions))? (gb_tessellator_active_region_ref_t)tb_iterator_item(impl->active_regions, itor) : tb_null;
+    return gb_tessellator_active_regions_tree_find(impl, &region_temp);
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_left(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
@@ -545,16 +712,22 @@ tb_void_t gb_tessellator_active_regions_remove(gb_tessellator_impl_t* impl, gb_t
     // clear the region reference for the edge
     gb_tessellator_edge_region_set(region->edge, tb_null);
 
+    // remove it from the search tree
+    gb_tessellator_active_regions_tree_remove(impl, region);
+
     // remove it
     tb_list_remove(impl->active_regions, region->position);
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions && region);
+    tb_assert(impl && impl->active_regions && region && region->edge);
+
+    // find the last region which is in the left of it from the search tree
+    gb_tessellator_active_region_ref_t region_prev = gb_tessellator_active_regions_tree_find(impl, region);
 
     // insert it
-    return gb_tessellator_active_regions_insert_done(impl, tb_iterator_head(impl->active_regions), region);
+    return gb_tessellator_active_regions_insert_done(impl, region_prev? region_prev->position : tb_iterator_head(impl->active_regions), region);
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_after(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_prev, gb_tessellator_active_region_ref_t region)
 {
@@ -605,9 +778,16 @@ tb_void_t gb_tessellator_active_regions_check(gb_tessellator_impl_t* impl)
         // the edge must go up
         tb_assertf(gb_tessellator_edge_go_up(region->edge), "%{mesh_edge}", region->edge);
 
+        // check the search tree
+        tb_assert(region_prev? gb_tessellator_active_regions_tree_next(region_prev) == region : !region->parent || region->parent->lchild == region);
+        tb_assert(!region->parent || region->parent->priority >= region->priority);
+
         // update the previous region
         region_prev = region;
     }
+
+    // the last region must be the last node of the search tree
+    tb_assert(!region_prev || !gb_tessellator_active_regions_tree_next(region_prev));
 }
 #endif
 
@@ -38,21 +38,25 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_long_t gb_tessellator_event_queue_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+static __tb_inline__ tb_long_t gb_tessellator_event_comp(gb_mesh_vertex_ref_t lvertex, gb_mesh_vertex_ref_t rvertex)
 {
 #if 0
     // lvertex <= rvertex ? -1 : 1
-    return (!gb_tessellator_vertex_leq((gb_mesh_vertex_ref_t)ldata, (gb_mesh_vertex_ref_t)rdata) << 1) - 1;
+    return (!gb_tessellator_vertex_leq(lvertex, rvertex) << 1) - 1;
 #else
     // the left and right point
-    gb_point_ref_t lpoint = gb_tessellator_vertex_point(ldata);
-    gb_point_ref_t rpoint = gb_tessellator_vertex_point(rdata);
+    gb_point_ref_t lpoint = gb_tessellator_vertex_point(lvertex);
+    gb_point_ref_t rpoint = gb_tessellator_vertex_point(rvertex);
     tb_assert(lpoint && rpoint);
 
     // lpoint < rpoint?
     return (lpoint->y < rpoint->y)? -1 : ((lpoint->y > rpoint->y)? 1 : ((lpoint->x < rpoint->x)? -1 : (lpoint->x > rpoint->x)));
 #endif
 }
+static tb_long_t gb_tessellator_event_queue_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+{
+    return gb_tessellator_event_comp((gb_mesh_vertex_ref_t)ldata, (gb_mesh_vertex_ref_t)rdata);
+}
 static tb_bool_t gb_tessellator_event_queue_find(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
 {
     return item == value;
@@ -72,6 +76,170 @@ static tb_char_t const* gb_tessellator_event_queue_cstr(tb_element_ref_t element
     return cstr;
 }
 #endif
+// sift down the event at the given index for the heap sorting
+static tb_void_t gb_tessellator_event_list_sift(gb_mesh_vertex_ref_t* events, tb_size_t index, tb_size_t size)
+{
+    gb_mesh_vertex_ref_t event = events[index];
+    tb_size_t            child = (index << 1) + 1;
+    while (child < size)
+    {
+        // select the larger child
+        if (child + 1 < size && gb_tessellator_event_comp(events[child], events[child + 1]) < 0) child++;
+
+        // ok?
+        tb_check_break(gb_tessellator_event_comp(event, events[child]) < 0);
+
+        // move the child up
+        events[index] = events[child];
+        index = child;
+        child = (index << 1) + 1;
+    }
+    events[index] = event;
+}
+/* sort the events in [head, tail) by the introsort
+ *
+ * the vertices come in the contour order and the quick sort of tbox degrades badly for them,
+ * so we use the median-of-three partition and fall back to the heap sort if it goes too deep.
+ */
+static tb_void_t gb_tessellator_event_list_sort(gb_mesh_vertex_ref_t* events, tb_size_t head, tb_size_t tail, tb_size_t depth)
+{
+    // sort the large range by partitioning
+    gb_mesh_vertex_ref_t event;
+    while (tail - head > 16)
+    {
+        // too deep? sort it by the heap sort
+        if (!depth)
+        {
+            tb_size_t size = tail - head;
+            tb_size_t index = size >> 1;
+            while (index--) gb_tessellator_event_list_sift(events + head, index, size);
+            while (--size)
+            {
+                event = events[head]; events[head] = events[head + size]; events[head + size] = event;
+                gb_tessellator_event_list_sift(events + head, 0, size);
+            }
+            return ;
+        }
+        depth--;
+
+        // sort the head, middle and last events and use the middle one as the pivot
+        tb_size_t middle = head + ((tail - head) >> 1);
+        tb_size_t last = tail - 1;
+        if (gb_tessellator_event_comp(events[middle], events[head]) < 0) { event = events[middle]; events[middle] = events[head]; events[head] = event; }
+        if (gb_tessellator_event_comp(events[last], events[middle]) < 0) 
+        { 
+            event = events[last]; events[last] = events[middle]; events[middle] = event; 
+            if (gb_tessellator_event_comp(events[middle], events[head]) < 0) { event = events[middle]; events[middle] = events[head]; events[head] = event; }
+        }
+        gb_mesh_vertex_ref_t pivot = events[middle];
+
+        // partition it
+        tb_size_t i = head;
+        tb_size_t j = last;
+        while (1)
+        {
+            while (gb_tessellator_event_comp(events[i], pivot) < 0) i++;
+            while (gb_tessellator_event_comp(pivot, events[j]) < 0) j--;
+            if (i >= j) break;
+            event = events[i]; events[i] = events[j]; events[j] = event;
+            i++;
+            j--;
+        }
+
+        // sort the smaller part recursively and continue to sort the larger part
+        if (j + 1 - head < tail - j - 1)
+        {
+            gb_tessellator_event_list_sort(events, head, j + 1, depth);
+            head = j + 1;
+        }
+        else
+        {
+            gb_tessellator_event_list_sort(events, j + 1, tail, depth);
+            tail = j + 1;
+        }
+    }
+
+    // sort the small range by the insertion sort
+    tb_size_t i;
+    for (i = head + 1; i < tail; i++)
+    {
+        tb_size_t j = i;
+        event = events[i];
+        while (j > head && gb_tessellator_event_comp(event, events[j - 1]) < 0)
+        {
+            events[j] = events[j - 1];
+            j--;
+        }
+        events[j] = event;
+    }
+}
+// get the head event of the sorted event list and skip all removed events
+static gb_mesh_vertex_ref_t gb_tessellator_event_list_head(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->event_list);
+
+    // the events
+    gb_mesh_vertex_ref_t*   events = impl->event_list;
+    tb_size_t               size = impl->event_list_size;
+
+    // skip the removed events
+    while (impl->event_list_head < size && !events[impl->event_list_head]) impl->event_list_head++;
+
+    // ok?
+    return impl->event_list_head < size? events[impl->event_list_head] : tb_null;
+}
+// remove the given event from the sorted event list
+static tb_bool_t gb_tessellator_event_list_remove(gb_tessellator_impl_t* impl, gb_mesh_vertex_ref_t event)
+{
+    // check
+    tb_assert(impl && impl->event_list && event);
+
+    // the events
+    gb_mesh_vertex_ref_t*   events = impl->event_list;
+    tb_size_t               size = impl->event_list_size;
+
+    /* find the first event which is not less than the given event by the binary searching
+     *
+     * we cannot compare the removed events, so skip them to the right first
+     */
+    tb_size_t head = impl->event_list_head;
+    tb_size_t tail = size;
+    while (head < tail)
+    {
+        // the middle event
+        tb_size_t middle = head + ((tail - head) >> 1);
+        tb_size_t itor = middle;
+        while (itor < tail && !events[itor]) itor++;
+
+        // all removed in the right half?
+        if (itor == tail) tail = middle;
+        // events[itor] < event? find it in the right half
+        else if (gb_tessellator_event_comp(events[itor], event) < 0) head = itor + 1;
+        // find it in the left half
+        else tail = middle;
+    }
+
+    // find it from all events at the same position
+    for (; head < size; head++)
+    {
+        // removed?
+        if (!events[head]) continue;
+
+        // found? remove it
+        if (events[head] == event)
+        {
+            events[head] = tb_null;
+            return tb_true;
+        }
+
+        // not the same position?
+        if (gb_tessellator_event_comp(events[head], event)) break;
+    }
+
+    // not found
+    return tb_false;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -107,15 +275,75 @@ tb_bool_t gb_tessellator_event_queue_make(gb_tessellator_impl_t* impl)
     // clear event queue first
     tb_priority_queue_clear(impl->event_queue);
 
-    // done
+    // the vertex count
+    tb_size_t size = tb_iterator_size(gb_mesh_vertex_itor(mesh));
+    tb_check_return_val(size, tb_false);
+
+    /* init event list 
+     *
+     * we use the plain array instead of tb_vector_t, because the vertices of the mesh may be more than its maximum size
+     */
+    if (!impl->event_list || size > impl->event_list_maxn)
+    {
+        // exit the old event list
+        if (impl->event_list) tb_free(impl->event_list);
+
+        // make a new event list
+        impl->event_list_maxn   = tb_align8(size + 256);
+        impl->event_list        = tb_nalloc_type(impl->event_list_maxn, gb_mesh_vertex_ref_t);
+    }
+    tb_assert_and_check_return_val(impl->event_list, tb_false);
+
+    // put all vertex events to the list
+    tb_size_t               index = 0;
+    gb_mesh_vertex_ref_t*   events = impl->event_list;
     tb_for_all_if (gb_mesh_vertex_ref_t, vertex, gb_mesh_vertex_itor(mesh), vertex)
     {
-        // put vertex event to the queue
-        tb_priority_queue_put(impl->event_queue, vertex);
+        tb_assert(index < size);
+        events[index++] = vertex;
     }
+    tb_assert(index == size);
+    impl->event_list_head = 0;
+    impl->event_list_size = index;
+
+    /* sort all events only once
+     *
+     * only the new intersection vertices need be inserted to the event queue when sweeping, 
+     * so it is faster than putting all vertices to the priority queue one by one.
+     */
+    gb_tessellator_event_list_sort(events, 0, index, tb_ilog2i((tb_uint32_t)index) << 1);
 
     // ok
-    return tb_priority_queue_size(impl->event_queue);
+    return tb_true;
+}
+gb_mesh_vertex_ref_t gb_tessellator_event_queue_get(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->event_queue && impl->event_list);
+
+    // the head event of the sorted list
+    gb_mesh_vertex_ref_t event = gb_tessellator_event_list_head(impl);
+
+    // the minimum event of the queue
+    gb_mesh_vertex_ref_t event_queue = tb_priority_queue_size(impl->event_queue)? (gb_mesh_vertex_ref_t)tb_priority_queue_get(impl->event_queue) : tb_null;
+
+    // get the minimum event of them
+    return (event && (!event_queue || gb_tessellator_event_comp(event, event_queue) <= 0))? event : event_queue;
+}
+tb_void_t gb_tessellator_event_queue_pop(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->event_queue && impl->event_list);
+
+    // the head event of the sorted list
+    gb_mesh_vertex_ref_t event = gb_tessellator_event_list_head(impl);
+
+    // the minimum event of the queue
+    gb_mesh_vertex_ref_t event_queue = tb_priority_queue_size(impl->event_queue)? (gb_mesh_vertex_ref_t)tb_priority_queue_get(impl->event_queue) : tb_null;
+
+    // pop the minimum event of them
+    if (event && (!event_queue || gb_tessellator_event_comp(event, event_queue) <= 0)) impl->event_list_head++;
+    else if (event_queue) tb_priority_queue_pop(impl->event_queue);
 }
 tb_void_t gb_tessellator_event_queue_insert(gb_tessellator_impl_t* impl, gb_mesh_vertex_ref_t event)
 {
@@ -128,9 +356,12 @@ tb_void_t gb_tessellator_event_queue_insert(gb_tessellator_impl_t* impl, gb_mesh
 tb_void_t gb_tessellator_event_queue_remove(gb_tessellator_impl_t* impl, gb_mesh_vertex_ref_t event)
 {
     // check
-    tb_assert(impl && impl->event_queue && event);
+    tb_assert(impl && impl->event_queue && impl->event_list && event);
+
+    // remove it from the sorted event list first
+    if (gb_tessellator_event_list_remove(impl, event)) return ;
 
-    // find it
+    // find it from the event queue
     tb_size_t itor = tb_find_all_if(impl->event_queue, gb_tessellator_event_queue_find, event);
     if (itor != tb_iterator_tail(impl->event_queue))
     {
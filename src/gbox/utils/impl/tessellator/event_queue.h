@@ -47,6 +47,20 @@ __tb_extern_c_enter__
  */
 tb_bool_t           gb_tessellator_event_queue_make(gb_tessellator_impl_t* impl);
 
+/* get the minimum vertex event from queue
+ *
+ * @param impl      the tessellator impl
+ *
+ * @return          the vertex event, tb_null if the queue is empty
+ */
+gb_mesh_vertex_ref_t gb_tessellator_event_queue_get(gb_tessellator_impl_t* impl);
+
+/* pop the minimum vertex event from queue
+ *
+ * @param impl      the tessellator impl
+ */
+tb_void_t           gb_tessellator_event_queue_pop(gb_tessellator_impl_t* impl);
+
 /* insert the vertex event to queue
  *
  * @param impl      the tessellator impl
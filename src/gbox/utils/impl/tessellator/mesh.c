@@ -134,7 +134,7 @@ tb_bool_t gb_tessellator_mesh_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t
 
     // the points
     gb_point_ref_t      points = polygon->points;
-    tb_uint16_t const*  counts = polygon->counts;
+    tb_uint32_t const*  counts = polygon->counts;
     tb_assert_and_check_return_val(points && counts, tb_false);
 
     // not exists mesh?
@@ -177,7 +177,7 @@ tb_bool_t gb_tessellator_mesh_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t
 
     // done
     gb_point_ref_t      point       = tb_null;
-    tb_uint16_t         count       = *counts++;
+    tb_uint32_t         count       = *counts++;
     tb_size_t           index       = 0;
     gb_mesh_edge_ref_t  edge        = tb_null;
     gb_mesh_edge_ref_t  edge_first  = tb_null;
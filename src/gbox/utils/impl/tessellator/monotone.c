@@ -2583,6 +2583,7 @@ static gb_tessellator_active_region_ref_t gb_tessellator_insert_region_at_right(
     gb_tessellator_active_region_t region;
     region.edge     = edge_new;
     region.winding  = 0;
+    region.dirty    = 0;
     region.inside   = 0;
     region.bounds   = 0;
     region.fixedge  = 0;
@@ -4377,32 +4378,22 @@ tb_void_t gb_tessellator_monotone_make(gb_tessellator_impl_t* impl, gb_rect_ref_
     // make active regions
     if (!gb_tessellator_active_regions_make(impl, bounds)) return ;
 
-    // the event queue
-    tb_priority_queue_ref_t event_queue = impl->event_queue;
-    tb_assert(event_queue);
-
     // done
-    while (tb_priority_queue_size(event_queue))
+    gb_mesh_vertex_ref_t event = tb_null;
+    while ((event = gb_tessellator_event_queue_get(impl)))
     {
-        // get the minimum vertex event
-        gb_mesh_vertex_ref_t event = (gb_mesh_vertex_ref_t)tb_priority_queue_get(event_queue);
-        tb_assert(event);
-
         // pop it from the event queue first
-        tb_priority_queue_pop(event_queue);
+        gb_tessellator_event_queue_pop(impl);
 
         // attempt to merge all vertices at same position as mush as possible
-        while (tb_priority_queue_size(event_queue))
+        gb_mesh_vertex_ref_t event_next = tb_null;
+        while ((event_next = gb_tessellator_event_queue_get(impl)))
         {
-            // get the next vertex event
-            gb_mesh_vertex_ref_t event_next = (gb_mesh_vertex_ref_t)tb_priority_queue_get(event_queue);
-            tb_assert(event_next);
-
             // two vertices are exactly same?
             tb_check_break(gb_tessellator_vertex_eq(event, event_next));
 
             // pop the next event from the event queue
-            tb_priority_queue_pop(event_queue);
+            gb_tessellator_event_queue_pop(impl);
 
             // trace
             tb_trace_d("event: merge: %{point}", gb_tessellator_vertex_point(event));
@@ -106,6 +106,18 @@ typedef struct __gb_tessellator_active_region_t
     // the region position
     tb_size_t                           position;
 
+    // the parent region in the search tree
+    struct __gb_tessellator_active_region_t*    parent;
+
+    // the left child region in the search tree
+    struct __gb_tessellator_active_region_t*    lchild;
+
+    // the right child region in the search tree
+    struct __gb_tessellator_active_region_t*    rchild;
+
+    // the random priority in the search tree
+    tb_uint32_t                         priority;
+
     // the left edge and it goes up
     gb_mesh_edge_ref_t                  edge;
 
@@ -180,12 +192,37 @@ typedef struct __gb_tessellator_impl_t
     // the output points
     tb_vector_ref_t                     outputs;
 
-    // the event queue for vertex
+    /* the event queue for the new intersection vertices
+     *
+     * the initial vertices are sorted into the event list,
+     * only the vertices created by sweeping need be inserted to this queue.
+     */
     tb_priority_queue_ref_t             event_queue;
 
+    // the sorted event list for the initial vertices, the removed events are null
+    gb_mesh_vertex_ref_t*               event_list;
+
+    // the head index of the sorted event list
+    tb_size_t                           event_list_head;
+
+    // the size of the sorted event list
+    tb_size_t                           event_list_size;
+
+    // the maximum size of the sorted event list
+    tb_size_t                           event_list_maxn;
+
     // the active regions
     tb_list_ref_t                       active_regions;
 
+    /* the root of the search tree for the active regions
+     *
+     * it is a treap with the same order as the active regions list
+     */
+    gb_tessellator_active_region_ref_t  active_regions_root;
+
+    // the random seed of the treap priority
+    tb_uint32_t                         active_regions_seed;
+
 }gb_tessellator_impl_t;
 
 #endif
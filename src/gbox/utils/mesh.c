@@ -33,6 +33,13 @@
  * macros
  */
 
+// the mesh arena chunk size
+#ifdef __gb_small__
+#   define GB_MESH_ARENA_CHUNK_SIZE             (16384)
+#else
+#   define GB_MESH_ARENA_CHUNK_SIZE             (65536)
+#endif
+
 // set the face edge
 #define gb_mesh_face_edge_set(face, val)        do { tb_assert(face); (face)->edge = (val); } while (0)
 
@@ -96,6 +103,9 @@
 // the mesh impl type 
 typedef struct __gb_mesh_impl_t
 {
+    // the arena for all edges, faces and vertices
+    gb_mesh_arena_ref_t             arena;
+
     // the edges
     gb_mesh_edge_list_ref_t         edges;
 
@@ -446,16 +456,20 @@ gb_mesh_ref_t gb_mesh_init(tb_element_t edge_element, tb_element_t face_element,
         impl = tb_malloc0_type(gb_mesh_impl_t);
         tb_assert_and_check_break(impl);
     
+        // init arena
+        impl->arena = gb_mesh_arena_init(GB_MESH_ARENA_CHUNK_SIZE);
+        tb_assert_and_check_break(impl->arena);
+
         // init edges
-        impl->edges = gb_mesh_edge_list_init(edge_element);
+        impl->edges = gb_mesh_edge_list_init(impl->arena, edge_element);
         tb_assert_and_check_break(impl->edges);
   
         // init faces
-        impl->faces = gb_mesh_face_list_init(face_element);
+        impl->faces = gb_mesh_face_list_init(impl->arena, face_element);
         tb_assert_and_check_break(impl->faces);
 
         // init vertices
-        impl->vertices = gb_mesh_vertex_list_init(vertex_element);
+        impl->vertices = gb_mesh_vertex_list_init(impl->arena, vertex_element);
         tb_assert_and_check_break(impl->vertices);
 
 #ifdef __gb_debug__
@@ -510,6 +524,10 @@ tb_void_t gb_mesh_exit(gb_mesh_ref_t mesh)
     if (impl->vertices) gb_mesh_vertex_list_exit(impl->vertices);
     impl->vertices = tb_null;
 
+    // exit arena
+    if (impl->arena) gb_mesh_arena_exit(impl->arena);
+    impl->arena = tb_null;
+
     // exit it
     tb_free(impl);
 }
@@ -527,6 +545,9 @@ tb_void_t gb_mesh_clear(gb_mesh_ref_t mesh)
 
     // clear vertices
     if (impl->vertices) gb_mesh_vertex_list_clear(impl->vertices);
+
+    // clear arena and reuse all storage of the edges, faces and vertices
+    if (impl->arena) gb_mesh_arena_clear(impl->arena);
 }
 tb_bool_t gb_mesh_is_empty(gb_mesh_ref_t mesh)
 {
@@ -34,6 +34,7 @@
  */
 #include "tessellator.h"
 #include "impl/tessellator/tessellator.h"
+#include "../core/impl/stats.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -102,7 +103,7 @@ static tb_void_t gb_tessellator_done_output(gb_tessellator_impl_t* impl)
                 tb_vector_insert_tail(outputs, point_first);
 
                 // done it
-                impl->func((gb_point_ref_t)tb_vector_data(outputs), (tb_uint16_t)tb_vector_size(outputs), impl->priv);
+                impl->func((gb_point_ref_t)tb_vector_data(outputs), tb_vector_size(outputs), impl->priv);
             }
         }
     }
@@ -199,6 +200,10 @@ tb_void_t gb_tessellator_exit(gb_tessellator_ref_t tessellator)
     if (impl->event_queue) tb_priority_queue_exit(impl->event_queue);
     impl->event_queue = tb_null;
 
+    // exit event list
+    if (impl->event_list) tb_free(impl->event_list);
+    impl->event_list = tb_null;
+
     // exit active regions
     if (impl->active_regions) tb_list_exit(impl->active_regions);
     impl->active_regions = tb_null;
@@ -240,14 +245,17 @@ tb_void_t gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t
     gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
     tb_assert_and_check_return(impl && impl->func && polygon && polygon->points && polygon->counts && bounds);
 
+    // enter the stats
+    gb_stats_enter();
+
     // is convex polygon for each contour?
     if (polygon->convex)
     {
         // done
         tb_size_t       index               = 0;
         gb_point_ref_t  points              = polygon->points;
-        tb_uint16_t*    counts              = polygon->counts;
-        tb_uint16_t     contour_counts[2]   = {0, 0};
+        tb_uint32_t*    counts              = polygon->counts;
+        tb_uint32_t     contour_counts[2]   = {0, 0};
         gb_polygon_t    contour             = {tb_null, contour_counts, tb_true};
         while ((contour_counts[0] = *counts++))
         {
@@ -266,4 +274,7 @@ tb_void_t gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t
         // done tessellator for the concave polygon
         gb_tessellator_done_concave(impl, polygon, bounds);
     }
+
+    // leave the stats with the polygon points
+    gb_stats_leave(GB_STATS_STAGE_TESSELLATE, gb_stats_polygon_size(polygon));
 }
@@ -76,9 +76,9 @@ __tb_extern_c_enter__
  *
  *     1. simplify the mesh and process some degenerate cases.
  *
- *     2. build a vertex event queue and sort it (uses the priority queue with min-heap).
+ *     2. build a vertex event queue and sort it (sorts the initial vertices once and uses a min-heap for the new intersections only).
  *
- *     3. build an active edge region list and sort it (uses the partial insertion sort).
+ *     3. build an active edge region list and sort it (indexed by a treap, so find and insert only need O(log(n)) comparisons).
  *
  *     4. sweep all events from the event queue using the Bentley-Ottman line-sweep algorithm
  *        and calculate the intersection and winding number.
@@ -124,7 +124,7 @@ typedef struct{}*       gb_tessellator_ref_t;
  * @param count         the points count of the contour
  * @param priv          the user private data
  */
-typedef tb_void_t       (*gb_tessellator_func_t)(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv);
+typedef tb_void_t       (*gb_tessellator_func_t)(gb_point_ref_t points, tb_size_t count, tb_cpointer_t priv);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -15,6 +15,14 @@ option("bitmap")
     set_description("Enable or disable the bitmap device")
     add_defines_h("$(prefix)_DEVICE_HAVE_BITMAP")
 
+-- add option: stats
+option("stats")
+    set_default(false)
+    set_showmenu(true)
+    set_category("option")
+    set_description("Enable or disable the stats of the pipeline stages")
+    add_defines_h("$(prefix)_CORE_HAVE_STATS")
+
 -- add option: smallest
 option("smallest")
     set_default(false)
@@ -46,7 +54,7 @@ target("gbox")
     add_headers("../(gbox/**.h)|**/impl/**.h")
 
     -- add is_option
-    add_options("bitmap", "fixed")
+    add_options("bitmap", "fixed", "stats")
 
     -- add packages for window
     if is_os("ios", "android") then 
@@ -61,6 +69,7 @@ target("gbox")
     -- add the common source files
     add_files("*.c")
     add_files("core/**.c|device/**.c")
+    add_files("core/device/recorder.c")
     add_files("platform/*.c")
     add_files("platform/impl/*.c")
     add_files("utils/**.c|impl/tessellator/profiler.c")
@@ -70,7 +79,7 @@ target("gbox")
 
     -- add the source files for device
     if is_option("opengl") then add_files("core/device/gl.c", "core/device/gl/**.c") end
-    if is_option("bitmap") then add_files("core/device/bitmap.c", "core/device/bitmap/**.c") end
+    if is_option("bitmap") then add_files("core/device/bitmap.c", "core/device/bitmap_tiled.c", "core/device/bitmap/**.c") end
     if is_option("skia") then add_files("core/device/skia.cpp") end
 
     -- add the source files for window
@@ -81,6 +90,9 @@ target("gbox")
     elseif is_option("sdl") then add_files("platform/sdl/window.c") 
     end
 
+    -- add the source files for the offscreen window
+    add_files("platform/offscreen/window.c")
+
 
 
 